@@ -0,0 +1,85 @@
+/*
+ * Distance fields shared by the monsters chasing something
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include <roguepp/extern.hpp>
+#include <roguepp/types.hpp>
+
+/**
+ * Number of steps from every place on the level to one target place,
+ * moving the way monsters do: through anything that is not a wall or
+ * solid rock, and diagonally only when neither corner is blocked.
+ */
+class distance_field
+{
+public:
+    /** Distance of places the target cannot be reached from. */
+    static constexpr short FAR = 32767;
+
+    /** Moves possible out of each place, one bit per direction. */
+    using move_map = std::array<unsigned char, MAXLINES * MAXCOLS>;
+
+    /**
+     * Fill in the field for the given target.
+     */
+    void build(const coord& target, const move_map& moves);
+
+    /** Steps from the given place to the target. */
+    short at(int y, int x) const
+    {
+        return m_dist[(x << 5) + y];
+    }
+
+private:
+    std::array<short, MAXLINES * MAXCOLS> m_dist;
+};
+
+/**
+ * The distance fields built for the current level.  Monsters heading
+ * for the same place (the hero, or a door out of their room) share one
+ * field, so each of their steps is a few lookups, and a field is only
+ * built again when its target moves or the map changes.
+ */
+class distance_cache
+{
+public:
+    /** Number of fields kept. */
+    static constexpr std::size_t SIZE = 8;
+
+    /**
+     * Field leading to the given place.
+     */
+    const distance_field& to(const coord& target);
+
+    /**
+     * Forget every field.  Must be called whenever a place monsters
+     * could not walk through becomes one they can, or the other way
+     * around.
+     */
+    void clear();
+
+private:
+    void map_moves();
+
+    struct entry
+    {
+        distance_field field;
+        coord target;
+        bool valid;
+    };
+
+    std::array<entry, SIZE> m_entries = {};
+    std::size_t m_next = 0;
+    distance_field::move_map m_moves = {};
+    bool m_mapped = false;
+};
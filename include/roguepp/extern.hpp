@@ -27,7 +27,6 @@
 #define MAXLINES	32	/* maximum number of screen lines used */
 #define MAXCOLS		80	/* maximum number of screen columns used */
 
-#define RN		(((seed = seed*11109+13849) >> 16) & 0xffff)
 #ifdef CTRL
 #undef CTRL
 #endif
@@ -38,10 +37,10 @@
  */
 
 extern bool	got_ltc, in_shell;
-extern int	wizard;
-extern char	fruit[], prbuf[], whoami[];
 extern int orig_dsusp;
 extern FILE	*scoreboard;
+extern int	score_keeper;
+extern int	score_log;
 
 /*
  * Function types
@@ -65,6 +64,7 @@ void    quit(int);
 void    resetltchars();
 void rollwand(int);
 void runners(int);
+int	serve(const std::string& path, const std::string& saves);
 void sight(int);
 void stomach(int);
 void swander(int);
@@ -84,7 +84,6 @@ int	checkout();
 int md_chmod(const std::string& filename, int mode);
 const char* md_crypt(const std::string& key, const std::string& salt);
 int	md_dsuspchar();
-int	md_erasechar();
 std::string md_gethomedir();
 std::string md_getusername();
 int	md_getuid();
@@ -92,18 +91,15 @@ char* md_getpass(const std::string& prompt);
 int	md_getpid();
 std::string md_getrealname(int uid);
 void	md_init();
-int	md_killchar();
+int	md_lockfile(FILE* f, int msec);
 void	md_normaluser();
-void	md_raw_standout();
-void	md_raw_standend();
-int	md_readchar();
 int	md_setdsuspchar(int c);
 int	md_shellescape();
 void	md_sleep(int s);
 int	md_suspchar();
-int	md_hasclreol();
 int	md_unlink(const std::string& filename);
 int md_unlink_open_file(const std::string& filename, FILE* inf);
+void	md_unlockfile(FILE* f);
 void md_tstpsignal();
 void md_tstphold();
 void md_tstpresume();
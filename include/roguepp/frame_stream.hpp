@@ -0,0 +1,57 @@
+/*
+ * Binary frame stream written by the stream renderer
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+#pragma once
+
+#include <cstdint>
+
+/**
+ * The stream starts with the four bytes of FRAME_MAGIC, the format
+ * version and the size of the screen in lines and columns, one byte
+ * each.  After that it is a sequence of records, each an opcode byte
+ * followed by its operands, all single bytes unless noted.
+ *
+ * Every record but FRAME_REDRAW names the window it applies to first.
+ * Window 0 is the main screen and window 1 the scratch window; further
+ * windows are opened and closed with FRAME_OPEN and FRAME_CLOSE.
+ *
+ * A reader keeps a copy of every window, applies the records to it as
+ * they come, and puts a window on the screen when its FRAME_SHOW
+ * arrives.  The stream is only written out after a FRAME_SHOW, or
+ * before the game waits for a key, so a reader never sees half a
+ * frame.
+ */
+static constexpr char FRAME_MAGIC[4] = { 'R', 'G', 'F', 'S' };
+static constexpr std::uint8_t FRAME_VERSION = 1;
+
+enum frame_op : std::uint8_t
+{
+    /** window, y, x: move the cursor. */
+    FRAME_MOVE = 1,
+    /** window, n, then n characters: draw them at the cursor. */
+    FRAME_TEXT = 2,
+    /** window: clear from the cursor to the end of the line. */
+    FRAME_CLRTOEOL = 3,
+    /** window: blank the window and repaint it when it is next shown. */
+    FRAME_CLEAR = 4,
+    /** window, 0 or 1: draw the following text in standout mode or not. */
+    FRAME_STANDOUT = 5,
+    /** window: repaint all of it when it is next shown. */
+    FRAME_TOUCH = 6,
+    /** window, y, x: move the window on the screen. */
+    FRAME_PLACE = 7,
+    /** window, lines, cols, y, x: open a new blank window. */
+    FRAME_OPEN = 8,
+    /** window: the window is gone. */
+    FRAME_CLOSE = 9,
+    /** window: put the changes to the window on the screen. */
+    FRAME_SHOW = 10,
+    /** Repaint the whole screen on the next FRAME_SHOW. */
+    FRAME_REDRAW = 11,
+};
@@ -0,0 +1,111 @@
+/*
+ * Playing a game by handing it keys, one step at a time
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+
+struct game;
+
+/**
+ * Runs a game as a coroutine, so that whoever plays it supplies keys
+ * when the game wants them instead of the game blocking until they
+ * come.
+ *
+ * The rules keep asking for keys deep inside a turn: command(),
+ * get_item(), get_dir(), the --More-- of msg() and wait_for() all
+ * call readchar().  The game therefore runs on a stack of its own.
+ * When its renderer asks take() for a key that hasn't been fed, the
+ * game is put aside right there and step() returns; the next step()
+ * after feed() carries on from the same place.  Many games can take
+ * turns on one thread this way.  Nothing the rules keep in
+ * thread_local storage may stay in use across a readchar() for that
+ * to work.
+ */
+class game_stepper
+{
+public:
+    /** Stack size a game gets unless told otherwise. */
+    static constexpr std::size_t STACK_SIZE = 256 * 1024;
+
+    /**
+     * Set up the given game to be played by calling play on its own
+     * stack.  Nothing runs until the first step().  A game_over ends
+     * play quietly; any other exception is thrown again by step().
+     */
+    game_stepper(game& g, std::function<void()> play, std::size_t stack_size = STACK_SIZE);
+
+    /**
+     * Ends the game if it is still going, see end().
+     */
+    ~game_stepper();
+
+    game_stepper(const game_stepper&) = delete;
+    game_stepper& operator=(const game_stepper&) = delete;
+
+    /** Queue a key (or byte) for the game. */
+    void feed(int key)
+    {
+        m_keys.push_back(key);
+    }
+
+    /**
+     * Run the game until it wants a key that hasn't been fed, or is
+     * over.  cur_game points at the game while it runs and is put back
+     * afterwards.  Returns whether the game is still going.
+     */
+    bool step();
+
+    /**
+     * Make the game end the next time it wants a key it hasn't got, as
+     * if my_exit() had been called there.
+     */
+    void hangup()
+    {
+        m_hungup = true;
+    }
+
+    /**
+     * End the game now if it is still going, unwinding whatever it was
+     * in the middle of.
+     */
+    void end();
+
+    /** Has the game finished? */
+    bool over() const
+    {
+        return m_over;
+    }
+
+    /**
+     * Next key for the game, for its renderer to call.  If none has
+     * been fed, waits for one if wait is true, or returns -1.
+     */
+    int take(bool wait);
+
+private:
+    struct context;
+
+    void run();
+    void yield();
+    void resume();
+
+    game& m_game;
+    std::function<void()> m_play;
+    std::unique_ptr<context> m_context;
+    std::deque<int> m_keys;
+    std::exception_ptr m_error;
+    bool m_started;
+    bool m_hungup;
+    bool m_over;
+};
@@ -11,6 +11,7 @@ static constexpr std::size_t MAXPACK = 23;
 static constexpr std::size_t MAXTRAPS = 10;
 /** Upper limit on number of passages. */
 static constexpr std::size_t MAXPASS = 13;
+/** Daemon slots written to a save file, even when fewer are in use. */
 static constexpr std::size_t MAXDAEMONS = 20;
 static constexpr std::size_t MAXPOTIONS = 14;
 static constexpr std::size_t MAXSCROLLS = 18;
@@ -0,0 +1,170 @@
+/*
+ * Interface between the game rules and whatever draws the screen
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+#pragma once
+
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+
+/**
+ * A rectangular drawing surface.  Game logic draws through canvases
+ * instead of calling the terminal library directly, so that the core
+ * can run without a terminal attached.
+ */
+class canvas
+{
+public:
+    virtual ~canvas() = default;
+
+    /** Number of lines on the canvas. */
+    virtual int lines() const = 0;
+    /** Number of columns on the canvas. */
+    virtual int cols() const = 0;
+
+    /** Move the cursor. */
+    virtual void move(int y, int x) = 0;
+    /** Current cursor position. */
+    virtual void getyx(int& y, int& x) const = 0;
+    /** Put a character at the cursor and advance it. */
+    virtual void addch(int ch) = 0;
+    /** Put a string at the cursor and advance it. */
+    virtual void addstr(const char* str) = 0;
+    /** Character under the cursor, without attributes. */
+    virtual int inch() const = 0;
+    /** Clear to the end of the current line. */
+    virtual void clrtoeol() = 0;
+    /** Blank the canvas and repaint it completely on next refresh. */
+    virtual void clear() = 0;
+    /** Blank the canvas. */
+    virtual void erase() = 0;
+    /** Start drawing in standout mode. */
+    virtual void standout() = 0;
+    /** Stop drawing in standout mode. */
+    virtual void standend() = 0;
+    /** Show the changes made to the canvas. */
+    virtual void refresh() = 0;
+    /** Mark the whole canvas as changed. */
+    virtual void touch() = 0;
+    /** Move the canvas on the screen. */
+    virtual void place(int y, int x) = 0;
+
+    void mvaddch(int y, int x, int ch)
+    {
+        move(y, x);
+        addch(ch);
+    }
+
+    void mvaddstr(int y, int x, const char* str)
+    {
+        move(y, x);
+        addstr(str);
+    }
+
+    int mvinch(int y, int x)
+    {
+        move(y, x);
+        return inch();
+    }
+
+    void printw(const char* fmt, ...);
+    void mvprintw(int y, int x, const char* fmt, ...);
+};
+
+/**
+ * Output and input device the game core talks to.  The interactive
+ * front end implements this on top of ncurses.
+ */
+class renderer
+{
+public:
+    virtual ~renderer() = default;
+
+    /** Take over the terminal. */
+    virtual void begin() = 0;
+    /** Give the terminal back. */
+    virtual void end() = 0;
+    /** Has the terminal been given back? */
+    virtual bool ended() const = 0;
+    /** Give the terminal back for a while (shell escape, suspend). */
+    virtual void suspend() = 0;
+    /** Take the terminal back after suspend(). */
+    virtual void resume() = 0;
+
+    /** Number of lines on the screen. */
+    virtual int lines() const = 0;
+    /** Number of columns on the screen. */
+    virtual int cols() const = 0;
+
+    /** The main screen. */
+    virtual canvas& screen() = 0;
+    /** Full screen scratch window for help, maps and inventories. */
+    virtual canvas& scratch() = 0;
+    /** Create a new canvas on top of the main screen. */
+    virtual std::unique_ptr<canvas> new_canvas(int lines, int cols, int y, int x) = 0;
+    /** Repaint the whole screen on next refresh. */
+    virtual void redraw() = 0;
+
+    /** Read a key, translating cursor keys into movement commands. */
+    virtual int readchar() = 0;
+    /** Throw away typeahead. */
+    virtual void flush_input() = 0;
+    /** The user's erase character. */
+    virtual int erasechar() = 0;
+    /** The user's line kill character. */
+    virtual int killchar() = 0;
+
+    /** Can the terminal clear to end of line cheaply? */
+    virtual bool has_clreol() const = 0;
+    /** Is the terminal too slow for fancy output? */
+    virtual bool slow() const = 0;
+
+    /** Start standout mode on a terminal not under our control. */
+    virtual void raw_standout() = 0;
+    /** End standout mode on a terminal not under our control. */
+    virtual void raw_standend() = 0;
+};
+
+/*
+ * Renderer backends
+ */
+
+/** Draws through ncurses. */
+std::unique_ptr<renderer> curses_renderer();
+
+/**
+ * Draws nothing at all and takes its keys from the given function, for
+ * simulations and bots.  What the game would show is still there in
+ * its shadow canvases.
+ */
+std::unique_ptr<renderer> null_renderer(int lines, int cols, std::function<int()> keys);
+
+/**
+ * Writes ANSI escape sequences straight to the terminal, without
+ * terminfo or curses windows.
+ */
+std::unique_ptr<renderer> ansi_renderer();
+
+/**
+ * Same for a terminal at the other end of a connection, of the given
+ * size.  The bytes typed there come from input, which returns -1 when
+ * called with false and nothing has arrived yet; the escape sequences
+ * to show go to output.
+ */
+std::unique_ptr<renderer> ansi_renderer(int lines, int cols,
+    std::function<int(bool)> input,
+    std::function<void(const std::string&)> output);
+
+/**
+ * Writes the screen changes as a binary frame stream (see
+ * frame_stream.hpp) to the given file, for recording or spectating,
+ * and reads keys from standard input.
+ */
+std::unique_ptr<renderer> stream_renderer(std::FILE* out);
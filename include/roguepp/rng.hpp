@@ -0,0 +1,103 @@
+/*
+ * Counter based random number streams
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Independent random number streams of a game.  Draws made for one
+ * purpose never shift the numbers seen by another, so for instance a
+ * change in the combat code does not change the dungeon layout of a
+ * given seed.
+ */
+enum rng_stream_id
+{
+    RNG_LEVEL,		/* Dungeon generation */
+    RNG_COMBAT,		/* Hits, damage and saving throws */
+    RNG_MONSTER,	/* Monster movement and wandering monsters */
+    RNG_ITEM,		/* Object creation */
+    RNG_MISC,		/* Everything else */
+    NRNG
+};
+
+/**
+ * Random number stream whose n-th number is a hash of the stream key
+ * and n.  Nothing but the position changes as numbers are drawn, so a
+ * stream can be saved, restored or moved to any point in constant time.
+ */
+class rng_stream
+{
+public:
+    /**
+     * Start the stream over with a new key.
+     */
+    void reset(std::uint64_t key)
+    {
+        m_key = mix(key);
+        m_position = 0;
+    }
+
+    /** Number of values drawn from the stream so far. */
+    std::uint64_t position() const
+    {
+        return m_position;
+    }
+
+    /** Move the stream to the given position. */
+    void seek(std::uint64_t position)
+    {
+        m_position = position;
+    }
+
+    /** Next 32 random bits. */
+    std::uint32_t next()
+    {
+        return static_cast<std::uint32_t>(mix(m_key + ++m_position * GOLDEN) >> 32);
+    }
+
+    /**
+     * Unbiased random number in [0, range), with range > 0.  Uses the
+     * multiply and shift method, which only needs a division in the
+     * rare case the first draw falls in the biased part.
+     */
+    std::uint32_t below(std::uint32_t range)
+    {
+        auto m = static_cast<std::uint64_t>(next()) * range;
+        auto low = static_cast<std::uint32_t>(m);
+
+        if (low < range)
+        {
+            const auto threshold = -range % range;
+
+            while (low < threshold)
+            {
+                m = static_cast<std::uint64_t>(next()) * range;
+                low = static_cast<std::uint32_t>(m);
+            }
+        }
+
+        return static_cast<std::uint32_t>(m >> 32);
+    }
+
+private:
+    static constexpr std::uint64_t GOLDEN = 0x9e3779b97f4a7c15;
+
+    /** SplitMix64 finalizer. */
+    static std::uint64_t mix(std::uint64_t z)
+    {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+
+        return z ^ (z >> 31);
+    }
+
+    std::uint64_t m_key = 0;
+    std::uint64_t m_position = 0;
+};
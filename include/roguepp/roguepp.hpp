@@ -12,22 +12,31 @@
 #pragma once
 
 #include <array>
+#include <memory>
 #include <optional>
+#include <vector>
 
+#include <roguepp/distance_field.hpp>
 #include <roguepp/extern.hpp>
 #include <roguepp/limits.hpp>
+#include <roguepp/renderer.hpp>
+#include <roguepp/rng.hpp>
+#include <roguepp/scheduler.hpp>
+#include <roguepp/shadow_canvas.hpp>
+#include <roguepp/thing_pool.hpp>
 #include <roguepp/types.hpp>
 
 #undef lines
 
 #define NOOP(x) (x += 0)
-#define CCHAR(x) ( (char) (x & A_CHARTEXT) )
+#define CCHAR(x) ( (char) (x) )
 
 #define AMULETLEVEL	26
 #define	NUMTHINGS	7	/* number of types of things */
 #define	NUMLINES	24
 #define	NUMCOLS		80
 #define STATLINE		(NUMLINES - 1)
+#define MAXMSG	(NUMCOLS - sizeof "--More--")
 #define BORE_LEVEL	50
 
 /*
@@ -54,28 +63,29 @@
 #define prev(ptr)	(*ptr).l_prev
 #define winat(y,x)	(moat(y,x) != nullptr ? moat(y,x)->t_disguise : chat(y,x))
 #define ce(a,b)		((a).x == (b).x && (a).y == (b).y)
-#define hero		player.t_pos
-#define pstats		player.t_stats
-#define pack		player.t_pack
-#define proom		player.t_room
-#define max_hp		player.t_stats.s_maxhp
+#define hero		cur_game->player.t_pos
+#define pstats		cur_game->player.t_stats
+#define pack		cur_game->player.t_pack
+#define proom		cur_game->player.t_room
+#define max_hp		cur_game->player.t_stats.s_maxhp
 #define attach(a,b)	_attach(&a,b)
 #define detach(a,b)	_detach(&a,b)
 #define free_list(a)	_free_list(&a)
 #undef max
 #define max(a,b)	((a) > (b) ? (a) : (b))
 #define on(thing,flag)	((bool)(((thing).t_flags & (flag)) != 0))
-#define GOLDCALC	(rnd(50 + 10 * level) + 2)
-#define ISRING(h,r)	(cur_ring[h] != nullptr && cur_ring[h]->o_which == r)
+#define GOLDCALC	(rnd(50 + 10 * cur_game->level) + 2)
+#define ISRING(h,r)	(cur_game->cur_ring[h] != nullptr && cur_game->cur_ring[h]->o_which == r)
 #define ISWEARING(r)	(ISRING(LEFT, r) || ISRING(RIGHT, r))
 #define ISMULT(type) 	(type == POTION || type == SCROLL || type == FOOD)
-#define INDEX(y,x)	(&places[((x) << 5) + (y)])
-#define chat(y,x)	(places[((x) << 5) + (y)].p_ch)
-#define flat(y,x)	(places[((x) << 5) + (y)].p_flags)
-#define moat(y,x)	(places[((x) << 5) + (y)].p_monst)
+#define INDEX(y,x)	(&cur_game->places[((x) << 5) + (y)])
+#define chat(y,x)	(cur_game->places[((x) << 5) + (y)].p_ch)
+#define flat(y,x)	(cur_game->places[((x) << 5) + (y)].p_flags)
+#define moat(y,x)	(cur_game->places[((x) << 5) + (y)].p_monst)
+#define obat(y,x)	(cur_game->places[((x) << 5) + (y)].p_obj)
 #define unc(cp)		(cp).y, (cp).x
 #ifdef MASTER
-#define debug		if (wizard) msg
+#define debug		if (cur_game->wizard) msg
 #endif
 
 /*
@@ -221,72 +231,257 @@ enum object_type : int
 #define o_label		_o._o_label
 
 /*
- * External variables
+ * Everything that belongs to a single game.  Each game in the process
+ * has its own copy and cur_game points to the one being played on the
+ * calling thread.
  */
+struct game
+{
+    game();
+    ~game();
+
+    game(const game&) = delete;
+    game& operator=(const game&) = delete;
+
+    /** What the game draws on. */
+    renderer* display = nullptr;
+    /** The main screen. */
+    canvas* cw = nullptr;
+    /** Used as a scratch window. */
+    canvas* hw = nullptr;
+    /** What the game has drawn on the main screen. */
+    std::unique_ptr<shadow_canvas> cw_shadow;
+    /** What the game has drawn on the scratch window. */
+    std::unique_ptr<shadow_canvas> hw_shadow;
+
+    bool after = false;			/* True if we want after daemons */
+    bool again = false;			/* Repeating the last command */
+    bool amulet = false;		/* He found the amulet */
+    bool door_stop = false;		/* Stop running when we pass a door */
+    bool fight_flush = false;		/* True if toilet input */
+    bool firstmove = false;		/* First move after setting door_stop */
+    bool has_hit = false;		/* Has a "hit" message pending in msg */
+    bool inv_describe = true;		/* Say which way items are being used */
+    bool jump = false;			/* Show running as series of jumps */
+    bool kamikaze = false;		/* to_death really to DEATH */
+    bool lower_msg = false;		/* Messages should start w/lower case */
+    bool move_on = false;		/* Next move shouldn't pick up items */
+    bool msg_esc = false;		/* Check for ESC from msg's --More-- */
+    bool passgo = false;		/* Follow passages */
+    bool playing = true;		/* True until he quits */
+    bool q_comm = false;		/* Are we executing a 'Q' command? */
+    bool running = false;		/* True if player is running */
+    bool save_msg = true;		/* Remember last msg */
+    bool see_floor = true;		/* Show the lamp illuminated floor */
+    bool seenstairs = false;		/* Have seen the stairs (for lsd) */
+    bool stat_msg = false;		/* Should status() print as a msg() */
+    bool terse = false;			/* True if we should be short */
+    bool to_death = false;		/* Fighting is to the death! */
+    bool tombstone = true;		/* Print out tombstone at end */
+    int wizard = false;			/* True if allows wizard commands */
+    int noscore = 0;			/* Was a wizard sometime */
+
+    /** Is the character used in the pack? */
+    std::array<bool, 26> pack_used = {};
+
+    char dir_ch = '\0';			/* Direction from last get_dir() call */
+    char file_name[MAXSTR] = {};	/* Save file name */
+    char display_name[MAXSTR] = "curses";	/* Renderer to start with */
+    char fruit[MAXSTR] = "slime-mold";	/* Favorite fruit */
+    char huh[MAXSTR] = {};		/* The last message printed */
+    char l_last_comm = '\0';		/* Last last_comm */
+    char l_last_dir = '\0';		/* Last last_dir */
+    char last_comm = '\0';		/* Last command typed */
+    char last_dir = '\0';		/* Last direction given */
+    char prbuf[2*MAXSTR] = {};		/* buffer for sprintfs */
+    char runch = '\0';			/* Direction player is running */
+    char take = '\0';			/* Thing she is taking */
+    char whoami[MAXSTR] = {};		/* Name of player */
+
+    /** Colors of the potions. */
+    std::array<std::optional<std::string>, MAXPOTIONS> p_colors = {};
+    /** Stone settings of the rings. */
+    std::array<std::optional<std::string>, MAXRINGS> r_stones = {};
+    /** Names of the scrolls. */
+    std::array<std::string, MAXSCROLLS> s_names = {};
+    /** What sticks are made of. */
+    std::array<std::optional<std::string>, MAXSTICKS> ws_made = {};
+    /** Is it a wand or a staff? */
+    std::array<std::optional<std::string>, MAXSTICKS> ws_type = {};
+
+    int count = 0;			/* Number of times to repeat command */
+    int food_left = 0;			/* Amount of food in hero's stomach */
+    int hungry_state = 0;		/* How hungry is he */
+    int inpack = 0;			/* Number of things in pack */
+    int inv_type = 0;			/* Type of inventory to use */
+    int lastscore = -1;			/* Score before this turn */
+    int level = 1;			/* What level she is on */
+    int max_hit = 0;			/* Max damage done to her in to_death */
+    int max_level = 0;			/* Deepest player has gone */
+    int mpos = 0;			/* Where cursor is on top line */
+    int n_objs = 0;			/* # items listed in inventory() call */
+    int no_command = 0;			/* Number of turns asleep */
+    int no_food = 0;			/* Number of levels without food */
+    int no_move = 0;			/* Number of turns held in place */
+    int ntraps = 0;			/* Number of traps on this level */
+    int purse = 0;			/* How much gold he has */
+    int quiet = 0;			/* Number of quiet turns */
+    int vf_hit = 0;			/* Number of time flytrap has hit */
+    int dnum = 0;			/* Dungeon number */
+    int seed = 0;			/* Random number seed */
+    std::array<rng_stream, NRNG> rng = {};	/* Streams derived from seed */
+    int rng_cur = RNG_MISC;		/* Stream rnd() draws from */
+    thing_pool item_pool;		/* THINGs kept across levels */
+    thing_pool level_pool;		/* THINGs of the current level */
+    distance_cache chase_fields;	/* Where chasing monsters head */
+    std::vector<THING*> awake;		/* Running monsters, in mlist order */
+    bool awake_stale = true;		/* Has awake to be found again? */
+    int between = 0;			/* Turns since last wanderer check */
+    int group = 2;			/* Next group number for missiles */
+    int turns = 0;			/* Turns played so far */
+
+    bool embedded = false;		/* Run by another program */
+    int uid = -1;			/* Player's uid, if not the process's */
+
+    /*
+     * How the game ended, filled in by score(), which stops there for
+     * games that hand the result back instead of posting it
+     */
+    bool hand_back = false;		/* Hand the result back */
+    int end_score = 0;			/* Score posted at the end */
+    int end_flags = -1;			/* How it ended (see score()) */
+    char end_monst = '\0';		/* What killed him */
+
+    coord delta = {};			/* Change indicated to get_dir() */
+    coord nh = {};			/* Where the hero is moving to */
+    coord oldpos = {};			/* Position before last look() call */
+    coord stairs = {};			/* Location of staircase */
+
+    PLACE places[MAXLINES*MAXCOLS] = {};	/* level map */
+
+    THING* cur_armor = nullptr;		/* What he is wearing */
+    THING* cur_ring[2] = {};		/* Which rings are being worn */
+    THING* cur_weapon = nullptr;	/* Which weapon he is weilding */
+    THING* l_last_pick = nullptr;	/* Last last_pick */
+    THING* last_pick = nullptr;		/* Last object picked in get_item() */
+    THING* lvl_obj = nullptr;		/* List of objects on this level */
+    THING* mlist = nullptr;		/* List of monsters on the level */
+    THING player = {};			/* His stats */
+
+    /** The maximum for the player. */
+    stats max_stats = {};
+
+    /** Roomin(&oldpos) */
+    room* oldrp = nullptr;
+    /** One for each passage. */
+    std::array<room, MAXPASS> passages = {};
+    /** One for each room -- A level. */
+    std::array<room, MAXROOMS> rooms = {};
+
+    monster monsters[26] = {};
+    obj_info things[NUMTHINGS] = {};
+    obj_info arm_info[MAXARMORS] = {};
+    obj_info pot_info[MAXPOTIONS] = {};
+    obj_info ring_info[MAXRINGS] = {};
+    obj_info scr_info[MAXSCROLLS] = {};
+    obj_info weap_info[MAXWEAPONS + 1] = {};
+    obj_info ws_info[MAXSTICKS] = {};
+
+    /** Daemons and fuses. */
+    scheduler timers;
+
+    /*
+     * Working state of individual routines
+     */
+    char msgbuf[2*MAXMSG+1] = "";	/* msg() text not yet flushed */
+    int newpos = 0;			/* Length of msgbuf */
+    int hpwidth = 0;			/* status(): last line printed */
+    int s_hungry = 0;
+    int s_lvl = 0;
+    int s_pur = -1;
+    int s_hp = 0;
+    int s_arm = 0;
+    stats::str_t s_str = 0;
+    int s_exp = 0;
+    char countch = '\0';		/* command(): repeated command */
+    char direction = '\0';		/* command(): direction being run */
+    char newcount = false;		/* command(): count just typed */
+    coord last_delt = {0, 0};		/* get_dir(): last direction */
+    coord ch_ret = {};			/* Where chasing takes you */
+    coord this_ = {};			/* do_chase(): destination for chaser */
+    coord tryp = {};			/* chase(): square being tried */
+    coord rnd_ret = {};			/* rndmove(): where it moves */
+    int line_cnt = 0;			/* add_line(): lines shown so far */
+    bool newpage = false;		/* add_line(): started a new page */
+    int maxlen = -1;			/* add_line(): widest line */
+    const char* lastfmt = nullptr;	/* add_line(): last format */
+    const char* lastarg = nullptr;	/* add_line(): last argument */
+};
 
-extern bool	after, again, allscore, amulet, door_stop, fight_flush,
-		firstmove, has_hit, inv_describe, jump, kamikaze,
-		lower_msg, move_on, msg_esc,
-		passgo, playing, q_comm, running, save_msg, see_floor,
-		seenstairs, stat_msg, terse, to_death, tombstone;
+/** The game being played on this thread. */
+extern thread_local game* cur_game;
 
-/** Is the character used in the pack? */
-extern std::array<bool, 26> pack_used;
+/**
+ * Makes rnd() draw from the given stream of the current game for as
+ * long as it lives.
+ */
+class rng_scope
+{
+public:
+    explicit rng_scope(rng_stream_id id)
+        : m_saved(cur_game->rng_cur)
+    {
+        cur_game->rng_cur = id;
+    }
+
+    ~rng_scope()
+    {
+        cur_game->rng_cur = m_saved;
+    }
+
+    rng_scope(const rng_scope&) = delete;
+    rng_scope& operator=(const rng_scope&) = delete;
+
+private:
+    int m_saved;
+};
 
-extern char	dir_ch, file_name[], home[], huh[],
-		l_last_comm, l_last_dir, last_comm, last_dir,
-		outbuf[], runch, take;
+/**
+ * Thrown by my_exit() instead of leaving the process when the game
+ * is embedded in another program.
+ */
+struct game_over
+{
+    /** Exit status the stand-alone game would have used. */
+    int status;
+};
 
-extern const char* Numname;
+/**
+ * A saved game read into memory, see rs_open_file().
+ */
+struct saved_game
+{
+    /** The whole file. */
+    std::vector<char> image;
+    /** Written before saved games had sections. */
+    bool legacy = false;
+    /** Written by a version this one can't restore. */
+    bool stale = false;
+    /** Size of the screen it was saved on. */
+    int lines = 0;
+    int cols = 0;
+};
 
+extern bool allscore;
+extern char home[];
+extern const char* Numname;
 extern std::string release;
 extern std::array<const char*, 3> inv_t_name;
 /** Names of the traps. */
 extern std::array<const char*, NTRAPS> tr_name;
-/** Colors of the potions. */
-extern std::array<std::optional<std::string>, MAXPOTIONS> p_colors;
-/** Stone settings of the rings. */
-extern std::array<std::optional<std::string>, MAXRINGS> r_stones;
-/** Names of the scrolls. */
-extern std::array<std::string, MAXSCROLLS> s_names;
-/** What sticks are made of. */
-extern std::array<std::optional<std::string>, MAXSTICKS> ws_made;
-/** Is it a wand or a staff? */
-extern std::array<std::optional<std::string>, MAXSTICKS> ws_type;
-
-extern int	a_class[], count, food_left, hungry_state, inpack,
-		inv_type, lastscore, level, max_hit, max_level, mpos,
-		n_objs, no_command, no_food, no_move, noscore, ntraps, purse,
-		quiet, vf_hit;
-
-extern unsigned int	numscores;
-
-extern int	dnum, e_levels[], seed;
-
-extern WINDOW	*hw;
-
-extern coord	delta, oldpos, stairs;
-
-extern PLACE	places[];
-
-extern THING	*cur_armor, *cur_ring[], *cur_weapon, *l_last_pick,
-		*last_pick, *lvl_obj, *mlist, player;
-
-extern struct h_list	helpstr[];
-
-/** Roomin(&oldpos) */
-extern room* oldrp;
-/** One for each passage. */
-extern std::array<room, MAXPASS> passages;
-/** One for each room -- A level. */
-extern std::array<room, MAXROOMS> rooms;
-
-extern struct stats	max_stats;
-
-extern struct monster	monsters[];
-
-extern struct obj_info	arm_info[], pot_info[], ring_info[],
-			scr_info[], things[], ws_info[], weap_info[];
+extern int a_class[], e_levels[];
+extern unsigned int numscores;
+extern struct h_list helpstr[];
 
 /*
  * Function types
@@ -336,31 +531,37 @@ void	drain();
 void	drop();
 void	eat();
 size_t  encread(char *start, size_t size, FILE *inf);
+void	encxor(char* dst, const char* src, std::size_t size);
 std::size_t encwrite(const char* start, std::size_t size, FILE* outf);
+std::size_t encwrite(const char* start, std::size_t size, std::string& out);
 int	endmsg();
 void	enter_room(coord *cp);
 void erase_lamp(const coord& pos, const room& rp);
 int	exp_add(THING *tp);
 void extinguish(const delayed_action::callback_type& func);
+void extinguish(timer_handle wire);
 void	fall(THING *obj, bool pr);
 void fire_bolt(const coord* start, coord* dir, const char* name);
 char	floor_at();
 void	flush_type();
 int	fight(coord *mp, THING *weap, bool thrown);
 void fix_stick(THING& cur);
-void fuse(const delayed_action::callback_type& func, int arg, int time, int type);
+timer_handle fuse(const delayed_action::callback_type& func, int arg, int time, int type);
 bool	get_dir();
 int	gethand();
 void	give_pack(THING *tp);
 void	help();
 void	leave_room(coord *cp);
 void lengthen(const delayed_action::callback_type& func, int xtime);
+void lengthen(timer_handle wire, int xtime);
 void	look(bool wakeup);
 int	hit_monster(int y, int x, THING *obj);
 void	identify();
 void	illcom(int ch);
 void	init_check();
 void	init_colors();
+void	init_display();
+void	init_game();
 void	init_materials();
 void	init_names();
 void	init_player();
@@ -372,6 +573,7 @@ void	invis_on();
 void	killed(THING *tp, bool pr);
 void kill_daemon(const delayed_action::callback_type& func);
 bool	lock_sc();
+void	map_rooms();
 void	missile(int ydelta, int xdelta);
 void	money(int value);
 int	move_monst(THING *tp);
@@ -401,17 +603,21 @@ void    relocate(THING *th, coord *new_loc);
 void	remove_mon(coord *mp, THING *tp, bool waskill);
 void	reset_last();
 bool restore(const char* file, char** envp);
+bool restore_embedded();
 int	ring_eat(int hand);
 void	ring_on();
 void	ring_off();
 int	rnd(int range);
+void	srnd(int seed);
 int	rnd_room();
 int	roll(int number, int sides);
-bool rs_save_file(FILE* savef);
-bool rs_restore_file(FILE* inf);
+bool rs_open_file(saved_game& save);
+bool rs_save_file(std::string& savef);
+bool rs_restore_file(const saved_game& save);
 void	runto(coord *runner);
 void	rust_armor(THING *arm);
 int	save(int which);
+bool	save_embedded();
 void	save_file(FILE *savef);
 void	save_game();
 int	save_throw(int which, THING *tp);
@@ -426,7 +632,8 @@ void	show_map();
 void show_win(const std::string& message);
 int	sign(int nm);
 int	spread(int nm);
-void start_daemon(const delayed_action::callback_type& func, int arg, int type);
+timer_handle start_daemon(const delayed_action::callback_type& func, int arg, int type);
+void	start_game();
 void	start_score();
 void	status();
 int	step_ok(int ch);
@@ -480,7 +687,7 @@ std::string charge_str(const THING& obj);
 inline const char*
 choose_str(const char* ts, const char* ns)
 {
-    return on(player, ISHALU) ? ts : ns;
+    return on(cur_game->player, ISHALU) ? ts : ns;
 }
 
 extern const std::array<std::string, NCOLORS> rainbow;
@@ -499,20 +706,21 @@ random_color()
 inline const std::string&
 pick_color(const std::string& col)
 {
-    return on(player, ISHALU) ? random_color() : col;
+    return on(cur_game->player, ISHALU) ? random_color() : col;
 }
 
 char	*inv_name(THING *obj, bool drop);
 char	*num(int n1, int n2, char type);
 std::string ring_num(const THING& obj);
 const char* set_mname(THING* tp);
+const char* unctrl(int ch);
 const char* vowelstr(const std::string& str);
 
-int	get_bool(void *vp, WINDOW *win);
-int	get_inv_t(void *vp, WINDOW *win);
-int	get_num(void *vp, WINDOW *win);
-int	get_sf(void *vp, WINDOW *win);
-int	get_str(void *vopt, WINDOW *win);
+int	get_bool(void *vp, canvas* win);
+int	get_inv_t(void *vp, canvas* win);
+int	get_num(void *vp, canvas* win);
+int	get_sf(void *vp, canvas* win);
+int	get_str(void *vopt, canvas* win);
 int	trip_ch(int y, int x, int ch);
 
 coord	*find_dest(THING *tp);
@@ -520,24 +728,21 @@ coord	*rndmove(THING *who);
 
 THING	*find_obj(int y, int x);
 THING* get_item(const char* purpose, int type);
+THING	*keep_item(THING **list, THING *item);
 THING	*leave_pack(THING *obj, bool newobj, bool all);
+THING	*level_item(THING *item);
 THING	*new_item();
+THING	*new_pack_item();
 THING	*new_thing();
 
 struct room	*roomin(coord *cp);
 
-extern delayed_action d_list[MAXDAEMONS];
-
 struct STONE
 {
     std::string st_name;
     int st_value;
 };
 
-extern int      total;
-extern int      between;
-extern int      group;
-extern coord    nh;
 extern const std::array<STONE, NSTONES> stones;
 extern const std::array<std::string, NWOOD> wood;
 extern const std::array<std::string, NMETAL> metal;
@@ -0,0 +1,170 @@
+/*
+ * Timer wheel for daemons and fuses
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <roguepp/types.hpp>
+
+/**
+ * Names one daemon or fuse.  A handle stays tied to the action it was
+ * given for: once that action has gone off or been put out, the handle
+ * matches nothing, even if its slot is used again.
+ */
+struct timer_handle
+{
+    std::uint32_t slot = 0;
+    /** 0 for the null handle. */
+    std::uint32_t generation = 0;
+
+    explicit operator bool() const
+    {
+        return generation != 0;
+    }
+};
+
+/**
+ * Holds the daemons and fuses of a game.
+ *
+ * Every action has a slot, and a new one takes the lowest free slot,
+ * just like the fixed d_list[] this replaces, so daemons run and fuses
+ * go off in the same order as they always did.  There is no limit on
+ * the number of slots.
+ *
+ * Fuses sit on a hashed timer wheel, one per type, that turns one
+ * notch per call to run_fuses() of that type.  Lighting, putting out
+ * or lengthening a fuse is constant time, and a turn only looks at the
+ * fuses in the notch the wheel has turned to instead of every slot.
+ */
+class scheduler
+{
+public:
+    using callback_type = delayed_action::callback_type;
+
+    /** d_time of daemons, which run every turn until killed. */
+    static constexpr int DAEMON = -1;
+    /** Notches on each wheel. */
+    static constexpr std::size_t WHEEL_SIZE = 256;
+    /** Highest type (BEFORE, AFTER, ...) an action can have. */
+    static constexpr int MAX_TYPE = 3;
+
+    scheduler() = default;
+
+    scheduler(const scheduler&) = delete;
+    scheduler& operator=(const scheduler&) = delete;
+
+    /**
+     * Start a daemon that runs on every run_daemons() of its type.
+     */
+    timer_handle start_daemon(callback_type func, int arg, int type);
+
+    /**
+     * Light a fuse that goes off after the given number of
+     * run_fuses() of its type.  A fuse lit with no time left never
+     * goes off unless it is lengthened.
+     */
+    timer_handle fuse(callback_type func, int arg, int time, int type);
+
+    /**
+     * Kill a daemon or put out a fuse.  Returns false if the handle
+     * matches nothing.
+     */
+    bool cancel(timer_handle handle);
+
+    /**
+     * Add to the time until a fuse goes off.
+     */
+    bool lengthen(timer_handle handle, int xtime);
+
+    /**
+     * First action, in slot order, calling the given function.  Only
+     * there for callers that do not keep the handle they were given.
+     */
+    timer_handle find(callback_type func) const;
+
+    /**
+     * Run every daemon of the given type, in slot order.
+     */
+    void run_daemons(int type);
+
+    /**
+     * Turn the wheel of the given type one notch and set off the fuses
+     * whose time has come, in slot order.
+     */
+    void run_fuses(int type);
+
+    /**
+     * Forget every action.
+     */
+    void clear();
+
+    /**
+     * Every slot as a d_list[] entry, empty slots included, padded
+     * with empty entries to at least the given count.
+     */
+    std::vector<delayed_action> dump(std::size_t count) const;
+
+    /**
+     * Replace every action with d_list[] entries as given by dump().
+     */
+    void load(const std::vector<delayed_action>& list);
+
+private:
+    static constexpr std::uint32_t NONE = UINT32_MAX;
+
+    struct entry
+    {
+        callback_type func;
+        int arg;
+        int type;
+        /** Lane tick the fuse goes off at; unused for daemons. */
+        std::int64_t expiry;
+        std::uint32_t generation;
+        bool live;
+        bool daemon;
+        /** Neighbours in the notch list, if the fuse is on the wheel. */
+        std::uint32_t prev;
+        std::uint32_t next;
+        bool wheeled;
+    };
+
+    struct lane
+    {
+        /** Calls to run_fuses() so far. */
+        std::int64_t now = 0;
+        /** First fuse in each notch. */
+        std::array<std::uint32_t, WHEEL_SIZE> notches;
+
+        lane()
+        {
+            notches.fill(NONE);
+        }
+    };
+
+    entry* lookup(timer_handle handle);
+    const entry* lookup(timer_handle handle) const;
+    timer_handle add(callback_type func, int arg, int type);
+    void release(std::uint32_t slot);
+    void wheel(std::uint32_t slot);
+    void unwheel(std::uint32_t slot);
+    lane& lane_of(int type);
+
+    std::vector<entry> m_entries;
+    /** Free slots, as a min-heap so the lowest is reused first. */
+    std::vector<std::uint32_t> m_free;
+    /** Slots of the daemons, sorted. */
+    std::vector<std::uint32_t> m_daemons;
+    std::array<lane, MAX_TYPE + 1> m_lanes;
+    /** Fuses set off by the notch being handled. */
+    std::vector<std::uint32_t> m_due;
+};
@@ -11,6 +11,15 @@
  */
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 struct sc_ent {
     unsigned int sc_uid;
     int sc_score;
@@ -23,5 +32,282 @@ struct sc_ent {
 
 typedef struct sc_ent SCORE;
 
-void	rd_score(SCORE *top_ten);
-void	wr_score(SCORE *top_ten);
+/**
+ * The score file.  Entries are fixed size records that stay in the
+ * slot they were written to, behind an index of the slots by rank:
+ *
+ *     header   magic, format, record size, slots, entries in use
+ *     index    a slot number for each rank; the ranks past the last
+ *              entry hold the free slots
+ *     records  one for each slot, each encrypted on its own
+ *
+ * Posting a score finds its rank by binary search and rewrites only
+ * the record it goes into, the stretch of the index that moves and the
+ * header.  A file in the old format, a whole name and a line of text
+ * for every entry, is read as well and rewritten in the new one the
+ * first time it changes.
+ */
+class score_table
+{
+public:
+    /** Longest name kept, with its terminating NUL. */
+    static constexpr std::size_t NAME_LENGTH = 80;
+    /** Bytes each entry takes in the file. */
+    static constexpr std::size_t RECORD_SIZE = 24 + NAME_LENGTH;
+
+    /**
+     * Table kept in the given file, which may be null to keep it in
+     * memory only.  A new file gets room for slots entries.
+     */
+    score_table(std::FILE* file, unsigned int slots);
+
+    /**
+     * Read the table from the file, dropping what was read before.
+     * false if the file is neither empty nor a score file.
+     */
+    bool load();
+
+    /** Number of entries. */
+    std::size_t size() const
+    {
+        return m_count;
+    }
+
+    /** Entry at the given rank, best first. */
+    const SCORE& entry(std::size_t rank) const
+    {
+        return m_records[m_index[rank]];
+    }
+
+    /**
+     * Post a score if it makes the table, after any as good as it.
+     * Unless all is set, a player has only one entry that isn't a win:
+     * a better one of theirs keeps the new score out, a worse one makes
+     * room for it.  Returns the rank it got, or -1.
+     */
+    int post(const SCORE& score, bool all);
+
+    /** Take the entry at the given rank out of the table. */
+    void remove(std::size_t rank);
+
+    /**
+     * Hold back writing changes to the file until flush() while on is
+     * true.  Turning it off writes whatever was held back.
+     */
+    void defer(bool on);
+
+    /** Are there changes that haven't been written yet? */
+    bool pending() const
+    {
+        return m_header_dirty || !m_dirty_slots.empty();
+    }
+
+    /** Write the changes held back. */
+    void flush();
+
+private:
+    bool load_old();
+    void changed(std::uint32_t slot, std::size_t first, std::size_t last);
+    void clean();
+    void write_all();
+    void write_header();
+    void write_index(std::size_t first, std::size_t last);
+    void write_record(std::uint32_t slot);
+    void write_at(long offset, const char* data, std::size_t size);
+
+    std::FILE* m_file;
+    std::uint32_t m_slots;
+    std::size_t m_count;
+    /** Slot of each rank, then the free slots. */
+    std::vector<std::uint32_t> m_index;
+    /** Entries by slot. */
+    std::vector<SCORE> m_records;
+    /** Whether the file has yet to be written in this format. */
+    bool m_rewrite;
+    bool m_defer;
+    /** Records, stretch of the index and header flush() has to write. */
+    std::vector<std::uint32_t> m_dirty_slots;
+    std::size_t m_dirty_first;
+    std::size_t m_dirty_last;
+    bool m_header_dirty;
+};
+
+/**
+ * Every game's score, in the order the games ended, for whoever wants
+ * more than the table keeps:
+ *
+ *     header   magic, format, record size
+ *     records  one for each game, laid out as in the score file but
+ *              not encrypted
+ *
+ * Records are only ever added at the end, each with one write under a
+ * lock held just for that write.  A game that dies while writing one
+ * leaves at most part of a record at the end.  Readers skip it, and
+ * the next record written replaces it.
+ */
+class score_journal
+{
+public:
+    /**
+     * Open the journal at path, for adding records if append is set,
+     * making it if need be.  -1 if it can't be, or isn't a journal.
+     */
+    static int open(const char* path, bool append);
+
+    /** Journal open on the given descriptor, which it doesn't own. */
+    explicit score_journal(int fd)
+        : m_fd(fd) {}
+
+    /** Add a record for a game. */
+    bool append(const SCORE& score);
+
+    /** Call fn with every whole record from the first'th on, oldest first. */
+    bool scan(const std::function<void(const SCORE&)>& fn, std::size_t first = 0) const;
+
+    /**
+     * Rebuild from the journal what it adds up to: the table of the
+     * best slots entries, as a score file at path.top, and each
+     * player's best score, as a journal at path.best ordered best
+     * first.  The indexes score_view looks the journal and path.best
+     * up by go to path.idx and path.best.idx.  Each file is replaced
+     * only once it has been written in full.
+     */
+    bool compact(const std::string& path, unsigned int slots, bool all) const;
+
+private:
+    int m_fd;
+};
+
+/**
+ * A score file or journal mapped into memory for answering questions
+ * about it.  A journal is looked up through the index compact() wrote
+ * next to it, mapped as well: its entries best first, by player, by
+ * the monster that killed them, the total winners and by when the game
+ * ended.  A query starts from the narrowest of those that applies and
+ * checks the rest of the conditions against the entries in it.  The
+ * few entries journaled since the index was written are ranked among
+ * the rest as the journal is opened.  Without an index, a query reads
+ * through the journal for just what it asks.  A score file is short,
+ * and in order of rank already.
+ */
+class score_view
+{
+public:
+    /** What to look for; a field left as it is matches everything. */
+    struct query
+    {
+        long uid = -1;
+        int monster = -1;
+        bool winners = false;
+        unsigned int from = 0;
+        unsigned int to = ~0U;
+        /** Most entries wanted, or 0 for all. */
+        std::size_t limit = 0;
+    };
+
+    /** An entry found, and where it ranks, from 0. */
+    struct match
+    {
+        std::uint32_t number;
+        std::uint32_t rank;
+    };
+
+    score_view();
+    ~score_view();
+
+    score_view(const score_view&) = delete;
+    score_view& operator=(const score_view&) = delete;
+
+    /**
+     * Map the score file or journal at path, whichever it is, and the
+     * journal's index.  false if it is neither, or a score file in the
+     * old format.
+     */
+    bool open(const char* path);
+
+    /** Number of entries. */
+    std::size_t size() const
+    {
+        return m_count;
+    }
+
+    /** The entry with the given number. */
+    SCORE entry(std::uint32_t number) const;
+
+    /** The entries that match, best first. */
+    std::vector<match> find(const query& q) const;
+
+private:
+    void close();
+    bool open_index(const std::string& path);
+    int points(std::uint32_t number) const;
+    std::uint32_t list(int which, std::size_t place) const;
+    std::pair<std::size_t, std::size_t> keys(int which, std::uint32_t low, std::uint32_t high) const;
+    bool matches(std::uint32_t number, const query& q) const;
+    std::vector<match> find_indexed(const query& q) const;
+    std::vector<match> find_unindexed(const query& q) const;
+
+    /** The whole file as mapped, or read if it couldn't be. */
+    const char* m_data;
+    std::size_t m_length;
+    bool m_mapped;
+    std::vector<char> m_copy;
+    /** Where the records start, whether they are a journal's, and how many. */
+    const char* m_records;
+    bool m_journal;
+    std::uint32_t m_count;
+    /** For a score file, the slot of each rank. */
+    const char* m_slots;
+    /** The journal's index as mapped, and the entries and winners it covers. */
+    const char* m_index;
+    std::size_t m_index_length;
+    std::uint32_t m_covered;
+    std::uint32_t m_winners;
+    /** Entries journaled since, best first, with their ranks and scores. */
+    std::vector<std::uint32_t> m_tail;
+    std::vector<std::uint32_t> m_tail_rank;
+    std::vector<int> m_tail_scores;
+};
+
+/**
+ * Connection to rogue++-scored, the process that keeps the score file
+ * for every game on the host so that they needn't open it themselves.
+ * The keeper only lets in its own group, so a game connects while it
+ * still has the group and keeps the connection for the whole game.
+ * Each call is one request over it, a line of text, answered by the
+ * rank of what was posted and the whole table, one entry to a line.
+ */
+class score_client
+{
+public:
+    /** Talk over a connection made by connect(). */
+    explicit score_client(int fd)
+        : m_fd(fd) {}
+
+    /** Connect to the keeper; -1 if it isn't listening or we may not. */
+    static int connect(const char* path);
+
+    /**
+     * Post a score and fill the empty table with the entries as they
+     * stand afterwards.  rank is where the score went, or -1.  false
+     * if the keeper couldn't be asked.
+     */
+    bool post(const SCORE& score, score_table& table, int& rank);
+
+    /** Fill the empty table with the keeper's entries. */
+    bool list(score_table& table);
+
+    /** Take the entry at the given rank out, there and in table. */
+    bool remove(std::size_t rank, score_table& table);
+
+    /** An entry as a line of the answer, or of a post. */
+    static std::string format(const SCORE& score);
+
+    /** Read an entry from a line made by format(). */
+    static bool parse(const char* line, SCORE& score);
+
+private:
+    bool request(const std::string& line, score_table* table, int& rank);
+
+    int m_fd;
+};
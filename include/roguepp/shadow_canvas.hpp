@@ -0,0 +1,126 @@
+/*
+ * Engine side copy of what is on the screen
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+#pragma once
+
+#include <vector>
+
+#include <roguepp/renderer.hpp>
+
+/**
+ * Canvas that keeps its own copy of every cell and passes the changes
+ * on to a canvas of the renderer.  Everything the game reads back from
+ * the screen (inch(), getyx()) is answered from the copy, so the rules
+ * never depend on what the terminal library remembers.
+ *
+ * Drawing only changes the copy and notes which part of each line it
+ * touched.  Nothing reaches the renderer until the copy is flushed,
+ * which happens on refresh() and before waiting for a key.  A flush
+ * compares the touched cells with what the renderer was last given
+ * and sends only the ones that differ, so a cell drawn and put back
+ * during a turn, or the whole map erased and drawn again, costs
+ * nothing.
+ */
+class shadow_canvas : public canvas
+{
+public:
+    /** One character on the screen. */
+    struct cell
+    {
+        char ch;
+        bool standout;
+
+        bool operator==(const cell& that) const
+        {
+            return ch == that.ch && standout == that.standout;
+        }
+
+        bool operator!=(const cell& that) const
+        {
+            return !(*this == that);
+        }
+    };
+
+    /**
+     * Shadow the given canvas, taking over its size.  The canvas is
+     * assumed to be blank.
+     */
+    explicit shadow_canvas(canvas& target);
+
+    int lines() const override
+    {
+        return m_lines;
+    }
+
+    int cols() const override
+    {
+        return m_cols;
+    }
+
+    void move(int y, int x) override;
+    void getyx(int& y, int& x) const override;
+    void addch(int ch) override;
+    void addstr(const char* str) override;
+    int inch() const override;
+    void clrtoeol() override;
+    void clear() override;
+    void erase() override;
+    void standout() override;
+    void standend() override;
+    void refresh() override;
+    void touch() override;
+    void place(int y, int x) override;
+
+    /** Cell at the given position. */
+    const cell& at(int y, int x) const
+    {
+        return m_cells[y * m_cols + x];
+    }
+
+    /**
+     * Send the renderer what has changed since the last flush and
+     * move its cursor to ours, without asking it to show the result.
+     * Needed before waiting for a key, since the terminal library may
+     * show the screen then.
+     */
+    void flush();
+
+    /** The canvas changes are passed on to. */
+    canvas& target() const
+    {
+        return m_target;
+    }
+
+private:
+    void put(char ch);
+    void advance();
+    void touch_cells(int y, int first, int last);
+    void flush_line(int y);
+
+    canvas& m_target;
+    int m_lines;
+    int m_cols;
+    /** What the game has drawn. */
+    std::vector<cell> m_cells;
+    /** What the renderer has been given. */
+    std::vector<cell> m_front;
+    /** Touched columns of each line, first to last; empty if first > last. */
+    std::vector<int> m_first;
+    std::vector<int> m_last;
+    int m_y;
+    int m_x;
+    bool m_standout;
+    /** Has the renderer to be cleared before the next flush? */
+    bool m_cleared;
+    /** Is the renderer drawing in standout mode? */
+    bool m_target_standout;
+    /** Where the renderer's cursor was left, or -1 if not known. */
+    int m_target_y;
+    int m_target_x;
+};
@@ -0,0 +1,92 @@
+/*
+ * Slab allocator for monsters and objects
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <roguepp/types.hpp>
+
+/**
+ * Hands out THINGs from large slabs instead of allocating them one by
+ * one.  Released slots go on a free list and are handed out again
+ * before the pool carves new ones, most recently released first, so a
+ * game keeps reusing the same few slabs.  Slabs are only given back
+ * when the pool itself is destroyed.
+ *
+ * A pool can also be used as an arena: reset() forgets every THING in
+ * it at once without looking at them.
+ */
+class thing_pool
+{
+public:
+    /** Number of THINGs in one slab. */
+    static constexpr std::size_t SLAB_SIZE = 256;
+
+    /** Allocation statistics. */
+    struct stats
+    {
+        /** THINGs currently in use. */
+        std::size_t live;
+        /** Most THINGs ever in use at once. */
+        std::size_t peak;
+        /** Slabs allocated. */
+        std::size_t slabs;
+        /** Calls to allocate() so far. */
+        std::size_t allocations;
+    };
+
+    thing_pool() = default;
+
+    thing_pool(const thing_pool&) = delete;
+    thing_pool& operator=(const thing_pool&) = delete;
+
+    /**
+     * Get a zero filled THING.
+     */
+    THING* allocate();
+
+    /**
+     * Give back a THING obtained from allocate().
+     */
+    void release(THING* item);
+
+    /**
+     * Give back every THING at once.  Pointers into the pool must not
+     * be used afterwards.
+     */
+    void reset();
+
+    /**
+     * Did the THING come from this pool?
+     */
+    bool owns(const THING* item) const;
+
+    const stats& statistics() const
+    {
+        return m_stats;
+    }
+
+    /** Number of THINGs the pool can hold without growing. */
+    std::size_t capacity() const
+    {
+        return m_slabs.size() * SLAB_SIZE;
+    }
+
+private:
+    std::vector<std::unique_ptr<THING[]>> m_slabs;
+    /** Slab new slots are carved from. */
+    std::size_t m_current = 0;
+    /** Slots carved from the current slab so far. */
+    std::size_t m_used = 0;
+    THING* m_free = nullptr;
+    stats m_stats = {};
+};
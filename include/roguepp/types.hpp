@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <cstddef>
 
 /**
@@ -296,7 +297,10 @@ struct PLACE
 {
     char p_ch;
     char p_flags;
+    /** Index of the room the place is in, or -1. */
+    signed char p_room;
     thing* p_monst;
+    thing* p_obj;
 };
 
 /**
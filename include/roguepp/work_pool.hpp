@@ -0,0 +1,83 @@
+/*
+ * Work stealing thread pool for running many games at once
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Fixed set of worker threads, each with a queue of its own.  Jobs
+ * submitted from a worker go to the front of that worker's queue, so
+ * it keeps working on what it split off most recently.  Idle workers
+ * steal from the back of the other queues, where the oldest and
+ * usually largest pieces of work are.
+ */
+class work_pool
+{
+public:
+    using job = std::function<void()>;
+
+    /**
+     * Start the workers.  Zero means one per hardware thread.
+     */
+    explicit work_pool(unsigned int threads = 0);
+
+    /**
+     * Wait for the remaining jobs and stop the workers.
+     */
+    ~work_pool();
+
+    work_pool(const work_pool&) = delete;
+    work_pool& operator=(const work_pool&) = delete;
+
+    /** Number of worker threads. */
+    std::size_t size() const
+    {
+        return m_workers.size();
+    }
+
+    /**
+     * Queue a job.  May be called from inside a job.
+     */
+    void submit(job j);
+
+    /**
+     * Block until every submitted job, including the ones they
+     * submitted, has finished.
+     */
+    void wait();
+
+private:
+    struct queue
+    {
+        std::mutex mutex;
+        std::deque<job> jobs;
+    };
+
+    void work(std::size_t self);
+    bool take(std::size_t self, job& j);
+
+    std::vector<std::unique_ptr<queue>> m_queues;
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::condition_variable m_idle;
+    std::atomic<std::size_t> m_queued;
+    std::size_t m_pending;
+    std::size_t m_next;
+    bool m_stopping;
+};
@@ -9,8 +9,6 @@
  * See the file LICENSE.TXT for full copyright and licensing information.
  */
 
-#include <ncurses.h>
-
 #include <roguepp/roguepp.hpp>
 
 /*
@@ -25,13 +23,13 @@ wear()
 
     if ((obj = get_item("wear", ARMOR)) == nullptr)
 	return;
-    if (cur_armor != nullptr)
+    if (cur_game->cur_armor != nullptr)
     {
 	addmsg("you are already wearing some");
-	if (!terse)
+	if (!cur_game->terse)
 	    addmsg(".  You'll have to take it off first");
 	endmsg();
-	after = false;
+	cur_game->after = false;
 	return;
     }
     if (obj->o_type != ARMOR)
@@ -42,8 +40,8 @@ wear()
     waste_time();
     obj->o_flags |= ISKNOW;
     sp = inv_name(obj, true);
-    cur_armor = obj;
-    if (!terse)
+    cur_game->cur_armor = obj;
+    if (!cur_game->terse)
 	addmsg("you are now ");
     msg("wearing %s", sp);
 }
@@ -57,19 +55,19 @@ take_off()
 {
     THING *obj;
 
-    if ((obj = cur_armor) == nullptr)
+    if ((obj = cur_game->cur_armor) == nullptr)
     {
-	after = false;
-	if (terse)
+	cur_game->after = false;
+	if (cur_game->terse)
 		msg("not wearing armor");
 	else
 		msg("you aren't wearing any armor");
 	return;
     }
-    if (!dropcheck(cur_armor))
+    if (!dropcheck(cur_game->cur_armor))
 	return;
-    cur_armor = nullptr;
-    if (terse)
+    cur_game->cur_armor = nullptr;
+    if (cur_game->terse)
 	addmsg("was");
     else
 	addmsg("you used to be");
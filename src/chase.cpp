@@ -12,51 +12,92 @@
 
 #include <cstdlib>
 
-#include <ncurses.h>
-
 #include <roguepp/roguepp.hpp>
 
 #define DRAGONSHOT  5	/* one chance in DRAGONSHOT that a dragon will flame */
 
-static coord ch_ret;				/* Where chasing takes you */
-
 static inline int dist_cp(const coord&, const coord&);
 
+/*
+ * awake:
+ *	Is the monster one of the ones runners() moves?
+ */
+static inline bool
+awake(THING *tp)
+{
+    return !on(*tp, ISHELD) && on(*tp, ISRUN);
+}
+
+/*
+ * run_monster:
+ *	Give a running monster its turn
+ */
+static void
+run_monster(THING *tp)
+{
+    bool wastarget;
+    coord orig_pos;
+
+    orig_pos = tp->t_pos;
+    wastarget = on(*tp, ISTARGET);
+    if (move_monst(tp) == -1)
+	return;
+    if (on(*tp, ISFLY) && dist_cp(hero, tp->t_pos) >= 3)
+	move_monst(tp);
+    if (wastarget && !ce(orig_pos, tp->t_pos))
+    {
+	tp->t_flags &= ~ISTARGET;
+	cur_game->to_death = false;
+    }
+}
+
 /*
  * runners:
- *	Make all the running monsters move.
+ *	Make all the running monsters move.  The running ones are kept
+ *	in a list of their own, which is only looked for again after a
+ *	monster wakes up, stops, comes or goes.
  */
 void
 runners(int)
 {
     THING *tp;
     THING *next;
-    bool wastarget;
-    static coord orig_pos;
+    std::size_t i;
+    rng_scope stream(RNG_MONSTER);
 
-    for (tp = mlist; tp != nullptr; tp = next)
+    if (cur_game->awake_stale)
+    {
+	cur_game->awake.clear();
+	for (tp = cur_game->mlist; tp != nullptr; tp = next(tp))
+	    if (awake(tp))
+		cur_game->awake.push_back(tp);
+	cur_game->awake_stale = false;
+    }
+    for (i = 0; i < cur_game->awake.size(); i++)
     {
+	tp = cur_game->awake[i];
         /* remember this in case the monster's "next" is changed */
-        next = next(tp);
-	if (!on(*tp, ISHELD) && on(*tp, ISRUN))
+	next = next(tp);
+	run_monster(tp);
+	if (cur_game->awake_stale)
 	{
-	    orig_pos = tp->t_pos;
-	    wastarget = on(*tp, ISTARGET);
-	    if (move_monst(tp) == -1)
-                continue;
-	    if (on(*tp, ISFLY) && dist_cp(hero, tp->t_pos) >= 3)
-		move_monst(tp);
-	    if (wastarget && !ce(orig_pos, tp->t_pos))
+	    /*
+	     * Somebody woke up, stopped or died, so the list can't be
+	     * trusted for the rest of this turn.
+	     */
+	    for (tp = next; tp != nullptr; tp = next)
 	    {
-		tp->t_flags &= ~ISTARGET;
-		to_death = false;
+		next = next(tp);
+		if (awake(tp))
+		    run_monster(tp);
 	    }
+	    break;
 	}
     }
-    if (has_hit)
+    if (cur_game->has_hit)
     {
 	endmsg();
-	has_hit = false;
+	cur_game->has_hit = false;
     }
 }
 
@@ -89,7 +130,7 @@ relocate(THING *th, coord *new_loc)
 
     if (!ce(*new_loc, th->t_pos))
     {
-	mvaddch(th->t_pos.y, th->t_pos.x, th->t_oldch);
+	cur_game->cw->mvaddch(th->t_pos.y, th->t_pos.x, th->t_oldch);
 	th->t_room = roomin(new_loc);
 	set_oldch(th, new_loc);
 	oroom = th->t_room;
@@ -100,14 +141,14 @@ relocate(THING *th, coord *new_loc)
 	th->t_pos = *new_loc;
 	moat(new_loc->y, new_loc->x) = th;
     }
-    move(new_loc->y, new_loc->x);
+    cur_game->cw->move(new_loc->y, new_loc->x);
     if (see_monst(th))
-	addch(th->t_disguise);
-    else if (on(player, SEEMONST))
+	cur_game->cw->addch(th->t_disguise);
+    else if (on(cur_game->player, SEEMONST))
     {
-	standout();
-	addch(th->t_type);
-	standend();
+	cur_game->cw->standout();
+	cur_game->cw->addch(th->t_type);
+	cur_game->cw->standend();
     }
 }
 
@@ -123,7 +164,6 @@ do_chase(THING *th)
     bool stoprun = false;	/* true means we are there */
     bool door;
     THING *obj;
-    static coord this_;			/* Temporary destination for chaser */
 
     rer = th->t_room;		/* Find room of chaser */
     if (on(*th, ISGREED) && rer->r_goldval == 0)
@@ -150,20 +190,20 @@ over:
 
             if (curdist < mindist)
             {
-                this_ = rer->r_exit[i];
+                cur_game->this_ = rer->r_exit[i];
                 mindist = curdist;
             }
         }
 	if (door)
 	{
-	    rer = &passages[flat(th->t_pos.y, th->t_pos.x) & F_PNUM];
+	    rer = &cur_game->passages[flat(th->t_pos.y, th->t_pos.x) & F_PNUM];
 	    door = false;
 	    goto over;
 	}
     }
     else
     {
-	this_ = *th->t_dest;
+	cur_game->this_ = *th->t_dest;
 	/*
 	 * For dragons check and see if (a) the hero is on a straight
 	 * line from it, and (b) that it is within shooting distance,
@@ -174,18 +214,18 @@ over:
 	    && dist_cp(th->t_pos, hero) <= BOLT_LENGTH * BOLT_LENGTH
 	    && !on(*th, ISCANC) && rnd(DRAGONSHOT) == 0)
 	{
-	    delta.y = sign(hero.y - th->t_pos.y);
-	    delta.x = sign(hero.x - th->t_pos.x);
-	    if (has_hit)
+	    cur_game->delta.y = sign(hero.y - th->t_pos.y);
+	    cur_game->delta.x = sign(hero.x - th->t_pos.x);
+	    if (cur_game->has_hit)
 		endmsg();
-	    fire_bolt(&th->t_pos, &delta, "flame");
-	    running = false;
-	    count = 0;
-	    quiet = 0;
-	    if (to_death && !on(*th, ISTARGET))
+	    fire_bolt(&th->t_pos, &cur_game->delta, "flame");
+	    cur_game->running = false;
+	    cur_game->count = 0;
+	    cur_game->quiet = 0;
+	    if (cur_game->to_death && !on(*th, ISTARGET))
 	    {
-		to_death = false;
-		kamikaze = false;
+		cur_game->to_death = false;
+		cur_game->kamikaze = false;
 	    }
 	    return(0);
 	}
@@ -195,24 +235,23 @@ over:
      * so we run to it.  If we hit it we either want to fight it
      * or stop running
      */
-    if (!chase(th, &this_))
+    if (!chase(th, &cur_game->this_))
     {
-	if (ce(this_, hero))
+	if (ce(cur_game->this_, hero))
 	{
 	    return( attack(th) );
 	}
-	else if (ce(this_, *th->t_dest))
+	else if (ce(cur_game->this_, *th->t_dest))
 	{
-	    for (obj = lvl_obj; obj != nullptr; obj = next(obj))
-		if (th->t_dest == &obj->o_pos)
-		{
-		    detach(lvl_obj, obj);
-		    attach(th->t_pack, obj);
-		    chat(obj->o_pos.y, obj->o_pos.x) =
-			(th->t_room->r_flags & ISGONE) ? PASSAGE : FLOOR;
-		    th->t_dest = find_dest(th);
-		    break;
-		}
+	    obj = obat(cur_game->this_.y, cur_game->this_.x);
+	    if (obj != nullptr && th->t_dest == &obj->o_pos)
+	    {
+		detach(cur_game->lvl_obj, obj);
+		attach(th->t_pack, obj);
+		chat(obj->o_pos.y, obj->o_pos.x) =
+		    (th->t_room->r_flags & ISGONE) ? PASSAGE : FLOOR;
+		th->t_dest = find_dest(th);
+	    }
 	    if (th->t_type != 'F')
 		stoprun = true;
 	}
@@ -222,12 +261,15 @@ over:
 	if (th->t_type == 'F')
 	    return(0);
     }
-    relocate(th, &ch_ret);
+    relocate(th, &cur_game->ch_ret);
     /*
      * And stop running if need be
      */
     if (stoprun && ce(th->t_pos, *(th->t_dest)))
+    {
 	th->t_flags &= ~ISRUN;
+	cur_game->awake_stale = true;
+    }
     return(0);
 }
 
@@ -244,13 +286,13 @@ set_oldch(THING *tp, coord *cp)
         return;
 
     sch = tp->t_oldch;
-    tp->t_oldch = CCHAR( mvinch(cp->y,cp->x) );
-    if (!on(player, ISBLIND))
+    tp->t_oldch = CCHAR( cur_game->cw->mvinch(cp->y,cp->x) );
+    if (!on(cur_game->player, ISBLIND))
     {
 	    if ((sch == FLOOR || tp->t_oldch == FLOOR) &&
 		(tp->t_room->r_flags & ISDARK))
 		    tp->t_oldch = ' ';
-	    else if (dist_cp(*cp, hero) <= LAMPDIST && see_floor)
+	    else if (dist_cp(*cp, hero) <= LAMPDIST && cur_game->see_floor)
 		tp->t_oldch = chat(cp->y, cp->x);
     }
 }
@@ -264,9 +306,9 @@ see_monst(THING *mp)
 {
     int y, x;
 
-    if (on(player, ISBLIND))
+    if (on(cur_game->player, ISBLIND))
 	return false;
-    if (on(*mp, ISINVIS) && !on(player, CANSEE))
+    if (on(*mp, ISINVIS) && !on(cur_game->player, CANSEE))
 	return false;
     y = mp->t_pos.y;
     x = mp->t_pos.x;
@@ -306,6 +348,23 @@ runto(coord *runner)
     tp->t_flags |= ISRUN;
     tp->t_flags &= ~ISHELD;
     tp->t_dest = find_dest(tp);
+    cur_game->awake_stale = true;
+}
+
+/*
+ * chase_dist:
+ *	How far a place is from the chasee: steps along the distance
+ *	field first, with the straight line distance breaking ties.
+ */
+static int
+chase_dist(const distance_field *field, int y, int x, const coord *ee)
+{
+    int d;
+
+    d = dist(y, x, ee->y, ee->x);
+    if (field != nullptr)
+	d += field->at(y, x) << 16;
+    return d;
 }
 
 /*
@@ -323,7 +382,6 @@ chase(THING *tp, coord *ee)
     coord *er = &tp->t_pos;
     char ch;
     int plcnt = 1;
-    static coord tryp;
 
     /*
      * If the thing is confused, let it move randomly. Invisible
@@ -336,8 +394,8 @@ chase(THING *tp, coord *ee)
 	/*
 	 * get a valid random move
 	 */
-	ch_ret = *rndmove(tp);
-	curdist = dist_cp(ch_ret, *ee);
+	cur_game->ch_ret = *rndmove(tp);
+	curdist = dist_cp(cur_game->ch_ret, *ee);
 	/*
 	 * Small chance that it will become un-confused
 	 */
@@ -351,12 +409,21 @@ chase(THING *tp, coord *ee)
     else
     {
 	int ey, ex;
+	const distance_field *field;
+
+	/*
+	 * Follow the distance field to the chasee unless it can't
+	 * be reached from here, then just head straight for it.
+	 */
+	field = &cur_game->chase_fields.to(*ee);
+	if (field->at(er->y, er->x) == distance_field::FAR)
+	    field = nullptr;
 	/*
 	 * This will eventually hold where we move to get closer
 	 * If we can't find an empty spot, we stay where we are.
 	 */
-	curdist = dist_cp(*er, *ee);
-	ch_ret = *er;
+	curdist = chase_dist(field, er->y, er->x, ee);
+	cur_game->ch_ret = *er;
 
 	ey = er->y + 1;
 	if (ey >= NUMLINES - 1)
@@ -369,11 +436,11 @@ chase(THING *tp, coord *ee)
 	{
 	    if (x < 0)
 		continue;
-	    tryp.x = x;
+	    cur_game->tryp.x = x;
 	    for (y = er->y - 1; y <= ey; y++)
 	    {
-		tryp.y = y;
-		if (!diag_ok(er, &tryp))
+		cur_game->tryp.y = y;
+		if (!diag_ok(er, &cur_game->tryp))
 		    continue;
 		ch = winat(y, x);
 		if (step_ok(ch))
@@ -384,11 +451,7 @@ chase(THING *tp, coord *ee)
 		     */
 		    if (ch == SCROLL)
 		    {
-			for (obj = lvl_obj; obj != nullptr; obj = next(obj))
-			{
-			    if (y == obj->o_pos.y && x == obj->o_pos.x)
-				break;
-			}
+			obj = obat(y, x);
 			if (obj != nullptr && obj->o_which == S_SCARE)
 			    continue;
 		    }
@@ -401,23 +464,23 @@ chase(THING *tp, coord *ee)
 		     * If we didn't find any scrolls at this place or it
 		     * wasn't a scare scroll, then this place counts
 		     */
-		    thisdist = dist(y, x, ee->y, ee->x);
+		    thisdist = chase_dist(field, y, x, ee);
 		    if (thisdist < curdist)
 		    {
 			plcnt = 1;
-			ch_ret = tryp;
+			cur_game->ch_ret = cur_game->tryp;
 			curdist = thisdist;
 		    }
 		    else if (thisdist == curdist && rnd(++plcnt) == 0)
 		    {
-			ch_ret = tryp;
+			cur_game->ch_ret = cur_game->tryp;
 			curdist = thisdist;
 		    }
 		}
 	    }
 	}
     }
-    return (bool)(curdist != 0 && !ce(ch_ret, hero));
+    return (bool)(curdist != 0 && !ce(cur_game->ch_ret, hero));
 }
 
 /**
@@ -427,24 +490,15 @@ chase(THING *tp, coord *ee)
 room*
 roomin(coord* cp)
 {
-    const auto* fp = &flat(cp->y, cp->x);
+    const auto* pp = INDEX(cp->y, cp->x);
 
-    if ((*fp & F_PASS))
+    if ((pp->p_flags & F_PASS))
     {
-        return &passages[*fp & F_PNUM];
+        return &cur_game->passages[pp->p_flags & F_PNUM];
     }
-
-    for (std::size_t i = 0; i < MAXROOMS; ++i)
+    if (pp->p_room >= 0)
     {
-        auto* rp = &rooms[i];
-
-        if (cp->x <= rp->r_pos.x + rp->r_max.x &&
-            rp->r_pos.x <= cp->x &&
-            cp->y <= rp->r_pos.y + rp->r_max.y &&
-            rp->r_pos.y <= cp->y)
-        {
-            return rp;
-        }
+        return &cur_game->rooms[pp->p_room];
     }
 
     msg("in some bizarre place (%d, %d)", unc(*cp));
@@ -477,9 +531,9 @@ bool
 cansee(int y, int x)
 {
     struct room *rer;
-    static coord tp;
+    static thread_local coord tp;
 
-    if (on(player, ISBLIND))
+    if (on(cur_game->player, ISBLIND))
 	return false;
     if (dist(y, x, hero.y, hero.x) < LAMPDIST)
     {
@@ -508,16 +562,16 @@ find_dest(THING *tp)
     THING *obj;
     int prob;
 
-    if ((prob = monsters[tp->t_type - 'A'].m_carry) <= 0 || tp->t_room == proom
+    if ((prob = cur_game->monsters[tp->t_type - 'A'].m_carry) <= 0 || tp->t_room == proom
 	|| see_monst(tp))
 	    return &hero;
-    for (obj = lvl_obj; obj != nullptr; obj = next(obj))
+    for (obj = cur_game->lvl_obj; obj != nullptr; obj = next(obj))
     {
 	if (obj->o_type == SCROLL && obj->o_which == S_SCARE)
 	    continue;
 	if (roomin(&obj->o_pos) == tp->t_room && rnd(100) < prob)
 	{
-	    for (tp = mlist; tp != nullptr; tp = next(tp))
+	    for (tp = cur_game->mlist; tp != nullptr; tp = next(tp))
 		if (tp->t_dest == &obj->o_pos)
 		    break;
 	    if (tp == nullptr)
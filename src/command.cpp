@@ -15,8 +15,6 @@
 #include <cstring>
 #include <unordered_map>
 
-#include <ncurses.h>
-
 #include <roguepp/roguepp.hpp>
 
 /*
@@ -30,9 +28,8 @@ command()
     int ntimes = 1;			/* Number of player moves */
     char *fp;
     THING *mp;
-    static char countch, direction, newcount = false;
 
-    if (on(player, ISHASTE))
+    if (on(cur_game->player, ISHASTE))
 	ntimes++;
     /*
      * Let the daemons start up
@@ -41,57 +38,57 @@ command()
     do_fuses(BEFORE);
     while (ntimes--)
     {
-	again = false;
-	if (has_hit)
+	cur_game->again = false;
+	if (cur_game->has_hit)
 	{
 	    endmsg();
-	    has_hit = false;
+	    cur_game->has_hit = false;
 	}
 	/*
 	 * these are illegal things for the player to be, so if any are
 	 * set, someone's been poking in memeory
 	 */
-	if (on(player, ISSLOW|ISGREED|ISINVIS|ISREGEN|ISTARGET))
-	    exit(1);
+	if (on(cur_game->player, ISSLOW|ISGREED|ISINVIS|ISREGEN|ISTARGET))
+	    my_exit(1);
 
 	look(true);
-	if (!running)
-	    door_stop = false;
+	if (!cur_game->running)
+	    cur_game->door_stop = false;
 	status();
-	lastscore = purse;
-	move(hero.y, hero.x);
-	if (!((running || count) && jump))
-	    refresh();			/* Draw screen */
-	take = 0;
-	after = true;
+	cur_game->lastscore = cur_game->purse;
+	cur_game->cw->move(hero.y, hero.x);
+	if (!((cur_game->running || cur_game->count) && cur_game->jump))
+	    cur_game->cw->refresh();			/* Draw screen */
+	cur_game->take = 0;
+	cur_game->after = true;
 	/*
 	 * Read command or continue run
 	 */
 #ifdef MASTER
-	if (wizard)
-	    noscore = true;
+	if (cur_game->wizard)
+	    cur_game->noscore = true;
 #endif
-	if (!no_command)
+	if (!cur_game->no_command)
 	{
-	    if (running || to_death)
-		ch = runch;
-	    else if (count)
-		ch = countch;
+	    if (cur_game->running || cur_game->to_death)
+		ch = cur_game->runch;
+	    else if (cur_game->count)
+		ch = cur_game->countch;
 	    else
 	    {
 		ch = readchar();
-		move_on = false;
-		if (mpos != 0)		/* Erase message if its there */
+		cur_game->move_on = false;
+		if (cur_game->mpos != 0)		/* Erase message if its there */
 		    msg("");
 	    }
 	}
 	else
 	    ch = '.';
-	if (no_command)
+	if (cur_game->no_command)
 	{
-	    if (--no_command == 0)
+	    if (--cur_game->no_command == 0)
 	    {
-		player.t_flags |= ISRUN;
+		cur_game->player.t_flags |= ISRUN;
 		msg("you can move again");
 	    }
 	}
@@ -100,19 +97,19 @@ command()
 	    /*
 	     * check for prefixes
 	     */
-	    newcount = false;
+	    cur_game->newcount = false;
 	    if (isdigit(ch))
 	    {
-		count = 0;
-		newcount = true;
+		cur_game->count = 0;
+		cur_game->newcount = true;
 		while (isdigit(ch))
 		{
-		    count = count * 10 + (ch - '0');
-		    if (count > 255)
-			count = 255;
+		    cur_game->count = cur_game->count * 10 + (ch - '0');
+		    if (cur_game->count > 255)
+			cur_game->count = 255;
 		    ch = readchar();
 		}
-		countch = ch;
+		cur_game->countch = ch;
 		/*
 		 * turn off count for commands which don't make sense
 		 * to repeat
@@ -133,49 +130,40 @@ command()
 #endif
 			break;
 		    default:
-			count = 0;
+			cur_game->count = 0;
 		}
 	    }
 	    /*
 	     * execute a command
 	     */
-	    if (count && !running)
-		count--;
-	    if (ch != 'a' && ch != ESCAPE && !(running || count || to_death))
+	    if (cur_game->count && !cur_game->running)
+		cur_game->count--;
+	    if (ch != 'a' && ch != ESCAPE && !(cur_game->running || cur_game->count || cur_game->to_death))
 	    {
-		l_last_comm = last_comm;
-		l_last_dir = last_dir;
-		l_last_pick = last_pick;
-		last_comm = ch;
-		last_dir = '\0';
-		last_pick = nullptr;
+		cur_game->l_last_comm = cur_game->last_comm;
+		cur_game->l_last_dir = cur_game->last_dir;
+		cur_game->l_last_pick = cur_game->last_pick;
+		cur_game->last_comm = ch;
+		cur_game->last_dir = '\0';
+		cur_game->last_pick = nullptr;
 	    }
 over:
 	    switch (ch)
 	    {
 		case ',': {
-		    THING *obj = nullptr;
-		    int found = 0;
-		    for (obj = lvl_obj; obj != nullptr; obj = next(obj))
-    			{
-			    if (obj->o_pos.y == hero.y && obj->o_pos.x == hero.x)
-			    {
-				found=1;
-				break;
-			    }
-    			}
+		    THING *obj = obat(hero.y, hero.x);
 
-		    if (found) {
+		    if (obj != nullptr) {
 			if (levit_check())
 			    ;
 			else
 			    pick_up((char)obj->o_type);
 		    }
 		    else {
-			if (!terse)
+			if (!cur_game->terse)
 			    addmsg("there is ");
 			addmsg("nothing here");
-                        if (!terse)
+                        if (!cur_game->terse)
                             addmsg(" to pick up");
                         endmsg();
 		    }
@@ -200,72 +188,72 @@ over:
 		when CTRL('H'): case CTRL('J'): case CTRL('K'): case CTRL('L'):
 		case CTRL('Y'): case CTRL('U'): case CTRL('B'): case CTRL('N'):
 		{
-		    if (!on(player, ISBLIND))
+		    if (!on(cur_game->player, ISBLIND))
 		    {
-			door_stop = true;
-			firstmove = true;
+			cur_game->door_stop = true;
+			cur_game->firstmove = true;
 		    }
-		    if (count && !newcount)
-			ch = direction;
+		    if (cur_game->count && !cur_game->newcount)
+			ch = cur_game->direction;
 		    else
 		    {
 			ch += ('A' - CTRL('A'));
-			direction = ch;
+			cur_game->direction = ch;
 		    }
 		    goto over;
 		}
 		when 'F':
-		    kamikaze = true;
+		    cur_game->kamikaze = true;
 		    /* FALLTHROUGH */
 		case 'f':
 		    if (!get_dir())
 		    {
-			after = false;
+			cur_game->after = false;
 			break;
 		    }
-		    delta.y += hero.y;
-		    delta.x += hero.x;
-		    if ( ((mp = moat(delta.y, delta.x)) == nullptr)
-			|| ((!see_monst(mp)) && !on(player, SEEMONST)))
+		    cur_game->delta.y += hero.y;
+		    cur_game->delta.x += hero.x;
+		    if ( ((mp = moat(cur_game->delta.y, cur_game->delta.x)) == nullptr)
+			|| ((!see_monst(mp)) && !on(cur_game->player, SEEMONST)))
 		    {
-			if (!terse)
+			if (!cur_game->terse)
 			    addmsg("I see ");
 			msg("no monster there");
-			after = false;
+			cur_game->after = false;
 		    }
-		    else if (diag_ok(&hero, &delta))
+		    else if (diag_ok(&hero, &cur_game->delta))
 		    {
-			to_death = true;
-			max_hit = 0;
+			cur_game->to_death = true;
+			cur_game->max_hit = 0;
 			mp->t_flags |= ISTARGET;
-			runch = ch = dir_ch;
+			cur_game->runch = ch = cur_game->dir_ch;
 			goto over;
 		    }
 		when 't':
 		    if (!get_dir())
-			after = false;
+			cur_game->after = false;
 		    else
-			missile(delta.y, delta.x);
+			missile(cur_game->delta.y, cur_game->delta.x);
 		when 'a':
-		    if (last_comm == '\0')
+		    if (cur_game->last_comm == '\0')
 		    {
 			msg("you haven't typed a command yet");
-			after = false;
+			cur_game->after = false;
 		    }
 		    else
 		    {
-			ch = last_comm;
-			again = true;
+			ch = cur_game->last_comm;
+			cur_game->again = true;
 			goto over;
 		    }
 		when 'q': quaff();
 		when 'Q':
-		    after = false;
-		    q_comm = true;
+		    cur_game->after = false;
+		    cur_game->q_comm = true;
 		    quit(0);
-		    q_comm = false;
-		when 'i': after = false; inventory(pack, 0);
-		when 'I': after = false; picky_inven();
+		    cur_game->q_comm = false;
+		when 'i': cur_game->after = false; inventory(pack, 0);
+		when 'I': cur_game->after = false; picky_inven();
 		when 'd': drop();
 		when 'r': read_scroll();
 		when 'e': eat();
@@ -274,43 +262,43 @@ over:
 		when 'T': take_off();
 		when 'P': ring_on();
 		when 'R': ring_off();
-		when 'o': option(); after = false;
-		when 'c': call(); after = false;
-		when '>': after = false; d_level();
-		when '<': after = false; u_level();
-		when '?': after = false; help();
-		when '/': after = false; identify();
+		when 'o': option(); cur_game->after = false;
+		when 'c': call(); cur_game->after = false;
+		when '>': cur_game->after = false; d_level();
+		when '<': cur_game->after = false; u_level();
+		when '?': cur_game->after = false; help();
+		when '/': cur_game->after = false; identify();
 		when 's': search();
 		when 'z':
 		    if (get_dir())
 			do_zap();
 		    else
-			after = false;
-		when 'D': after = false; discovered();
-		when CTRL('P'): after = false; msg(huh);
+			cur_game->after = false;
+		when 'D': cur_game->after = false; discovered();
+		when CTRL('P'): cur_game->after = false; msg(cur_game->huh);
 		when CTRL('R'):
-		    after = false;
-		    clearok(curscr,true);
-		    wrefresh(curscr);
+		    cur_game->after = false;
+		    cur_game->display->redraw();
+		    cur_game->cw->refresh();
 		when 'v':
-		    after = false;
+		    cur_game->after = false;
 		    msg("version %s. (mctesq was here)", release.c_str());
 		when 'S':
-		    after = false;
+		    cur_game->after = false;
 		    save_game();
 		when '.': ;			/* Rest command */
-		when ' ': after = false;	/* "Legal" illegal command */
+		when ' ': cur_game->after = false;	/* "Legal" illegal command */
 		when '^':
-		    after = false;
+		    cur_game->after = false;
 		    if (get_dir()) {
-			delta.y += hero.y;
-			delta.x += hero.x;
-			fp = &flat(delta.y, delta.x);
-                        if (!terse)
+			cur_game->delta.y += hero.y;
+			cur_game->delta.x += hero.x;
+			fp = &flat(cur_game->delta.y, cur_game->delta.x);
+                        if (!cur_game->terse)
                             addmsg("You have found ");
-			if (chat(delta.y, delta.x) != TRAP)
+			if (chat(cur_game->delta.y, cur_game->delta.x) != TRAP)
 			    msg("no trap there");
-			else if (on(player, ISHALU))
+			else if (on(cur_game->player, ISHALU))
 			    msg(tr_name[rnd(NTRAPS)]);
 			else {
 			    msg(tr_name[*fp & F_TMASK]);
@@ -319,70 +307,79 @@ over:
 		    }
 #ifdef MASTER
 		when '+':
-		    after = false;
-		    if (wizard)
+		    cur_game->after = false;
+		    if (cur_game->wizard)
 		    {
-			wizard = false;
+			cur_game->wizard = false;
 			turn_see(true);
 			msg("not wizard any more");
 		    }
 		    else
 		    {
-			wizard = passwd();
-			if (wizard)
+			cur_game->wizard = passwd();
+			if (cur_game->wizard)
 			{
-			    noscore = true;
+			    cur_game->noscore = true;
 			    turn_see(false);
-			    msg("you are suddenly as smart as Ken Arnold in dungeon #%d", dnum);
+			    msg("you are suddenly as smart as Ken Arnold in dungeon #%d", cur_game->dnum);
 			}
 			else
 			    msg("sorry");
 		    }
 #endif
 		when ESCAPE:	/* Escape */
-		    door_stop = false;
-		    count = 0;
-		    after = false;
-		    again = false;
+		    cur_game->door_stop = false;
+		    cur_game->count = 0;
+		    cur_game->after = false;
+		    cur_game->again = false;
 		when 'm':
-		    move_on = true;
+		    cur_game->move_on = true;
 		    if (!get_dir())
-			after = false;
+			cur_game->after = false;
 		    else
 		    {
-			ch = dir_ch;
-			countch = dir_ch;
+			ch = cur_game->dir_ch;
+			cur_game->countch = cur_game->dir_ch;
 			goto over;
 		    }
-		when ')': current(cur_weapon, "wielding", nullptr);
-		when ']': current(cur_armor, "wearing", nullptr);
+		when ')': current(cur_game->cur_weapon, "wielding", nullptr);
+		when ']': current(cur_game->cur_armor, "wearing", nullptr);
 		when '=':
-		    current(cur_ring[LEFT], "wearing",
-					    terse ? "(L)" : "on left hand");
-		    current(cur_ring[RIGHT], "wearing",
-					    terse ? "(R)" : "on right hand");
+		    current(cur_game->cur_ring[LEFT], "wearing",
+					    cur_game->terse ? "(L)" : "on left hand");
+		    current(cur_game->cur_ring[RIGHT], "wearing",
+					    cur_game->terse ? "(R)" : "on right hand");
 		when '@':
-		    stat_msg = true;
+		    cur_game->stat_msg = true;
 		    status();
-		    stat_msg = false;
-		    after = false;
+		    cur_game->stat_msg = false;
+		    cur_game->after = false;
 		otherwise:
-		    after = false;
+		    cur_game->after = false;
 #ifdef MASTER
-		    if (wizard) switch (ch)
+		    if (cur_game->wizard) switch (ch)
 		    {
 			case '|': msg("@ %d,%d", hero.y, hero.x);
 			when 'C': create_obj();
-			when '$': msg("inpack = %d", inpack);
-			when CTRL('G'): inventory(lvl_obj, 0);
+			when '$': msg("inpack = %d", cur_game->inpack);
+			when '%':
+			{
+			    const auto& st = cur_game->item_pool.statistics();
+			    const auto& lst = cur_game->level_pool.statistics();
+
+			    msg("kept: %zu live, %zu peak, %zu slabs; level: %zu live, %zu peak, %zu slabs",
+				st.live, st.peak, st.slabs,
+				lst.live, lst.peak, lst.slabs);
+			}
+			when CTRL('G'): inventory(cur_game->lvl_obj, 0);
 			when CTRL('W'): whatis(false, 0);
-			when CTRL('D'): level++; new_level();
-			when CTRL('A'): level--; new_level();
+			when CTRL('D'): cur_game->level++; new_level();
+			when CTRL('A'): cur_game->level--; new_level();
 			when CTRL('F'): show_map();
 			when CTRL('T'): teleport();
-			when CTRL('E'): msg("food left: %d", food_left);
+			when CTRL('E'): msg("food left: %d", cur_game->food_left);
 			when CTRL('C'): add_pass();
-			when CTRL('X'): turn_see(on(player, SEEMONST));
+			when CTRL('X'): turn_see(on(cur_game->player, SEEMONST));
 			when CTRL('~'):
 			{
 			    THING *item;
@@ -400,23 +397,23 @@ over:
 			    /*
 			     * Give him a sword (+1,+1)
 			     */
-			    obj = new_item();
+			    obj = new_pack_item();
 			    init_weapon(obj, TWOSWORD);
 			    obj->o_hplus = 1;
 			    obj->o_dplus = 1;
 			    add_pack(obj, true);
-			    cur_weapon = obj;
+			    cur_game->cur_weapon = obj;
 			    /*
 			     * And his suit of armor
 			     */
-			    obj = new_item();
+			    obj = new_pack_item();
 			    obj->o_type = ARMOR;
 			    obj->o_which = PLATE_MAIL;
 			    obj->o_arm = -5;
 			    obj->o_flags |= ISKNOW;
 			    obj->o_count = 1;
 			    obj->o_group = 0;
-			    cur_armor = obj;
+			    cur_game->cur_armor = obj;
 			    add_pack(obj, true);
 			}
 			when '*' :
@@ -431,21 +428,22 @@ over:
 	    /*
 	     * turn off flags if no longer needed
 	     */
-	    if (!running)
-		door_stop = false;
+	    if (!cur_game->running)
+		cur_game->door_stop = false;
 	}
 	/*
 	 * If he ran into something to take, let him pick it up.
 	 */
-	if (take != 0)
-	    pick_up(take);
-	if (!running)
-	    door_stop = false;
-	if (!after)
+	if (cur_game->take != 0)
+	    pick_up(cur_game->take);
+	if (!cur_game->running)
+	    cur_game->door_stop = false;
+	if (!cur_game->after)
 	    ntimes++;
     }
     do_daemons(AFTER);
     do_fuses(AFTER);
+    cur_game->turns++;
     if (ISRING(LEFT, R_SEARCH))
 	search();
     else if (ISRING(LEFT, R_TELEPORT) && rnd(50) == 0)
@@ -463,10 +461,10 @@ over:
 void
 illcom(int ch)
 {
-    save_msg = false;
-    count = 0;
+    cur_game->save_msg = false;
+    cur_game->count = 0;
     msg("illegal command '%s'", unctrl(ch));
-    save_msg = true;
+    cur_game->save_msg = true;
 }
 
 /*
@@ -484,8 +482,8 @@ search()
 
     ey = hero.y + 1;
     ex = hero.x + 1;
-    probinc = (on(player, ISHALU) ? 3 : 0);
-    probinc += (on(player, ISBLIND) ? 2 : 0);
+    probinc = (on(cur_game->player, ISHALU) ? 3 : 0);
+    probinc += (on(cur_game->player, ISBLIND) ? 2 : 0);
     found = false;
     for (y = hero.y - 1; y <= ey; y++)
 	for (x = hero.x - 1; x <= ex; x++)
@@ -505,16 +503,16 @@ search()
 foundone:
 			found = true;
 			*fp |= F_REAL;
-			count = false;
-			running = false;
+			cur_game->count = false;
+			cur_game->running = false;
 			break;
 		    case FLOOR:
 			if (rnd(2 + probinc) != 0)
 			    break;
 			chat(y, x) = TRAP;
-			if (!terse)
+			if (!cur_game->terse)
 			    addmsg("you found ");
-			if (on(player, ISHALU))
+			if (on(cur_game->player, ISHALU))
 			    msg(tr_name[rnd(NTRAPS)]);
 			else {
 			    msg(tr_name[*fp & F_TMASK]);
@@ -530,7 +528,10 @@ foundone:
 		}
 	}
     if (found)
+    {
+	cur_game->chase_fields.clear();
 	look(false);
+    }
 }
 
 /*
@@ -545,20 +546,20 @@ help()
     int numprint, cnt;
     msg("character you want help for (* for all): ");
     helpch = readchar();
-    mpos = 0;
+    cur_game->mpos = 0;
     /*
      * If its not a *, print the right help string
      * or an error if he typed a funny character.
      */
     if (helpch != '*')
     {
-	move(0, 0);
+	cur_game->cw->move(0, 0);
 	for (strp = helpstr; strp->h_desc != nullptr; strp++)
 	    if (strp->h_ch == helpch)
 	    {
-		lower_msg = true;
+		cur_game->lower_msg = true;
 		msg("%s%s", unctrl(strp->h_ch), strp->h_desc);
-		lower_msg = false;
+		cur_game->lower_msg = false;
 		return;
 	    }
 	msg("unknown character '%s'", unctrl(helpch));
@@ -575,32 +576,32 @@ help()
     if (numprint & 01)		/* round odd numbers up */
 	numprint++;
     numprint /= 2;
-    if (numprint > LINES - 1)
-	numprint = LINES - 1;
+    if (numprint > cur_game->display->lines() - 1)
+	numprint = cur_game->display->lines() - 1;
 
-    wclear(hw);
+    cur_game->hw->clear();
     cnt = 0;
     for (strp = helpstr; strp->h_desc != nullptr; strp++)
 	if (strp->h_print)
 	{
-	    wmove(hw, cnt % numprint, cnt >= numprint ? COLS / 2 : 0);
+	    cur_game->hw->move(cnt % numprint, cnt >= numprint ? cur_game->display->cols() / 2 : 0);
 	    if (strp->h_ch)
-		waddstr(hw, unctrl(strp->h_ch));
-	    waddstr(hw, strp->h_desc);
+		cur_game->hw->addstr(unctrl(strp->h_ch));
+	    cur_game->hw->addstr(strp->h_desc);
 	    if (++cnt >= numprint * 2)
 		break;
 	}
-    wmove(hw, LINES - 1, 0);
-    waddstr(hw, "--Press space to continue--");
-    wrefresh(hw);
+    cur_game->hw->move(cur_game->display->lines() - 1, 0);
+    cur_game->hw->addstr("--Press space to continue--");
+    cur_game->hw->refresh();
     wait_for(' ');
-    clearok(stdscr, true);
+    cur_game->display->redraw();
 /*
-    refresh();
+    cw->refresh();
 */
     msg("");
-    touchwin(stdscr);
-    wrefresh(stdscr);
+    cur_game->cw->touch();
+    cur_game->cw->refresh();
 }
 
 /*
@@ -637,7 +638,7 @@ identify()
 
     msg("what do you want identified? ");
     ch = readchar();
-    mpos = 0;
+    cur_game->mpos = 0;
     if (ch == ESCAPE)
     {
         msg("");
@@ -645,7 +646,7 @@ identify()
     }
     if (std::isupper(ch))
     {
-        str = monsters[ch - 'A'].m_name;
+        str = cur_game->monsters[ch - 'A'].m_name;
     }
     entry = mapping.find(ch);
     if (entry != std::end(mapping))
@@ -668,8 +669,8 @@ d_level()
 	msg("I see no way down");
     else
     {
-	level++;
-	seenstairs = false;
+	cur_game->level++;
+	cur_game->seenstairs = false;
 	new_level();
     }
 }
@@ -684,10 +685,10 @@ u_level()
     if (levit_check())
 	return;
     if (chat(hero.y, hero.x) == STAIRS)
-	if (amulet)
+	if (cur_game->amulet)
 	{
-	    level--;
-	    if (level == 0)
+	    cur_game->level--;
+	    if (cur_game->level == 0)
 		total_winner();
 	    new_level();
 	    msg("you feel a wrenching sensation in your gut");
@@ -706,7 +707,7 @@ u_level()
 bool
 levit_check()
 {
-    if (!on(player, ISLEVIT))
+    if (!on(cur_game->player, ISLEVIT))
 	return false;
     msg("You can't.  You're floating off the ground!");
     return true;
@@ -733,23 +734,23 @@ call()
     switch (obj->o_type)
     {
         case RING:
-            op = &ring_info[obj->o_which];
-            elsewise = r_stones[obj->o_which];
+            op = &cur_game->ring_info[obj->o_which];
+            elsewise = cur_game->r_stones[obj->o_which];
             goto norm;
 
         case POTION:
-            op = &pot_info[obj->o_which];
-            elsewise = p_colors[obj->o_which];
+            op = &cur_game->pot_info[obj->o_which];
+            elsewise = cur_game->p_colors[obj->o_which];
             goto norm;
 
         case SCROLL:
-            op = &scr_info[obj->o_which];
-            elsewise = s_names[obj->o_which];
+            op = &cur_game->scr_info[obj->o_which];
+            elsewise = cur_game->s_names[obj->o_which];
             goto norm;
 
         case STICK:
-            op = &ws_info[obj->o_which];
-            elsewise = ws_made[obj->o_which];
+            op = &cur_game->ws_info[obj->o_which];
+            elsewise = cur_game->ws_made[obj->o_which];
 norm:
             know = &op->oi_know;
             guess = &op->oi_guess;
@@ -776,29 +777,29 @@ norm:
     }
     if (elsewise && !elsewise->compare(*guess))
     {
-        if (!terse)
+        if (!cur_game->terse)
         {
             addmsg("Was ");
         }
         msg("called \"%s\"", elsewise->c_str());
     }
-    if (terse)
+    if (cur_game->terse)
     {
         msg("call it: ");
     } else {
         msg("what do you want to call it? ");
     }
 
-    std::strcpy(prbuf, elsewise ? elsewise->c_str() : "");
+    std::strcpy(cur_game->prbuf, elsewise ? elsewise->c_str() : "");
 
-    if (get_str(prbuf, stdscr) == NORM)
+    if (get_str(cur_game->prbuf, cur_game->cw) == NORM)
     {
         if (*guess)
         {
             std::free(*guess);
         }
-        *guess = static_cast<char*>(std::malloc(std::strlen(prbuf) + 1));
-        std::strcpy(*guess, prbuf);
+        *guess = static_cast<char*>(std::malloc(std::strlen(cur_game->prbuf) + 1));
+        std::strcpy(*guess, cur_game->prbuf);
     }
 }
 
@@ -809,21 +810,21 @@ norm:
 void
 current(THING *cur, const char* how, const char* where)
 {
-    after = false;
+    cur_game->after = false;
     if (cur != nullptr)
     {
-	if (!terse)
+	if (!cur_game->terse)
 	    addmsg("you are %s (", how);
-	inv_describe = false;
+	cur_game->inv_describe = false;
 	addmsg("%c) %s", cur->o_packch, inv_name(cur, true));
-	inv_describe = true;
+	cur_game->inv_describe = true;
 	if (where)
 	    addmsg(" %s", where);
 	endmsg();
     }
     else
     {
-	if (!terse)
+	if (!cur_game->terse)
 	    addmsg("you are ");
 	addmsg("%s nothing", how);
 	if (where)
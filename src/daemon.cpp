@@ -11,68 +11,16 @@
  * See the file LICENSE.TXT for full copyright and licensing information.
  */
 
-#include <ncurses.h>
-
 #include <roguepp/roguepp.hpp>
 
-#define EMPTY 0
-#define DAEMON -1
-#define MAXDAEMONS 20
-
-#define _X_ { EMPTY }
-
-struct delayed_action d_list[MAXDAEMONS] = {
-    _X_, _X_, _X_, _X_, _X_, _X_, _X_, _X_, _X_, _X_,
-    _X_, _X_, _X_, _X_, _X_, _X_, _X_, _X_, _X_, _X_,
-};
-
-/*
- * d_slot:
- *	Find an empty slot in the daemon/fuse list
- */
-static struct delayed_action*
-d_slot()
-{
-    struct delayed_action *dev;
-
-    for (dev = d_list; dev <= &d_list[MAXDAEMONS-1]; dev++)
-	if (dev->d_type == EMPTY)
-	    return dev;
-#ifdef MASTER
-    debug("Ran out of fuse slots");
-#endif
-    return nullptr;
-}
-
-/*
- * find_slot:
- *	Find a particular slot in the table
- */
-static struct delayed_action*
-find_slot(const delayed_action::callback_type& func)
-{
-    struct delayed_action *dev;
-
-    for (dev = d_list; dev <= &d_list[MAXDAEMONS-1]; dev++)
-	if (dev->d_type != EMPTY && func == dev->d_func)
-	    return dev;
-    return nullptr;
-}
-
 /*
  * start_daemon:
  *	Start a daemon, takes a function.
  */
-void
+timer_handle
 start_daemon(const delayed_action::callback_type& func, int arg, int type)
 {
-    struct delayed_action *dev;
-
-    dev = d_slot();
-    dev->d_type = type;
-    dev->d_func = func;
-    dev->d_arg = arg;
-    dev->d_time = DAEMON;
+    return cur_game->timers.start_daemon(func, arg, type);
 }
 
 /*
@@ -82,14 +30,7 @@ start_daemon(const delayed_action::callback_type& func, int arg, int type)
 void
 kill_daemon(const delayed_action::callback_type& func)
 {
-    struct delayed_action *dev;
-
-    if ((dev = find_slot(func)) == nullptr)
-	return;
-    /*
-     * Take it out of the list
-     */
-    dev->d_type = EMPTY;
+    cur_game->timers.cancel(cur_game->timers.find(func));
 }
 
 /*
@@ -100,33 +41,17 @@ kill_daemon(const delayed_action::callback_type& func)
 void
 do_daemons(int flag)
 {
-    struct delayed_action *dev;
-
-    /*
-     * Loop through the devil list
-     */
-    for (dev = d_list; dev <= &d_list[MAXDAEMONS-1]; dev++)
-	/*
-	 * Executing each one, giving it the proper arguments
-	 */
-	if (dev->d_type == flag && dev->d_time == DAEMON)
-	    (*dev->d_func)(dev->d_arg);
+    cur_game->timers.run_daemons(flag);
 }
 
 /*
  * fuse:
  *	Start a fuse to go off in a certain number of turns
  */
-void
+timer_handle
 fuse(const delayed_action::callback_type& func, int arg, int time, int type)
 {
-    struct delayed_action *wire;
-
-    wire = d_slot();
-    wire->d_type = type;
-    wire->d_func = func;
-    wire->d_arg = arg;
-    wire->d_time = time;
+    return cur_game->timers.fuse(func, arg, time, type);
 }
 
 /*
@@ -136,11 +61,13 @@ fuse(const delayed_action::callback_type& func, int arg, int time, int type)
 void
 lengthen(const delayed_action::callback_type& func, int xtime)
 {
-    struct delayed_action *wire;
+    cur_game->timers.lengthen(cur_game->timers.find(func), xtime);
+}
 
-    if ((wire = find_slot(func)) == nullptr)
-	return;
-    wire->d_time += xtime;
+void
+lengthen(timer_handle wire, int xtime)
+{
+    cur_game->timers.lengthen(wire, xtime);
 }
 
 /*
@@ -150,11 +77,13 @@ lengthen(const delayed_action::callback_type& func, int xtime)
 void
 extinguish(const delayed_action::callback_type& func)
 {
-    struct delayed_action *wire;
+    cur_game->timers.cancel(cur_game->timers.find(func));
+}
 
-    if ((wire = find_slot(func)) == nullptr)
-	return;
-    wire->d_type = EMPTY;
+void
+extinguish(timer_handle wire)
+{
+    cur_game->timers.cancel(wire);
 }
 
 /*
@@ -164,19 +93,5 @@ extinguish(const delayed_action::callback_type& func)
 void
 do_fuses(int flag)
 {
-    struct delayed_action *wire;
-
-    /*
-     * Step though the list
-     */
-    for (wire = d_list; wire <= &d_list[MAXDAEMONS-1]; wire++)
-	/*
-	 * Decrementing counters and starting things we want.  We also need
-	 * to remove the fuse from the list once it has gone off.
-	 */
-	if (flag == wire->d_type && wire->d_time > 0 && --wire->d_time == 0)
-	{
-	    wire->d_type = EMPTY;
-	    (*wire->d_func)(wire->d_arg);
-	}
+    cur_game->timers.run_fuses(flag);
 }
@@ -10,8 +10,6 @@
  * See the file LICENSE.TXT for full copyright and licensing information.
  */
 
-#include <ncurses.h>
-
 #include <roguepp/roguepp.hpp>
 
 /*
@@ -25,14 +23,14 @@ doctor(int)
 
     lv = pstats.s_lvl;
     ohp = pstats.s_hpt;
-    quiet++;
+    cur_game->quiet++;
     if (lv < 8)
     {
-	if (quiet + (lv << 1) > 20)
+	if (cur_game->quiet + (lv << 1) > 20)
 	    pstats.s_hpt++;
     }
     else
-	if (quiet >= 3)
+	if (cur_game->quiet >= 3)
 	    pstats.s_hpt += rnd(lv - 7) + 1;
     if (ISRING(LEFT, R_REGEN))
 	pstats.s_hpt++;
@@ -42,7 +40,7 @@ doctor(int)
     {
 	if (pstats.s_hpt > max_hp)
 	    pstats.s_hpt = max_hp;
-	quiet = 0;
+	cur_game->quiet = 0;
     }
 }
 
@@ -60,12 +58,11 @@ swander(int)
  * rollwand:
  *	Called to roll to see if a wandering monster starts up
  */
-int between = 0;
 void
 rollwand(int)
 {
 
-    if (++between >= 4)
+    if (++cur_game->between >= 4)
     {
 	if (roll(1, 6) == 4)
 	{
@@ -73,7 +70,7 @@ rollwand(int)
 	    kill_daemon(rollwand);
 	    fuse(swander, 0, WANDERTIME, BEFORE);
 	}
-	between = 0;
+	cur_game->between = 0;
     }
 }
 
@@ -84,7 +81,7 @@ rollwand(int)
 void
 unconfuse(int)
 {
-    player.t_flags &= ~ISHUH;
+    cur_game->player.t_flags &= ~ISHUH;
     msg("you feel less %s now", choose_str("trippy", "confused"));
 }
 
@@ -97,10 +94,10 @@ unsee(int)
 {
     THING *th;
 
-    for (th = mlist; th != nullptr; th = next(th))
+    for (th = cur_game->mlist; th != nullptr; th = next(th))
 	if (on(*th, ISINVIS) && see_monst(th))
-	    mvaddch(th->t_pos.y, th->t_pos.x, th->t_oldch);
-    player.t_flags &= ~CANSEE;
+	    cur_game->cw->mvaddch(th->t_pos.y, th->t_pos.x, th->t_oldch);
+    cur_game->player.t_flags &= ~CANSEE;
 }
 
 /*
@@ -110,10 +107,10 @@ unsee(int)
 void
 sight(int)
 {
-    if (on(player, ISBLIND))
+    if (on(cur_game->player, ISBLIND))
     {
 	extinguish(sight);
-	player.t_flags &= ~ISBLIND;
+	cur_game->player.t_flags &= ~ISBLIND;
 	if (!(proom->r_flags & ISGONE))
 	    enter_room(&hero);
 	msg(choose_str("far out!  Everything is all cosmic again",
@@ -128,7 +125,7 @@ sight(int)
 void
 nohaste(int)
 {
-    player.t_flags &= ~ISHASTE;
+    cur_game->player.t_flags &= ~ISHASTE;
     msg("you feel yourself slowing down");
 }
 
@@ -140,50 +137,50 @@ void
 stomach(int)
 {
     int oldfood;
-    int orig_hungry = hungry_state;
+    int orig_hungry = cur_game->hungry_state;
 
-    if (food_left <= 0)
+    if (cur_game->food_left <= 0)
     {
-	if (food_left-- < -STARVETIME)
+	if (cur_game->food_left-- < -STARVETIME)
 	    death('s');
 	/*
 	 * the hero is fainting
 	 */
-	if (no_command || rnd(5) != 0)
+	if (cur_game->no_command || rnd(5) != 0)
 	    return;
-	no_command += rnd(8) + 4;
-	hungry_state = 3;
-	if (!terse)
+	cur_game->no_command += rnd(8) + 4;
+	cur_game->hungry_state = 3;
+	if (!cur_game->terse)
 	    addmsg(choose_str("the munchies overpower your motor capabilities.  ",
 			      "you feel too weak from lack of food.  "));
 	msg(choose_str("You freak out", "You faint"));
     }
     else
     {
-	oldfood = food_left;
-	food_left -= ring_eat(LEFT) + ring_eat(RIGHT) + 1 - amulet;
+	oldfood = cur_game->food_left;
+	cur_game->food_left -= ring_eat(LEFT) + ring_eat(RIGHT) + 1 - cur_game->amulet;
 
-	if (food_left < MORETIME && oldfood >= MORETIME)
+	if (cur_game->food_left < MORETIME && oldfood >= MORETIME)
 	{
-	    hungry_state = 2;
+	    cur_game->hungry_state = 2;
 	    msg(choose_str("the munchies are interfering with your motor capabilites",
 			   "you are starting to feel weak"));
 	}
-	else if (food_left < 2 * MORETIME && oldfood >= 2 * MORETIME)
+	else if (cur_game->food_left < 2 * MORETIME && oldfood >= 2 * MORETIME)
 	{
-	    hungry_state = 1;
-	    if (terse)
+	    cur_game->hungry_state = 1;
+	    if (cur_game->terse)
 		msg(choose_str("getting the munchies", "getting hungry"));
 	    else
 		msg(choose_str("you are getting the munchies",
 			       "you are starting to get hungry"));
 	}
     }
-    if (hungry_state != orig_hungry) {
-        player.t_flags &= ~ISRUN;
-        running = false;
-        to_death = false;
-        count = 0;
+    if (cur_game->hungry_state != orig_hungry) {
+        cur_game->player.t_flags &= ~ISRUN;
+        cur_game->running = false;
+        cur_game->to_death = false;
+        cur_game->count = 0;
     }
 }
 
@@ -197,39 +194,39 @@ come_down(int)
     THING *tp;
     bool seemonst;
 
-    if (!on(player, ISHALU))
+    if (!on(cur_game->player, ISHALU))
 	return;
 
     kill_daemon(visuals);
-    player.t_flags &= ~ISHALU;
+    cur_game->player.t_flags &= ~ISHALU;
 
-    if (on(player, ISBLIND))
+    if (on(cur_game->player, ISBLIND))
 	return;
 
     /*
      * undo the things
      */
-    for (tp = lvl_obj; tp != nullptr; tp = next(tp))
+    for (tp = cur_game->lvl_obj; tp != nullptr; tp = next(tp))
 	if (cansee(tp->o_pos.y, tp->o_pos.x))
-	    mvaddch(tp->o_pos.y, tp->o_pos.x, tp->o_type);
+	    cur_game->cw->mvaddch(tp->o_pos.y, tp->o_pos.x, tp->o_type);
 
     /*
      * undo the monsters
      */
-    seemonst = on(player, SEEMONST);
-    for (tp = mlist; tp != nullptr; tp = next(tp))
+    seemonst = on(cur_game->player, SEEMONST);
+    for (tp = cur_game->mlist; tp != nullptr; tp = next(tp))
     {
-	move(tp->t_pos.y, tp->t_pos.x);
+	cur_game->cw->move(tp->t_pos.y, tp->t_pos.x);
 	if (cansee(tp->t_pos.y, tp->t_pos.x))
-	    if (!on(*tp, ISINVIS) || on(player, CANSEE))
-		addch(tp->t_disguise);
+	    if (!on(*tp, ISINVIS) || on(cur_game->player, CANSEE))
+		cur_game->cw->addch(tp->t_disguise);
 	    else
-		addch(chat(tp->t_pos.y, tp->t_pos.x));
+		cur_game->cw->addch(chat(tp->t_pos.y, tp->t_pos.x));
 	else if (seemonst)
 	{
-	    standout();
-	    addch(tp->t_type);
-	    standend();
+	    cur_game->cw->standout();
+	    cur_game->cw->addch(tp->t_type);
+	    cur_game->cw->standend();
 	}
     }
     msg("Everything looks SO boring now.");
@@ -245,40 +242,40 @@ visuals(int)
     THING *tp;
     bool seemonst;
 
-    if (!after || (running && jump))
+    if (!cur_game->after || (cur_game->running && cur_game->jump))
 	return;
     /*
      * change the things
      */
-    for (tp = lvl_obj; tp != nullptr; tp = next(tp))
+    for (tp = cur_game->lvl_obj; tp != nullptr; tp = next(tp))
 	if (cansee(tp->o_pos.y, tp->o_pos.x))
-	    mvaddch(tp->o_pos.y, tp->o_pos.x, rnd_thing());
+	    cur_game->cw->mvaddch(tp->o_pos.y, tp->o_pos.x, rnd_thing());
 
     /*
      * change the stairs
      */
-    if (!seenstairs && cansee(stairs.y, stairs.x))
-	mvaddch(stairs.y, stairs.x, rnd_thing());
+    if (!cur_game->seenstairs && cansee(cur_game->stairs.y, cur_game->stairs.x))
+	cur_game->cw->mvaddch(cur_game->stairs.y, cur_game->stairs.x, rnd_thing());
 
     /*
      * change the monsters
      */
-    seemonst = on(player, SEEMONST);
-    for (tp = mlist; tp != nullptr; tp = next(tp))
+    seemonst = on(cur_game->player, SEEMONST);
+    for (tp = cur_game->mlist; tp != nullptr; tp = next(tp))
     {
-	move(tp->t_pos.y, tp->t_pos.x);
+	cur_game->cw->move(tp->t_pos.y, tp->t_pos.x);
 	if (see_monst(tp))
 	{
 	    if (tp->t_type == 'X' && tp->t_disguise != 'X')
-		addch(rnd_thing());
+		cur_game->cw->addch(rnd_thing());
 	    else
-		addch(rnd(26) + 'A');
+		cur_game->cw->addch(rnd(26) + 'A');
 	}
 	else if (seemonst)
 	{
-	    standout();
-	    addch(rnd(26) + 'A');
-	    standend();
+	    cur_game->cw->standout();
+	    cur_game->cw->addch(rnd(26) + 'A');
+	    cur_game->cw->standend();
 	}
     }
 }
@@ -290,7 +287,7 @@ visuals(int)
 void
 land(int)
 {
-    player.t_flags &= ~ISLEVIT;
+    cur_game->player.t_flags &= ~ISLEVIT;
     msg(choose_str("bummer!  You've hit the ground",
 		   "you float gently to the ground"));
 }
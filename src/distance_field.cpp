@@ -0,0 +1,127 @@
+/*
+ * Distance fields shared by the monsters chasing something
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+
+#include <roguepp/roguepp.hpp>
+
+/*
+ * The eight directions, as steps and as offsets into places[].
+ */
+static const int move_dy[8] = { -1, -1, -1, 0, 0, 1, 1, 1 };
+static const int move_dx[8] = { -1, 0, 1, -1, 1, -1, 0, 1 };
+static const int move_offset[8] = {
+    -MAXLINES - 1, -1, MAXLINES - 1, -MAXLINES, MAXLINES, -MAXLINES + 1, 1, MAXLINES + 1
+};
+
+/**
+ * Breadth first search outwards from the target.  Moves are symmetric,
+ * so the steps from the target to a place are the steps back.
+ */
+void
+distance_field::build(const coord& target, const move_map& moves)
+{
+    static thread_local std::array<int, MAXLINES * MAXCOLS> queue;
+    std::size_t head = 0;
+    std::size_t tail = 0;
+
+    m_dist.fill(FAR);
+    queue[tail++] = (target.x << 5) + target.y;
+    m_dist[queue[0]] = 0;
+    while (head < tail)
+    {
+        const auto here = queue[head++];
+        const auto steps = static_cast<short>(m_dist[here] + 1);
+        const auto open = moves[here];
+
+        for (int i = 0; i < 8; ++i)
+        {
+            if (!(open & (1 << i)))
+            {
+                continue;
+            }
+
+            const auto there = here + move_offset[i];
+
+            if (m_dist[there] > steps)
+            {
+                m_dist[there] = steps;
+                queue[tail++] = there;
+            }
+        }
+    }
+}
+
+const distance_field&
+distance_cache::to(const coord& target)
+{
+    if (!m_mapped)
+    {
+        map_moves();
+    }
+    for (auto& e : m_entries)
+    {
+        if (e.valid && ce(e.target, target))
+        {
+            return e.field;
+        }
+    }
+
+    auto& e = m_entries[m_next];
+
+    m_next = (m_next + 1) % SIZE;
+    e.field.build(target, m_moves);
+    e.target = target;
+    e.valid = true;
+
+    return e.field;
+}
+
+void
+distance_cache::clear()
+{
+    for (auto& e : m_entries)
+    {
+        e.valid = false;
+    }
+    m_mapped = false;
+}
+
+/**
+ * Work out once which moves diag_ok() and step_ok() allow out of each
+ * place, so building a field does not have to.
+ */
+void
+distance_cache::map_moves()
+{
+    coord here;
+    coord there;
+
+    for (here.x = 0; here.x < MAXCOLS; ++here.x)
+    {
+        for (here.y = 0; here.y < MAXLINES; ++here.y)
+        {
+            unsigned char open = 0;
+
+            if (here.x < NUMCOLS && here.y < NUMLINES)
+            {
+                for (int i = 0; i < 8; ++i)
+                {
+                    there.y = here.y + move_dy[i];
+                    there.x = here.x + move_dx[i];
+                    if (diag_ok(&here, &there) && step_ok(chat(there.y, there.x)))
+                    {
+                        open |= 1 << i;
+                    }
+                }
+            }
+            m_moves[(here.x << 5) + here.y] = open;
+        }
+    }
+    m_mapped = true;
+}
@@ -10,61 +10,17 @@
  * See the file LICENSE.TXT for full copyright and licensing information.
  */
 
-#include <ncurses.h>
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
 
 #include <roguepp/roguepp.hpp>
 
-bool after;				/* True if we want after daemons */
-bool again;				/* Repeating the last command */
-int  noscore;				/* Was a wizard sometime */
-bool seenstairs;			/* Have seen the stairs (for lsd) */
-bool amulet = false;			/* He found the amulet */
-bool door_stop = false;			/* Stop running when we pass a door */
-bool fight_flush = false;		/* True if toilet input */
-bool firstmove = false;			/* First move after setting door_stop */
+thread_local game* cur_game = nullptr;	/* Game played on this thread */
+
 bool got_ltc = false;			/* We have gotten the local tty chars */
-bool has_hit = false;			/* Has a "hit" message pending in msg */
 bool in_shell = false;			/* True if executing a shell */
-bool inv_describe = true;		/* Say which way items are being used */
-bool jump = false;			/* Show running as series of jumps */
-bool kamikaze = false;			/* to_death really to DEATH */
-bool lower_msg = false;			/* Messages should start w/lower case */
-bool move_on = false;			/* Next move shouldn't pick up items */
-bool msg_esc = false;			/* Check for ESC from msg's --More-- */
-bool passgo = false;			/* Follow passages */
-bool playing = true;			/* True until he quits */
-bool q_comm = false;			/* Are we executing a 'Q' command? */
-bool running = false;			/* True if player is running */
-bool save_msg = true;			/* Remember last msg */
-bool see_floor = true;			/* Show the lamp illuminated floor */
-bool stat_msg = false;			/* Should status() print as a msg() */
-bool terse = false;			/* True if we should be short */
-bool to_death = false;			/* Fighting is to the death! */
-bool tombstone = true;			/* Print out tombstone at end */
-#ifdef MASTER
-int wizard = false;			/* True if allows wizard commands */
-#endif
-std::array<bool, 26> pack_used =
-{{
-    false, false, false, false, false, false, false, false, false,
-    false, false, false, false, false, false, false, false, false,
-    false, false, false, false, false, false, false, false
-}};
-char dir_ch;				/* Direction from last get_dir() call */
-char file_name[MAXSTR];			/* Save file name */
-char huh[MAXSTR];			/* The last message printed */
-std::array<std::optional<std::string>, MAXPOTIONS> p_colors;
-char prbuf[2*MAXSTR];			/* buffer for sprintfs */
-std::array<std::optional<std::string>, MAXRINGS> r_stones;
-char runch;				/* Direction player is running */
-std::array<std::string, MAXSCROLLS> s_names;
-char take;				/* Thing she is taking */
-char whoami[MAXSTR];			/* Name of player */
-std::array<std::optional<std::string>, MAXSTICKS> ws_made;
-std::array<std::optional<std::string>, MAXSTICKS> ws_type;
 int  orig_dsusp;			/* Original dsusp char */
-char fruit[MAXSTR] =			/* Favorite fruit */
-		{ 's', 'l', 'i', 'm', 'e', '-', 'm', 'o', 'l', 'd', '\0' };
 char home[MAXSTR] = { '\0' };		/* User's home directory */
 std::array<const char*, 3> inv_t_name =
 {{
@@ -72,10 +28,6 @@ std::array<const char*, 3> inv_t_name =
     "Slow",
     "Clear",
 }};
-char l_last_comm = '\0';		/* Last last_comm */
-char l_last_dir = '\0';			/* Last last_dir */
-char last_comm = '\0';			/* Last command typed */
-char last_dir = '\0';			/* Last direction given */
 std::array<const char*, NTRAPS> tr_name =
 {{
     "a trapdoor",
@@ -88,17 +40,6 @@ std::array<const char*, NTRAPS> tr_name =
     "a mysterious trap",
 }};
 
-
-int n_objs;				/* # items listed in inventory() call */
-int ntraps;				/* Number of traps on this level */
-int hungry_state = 0;			/* How hungry is he */
-int inpack = 0;				/* Number of things in pack */
-int inv_type = 0;			/* Type of inventory to use */
-int level = 1;				/* What level she is on */
-int max_hit;				/* Max damage done to her in to_death */
-int max_level;				/* Deepest player has gone */
-int mpos = 0;				/* Where cursor is on top line */
-int no_food = 0;			/* Number of levels without food */
 int a_class[MAXARMORS] = {		/* Armor class for each armor type */
 	8,	/* LEATHER */
 	7,	/* RING_MAIL */
@@ -110,18 +51,10 @@ int a_class[MAXARMORS] = {		/* Armor class for each armor type */
 	3,	/* PLATE_MAIL */
 };
 
-int count = 0;				/* Number of times to repeat command */
 FILE *scoreboard = nullptr;	/* File descriptor for score file */
-int food_left;				/* Amount of food in hero's stomach */
-int lastscore = -1;			/* Score before this turn */
-int no_command = 0;			/* Number of turns asleep */
-int no_move = 0;			/* Number of turns held in place */
-int purse = 0;				/* How much gold he has */
-int quiet = 0;				/* Number of quiet turns */
-int vf_hit = 0;				/* Number of time flytrap has hit */
+int score_keeper = -1;		/* Connection to rogue++-scored, if it runs */
+int score_log = -1;		/* File descriptor for score journal */
 
-int dnum;				/* Dungeon number */
-int seed;				/* Random number seed */
 int e_levels[] = {
         10L,
 	20L,
@@ -146,49 +79,11 @@ int e_levels[] = {
 	 0L
 };
 
-coord delta;				/* Change indicated to get_dir() */
-coord oldpos;				/* Position before last look() call */
-coord stairs;				/* Location of staircase */
-
-PLACE places[MAXLINES*MAXCOLS];		/* level map */
-
-THING *cur_armor;			/* What he is wearing */
-THING *cur_ring[2];			/* Which rings are being worn */
-THING *cur_weapon;			/* Which weapon he is weilding */
-THING *l_last_pick = nullptr;		/* Last last_pick */
-THING *last_pick = nullptr;		/* Last object picked in get_item() */
-THING *lvl_obj = nullptr;			/* List of objects on this level */
-THING *mlist = nullptr;			/* List of monsters on the level */
-THING player;				/* His stats */
-					/* restart of game */
-
-WINDOW *hw = nullptr;			/* used as a scratch window */
-
 #define INIT_STATS { 16, 0, 1, 10, 12, "1x4", 12 }
 
-struct stats max_stats = INIT_STATS;	/* The maximum for the player */
-
-room* oldrp;
-std::array<room, MAXROOMS> rooms;
-std::array<room, MAXPASS> passages =
-{{
-    { {0, 0}, {0, 0}, {0, 0}, 0, ISGONE|ISDARK, 0 },
-    { {0, 0}, {0, 0}, {0, 0}, 0, ISGONE|ISDARK, 0 },
-    { {0, 0}, {0, 0}, {0, 0}, 0, ISGONE|ISDARK, 0 },
-    { {0, 0}, {0, 0}, {0, 0}, 0, ISGONE|ISDARK, 0 },
-    { {0, 0}, {0, 0}, {0, 0}, 0, ISGONE|ISDARK, 0 },
-    { {0, 0}, {0, 0}, {0, 0}, 0, ISGONE|ISDARK, 0 },
-    { {0, 0}, {0, 0}, {0, 0}, 0, ISGONE|ISDARK, 0 },
-    { {0, 0}, {0, 0}, {0, 0}, 0, ISGONE|ISDARK, 0 },
-    { {0, 0}, {0, 0}, {0, 0}, 0, ISGONE|ISDARK, 0 },
-    { {0, 0}, {0, 0}, {0, 0}, 0, ISGONE|ISDARK, 0 },
-    { {0, 0}, {0, 0}, {0, 0}, 0, ISGONE|ISDARK, 0 },
-    { {0, 0}, {0, 0}, {0, 0}, 0, ISGONE|ISDARK, 0 },
-}};
-
 #define ___ 1
 #define XX 10
-struct monster monsters[26] =
+static const monster monsters_init[26] =
     {
 /* Name		 CARRY	FLAG    str, exp, lvl, amr, hpt, dmg */
 { "aquator",	   0,	ISMEAN,	{ XX, 20,   5,   2, ___, "0x0/0x0" } },
@@ -223,7 +118,7 @@ struct monster monsters[26] =
 #undef ___
 #undef XX
 
-struct obj_info things[NUMTHINGS] = {
+static const obj_info things_init[NUMTHINGS] = {
     { nullptr,			26 },	/* potion */
     { nullptr,			36 },	/* scroll */
     { nullptr,			16 },	/* food */
@@ -233,7 +128,7 @@ struct obj_info things[NUMTHINGS] = {
     { nullptr,			 4 },	/* stick */
 };
 
-struct obj_info arm_info[MAXARMORS] = {
+static const obj_info arm_info_init[MAXARMORS] = {
     { "leather armor",		 20,	 20, nullptr, false },
     { "ring mail",		 15,	 25, nullptr, false },
     { "studded leather armor",	 15,	 20, nullptr, false },
@@ -243,7 +138,7 @@ struct obj_info arm_info[MAXARMORS] = {
     { "banded mail",		 10,	 90, nullptr, false },
     { "plate mail",		  5,	150, nullptr, false },
 };
-struct obj_info pot_info[MAXPOTIONS] = {
+static const obj_info pot_info_init[MAXPOTIONS] = {
     { "confusion",		 7,   5, nullptr, false },
     { "hallucination",		 8,   5, nullptr, false },
     { "poison",			 8,   5, nullptr, false },
@@ -259,7 +154,7 @@ struct obj_info pot_info[MAXPOTIONS] = {
     { "blindness",		 5,   5, nullptr, false },
     { "levitation",		 6,  75, nullptr, false },
 };
-struct obj_info ring_info[MAXRINGS] = {
+static const obj_info ring_info_init[MAXRINGS] = {
     { "protection",		 9, 400, nullptr, false },
     { "add strength",		 9, 400, nullptr, false },
     { "sustain strength",	 5, 280, nullptr, false },
@@ -275,7 +170,7 @@ struct obj_info ring_info[MAXRINGS] = {
     { "stealth",		 7, 470, nullptr, false },
     { "maintain armor",		 5, 380, nullptr, false },
 };
-struct obj_info scr_info[MAXSCROLLS] = {
+static const obj_info scr_info_init[MAXSCROLLS] = {
     { "monster confusion",		 7, 140, nullptr, false },
     { "magic mapping",			 4, 150, nullptr, false },
     { "hold monster",			 2, 180, nullptr, false },
@@ -295,7 +190,7 @@ struct obj_info scr_info[MAXSCROLLS] = {
     { "aggravate monsters",		 3,  20, nullptr, false },
     { "protect armor",			 2, 250, nullptr, false },
 };
-struct obj_info weap_info[MAXWEAPONS + 1] = {
+static const obj_info weap_info_init[MAXWEAPONS + 1] = {
     { "mace",				11,   8, nullptr, false },
     { "long sword",			11,  15, nullptr, false },
     { "short bow",			12,  15, nullptr, false },
@@ -307,7 +202,7 @@ struct obj_info weap_info[MAXWEAPONS + 1] = {
     { "spear",				12,   5, nullptr, false },
     { nullptr, 0 },	/* DO NOT REMOVE: fake entry for dragon's breath */
 };
-struct obj_info ws_info[MAXSTICKS] = {
+static const obj_info ws_info_init[MAXSTICKS] = {
     { "light",			12, 250, nullptr, false },
     { "invisibility",		 6,   5, nullptr, false },
     { "lightning",		 3, 330, nullptr, false },
@@ -324,6 +219,55 @@ struct obj_info ws_info[MAXSTICKS] = {
     { "cancellation",		 5, 280, nullptr, false },
 };
 
+/*
+ * game:
+ *	Set up the state of a new game
+ */
+game::game()
+{
+    max_stats = INIT_STATS;
+    for (auto& rp : passages)
+	rp.r_flags = ISGONE|ISDARK;
+    std::copy(std::begin(monsters_init), std::end(monsters_init), monsters);
+    std::copy(std::begin(things_init), std::end(things_init), things);
+    std::copy(std::begin(arm_info_init), std::end(arm_info_init), arm_info);
+    std::copy(std::begin(pot_info_init), std::end(pot_info_init), pot_info);
+    std::copy(std::begin(ring_info_init), std::end(ring_info_init), ring_info);
+    std::copy(std::begin(scr_info_init), std::end(scr_info_init), scr_info);
+    std::copy(std::begin(weap_info_init), std::end(weap_info_init), weap_info);
+    std::copy(std::begin(ws_info_init), std::end(ws_info_init), ws_info);
+}
+
+/*
+ * free_guesses:
+ *	Forget what the player called the objects of one type
+ */
+static void
+free_guesses(obj_info* info, int nitems)
+{
+    for (int i = 0; i < nitems; i++)
+	std::free(info[i].oi_guess);
+}
+
+/*
+ * ~game:
+ *	Give back everything the game allocated
+ */
+game::~game()
+{
+    for (THING* tp = mlist; tp != nullptr; tp = next(tp))
+	free_list(tp->t_pack);
+    free_list(mlist);
+    free_list(lvl_obj);
+    free_list(player.t_pack);
+    free_guesses(arm_info, MAXARMORS);
+    free_guesses(pot_info, MAXPOTIONS);
+    free_guesses(ring_info, MAXRINGS);
+    free_guesses(scr_info, MAXSCROLLS);
+    free_guesses(weap_info, MAXWEAPONS);
+    free_guesses(ws_info, MAXSTICKS);
+}
+
 struct h_list helpstr[] = {
     {'?',	"	prints help",				true},
     {'/',	"	identify object",			true},
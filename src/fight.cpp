@@ -14,8 +14,6 @@
 #include <cstring>
 #include <cstdlib>
 #include <cstring>
-#include <ncurses.h>
-
 #include <roguepp/roguepp.hpp>
 
 #define	EQSTR(a, b)	(std::strcmp(a, b) == 0)
@@ -78,6 +76,7 @@ fight(coord *mp, THING *weap, bool thrown)
     bool did_hit = true;
     const char* mname;
     char ch;
+    rng_scope stream(RNG_COMBAT);
 
     /*
      * Find the monster we want to fight
@@ -92,19 +91,19 @@ fight(coord *mp, THING *weap, bool thrown)
      * Since we are fighting, things are not quiet so no healing takes
      * place.
      */
-    count = 0;
-    quiet = 0;
+    cur_game->count = 0;
+    cur_game->quiet = 0;
     runto(mp);
     /*
      * Let him know it was really a xeroc (if it was one).
      */
     ch = '\0';
-    if (tp->t_type == 'X' && tp->t_disguise != 'X' && !on(player, ISBLIND))
+    if (tp->t_type == 'X' && tp->t_disguise != 'X' && !on(cur_game->player, ISBLIND))
     {
 	tp->t_disguise = 'X';
-	if (on(player, ISHALU)) {
+	if (on(cur_game->player, ISHALU)) {
 	    ch = (char)(rnd(26) + 'A');
-	    mvaddch(tp->t_pos.y, tp->t_pos.x, ch);
+	    cur_game->cw->mvaddch(tp->t_pos.y, tp->t_pos.x, ch);
 	}
 	msg(choose_str("heavy!  That's a nasty critter!",
 		       "wait!  That's a xeroc!"));
@@ -113,34 +112,34 @@ fight(coord *mp, THING *weap, bool thrown)
     }
     mname = set_mname(tp);
     did_hit = false;
-    has_hit = (terse && !to_death);
-    if (roll_em(&player, tp, weap, thrown))
+    cur_game->has_hit = (cur_game->terse && !cur_game->to_death);
+    if (roll_em(&cur_game->player, tp, weap, thrown))
     {
 	did_hit = false;
 	if (thrown)
-	    thunk(weap, mname, terse);
+	    thunk(weap, mname, cur_game->terse);
 	else
-	    hit(nullptr, mname, terse);
-	if (on(player, CANHUH))
+	    hit(nullptr, mname, cur_game->terse);
+	if (on(cur_game->player, CANHUH))
 	{
 	    did_hit = true;
 	    tp->t_flags |= ISHUH;
-	    player.t_flags &= ~CANHUH;
+	    cur_game->player.t_flags &= ~CANHUH;
 	    endmsg();
-	    has_hit = false;
+	    cur_game->has_hit = false;
 	    msg("your hands stop glowing %s", pick_color("red").c_str());
 	}
 	if (tp->t_stats.s_hpt <= 0)
 	    killed(tp, true);
-	else if (did_hit && !on(player, ISBLIND))
+	else if (did_hit && !on(cur_game->player, ISBLIND))
 	    msg("%s appears confused", mname);
 	did_hit = true;
     }
     else
 	if (thrown)
-	    bounce(weap, mname, terse);
+	    bounce(weap, mname, cur_game->terse);
 	else
-	    miss(nullptr, mname, terse);
+	    miss(nullptr, mname, cur_game->terse);
     return did_hit;
 }
 
@@ -153,48 +152,49 @@ attack(THING *mp)
 {
     const char* mname;
     int oldhp;
+    rng_scope stream(RNG_COMBAT);
 
     /*
      * Since this is an attack, stop running and any healing that was
      * going on at the time.
      */
-    running = false;
-    count = 0;
-    quiet = 0;
-    if (to_death && !on(*mp, ISTARGET))
+    cur_game->running = false;
+    cur_game->count = 0;
+    cur_game->quiet = 0;
+    if (cur_game->to_death && !on(*mp, ISTARGET))
     {
-	to_death = false;
-	kamikaze = false;
+	cur_game->to_death = false;
+	cur_game->kamikaze = false;
     }
-    if (mp->t_type == 'X' && mp->t_disguise != 'X' && !on(player, ISBLIND))
+    if (mp->t_type == 'X' && mp->t_disguise != 'X' && !on(cur_game->player, ISBLIND))
     {
 	mp->t_disguise = 'X';
-	if (on(player, ISHALU))
-	    mvaddch(mp->t_pos.y, mp->t_pos.x, rnd(26) + 'A');
+	if (on(cur_game->player, ISHALU))
+	    cur_game->cw->mvaddch(mp->t_pos.y, mp->t_pos.x, rnd(26) + 'A');
     }
     mname = set_mname(mp);
     oldhp = pstats.s_hpt;
-    if (roll_em(mp, &player, nullptr, false))
+    if (roll_em(mp, &cur_game->player, nullptr, false))
     {
 	if (mp->t_type != 'I')
 	{
-	    if (has_hit)
+	    if (cur_game->has_hit)
 		addmsg(".  ");
 	    hit(mname, nullptr, false);
 	}
 	else
-	    if (has_hit)
+	    if (cur_game->has_hit)
 		endmsg();
-	has_hit = false;
+	cur_game->has_hit = false;
 	if (pstats.s_hpt <= 0)
 	    death(mp->t_type);	/* Bye bye life ... */
-	else if (!kamikaze)
+	else if (!cur_game->kamikaze)
 	{
 	    oldhp -= pstats.s_hpt;
-	    if (oldhp > max_hit)
-		max_hit = oldhp;
-	    if (pstats.s_hpt <= max_hit)
-		to_death = false;
+	    if (oldhp > cur_game->max_hit)
+		cur_game->max_hit = oldhp;
+	    if (pstats.s_hpt <= cur_game->max_hit)
+		cur_game->to_death = false;
 	}
 	if (!on(*mp, ISCANC))
 	    switch (mp->t_type)
@@ -203,21 +203,21 @@ attack(THING *mp)
 		    /*
 		     * If an aquator hits, you can lose armor class.
 		     */
-		    rust_armor(cur_armor);
+		    rust_armor(cur_game->cur_armor);
 		when 'I':
 		    /*
 		     * The ice monster freezes you
 		     */
-		    player.t_flags &= ~ISRUN;
-		    if (!no_command)
+		    cur_game->player.t_flags &= ~ISRUN;
+		    if (!cur_game->no_command)
 		    {
 			addmsg("you are frozen");
-			if (!terse)
+			if (!cur_game->terse)
 			    addmsg(" by the %s", mname);
 			endmsg();
 		    }
-		    no_command += rnd(2) + 2;
-		    if (no_command > BORE_LEVEL)
+		    cur_game->no_command += rnd(2) + 2;
+		    if (cur_game->no_command > BORE_LEVEL)
 			death('h');
 		when 'R':
 		    /*
@@ -228,14 +228,14 @@ attack(THING *mp)
 			if (!ISWEARING(R_SUSTSTR))
 			{
 			    chg_str(-1);
-			    if (!terse)
+			    if (!cur_game->terse)
 				msg("you feel a bite in your leg and now feel weaker");
 			    else
 				msg("a bite has weakened you");
 			}
-			else if (!to_death)
+			else if (!cur_game->to_death)
 			{
-			    if (!terse)
+			    if (!cur_game->terse)
 				msg("a bite momentarily weakens you");
 			    else
 				msg("bite has no effect");
@@ -278,8 +278,8 @@ attack(THING *mp)
 		    /*
 		     * Venus Flytrap stops the poor guy from moving
 		     */
-		    player.t_flags |= ISHELD;
-		    sprintf(monsters['F'-'A'].m_stats.s_dmg,"%dx1", ++vf_hit);
+		    cur_game->player.t_flags |= ISHELD;
+		    sprintf(cur_game->monsters['F'-'A'].m_stats.s_dmg,"%dx1", ++cur_game->vf_hit);
 		    if (--pstats.s_hpt <= 0)
 			death('F');
 		when 'L':
@@ -289,15 +289,15 @@ attack(THING *mp)
 		     */
 		    int lastpurse;
 
-		    lastpurse = purse;
-		    purse -= GOLDCALC;
+		    lastpurse = cur_game->purse;
+		    cur_game->purse -= GOLDCALC;
 		    if (!save(VS_MAGIC))
-			purse -= GOLDCALC + GOLDCALC + GOLDCALC + GOLDCALC;
-		    if (purse < 0)
-			purse = 0;
+			cur_game->purse -= GOLDCALC + GOLDCALC + GOLDCALC + GOLDCALC;
+		    if (cur_game->purse < 0)
+			cur_game->purse = 0;
 		    remove_mon(&mp->t_pos, mp, false);
                     mp=nullptr;
-		    if (purse != lastpurse)
+		    if (cur_game->purse != lastpurse)
 			msg("your purse feels lighter");
 		}
 		when 'N':
@@ -311,15 +311,15 @@ attack(THING *mp)
 		     */
 		    steal = nullptr;
 		    for (nobj = 0, obj = pack; obj != nullptr; obj = next(obj))
-			if (obj != cur_armor && obj != cur_weapon
-			    && obj != cur_ring[LEFT] && obj != cur_ring[RIGHT]
+			if (obj != cur_game->cur_armor && obj != cur_game->cur_weapon
+			    && obj != cur_game->cur_ring[LEFT] && obj != cur_game->cur_ring[RIGHT]
 			    && is_magic(obj) && rnd(++nobj) == 0)
 				steal = obj;
 		    if (steal != nullptr)
 		    {
 			remove_mon(&mp->t_pos, moat(mp->t_pos.y, mp->t_pos.x), false);
                         mp=nullptr;
-			leave_pack(steal, false, false);
+			steal = leave_pack(steal, true, false);
 			msg("she stole %s!", inv_name(steal, true));
 			discard(steal);
 		    }
@@ -330,22 +330,22 @@ attack(THING *mp)
     }
     else if (mp->t_type != 'I')
     {
-	if (has_hit)
+	if (cur_game->has_hit)
 	{
 	    addmsg(".  ");
-	    has_hit = false;
+	    cur_game->has_hit = false;
 	}
 	if (mp->t_type == 'F')
 	{
-	    pstats.s_hpt -= vf_hit;
+	    pstats.s_hpt -= cur_game->vf_hit;
 	    if (pstats.s_hpt <= 0)
 		death(mp->t_type);	/* Bye bye life ... */
 	}
 	miss(mname, nullptr, false);
     }
-    if (fight_flush && !to_death)
+    if (cur_game->fight_flush && !cur_game->to_death)
 	flush_type();
-    count = 0;
+    cur_game->count = 0;
     status();
     if (mp == nullptr)
         return(-1);
@@ -362,22 +362,22 @@ set_mname(THING *tp)
 {
     int ch;
     const char* mname;
-    static char tbuf[MAXSTR] = { 't', 'h', 'e', ' ' };
+    static thread_local char tbuf[MAXSTR] = { 't', 'h', 'e', ' ' };
 
-    if (!see_monst(tp) && !on(player, SEEMONST))
-	return (terse ? "it" : "something");
-    else if (on(player, ISHALU))
+    if (!see_monst(tp) && !on(cur_game->player, SEEMONST))
+	return (cur_game->terse ? "it" : "something");
+    else if (on(cur_game->player, ISHALU))
     {
-	move(tp->t_pos.y, tp->t_pos.x);
-	ch = toascii(inch());
+	cur_game->cw->move(tp->t_pos.y, tp->t_pos.x);
+	ch = toascii(cur_game->cw->inch());
 	if (!isupper(ch))
 	    ch = rnd(26);
 	else
 	    ch -= 'A';
-	mname = monsters[ch].m_name;
+	mname = cur_game->monsters[ch].m_name;
     }
     else
-	mname = monsters[tp->t_type - 'A'].m_name;
+	mname = cur_game->monsters[tp->t_type - 'A'].m_name;
     strcpy(&tbuf[4], mname);
     return tbuf;
 }
@@ -422,26 +422,26 @@ roll_em(THING *thatt, THING *thdef, THING *weap, bool hurl)
     {
 	hplus = (weap == nullptr ? 0 : weap->o_hplus);
 	dplus = (weap == nullptr ? 0 : weap->o_dplus);
-	if (weap == cur_weapon)
+	if (weap == cur_game->cur_weapon)
 	{
 	    if (ISRING(LEFT, R_ADDDAM))
-		dplus += cur_ring[LEFT]->o_arm;
+		dplus += cur_game->cur_ring[LEFT]->o_arm;
 	    else if (ISRING(LEFT, R_ADDHIT))
-		hplus += cur_ring[LEFT]->o_arm;
+		hplus += cur_game->cur_ring[LEFT]->o_arm;
 	    if (ISRING(RIGHT, R_ADDDAM))
-		dplus += cur_ring[RIGHT]->o_arm;
+		dplus += cur_game->cur_ring[RIGHT]->o_arm;
 	    else if (ISRING(RIGHT, R_ADDHIT))
-		hplus += cur_ring[RIGHT]->o_arm;
+		hplus += cur_game->cur_ring[RIGHT]->o_arm;
 	}
 	cp = weap->o_damage;
 	if (hurl)
 	{
-	    if ((weap->o_flags&ISMISL) && cur_weapon != nullptr &&
-	      cur_weapon->o_which == weap->o_launch)
+	    if ((weap->o_flags&ISMISL) && cur_game->cur_weapon != nullptr &&
+	      cur_game->cur_weapon->o_which == weap->o_launch)
 	    {
 		cp = weap->o_hurldmg;
-		hplus += cur_weapon->o_hplus;
-		dplus += cur_weapon->o_dplus;
+		hplus += cur_game->cur_weapon->o_hplus;
+		dplus += cur_game->cur_weapon->o_dplus;
 	    }
 	    else if (weap->o_launch < 0)
 		cp = weap->o_hurldmg;
@@ -456,12 +456,12 @@ roll_em(THING *thatt, THING *thdef, THING *weap, bool hurl)
     def_arm = def->s_arm;
     if (def == &pstats)
     {
-	if (cur_armor != nullptr)
-	    def_arm = cur_armor->o_arm;
+	if (cur_game->cur_armor != nullptr)
+	    def_arm = cur_game->cur_armor->o_arm;
 	if (ISRING(LEFT, R_PROTECT))
-	    def_arm -= cur_ring[LEFT]->o_arm;
+	    def_arm -= cur_game->cur_ring[LEFT]->o_arm;
 	if (ISRING(RIGHT, R_PROTECT))
-	    def_arm -= cur_ring[RIGHT]->o_arm;
+	    def_arm -= cur_game->cur_ring[RIGHT]->o_arm;
     }
     while(cp != nullptr && *cp != '\0')
     {
@@ -496,7 +496,7 @@ roll_em(THING *thatt, THING *thdef, THING *weap, bool hurl)
 static const char*
 prname(const char* mname, bool upper)
 {
-    static char tbuf[MAXSTR];
+    static thread_local char tbuf[MAXSTR];
 
     *tbuf = '\0';
     if (mname == nullptr)
@@ -520,10 +520,10 @@ prname(const char* mname, bool upper)
 static void
 thunk(THING* weap, const char* mname, bool noend)
 {
-    if (to_death)
+    if (cur_game->to_death)
 	return;
     if (weap->o_type == WEAPON)
-	addmsg("the %s hits ", weap_info[weap->o_which].oi_name);
+	addmsg("the %s hits ", cur_game->weap_info[weap->o_which].oi_name);
     else
 	addmsg("you hit ");
     addmsg("%s", mname);
@@ -541,10 +541,10 @@ hit(const char* er, const char* ee, bool noend)
     int i;
     const char* s;
 
-    if (to_death)
+    if (cur_game->to_death)
 	return;
     addmsg(prname(er, true));
-    if (terse)
+    if (cur_game->terse)
 	s = " hit";
     else
     {
@@ -554,7 +554,7 @@ hit(const char* er, const char* ee, bool noend)
 	s = h_names[i];
     }
     addmsg(s);
-    if (!terse)
+    if (!cur_game->terse)
 	addmsg(prname(ee, false));
     if (!noend)
 	endmsg();
@@ -569,17 +569,17 @@ miss(const char* er, const char* ee, bool noend)
 {
     int i;
 
-    if (to_death)
+    if (cur_game->to_death)
 	return;
     addmsg(prname(er, true));
-    if (terse)
+    if (cur_game->terse)
 	i = 0;
     else
 	i = rnd(4);
     if (er != nullptr)
 	i += 4;
     addmsg(m_names[i]);
-    if (!terse)
+    if (!cur_game->terse)
 	addmsg(" %s", prname(ee, false));
     if (!noend)
 	endmsg();
@@ -592,10 +592,10 @@ miss(const char* er, const char* ee, bool noend)
 static void
 bounce(THING* weap, const char* mname, bool noend)
 {
-    if (to_death)
+    if (cur_game->to_death)
 	return;
     if (weap->o_type == WEAPON)
-	addmsg("the %s misses ", weap_info[weap->o_which].oi_name);
+	addmsg("the %s misses ", cur_game->weap_info[weap->o_which].oi_name);
     else
 	addmsg("you missed ");
     addmsg(mname);
@@ -623,13 +623,13 @@ remove_mon(coord *mp, THING *tp, bool waskill)
 	    discard(obj);
     }
     moat(mp->y, mp->x) = nullptr;
-    mvaddch(mp->y, mp->x, tp->t_oldch);
-    detach(mlist, tp);
+    cur_game->cw->mvaddch(mp->y, mp->x, tp->t_oldch);
+    detach(cur_game->mlist, tp);
     if (on(*tp, ISTARGET))
     {
-	kamikaze = false;
-	to_death = false;
-	if (fight_flush)
+	cur_game->kamikaze = false;
+	cur_game->to_death = false;
+	if (cur_game->fight_flush)
 	    flush_type();
     }
     discard(tp);
@@ -652,14 +652,14 @@ killed(THING *tp, bool pr)
     switch (tp->t_type)
     {
 	case 'F':
-	    player.t_flags &= ~ISHELD;
-	    vf_hit = 0;
-	    strcpy(monsters['F'-'A'].m_stats.s_dmg, "000x0");
+	    cur_game->player.t_flags &= ~ISHELD;
+	    cur_game->vf_hit = 0;
+	    strcpy(cur_game->monsters['F'-'A'].m_stats.s_dmg, "000x0");
 	when 'L':
 	{
 	    THING *gold;
 
-	    if (fallpos(&tp->t_pos, &tp->t_room->r_gold) && level >= max_level)
+	    if (fallpos(&tp->t_pos, &tp->t_room->r_gold) && cur_game->level >= cur_game->max_level)
 	    {
 		gold = new_item();
 		gold->o_type = GOLD;
@@ -678,14 +678,14 @@ killed(THING *tp, bool pr)
     remove_mon(&tp->t_pos, tp, true);
     if (pr)
     {
-	if (has_hit)
+	if (cur_game->has_hit)
 	{
 	    addmsg(".  Defeated ");
-	    has_hit = false;
+	    cur_game->has_hit = false;
 	}
 	else
 	{
-	    if (!terse)
+	    if (!cur_game->terse)
 		addmsg("you have ");
 	    addmsg("defeated ");
 	}
@@ -695,6 +695,6 @@ killed(THING *tp, bool pr)
      * Do adjustments if he went up a level
      */
     check_level();
-    if (fight_flush)
+    if (cur_game->fight_flush)
 	flush_type();
 }
@@ -0,0 +1,296 @@
+/*
+ * Game loop and process control
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ *
+ * @(#)main.c	4.22 (Berkeley) 02/05/99
+ */
+
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include <roguepp/roguepp.hpp>
+
+/*
+ * endit:
+ *	Exit the program abnormally.
+ */
+
+void
+endit(int sig)
+{
+    NOOP(sig);
+    fatal("Okay, bye bye!\n");
+}
+
+/*
+ * fatal:
+ *	Exit the program, printing a message.
+ */
+void
+fatal(const std::string& message)
+{
+    cur_game->cw->mvaddstr(cur_game->display->lines() - 2, 0, message.c_str());
+    cur_game->cw->refresh();
+    cur_game->display->end();
+    my_exit(0);
+}
+
+/*
+ * rnd:
+ *	Pick a very random number from the current stream.
+ */
+int
+rnd(int range)
+{
+    if (range == 0)
+	return 0;
+    return static_cast<int>(cur_game->rng[cur_game->rng_cur].below(
+	static_cast<std::uint32_t>(std::abs(range))));
+}
+
+/*
+ * srnd:
+ *	Seed the random number streams of the game
+ */
+void
+srnd(int seed)
+{
+    cur_game->seed = seed;
+    for (std::size_t i = 0; i < cur_game->rng.size(); i++)
+	cur_game->rng[i].reset(static_cast<std::uint64_t>(static_cast<std::uint32_t>(seed)) << 8 | i);
+}
+
+/*
+ * roll:
+ *	Roll a number of dice
+ */
+int
+roll(int number, int sides)
+{
+    int dtotal = 0;
+
+    while (number--)
+	dtotal += rnd(sides)+1;
+    return dtotal;
+}
+
+/*
+ * init_game:
+ *	Set up the tables and the player for a new game
+ */
+
+void
+init_game()
+{
+    init_probs();			/* Set up prob tables for objects */
+    init_player();			/* Set up initial player stats */
+    init_names();			/* Set up names of scrolls */
+    init_colors();			/* Set up colors of potions */
+    init_stones();			/* Set up stone settings of rings */
+    init_materials();			/* Set up materials of wands */
+}
+
+/*
+ * start_game:
+ *	Draw the first level and start up the daemons and fuses
+ */
+
+void
+start_game()
+{
+    new_level();			/* Draw current level */
+    start_daemon(runners, 0, AFTER);
+    start_daemon(doctor, 0, AFTER);
+    fuse(swander, 0, WANDERTIME, AFTER);
+    start_daemon(stomach, 0, AFTER);
+}
+
+/*
+ * tstp:
+ *	Handle stop and start signals
+ */
+
+void
+tstp(int)
+{
+    /*
+     * leave nicely
+     */
+    cur_game->display->suspend();
+    resetltchars();
+    std::fflush(stdout);
+    md_tstpsignal();
+
+    /*
+     * start back up again
+     */
+    md_tstpresume();
+    playltchars();
+    cur_game->display->resume();
+}
+
+/*
+ * playit:
+ *	The main loop of the program.  Loop until the game is over,
+ *	refreshing things and looking at the proper times.
+ */
+
+void
+playit()
+{
+    char *opts;
+
+    /*
+     * set up defaults for slow terminals
+     */
+
+    if (cur_game->display->slow())
+    {
+	cur_game->terse = true;
+	cur_game->jump = true;
+	cur_game->see_floor = false;
+    }
+
+    if (cur_game->display->has_clreol())
+	cur_game->inv_type = INV_CLEAR;
+
+    /*
+     * parse environment declaration of options
+     */
+    if ((opts = std::getenv("ROGUEOPTS")) != nullptr)
+	parse_opts(opts);
+
+
+    cur_game->oldpos = hero;
+    cur_game->oldrp = roomin(&hero);
+    while (cur_game->playing)
+	command();			/* Command execution */
+    endit(0);
+}
+
+/*
+ * quit:
+ *	Have player make certain, then exit.
+ */
+
+void
+quit(int sig)
+{
+    int oy, ox;
+
+    NOOP(sig);
+
+    /*
+     * Reset the signal in case we got here via an interrupt
+     */
+    if (!cur_game->q_comm)
+	cur_game->mpos = 0;
+    cur_game->cw->getyx(oy, ox);
+    msg("really quit?");
+    if (readchar() == 'y')
+    {
+	signal(SIGINT, leave);
+	cur_game->cw->clear();
+	cur_game->cw->mvprintw(cur_game->display->lines() - 2, 0, "You quit with %d gold pieces", cur_game->purse);
+	cur_game->cw->move(cur_game->display->lines() - 1, 0);
+	cur_game->cw->refresh();
+	score(cur_game->purse, 1, 0);
+	my_exit(0);
+    }
+    else
+    {
+	cur_game->cw->move(0, 0);
+	cur_game->cw->clrtoeol();
+	status();
+	cur_game->cw->move(oy, ox);
+	cur_game->cw->refresh();
+	cur_game->mpos = 0;
+	cur_game->count = 0;
+	cur_game->to_death = false;
+    }
+}
+
+/*
+ * leave:
+ *	Leave quickly, but curteously
+ */
+
+void
+leave(int sig)
+{
+    static char buf[BUFSIZ];
+
+    NOOP(sig);
+
+    setbuf(stdout, buf);	/* throw away pending output */
+
+    if (cur_game != nullptr && cur_game->display != nullptr
+	&& !cur_game->display->ended())
+	cur_game->display->end();
+
+    putchar('\n');
+    my_exit(0);
+}
+
+/*
+ * shell:
+ *	Let them escape for a while
+ */
+
+void
+shell()
+{
+    /*
+     * An embedded game has no terminal of its own to give up
+     */
+    if (cur_game->embedded)
+    {
+	cur_game->after = false;
+	msg("no shell escape here");
+	return;
+    }
+    /*
+     * Set the terminal back to original mode
+     */
+    cur_game->display->suspend();
+    resetltchars();
+    putchar('\n');
+    in_shell = true;
+    cur_game->after = false;
+    fflush(stdout);
+    /*
+     * Fork and do a shell
+     */
+    md_shellescape();
+
+    printf("\n[Press return to continue]");
+    fflush(stdout);
+    cur_game->display->resume();
+    playltchars();
+    in_shell = false;
+    wait_for('\n');
+    cur_game->display->redraw();
+}
+
+/*
+ * my_exit:
+ *	Leave the process properly, or just the game if it is embedded
+ *	in another program
+ */
+
+void
+my_exit(int st)
+{
+    if (cur_game != nullptr && cur_game->embedded)
+	throw game_over{st};
+    resetltchars();
+    exit(st);
+}
+
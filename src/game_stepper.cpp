@@ -0,0 +1,233 @@
+/*
+ * Playing a game by handing it keys, one step at a time
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include <roguepp/game_stepper.hpp>
+#include <roguepp/roguepp.hpp>
+
+#if defined(HAVE_UCONTEXT_H)
+#include <ucontext.h>
+
+/**
+ * The game's own stack, and where to switch to in either direction.
+ */
+struct game_stepper::context
+{
+    explicit context(std::size_t stack_size)
+        // Left uninitialised, so that only the part of the stack the
+        // game gets to use takes up memory.
+        : stack(new char[stack_size])
+        , size(stack_size)
+        , self()
+        , caller() {}
+
+    /** Where the game's stack starts out. */
+    static void launch();
+
+    std::unique_ptr<char[]> stack;
+    std::size_t size;
+    ucontext_t self;
+    ucontext_t caller;
+};
+
+/** Stepper whose game launch() is about to start. */
+static thread_local game_stepper* starting = nullptr;
+
+void
+game_stepper::resume()
+{
+    if (!m_started)
+    {
+        m_started = true;
+        getcontext(&m_context->self);
+        m_context->self.uc_stack.ss_sp = m_context->stack.get();
+        m_context->self.uc_stack.ss_size = m_context->size;
+        m_context->self.uc_link = &m_context->caller;
+        makecontext(&m_context->self, &context::launch, 0);
+        starting = this;
+    }
+    swapcontext(&m_context->caller, &m_context->self);
+}
+
+void
+game_stepper::yield()
+{
+    swapcontext(&m_context->self, &m_context->caller);
+}
+
+void
+game_stepper::context::launch()
+{
+    game_stepper* const stepper = starting;
+
+    starting = nullptr;
+    stepper->run();
+}
+#else
+/**
+ * Without coroutines the game gets a thread of its own, and it and the
+ * caller hand the turn to each other.
+ */
+struct game_stepper::context
+{
+    explicit context(std::size_t)
+        : game_turn(false) {}
+
+    ~context()
+    {
+        if (thread.joinable())
+        {
+            thread.join();
+        }
+    }
+
+    std::thread thread;
+    std::mutex lock;
+    std::condition_variable turn;
+    bool game_turn;
+};
+
+void
+game_stepper::resume()
+{
+    std::unique_lock<std::mutex> hold(m_context->lock);
+
+    m_context->game_turn = true;
+    if (!m_started)
+    {
+        m_started = true;
+        m_context->thread = std::thread(&game_stepper::run, this);
+    } else {
+        m_context->turn.notify_all();
+    }
+    m_context->turn.wait(hold, [this] { return !m_context->game_turn; });
+}
+
+void
+game_stepper::yield()
+{
+    std::unique_lock<std::mutex> hold(m_context->lock);
+
+    m_context->game_turn = false;
+    m_context->turn.notify_all();
+    m_context->turn.wait(hold, [this] { return m_context->game_turn; });
+}
+#endif
+
+game_stepper::game_stepper(game& g, std::function<void()> play, std::size_t stack_size)
+    : m_game(g)
+    , m_play(std::move(play))
+    , m_context(std::make_unique<context>(stack_size))
+    , m_started(false)
+    , m_hungup(false)
+    , m_over(false) {}
+
+game_stepper::~game_stepper()
+{
+    try
+    {
+        end();
+    }
+    catch (...) {}
+}
+
+bool
+game_stepper::step()
+{
+    game* const saved = cur_game;
+
+    if (m_over)
+    {
+        return false;
+    }
+    if (!m_started && m_hungup)
+    {
+        // Never got going; nothing to unwind.
+        m_over = true;
+        return false;
+    }
+    if (m_started && m_keys.empty() && !m_hungup)
+    {
+        // Still waiting for a key.
+        return true;
+    }
+    cur_game = &m_game;
+    resume();
+    cur_game = saved;
+    if (m_error)
+    {
+        std::rethrow_exception(std::exchange(m_error, nullptr));
+    }
+
+    return !m_over;
+}
+
+void
+game_stepper::end()
+{
+    hangup();
+    while (step())
+    {
+    }
+}
+
+int
+game_stepper::take(bool wait)
+{
+    int key;
+
+    while (m_keys.empty())
+    {
+        if (m_hungup)
+        {
+            throw game_over{0};
+        }
+        if (!wait)
+        {
+            return -1;
+        }
+        yield();
+    }
+    key = m_keys.front();
+    m_keys.pop_front();
+
+    return key;
+}
+
+/**
+ * Play the game on its own stack, until it is over.
+ */
+void
+game_stepper::run()
+{
+#if !defined(HAVE_UCONTEXT_H)
+    cur_game = &m_game;
+#endif
+    try
+    {
+        m_play();
+    }
+    catch (const game_over&) {}
+    catch (...)
+    {
+        m_error = std::current_exception();
+    }
+    m_over = true;
+#if !defined(HAVE_UCONTEXT_H)
+    std::lock_guard<std::mutex> hold(m_context->lock);
+
+    m_context->game_turn = false;
+    m_context->turn.notify_all();
+#endif
+}
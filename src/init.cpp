@@ -14,8 +14,6 @@
 #include <cstdlib>
 #include <cstring>
 
-#include <ncurses.h>
-
 #include <roguepp/roguepp.hpp>
 
 /*
@@ -27,40 +25,40 @@ init_player()
 {
     THING *obj;
 
-    pstats = max_stats;
-    food_left = HUNGERTIME;
+    pstats = cur_game->max_stats;
+    cur_game->food_left = HUNGERTIME;
     /*
      * Give him some food
      */
-    obj = new_item();
+    obj = new_pack_item();
     obj->o_type = FOOD;
     obj->o_count = 1;
     add_pack(obj, true);
     /*
      * And his suit of armor
      */
-    obj = new_item();
+    obj = new_pack_item();
     obj->o_type = ARMOR;
     obj->o_which = RING_MAIL;
     obj->o_arm = a_class[RING_MAIL] - 1;
     obj->o_flags |= ISKNOW;
     obj->o_count = 1;
-    cur_armor = obj;
+    cur_game->cur_armor = obj;
     add_pack(obj, true);
     /*
      * Give him his weaponry.  First a mace.
      */
-    obj = new_item();
+    obj = new_pack_item();
     init_weapon(obj, MACE);
     obj->o_hplus = 1;
     obj->o_dplus = 1;
     obj->o_flags |= ISKNOW;
     add_pack(obj, true);
-    cur_weapon = obj;
+    cur_game->cur_weapon = obj;
     /*
      * Now a +1 bow
      */
-    obj = new_item();
+    obj = new_pack_item();
     init_weapon(obj, BOW);
     obj->o_hplus = 1;
     obj->o_flags |= ISKNOW;
@@ -68,7 +66,7 @@ init_player()
     /*
      * Now some arrows
      */
-    obj = new_item();
+    obj = new_pack_item();
     init_weapon(obj, ARROW);
     obj->o_count = rnd(15) + 25;
     obj->o_flags |= ISKNOW;
@@ -225,7 +223,7 @@ const std::array<std::string, NMETAL> metal =
 
 #define MAX3(a,b,c)	(a > b ? (a > c ? a : c) : (b > c ? b : c))
 
-static bool used[MAX3(NCOLORS, NSTONES, NWOOD)];
+static thread_local bool used[MAX3(NCOLORS, NSTONES, NWOOD)];
 
 /*
  * init_colors:
@@ -244,7 +242,7 @@ init_colors()
 	    j = rnd(NCOLORS);
 	until (!used[j]);
 	used[j] = true;
-	p_colors[i] = rainbow[j];
+	cur_game->p_colors[i] = rainbow[j];
     }
 }
 
@@ -260,7 +258,7 @@ init_names()
 {
     for (std::size_t i = 0; i < MAXSCROLLS; ++i)
     {
-        auto* cp = prbuf;
+        auto* cp = cur_game->prbuf;
         int nwords = rnd(3) + 2;
 
         while (nwords--)
@@ -271,7 +269,7 @@ init_names()
             {
                 const auto* sp = sylls[rnd((sizeof sylls) / (sizeof (char*)))];
 
-                if (&cp[std::strlen(sp)] > &prbuf[MAXNAME])
+                if (&cp[std::strlen(sp)] > &cur_game->prbuf[MAXNAME])
                 {
                     break;
                 }
@@ -283,7 +281,7 @@ init_names()
             *cp++ = ' ';
         }
         *--cp = 0;
-        s_names[i] = prbuf;
+        cur_game->s_names[i] = cur_game->prbuf;
     }
 }
 
@@ -304,8 +302,8 @@ init_stones()
 	    j = rnd(NSTONES);
 	until (!used[j]);
 	used[j] = true;
-	r_stones[i] = stones[j].st_name;
-	ring_info[i].oi_worth += stones[j].st_value;
+	cur_game->r_stones[i] = stones[j].st_name;
+	cur_game->ring_info[i].oi_worth += stones[j].st_value;
     }
 }
 
@@ -316,7 +314,7 @@ init_stones()
 void
 init_materials()
 {
-    static std::array<bool, NMETAL> metused;
+    static thread_local std::array<bool, NMETAL> metused;
 
     for (std::size_t i = 0; i < NWOOD; ++i)
     {
@@ -338,7 +336,7 @@ init_materials()
 
                 if (!metused[j])
                 {
-                    ws_type[i] = "wand";
+                    cur_game->ws_type[i] = "wand";
                     str = metal[j];
                     metused[j] = true;
                     break;
@@ -348,14 +346,14 @@ init_materials()
 
                 if (!used[j])
                 {
-                    ws_type[i] = "staff";
+                    cur_game->ws_type[i] = "staff";
                     str = wood[j];
                     used[j] = true;
                     break;
                 }
             }
         }
-        ws_made[i] = str;
+        cur_game->ws_made[i] = str;
     }
 }
 
@@ -408,13 +406,13 @@ sumprobs(struct obj_info *info, int bound
 void
 init_probs()
 {
-    sumprobs(things, NT);
-    sumprobs(pot_info, MP);
-    sumprobs(scr_info, MS);
-    sumprobs(ring_info, MR);
-    sumprobs(ws_info, MWS);
-    sumprobs(weap_info, MW);
-    sumprobs(arm_info, MA);
+    sumprobs(cur_game->things, NT);
+    sumprobs(cur_game->pot_info, MP);
+    sumprobs(cur_game->scr_info, MS);
+    sumprobs(cur_game->ring_info, MR);
+    sumprobs(cur_game->ws_info, MWS);
+    sumprobs(cur_game->weap_info, MW);
+    sumprobs(cur_game->arm_info, MA);
 }
 
 #ifdef MASTER
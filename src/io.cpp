@@ -10,19 +10,12 @@
 #include <cstdio>
 #include <cstring>
 
-#include <ncurses.h>
-
 #include <roguepp/roguepp.hpp>
 
 /*
  * msg:
  *	Display a message at the top of the screen.
  */
-#define MAXMSG	(NUMCOLS - sizeof "--More--")
-
-static char msgbuf[2*MAXMSG+1];
-static int newpos = 0;
-
 static void doadd(const char*, std::va_list);
 
 /* VARARGS1 */
@@ -36,9 +29,9 @@ msg(const char* fmt, ...)
      */
     if (*fmt == '\0')
     {
-        move(0, 0);
-        clrtoeol();
-        mpos = 0;
+        cur_game->cw->move(0, 0);
+        cur_game->cw->clrtoeol();
+        cur_game->mpos = 0;
 
         return ~ESCAPE;
     }
@@ -78,24 +71,24 @@ endmsg()
 {
     char ch;
 
-    if (save_msg)
-	strcpy(huh, msgbuf);
-    if (mpos)
+    if (cur_game->save_msg)
+	strcpy(cur_game->huh, cur_game->msgbuf);
+    if (cur_game->mpos)
     {
 	look(false);
-	mvaddstr(0, mpos, "--More--");
-	refresh();
-	if (!msg_esc)
+	cur_game->cw->mvaddstr(0, cur_game->mpos, "--More--");
+	cur_game->cw->refresh();
+	if (!cur_game->msg_esc)
 	    wait_for(' ');
 	else
 	{
 	    while ((ch = readchar()) != ' ')
 		if (ch == ESCAPE)
 		{
-		    msgbuf[0] = '\0';
-		    mpos = 0;
-		    newpos = 0;
-		    msgbuf[0] = '\0';
+		    cur_game->msgbuf[0] = '\0';
+		    cur_game->mpos = 0;
+		    cur_game->newpos = 0;
+		    cur_game->msgbuf[0] = '\0';
 		    return ESCAPE;
 		}
 	}
@@ -104,14 +97,14 @@ endmsg()
      * All messages should start with uppercase, except ones that
      * start with a pack addressing character
      */
-    if (islower(msgbuf[0]) && !lower_msg && msgbuf[1] != ')')
-	msgbuf[0] = (char) toupper(msgbuf[0]);
-    mvaddstr(0, 0, msgbuf);
-    clrtoeol();
-    mpos = newpos;
-    newpos = 0;
-    msgbuf[0] = '\0';
-    refresh();
+    if (islower(cur_game->msgbuf[0]) && !cur_game->lower_msg && cur_game->msgbuf[1] != ')')
+	cur_game->msgbuf[0] = (char) toupper(cur_game->msgbuf[0]);
+    cur_game->cw->mvaddstr(0, 0, cur_game->msgbuf);
+    cur_game->cw->clrtoeol();
+    cur_game->mpos = cur_game->newpos;
+    cur_game->newpos = 0;
+    cur_game->msgbuf[0] = '\0';
+    cur_game->cw->refresh();
     return ~ESCAPE;
 }
 
@@ -122,18 +115,18 @@ endmsg()
 static void
 doadd(const char* fmt, std::va_list args)
 {
-    static char buf[MAXSTR];
+    char buf[MAXSTR];
 
     /*
      * Do the printf into buf
      */
     std::vsprintf(buf, fmt, args);
-    if (std::strlen(buf) + newpos >= MAXMSG)
+    if (std::strlen(buf) + cur_game->newpos >= MAXMSG)
     {
         endmsg();
     }
-    std::strcat(msgbuf, buf);
-    newpos = static_cast<int>(std::strlen(msgbuf));
+    std::strcat(cur_game->msgbuf, buf);
+    cur_game->newpos = static_cast<int>(std::strlen(cur_game->msgbuf));
 }
 
 /*
@@ -163,7 +156,9 @@ readchar()
 {
     char ch;
 
-    ch = (char) md_readchar();
+    if (cur_game->cw_shadow)
+	cur_game->cw_shadow->flush();
+    ch = (char) cur_game->display->readchar();
 
     if (ch == 3)
     {
@@ -189,68 +184,60 @@ status()
         "Faint",
     }};
     int oy, ox, temp;
-    static int hpwidth = 0;
-    static int s_hungry = 0;
-    static int s_lvl = 0;
-    static int s_pur = -1;
-    static int s_hp = 0;
-    static int s_arm = 0;
-    static stats::str_t s_str = 0;
-    static int s_exp = 0;
 
     /*
      * If nothing has changed since the last status, don't
      * bother.
      */
-    temp = (cur_armor != nullptr ? cur_armor->o_arm : pstats.s_arm);
-    if (s_hp == pstats.s_hpt && s_exp == pstats.s_exp && s_pur == purse
-	&& s_arm == temp && s_str == pstats.s_str && s_lvl == level
-	&& s_hungry == hungry_state
-	&& !stat_msg
+    temp = (cur_game->cur_armor != nullptr ? cur_game->cur_armor->o_arm : pstats.s_arm);
+    if (cur_game->s_hp == pstats.s_hpt && cur_game->s_exp == pstats.s_exp && cur_game->s_pur == cur_game->purse
+	&& cur_game->s_arm == temp && cur_game->s_str == pstats.s_str && cur_game->s_lvl == cur_game->level
+	&& cur_game->s_hungry == cur_game->hungry_state
+	&& !cur_game->stat_msg
 	)
 	    return;
 
-    s_arm = temp;
+    cur_game->s_arm = temp;
 
-    getyx(stdscr, oy, ox);
-    if (s_hp != max_hp)
+    cur_game->cw->getyx(oy, ox);
+    if (cur_game->s_hp != max_hp)
     {
 	temp = max_hp;
-	s_hp = max_hp;
-	for (hpwidth = 0; temp; hpwidth++)
+	cur_game->s_hp = max_hp;
+	for (cur_game->hpwidth = 0; temp; cur_game->hpwidth++)
 	    temp /= 10;
     }
 
     /*
      * Save current status
      */
-    s_lvl = level;
-    s_pur = purse;
-    s_hp = pstats.s_hpt;
-    s_str = pstats.s_str;
-    s_exp = pstats.s_exp;
-    s_hungry = hungry_state;
-
-    if (stat_msg)
+    cur_game->s_lvl = cur_game->level;
+    cur_game->s_pur = cur_game->purse;
+    cur_game->s_hp = pstats.s_hpt;
+    cur_game->s_str = pstats.s_str;
+    cur_game->s_exp = pstats.s_exp;
+    cur_game->s_hungry = cur_game->hungry_state;
+
+    if (cur_game->stat_msg)
     {
-	move(0, 0);
+	cur_game->cw->move(0, 0);
         msg("Level: %d  Gold: %-5d  Hp: %*d(%*d)  Str: %2d(%d)  Arm: %-2d  Exp: %d/%ld  %s",
-	    level, purse, hpwidth, pstats.s_hpt, hpwidth, max_hp, pstats.s_str,
-	    max_stats.s_str, 10 - s_arm, pstats.s_lvl, pstats.s_exp,
-	    state_name[hungry_state]);
+	    cur_game->level, cur_game->purse, cur_game->hpwidth, pstats.s_hpt, cur_game->hpwidth, max_hp, pstats.s_str,
+	    cur_game->max_stats.s_str, 10 - cur_game->s_arm, pstats.s_lvl, pstats.s_exp,
+	    state_name[cur_game->hungry_state]);
     }
     else
     {
-	move(STATLINE, 0);
+	cur_game->cw->move(STATLINE, 0);
 
-        printw("Level: %d  Gold: %-5d  Hp: %*d(%*d)  Str: %2d(%d)  Arm: %-2d  Exp: %d/%d  %s",
-	    level, purse, hpwidth, pstats.s_hpt, hpwidth, max_hp, pstats.s_str,
-	    max_stats.s_str, 10 - s_arm, pstats.s_lvl, pstats.s_exp,
-	    state_name[hungry_state]);
+        cur_game->cw->printw("Level: %d  Gold: %-5d  Hp: %*d(%*d)  Str: %2d(%d)  Arm: %-2d  Exp: %d/%d  %s",
+	    cur_game->level, cur_game->purse, cur_game->hpwidth, pstats.s_hpt, cur_game->hpwidth, max_hp, pstats.s_str,
+	    cur_game->max_stats.s_str, 10 - cur_game->s_arm, pstats.s_lvl, pstats.s_exp,
+	    state_name[cur_game->hungry_state]);
     }
 
-    clrtoeol();
-    move(oy, ox);
+    cur_game->cw->clrtoeol();
+    cur_game->cw->move(oy, ox);
 }
 
 /*
@@ -277,14 +264,82 @@ wait_for(int ch)
 void
 show_win(const std::string& message)
 {
-    auto win = hw;
+    auto win = cur_game->hw;
 
-    wmove(win, 0, 0);
-    waddstr(win, message.c_str());
-    touchwin(win);
-    wmove(win, hero.y, hero.x);
-    wrefresh(win);
+    win->move(0, 0);
+    win->addstr(message.c_str());
+    win->touch();
+    win->move(hero.y, hero.x);
+    win->refresh();
     wait_for(' ');
-    clearok(curscr, true);
-    touchwin(stdscr);
+    cur_game->display->redraw();
+    cur_game->cw->touch();
+}
+
+/*
+ * init_display:
+ *	Take over the terminal and set up the windows we draw on.  The
+ *	game draws on copies of them it can read back from.
+ */
+void
+init_display()
+{
+    cur_game->display->begin();
+    if (!cur_game->cw_shadow)
+    {
+	cur_game->cw_shadow = std::make_unique<shadow_canvas>(cur_game->display->screen());
+	cur_game->hw_shadow = std::make_unique<shadow_canvas>(cur_game->display->scratch());
+    }
+    cur_game->cw = cur_game->cw_shadow.get();
+    cur_game->hw = cur_game->hw_shadow.get();
+}
+
+/*
+ * unctrl:
+ *	Printable representation of a character
+ */
+const char*
+unctrl(int ch)
+{
+    static thread_local char buf[3];
+
+    ch &= 0x7f;
+    if (ch < ' ' || ch == 0x7f)
+    {
+        buf[0] = '^';
+        buf[1] = static_cast<char>(ch ^ 0x40);
+        buf[2] = '\0';
+    }
+    else
+    {
+        buf[0] = static_cast<char>(ch);
+        buf[1] = '\0';
+    }
+
+    return buf;
+}
+
+void
+canvas::printw(const char* fmt, ...)
+{
+    char buf[MAXSTR];
+    std::va_list args;
+
+    va_start(args, fmt);
+    std::vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    addstr(buf);
+}
+
+void
+canvas::mvprintw(int y, int x, const char* fmt, ...)
+{
+    char buf[MAXSTR];
+    std::va_list args;
+
+    move(y, x);
+    va_start(args, fmt);
+    std::vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    addstr(buf);
 }
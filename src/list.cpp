@@ -10,16 +10,8 @@
  * See the file LICENSE.TXT for full copyright and licensing information.
  */
 
-#include <cstdlib>
-
-#include <ncurses.h>
-
 #include <roguepp/roguepp.hpp>
 
-#ifdef MASTER
-int total = 0;			/* total dynamic memory bytes */
-#endif
-
 /*
  * detach:
  *	takes an item out of whatever linked list it might be in
@@ -28,6 +20,10 @@ int total = 0;			/* total dynamic memory bytes */
 void
 _detach(THING **list, THING *item)
 {
+    if (list == &cur_game->mlist)
+	cur_game->awake_stale = true;
+    if (list == &cur_game->lvl_obj && obat(item->o_pos.y, item->o_pos.x) == item)
+	obat(item->o_pos.y, item->o_pos.x) = nullptr;
     if (*list == item)
 	*list = next(item);
     if (prev(item) != nullptr)
@@ -40,7 +36,8 @@ _detach(THING **list, THING *item)
 
 /*
  * _attach:
- *	add an item to the head of a list
+ *	add an item to the head of a list.  Objects put on the level
+ *	list must already have their position set.
  */
 
 void
@@ -58,6 +55,10 @@ _attach(THING **list, THING *item)
 	item->l_prev = nullptr;
     }
     *list = item;
+    if (list == &cur_game->lvl_obj)
+	obat(item->o_pos.y, item->o_pos.x) = item;
+    else if (list == &cur_game->mlist)
+	cur_game->awake_stale = true;
 }
 
 /*
@@ -86,31 +87,76 @@ _free_list(THING **ptr)
 void
 discard(THING *item)
 {
-#ifdef MASTER
-    total--;
-#endif
-    free((char *) item);
+    if (cur_game->level_pool.owns(item))
+	cur_game->level_pool.release(item);
+    else
+	cur_game->item_pool.release(item);
 }
 
 /*
  * new_item
- *	Get a new item with a specified size
+ *	Get a new item that goes away with the current level
  */
 THING*
 new_item()
 {
-    THING* item = static_cast<THING*>(std::calloc(1, sizeof(THING)));
+    return cur_game->level_pool.allocate();
+}
 
-#if defined(MASTER)
-    if (!item)
-    {
-        msg("ran out of memory after %d items", total);
-    } else {
-        ++total;
-    }
-#endif
-    item->l_next = nullptr;
-    item->l_prev = nullptr;
+/*
+ * new_pack_item
+ *	Get a new item that is kept when the hero changes levels
+ */
+THING*
+new_pack_item()
+{
+    return cur_game->item_pool.allocate();
+}
 
-    return item;
+/*
+ * move_item:
+ *	Copy an item into another pool, taking its place in the list
+ *	it is on (if any).
+ */
+static THING *
+move_item(THING **list, THING *item, thing_pool& from, thing_pool& to)
+{
+    THING *copy;
+
+    copy = to.allocate();
+    *copy = *item;
+    if (prev(copy) != nullptr)
+	copy->l_prev->l_next = copy;
+    else if (list != nullptr)
+	*list = copy;
+    if (next(copy) != nullptr)
+	copy->l_next->l_prev = copy;
+    from.release(item);
+    return copy;
+}
+
+/*
+ * keep_item:
+ *	Make sure an item on the given list survives a level change.
+ *	Returns where the item lives now.
+ */
+THING *
+keep_item(THING **list, THING *item)
+{
+    if (!cur_game->level_pool.owns(item))
+	return item;
+    return move_item(list, item, cur_game->level_pool, cur_game->item_pool);
+}
+
+/*
+ * level_item:
+ *	Hand an item that is on no list over to the current level, so
+ *	it is thrown away with it.  Returns where the item lives now.
+ */
+THING *
+level_item(THING *item)
+{
+    if (cur_game->level_pool.owns(item))
+	return item;
+    return move_item(nullptr, item, cur_game->item_pool, cur_game->level_pool);
 }
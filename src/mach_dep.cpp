@@ -14,6 +14,10 @@
  * The various tuneable defines are:
  *
  *	SCOREFILE	Where/if the score file should live.
+ *	SCORESOCK	Where rogue++-scored listens, if it is to keep
+ *			the score file instead of each game.
+ *	SCORELOG	Where/if every game's score should be added to a
+ *			journal, as well as to the score file.
  *	ALLSCORES	Score file is top ten scores, not top ten
  *			players.  This is only useful when only a few
  *			people will be playing; otherwise the score file
@@ -21,6 +25,8 @@
  *	NUMSCORES	Number of scores in the score file (default 10).
  *	NUMNAME		String version of NUMSCORES (first character
  *			should be capitalized) (default "Ten").
+ *	LOCK_WAIT	Milliseconds to wait for someone else to finish
+ *			with the score file (default 5000).
  *	MAXLOAD		What (if any) the maximum load average should be
  *			when people are playing.  Since it is divided
  *			by 10, to specify a load limit of 4.0, MAXLOAD
@@ -48,9 +54,8 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 
-#include <ncurses.h>
-
 #include <roguepp/roguepp.hpp>
+#include <roguepp/score.hpp>
 
 #define NOOP(x) (x += 0)
 
@@ -59,6 +64,10 @@
 #	define	NUMNAME		"Ten"
 # endif
 
+# ifndef LOCK_WAIT
+#	define	LOCK_WAIT	5000
+# endif
+
 unsigned int numscores = NUMSCORES;
 const char* Numname = NUMNAME;
 
@@ -102,8 +111,30 @@ init_check()
 void
 open_score()
 {
+#ifdef SCORESOCK
+    /*
+     * When rogue++-scored keeps the score file, games leave it to it.
+     * It only lets in games that still have their group, so the one
+     * connection made now serves the whole game.  Such a game opens
+     * just the journal, to add to, and never the score file: if the
+     * keeper goes away before the game ends, the score waits in the
+     * journal for it to post.
+     */
+    if (score_keeper < 0)
+	score_keeper = score_client::connect(SCORESOCK);
+#endif
+#ifdef SCORELOG
+    if (score_log < 0 && (score_log = score_journal::open(SCORELOG, true)) < 0)
+    {
+	fprintf(stderr, "Could not open %s for writing: %s\n", SCORELOG, strerror(errno));
+	fflush(stderr);
+    }
+#endif
 #ifdef SCOREFILE
-    char *scorefile = SCOREFILE;
+    const char *scorefile = SCOREFILE;
+
+    if (score_keeper >= 0)
+	return;
      /*
       * We drop setgid privileges after opening the score file, so subsequent
       * open()'s will fail.  Just reuse the earlier filehandle.
@@ -154,9 +185,6 @@ setup()
     num_checks = 0;
 #endif
 
-    raw();				/* Raw mode */
-    noecho();				/* Echo off */
-    keypad(stdscr,1);
     getltchars();			/* get the local tty chars */
 }
 
@@ -368,69 +396,21 @@ ucount()
 }
 #endif
 
-#if defined(SCOREFILE) && defined(LOCKFILE)
-static FILE* lfd = nullptr;
-#endif
-
 /*
  * lock_sc:
- *	lock the score file.  If it takes too long, ask the user if
- *	they care to wait.  Return true if the lock is successful.
+ *	Lock the score file, for as long as LOCK_WAIT at most.  Return
+ *	true if the lock is successful.
  */
 bool
 lock_sc()
 {
-#if defined(SCOREFILE) && defined(LOCKFILE)
-    int cnt;
-    static struct stat sbuf;
-    char *lockfile = LOCKFILE;
-
-over:
-    if ((lfd=std::fopen(lockfile, "w+")) != nullptr)
+#ifdef SCOREFILE
+    if (scoreboard == nullptr)
 	return true;
-    for (cnt = 0; cnt < 5; cnt++)
-    {
-	md_sleep(1);
-	if ((lfd=std::fopen(lockfile, "w+")) != nullptr)
-	    return true;
-    }
-    if (stat(lockfile, &sbuf) < 0)
-    {
-	lfd=std::fopen(lockfile, "w+");
+    if (md_lockfile(scoreboard, LOCK_WAIT) == 0)
 	return true;
-    }
-    if (std::time(nullptr) - sbuf.st_mtime > 10)
-    {
-	if (md_unlink(lockfile) < 0)
-	    return false;
-	goto over;
-    }
-    else
-    {
-	printf("The score file is very busy.  Do you want to wait longer\n");
-	printf("for it to become free so your score can get posted?\n");
-	printf("If so, type \"y\"\n");
-	(void) fgets(prbuf, MAXSTR, stdin);
-	if (prbuf[0] == 'y')
-	    for (;;)
-	    {
-		if ((lfd=std::fopen(lockfile, "w+")) != 0)
-		    return true;
-		if (stat(lockfile, &sbuf) < 0)
-		{
-		    lfd=std::fopen(lockfile, "w+");
-		    return true;
-		}
-		if (std::time(nullptr) - sbuf.st_mtime > 10)
-		{
-		    if (md_unlink(lockfile) < 0)
-			return false;
-		}
-		md_sleep(1);
-	    }
-	else
-	    return false;
-    }
+    printf("The score file is too busy to post your score.\n");
+    return false;
 #else
     return true;
 #endif
@@ -444,11 +424,9 @@ over:
 void
 unlock_sc()
 {
-#if defined(SCOREFILE) && defined(LOCKFILE)
-    if (lfd != nullptr)
-        fclose(lfd);
-    lfd = nullptr;
-    md_unlink(LOCKFILE);
+#ifdef SCOREFILE
+    if (scoreboard != nullptr)
+	md_unlockfile(scoreboard);
 #endif
 }
 
@@ -460,5 +438,5 @@ unlock_sc()
 void
 flush_type()
 {
-    flushinp();
+    cur_game->display->flush_input();
 }
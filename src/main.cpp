@@ -9,14 +9,54 @@
  */
 
 #include <csignal>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
-
-#include <ncurses.h>
+#include <memory>
 
 #include <roguepp/roguepp.hpp>
 
+#if defined(HAVE_UNISTD_H)
+#include <unistd.h>
+#endif
+
+/*
+ * open_display:
+ *	Start the renderer asked for with -D or the display option
+ */
+static std::unique_ptr<renderer>
+open_display(const char* name)
+{
+    if (!std::strcmp(name, "ansi"))
+	return ansi_renderer();
+#if defined(HAVE_UNISTD_H)
+    if (!std::strcmp(name, "stream"))
+    {
+	/*
+	 * The frame stream gets standard output to itself, and the
+	 * messages printed around the game go to standard error.
+	 */
+	std::FILE* out = fdopen(dup(1), "wb");
+
+	std::fflush(stdout);
+	dup2(2, 1);
+	return stream_renderer(out);
+    }
+#endif
+    if (!std::strcmp(name, "null"))
+	return null_renderer(NUMLINES, NUMCOLS, []() {
+	    int ch;
+
+	    if ((ch = std::getchar()) == EOF)
+		auto_save(SIGHUP);
+	    return ch;
+	});
+    if (std::strcmp(name, "curses"))
+	std::fprintf(stderr, "Unknown display \"%s\", using curses\n", name);
+    return curses_renderer();
+}
+
 /*
  * main:
  *	The main program, of course
@@ -26,7 +66,10 @@ main(int argc, char **argv, char** envp)
 {
     char *env;
     int lowtime;
+    std::unique_ptr<renderer> screen;
+    const auto g = std::make_unique<game>();
 
+    cur_game = g.get();
     md_init();
 
 #ifdef MASTER
@@ -36,8 +79,8 @@ main(int argc, char **argv, char** envp)
     if (argc >= 2 && argv[1][0] == '\0')
 	if (strcmp(PASSWD, md_crypt(md_getpass("wizard's password: "), "mT")) == 0)
 	{
-	    wizard = true;
-	    player.t_flags |= SEEMONST;
+	    cur_game->wizard = true;
+	    cur_game->player.t_flags |= SEEMONST;
 	    argv++;
 	    argc--;
 	}
@@ -47,27 +90,45 @@ main(int argc, char **argv, char** envp)
     // get home and options from environment
     std::strncpy(home, md_gethomedir().c_str(), MAXSTR);
 
-    strcpy(file_name, home);
-    strcat(file_name, "rogue.save");
+    strcpy(cur_game->file_name, home);
+    strcat(cur_game->file_name, "rogue.save");
 
     if ((env = std::getenv("ROGUEOPTS")))
     {
         parse_opts(env);
     }
-    if (!env || !*whoami)
+    if (!env || !*cur_game->whoami)
     {
         const auto username = md_getusername();
 
-        strucpy(whoami, username.c_str(), username.length());
+        strucpy(cur_game->whoami, username.c_str(), username.length());
     }
+    if (argc >= 3 && strcmp(argv[1], "-D") == 0)
+    {
+	strucpy(cur_game->display_name, argv[2], strlen(argv[2]));
+	argv += 2;
+	argc -= 2;
+    }
+    /*
+     * Server mode plays games for others, none for the one who starts it.
+     * Their scores are posted like any other.
+     */
+    if (argc >= 2 && strcmp(argv[1], "--serve") == 0)
+    {
+	open_score();
+	md_normaluser();
+	return serve(argc >= 3 ? argv[2] : std::string(home) + "rogue.sock", home);
+    }
+    screen = open_display(cur_game->display_name);
+    cur_game->display = screen.get();
     lowtime = static_cast<int>(std::time(nullptr));
 #ifdef MASTER
-    if (wizard && std::getenv("SEED") != nullptr)
-	dnum = std::atoi(std::getenv("SEED"));
+    if (cur_game->wizard && std::getenv("SEED") != nullptr)
+	cur_game->dnum = std::atoi(std::getenv("SEED"));
     else
 #endif
-	dnum = lowtime + md_getpid();
-    seed = dnum;
+	cur_game->dnum = lowtime + md_getpid();
+    srnd(cur_game->dnum);
 
     open_score();
 
@@ -87,18 +148,18 @@ main(int argc, char **argv, char** envp)
     {
 	if (strcmp(argv[1], "-s") == 0)
 	{
-	    noscore = true;
+	    cur_game->noscore = true;
 	    score(0, -1, 0);
 	    exit(0);
 	}
 	else if (strcmp(argv[1], "-d") == 0)
 	{
-	    dnum = rnd(100);	/* throw away some rnd()s to break patterns */
-	    while (--dnum)
+	    cur_game->dnum = rnd(100);	/* throw away some rnd()s to break patterns */
+	    while (--cur_game->dnum)
 		rnd(100);
-	    purse = rnd(100) + 1;
-	    level = rnd(100) + 1;
-	    initscr();
+	    cur_game->purse = rnd(100) + 1;
+	    cur_game->level = rnd(100) + 1;
+	    init_display();
 	    getltchars();
 	    death(death_monst());
 	    exit(0);
@@ -110,288 +171,31 @@ main(int argc, char **argv, char** envp)
 	if (!restore(argv[1], envp))	/* Note: restore will never return */
 	    my_exit(1);
 #ifdef MASTER
-    if (wizard)
-	printf("Hello %s, welcome to dungeon #%d", whoami, dnum);
+    if (cur_game->wizard)
+	printf("Hello %s, welcome to dungeon #%d", cur_game->whoami, cur_game->dnum);
     else
 #endif
-	printf("Hello %s, just a moment while I dig the dungeon...", whoami);
+	printf("Hello %s, just a moment while I dig the dungeon...", cur_game->whoami);
     fflush(stdout);
 
-    initscr();				/* Start up cursor package */
-    init_probs();			/* Set up prob tables for objects */
-    init_player();			/* Set up initial player stats */
-    init_names();			/* Set up names of scrolls */
-    init_colors();			/* Set up colors of potions */
-    init_stones();			/* Set up stone settings of rings */
-    init_materials();			/* Set up materials of wands */
+    init_display();			/* Start up cursor package */
+    init_game();
     setup();
 
     /*
      * The screen must be at least NUMLINES x NUMCOLS
      */
-    if (LINES < NUMLINES || COLS < NUMCOLS)
+    if (cur_game->display->lines() < NUMLINES || cur_game->display->cols() < NUMCOLS)
     {
 	printf("\nSorry, the screen must be at least %dx%d\n", NUMLINES, NUMCOLS);
-	endwin();
+	cur_game->display->end();
 	my_exit(1);
     }
 
-    /*
-     * Set up windows
-     */
-    hw = newwin(LINES, COLS, 0, 0);
-    idlok(stdscr, true);
-    idlok(hw, true);
 #ifdef MASTER
-    noscore = wizard;
+    cur_game->noscore = cur_game->wizard;
 #endif
-    new_level();			/* Draw current level */
-    /*
-     * Start up daemons and fuses
-     */
-    start_daemon(runners, 0, AFTER);
-    start_daemon(doctor, 0, AFTER);
-    fuse(swander, 0, WANDERTIME, AFTER);
-    start_daemon(stomach, 0, AFTER);
+    start_game();
     playit();
     return(0);
 }
-
-/*
- * endit:
- *	Exit the program abnormally.
- */
-
-void
-endit(int sig)
-{
-    NOOP(sig);
-    fatal("Okay, bye bye!\n");
-}
-
-/*
- * fatal:
- *	Exit the program, printing a message.
- */
-void
-fatal(const std::string& message)
-{
-    mvaddstr(LINES - 2, 0, message.c_str());
-    refresh();
-    endwin();
-    my_exit(0);
-}
-
-/*
- * rnd:
- *	Pick a very random number.
- */
-int
-rnd(int range)
-{
-    return range == 0 ? 0 : abs((int) RN) % range;
-}
-
-/*
- * roll:
- *	Roll a number of dice
- */
-int
-roll(int number, int sides)
-{
-    int dtotal = 0;
-
-    while (number--)
-	dtotal += rnd(sides)+1;
-    return dtotal;
-}
-
-/*
- * tstp:
- *	Handle stop and start signals
- */
-
-void
-tstp(int)
-{
-    int y, x;
-    int oy, ox;
-
-    /*
-     * leave nicely
-     */
-    getyx(curscr, oy, ox);
-    mvcur(0, COLS - 1, LINES - 1, 0);
-    endwin();
-    resetltchars();
-    std::fflush(stdout);
-    md_tstpsignal();
-
-    /*
-     * start back up again
-     */
-    md_tstpresume();
-    raw();
-    noecho();
-    keypad(stdscr,1);
-    playltchars();
-    clearok(curscr, true);
-    wrefresh(curscr);
-    getyx(curscr, y, x);
-    mvcur(y, x, oy, ox);
-    std::fflush(stdout);
-    setsyx(oy, ox);
-}
-
-/*
- * playit:
- *	The main loop of the program.  Loop until the game is over,
- *	refreshing things and looking at the proper times.
- */
-
-void
-playit()
-{
-    char *opts;
-
-    /*
-     * set up defaults for slow terminals
-     */
-
-    if (baudrate() <= 1200)
-    {
-	terse = true;
-	jump = true;
-	see_floor = false;
-    }
-
-    if (md_hasclreol())
-	inv_type = INV_CLEAR;
-
-    /*
-     * parse environment declaration of options
-     */
-    if ((opts = std::getenv("ROGUEOPTS")) != nullptr)
-	parse_opts(opts);
-
-
-    oldpos = hero;
-    oldrp = roomin(&hero);
-    while (playing)
-	command();			/* Command execution */
-    endit(0);
-}
-
-/*
- * quit:
- *	Have player make certain, then exit.
- */
-
-void
-quit(int sig)
-{
-    int oy, ox;
-
-    NOOP(sig);
-
-    /*
-     * Reset the signal in case we got here via an interrupt
-     */
-    if (!q_comm)
-	mpos = 0;
-    getyx(curscr, oy, ox);
-    msg("really quit?");
-    if (readchar() == 'y')
-    {
-	signal(SIGINT, leave);
-	clear();
-	mvprintw(LINES - 2, 0, "You quit with %d gold pieces", purse);
-	move(LINES - 1, 0);
-	refresh();
-	score(purse, 1, 0);
-	my_exit(0);
-    }
-    else
-    {
-	move(0, 0);
-	clrtoeol();
-	status();
-	move(oy, ox);
-	refresh();
-	mpos = 0;
-	count = 0;
-	to_death = false;
-    }
-}
-
-/*
- * leave:
- *	Leave quickly, but curteously
- */
-
-void
-leave(int sig)
-{
-    static char buf[BUFSIZ];
-
-    NOOP(sig);
-
-    setbuf(stdout, buf);	/* throw away pending output */
-
-    if (!isendwin())
-    {
-	mvcur(0, COLS - 1, LINES - 1, 0);
-	endwin();
-    }
-
-    putchar('\n');
-    my_exit(0);
-}
-
-/*
- * shell:
- *	Let them escape for a while
- */
-
-void
-shell()
-{
-    /*
-     * Set the terminal back to original mode
-     */
-    move(LINES-1, 0);
-    refresh();
-    endwin();
-    resetltchars();
-    putchar('\n');
-    in_shell = true;
-    after = false;
-    fflush(stdout);
-    /*
-     * Fork and do a shell
-     */
-    md_shellescape();
-
-    printf("\n[Press return to continue]");
-    fflush(stdout);
-    noecho();
-    raw();
-    keypad(stdscr,1);
-    playltchars();
-    in_shell = false;
-    wait_for('\n');
-    clearok(stdscr, true);
-}
-
-/*
- * my_exit:
- *	Leave the process properly
- */
-
-void
-my_exit(int st)
-{
-    resetltchars();
-    exit(st);
-}
-
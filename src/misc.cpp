@@ -14,8 +14,6 @@
 #include <cstdlib>
 #include <cstring>
 
-#include <ncurses.h>
-
 #include <roguepp/roguepp.hpp>
 
 /*
@@ -46,17 +44,17 @@ look(bool wakeup)
 # endif /* DEBUG */
     passcount = 0;
     rp = proom;
-    if (!ce(oldpos, hero))
+    if (!ce(cur_game->oldpos, hero))
     {
-	erase_lamp(oldpos, *oldrp);
-	oldpos = hero;
-	oldrp = rp;
+	erase_lamp(cur_game->oldpos, *cur_game->oldrp);
+	cur_game->oldpos = hero;
+	cur_game->oldrp = rp;
     }
     ey = hero.y + 1;
     ex = hero.x + 1;
     sx = hero.x - 1;
     sy = hero.y - 1;
-    if (door_stop && !firstmove && running)
+    if (cur_game->door_stop && !cur_game->firstmove && cur_game->running)
     {
 	sumhero = hero.y + hero.x;
 	diffhero = hero.y - hero.x;
@@ -70,7 +68,7 @@ look(bool wakeup)
 	{
 	    if (x < 0 || x >= NUMCOLS)
 		continue;
-	    if (!on(player, ISBLIND))
+	    if (!on(cur_game->player, ISBLIND))
 	    {
 		if (y == hero.y && x == hero.x)
 		    continue;
@@ -95,10 +93,10 @@ look(bool wakeup)
 	    if ((tp = pp->p_monst) == nullptr)
 		ch = trip_ch(y, x, ch);
 	    else
-		if (on(player, SEEMONST) && on(*tp, ISINVIS))
+		if (on(cur_game->player, SEEMONST) && on(*tp, ISINVIS))
 		{
-		    if (door_stop && !firstmove)
-			running = false;
+		    if (cur_game->door_stop && !cur_game->firstmove)
+			cur_game->running = false;
 		    continue;
 		}
 		else
@@ -107,26 +105,26 @@ look(bool wakeup)
 			wake_monster(y, x);
 		    if (see_monst(tp))
 		    {
-			if (on(player, ISHALU))
+			if (on(cur_game->player, ISHALU))
 			    ch = rnd(26) + 'A';
 			else
 			    ch = tp->t_disguise;
 		    }
 		}
-	    if (on(player, ISBLIND) && (y != hero.y || x != hero.x))
+	    if (on(cur_game->player, ISBLIND) && (y != hero.y || x != hero.x))
 		continue;
 
-	    move(y, x);
+	    cur_game->cw->move(y, x);
 
-	    if ((proom->r_flags & ISDARK) && !see_floor && ch == FLOOR)
+	    if ((proom->r_flags & ISDARK) && !cur_game->see_floor && ch == FLOOR)
 		ch = ' ';
 
-	    if (tp != nullptr || ch != CCHAR( inch() ))
-		addch(ch);
+	    if (tp != nullptr || ch != CCHAR( cur_game->cw->inch() ))
+		cur_game->cw->addch(ch);
 
-	    if (door_stop && !firstmove && running)
+	    if (cur_game->door_stop && !cur_game->firstmove && cur_game->running)
 	    {
-		switch (runch)
+		switch (cur_game->runch)
 		{
 		    case 'h':
 			if (x == ex)
@@ -157,7 +155,7 @@ look(bool wakeup)
 		{
 		    case DOOR:
 			if (x == hero.x || y == hero.y)
-			    running = false;
+			    cur_game->running = false;
 			break;
 		    case PASSAGE:
 			if (x == hero.x || y == hero.y)
@@ -169,15 +167,15 @@ look(bool wakeup)
 		    case ' ':
 			break;
 		    default:
-			running = false;
+			cur_game->running = false;
 			break;
 		}
 	    }
 	}
-    if (door_stop && !firstmove && passcount > 1)
-	running = false;
-    if (!running || !jump)
-	mvaddch(hero.y, hero.x, PLAYER);
+    if (cur_game->door_stop && !cur_game->firstmove && passcount > 1)
+	cur_game->running = false;
+    if (!cur_game->running || !cur_game->jump)
+	cur_game->cw->mvaddch(hero.y, hero.x, PLAYER);
 # ifdef DEBUG
     done = false;
 # endif /* DEBUG */
@@ -191,7 +189,7 @@ look(bool wakeup)
 int
 trip_ch(int y, int x, int ch)
 {
-    if (on(player, ISHALU) && after)
+    if (on(cur_game->player, ISHALU) && cur_game->after)
 	switch (ch)
 	{
 	    case FLOOR:
@@ -203,7 +201,7 @@ trip_ch(int y, int x, int ch)
 	    case TRAP:
 		break;
 	    default:
-		if (y != stairs.y || x != stairs.x || !seenstairs)
+		if (y != cur_game->stairs.y || x != cur_game->stairs.x || !cur_game->seenstairs)
 		    ch = rnd_thing();
 		break;
 	}
@@ -222,9 +220,9 @@ erase_lamp(const coord& pos, const room& rp)
     int sy;
 
     if (!(
-        see_floor &&
+        cur_game->see_floor &&
         (rp.r_flags & (ISGONE|ISDARK)) == ISDARK &&
-        !on(player,ISBLIND)
+        !on(cur_game->player,ISBLIND)
     ))
     {
         return;
@@ -242,10 +240,10 @@ erase_lamp(const coord& pos, const room& rp)
             {
                 continue;
             }
-            move(y, x);
-            if (inch() == FLOOR)
+            cur_game->cw->move(y, x);
+            if (cur_game->cw->inch() == FLOOR)
             {
-                addch(' ');
+                cur_game->cw->addch(' ');
             }
         }
     }
@@ -258,8 +256,8 @@ erase_lamp(const coord& pos, const room& rp)
 bool
 show_floor()
 {
-    if ((proom->r_flags & (ISGONE|ISDARK)) == ISDARK && !on(player, ISBLIND))
-	return see_floor;
+    if ((proom->r_flags & (ISGONE|ISDARK)) == ISDARK && !on(cur_game->player, ISBLIND))
+	return cur_game->see_floor;
     else
 	return true;
 }
@@ -273,14 +271,11 @@ find_obj(int y, int x)
 {
     THING *obj;
 
-    for (obj = lvl_obj; obj != nullptr; obj = next(obj))
-    {
-	if (obj->o_pos.y == y && obj->o_pos.x == x)
-		return obj;
-    }
+    if ((obj = obat(y, x)) != nullptr)
+	return obj;
 #ifdef MASTER
-    sprintf(prbuf, "Non-object %d,%d", y, x);
-    msg(prbuf);
+    sprintf(cur_game->prbuf, "Non-object %d,%d", y, x);
+    msg(cur_game->prbuf);
     return nullptr;
 #else
     /* NOTREACHED */
@@ -297,26 +292,27 @@ void
 eat()
 {
     THING *obj;
+    bool discardit;
 
     if ((obj = get_item("eat", FOOD)) == nullptr)
 	return;
     if (obj->o_type != FOOD)
     {
-	if (!terse)
+	if (!cur_game->terse)
 	    msg("ugh, you would get ill if you ate that");
 	else
 	    msg("that's Inedible!");
 	return;
     }
-    if (food_left < 0)
-	food_left = 0;
-    if ((food_left += HUNGERTIME - 200 + rnd(400)) > STOMACHSIZE)
-	food_left = STOMACHSIZE;
-    hungry_state = 0;
-    if (obj == cur_weapon)
-	cur_weapon = nullptr;
+    if (cur_game->food_left < 0)
+	cur_game->food_left = 0;
+    if ((cur_game->food_left += HUNGERTIME - 200 + rnd(400)) > STOMACHSIZE)
+	cur_game->food_left = STOMACHSIZE;
+    cur_game->hungry_state = 0;
+    if (obj == cur_game->cur_weapon)
+	cur_game->cur_weapon = nullptr;
     if (obj->o_which == 1)
-	msg("my, that was a yummy %s", fruit);
+	msg("my, that was a yummy %s", cur_game->fruit);
     else
 	if (rnd(100) > 70)
 	{
@@ -326,7 +322,10 @@ eat()
 	}
 	else
 	    msg("%s, that tasted good", choose_str("oh, wow", "yum"));
+    discardit = (bool)(obj->o_count == 1);
     leave_pack(obj, false, false);
+    if (discardit)
+	discard(obj);
 }
 
 /*
@@ -370,11 +369,11 @@ chg_str(int amt)
     add_str(&pstats.s_str, amt);
     comp = pstats.s_str;
     if (ISRING(LEFT, R_ADDSTR))
-	add_str(&comp, -cur_ring[LEFT]->o_arm);
+	add_str(&comp, -cur_game->cur_ring[LEFT]->o_arm);
     if (ISRING(RIGHT, R_ADDSTR))
-	add_str(&comp, -cur_ring[RIGHT]->o_arm);
-    if (comp > max_stats.s_str)
-	max_stats.s_str = comp;
+	add_str(&comp, -cur_game->cur_ring[RIGHT]->o_arm);
+    if (comp > cur_game->max_stats.s_str)
+	cur_game->max_stats.s_str = comp;
 }
 
 /*
@@ -397,17 +396,17 @@ add_str(stats::str_t *sp, int amt)
 bool
 add_haste(bool potion)
 {
-    if (on(player, ISHASTE))
+    if (on(cur_game->player, ISHASTE))
     {
-	no_command += rnd(8);
-	player.t_flags &= ~(ISRUN|ISHASTE);
+	cur_game->no_command += rnd(8);
+	cur_game->player.t_flags &= ~(ISRUN|ISHASTE);
 	extinguish(nohaste);
 	msg("you faint from exhaustion");
 	return false;
     }
     else
     {
-	player.t_flags |= ISHASTE;
+	cur_game->player.t_flags |= ISHASTE;
 	if (potion)
 	    fuse(nohaste, 0, rnd(4)+4, AFTER);
 	return true;
@@ -424,7 +423,7 @@ aggravate()
 {
     THING *mp;
 
-    for (mp = mlist; mp != nullptr; mp = next(mp))
+    for (mp = cur_game->mlist; mp != nullptr; mp = next(mp))
 	runto(&mp->t_pos);
 }
 
@@ -461,10 +460,10 @@ is_current(THING *obj)
 {
     if (obj == nullptr)
 	return false;
-    if (obj == cur_armor || obj == cur_weapon || obj == cur_ring[LEFT]
-	|| obj == cur_ring[RIGHT])
+    if (obj == cur_game->cur_armor || obj == cur_game->cur_weapon || obj == cur_game->cur_ring[LEFT]
+	|| obj == cur_game->cur_ring[RIGHT])
     {
-	if (!terse)
+	if (!cur_game->terse)
 	    addmsg("That's already ");
 	msg("in use");
 	return true;
@@ -482,53 +481,52 @@ get_dir()
 {
     const char* prompt;
     bool gotit;
-    static coord last_delt= {0,0};
 
-    if (again && last_dir != '\0')
+    if (cur_game->again && cur_game->last_dir != '\0')
     {
-	delta.y = last_delt.y;
-	delta.x = last_delt.x;
-	dir_ch = last_dir;
+	cur_game->delta.y = cur_game->last_delt.y;
+	cur_game->delta.x = cur_game->last_delt.x;
+	cur_game->dir_ch = cur_game->last_dir;
     }
     else
     {
-	if (!terse)
+	if (!cur_game->terse)
 	    msg(prompt = "which direction? ");
 	else
 	    prompt = "direction: ";
 	do
 	{
 	    gotit = true;
-	    switch (dir_ch = readchar())
+	    switch (cur_game->dir_ch = readchar())
 	    {
-		case 'h': case'H': delta.y =  0; delta.x = -1;
-		when 'j': case'J': delta.y =  1; delta.x =  0;
-		when 'k': case'K': delta.y = -1; delta.x =  0;
-		when 'l': case'L': delta.y =  0; delta.x =  1;
-		when 'y': case'Y': delta.y = -1; delta.x = -1;
-		when 'u': case'U': delta.y = -1; delta.x =  1;
-		when 'b': case'B': delta.y =  1; delta.x = -1;
-		when 'n': case'N': delta.y =  1; delta.x =  1;
-		when ESCAPE: last_dir = '\0'; reset_last(); return false;
+		case 'h': case'H': cur_game->delta.y =  0; cur_game->delta.x = -1;
+		when 'j': case'J': cur_game->delta.y =  1; cur_game->delta.x =  0;
+		when 'k': case'K': cur_game->delta.y = -1; cur_game->delta.x =  0;
+		when 'l': case'L': cur_game->delta.y =  0; cur_game->delta.x =  1;
+		when 'y': case'Y': cur_game->delta.y = -1; cur_game->delta.x = -1;
+		when 'u': case'U': cur_game->delta.y = -1; cur_game->delta.x =  1;
+		when 'b': case'B': cur_game->delta.y =  1; cur_game->delta.x = -1;
+		when 'n': case'N': cur_game->delta.y =  1; cur_game->delta.x =  1;
+		when ESCAPE: cur_game->last_dir = '\0'; reset_last(); return false;
 		otherwise:
-		    mpos = 0;
+		    cur_game->mpos = 0;
 		    msg(prompt);
 		    gotit = false;
 	    }
 	} until (gotit);
-	if (isupper(dir_ch))
-	    dir_ch = (char) tolower(dir_ch);
-	last_dir = dir_ch;
-	last_delt.y = delta.y;
-	last_delt.x = delta.x;
+	if (isupper(cur_game->dir_ch))
+	    cur_game->dir_ch = (char) tolower(cur_game->dir_ch);
+	cur_game->last_dir = cur_game->dir_ch;
+	cur_game->last_delt.y = cur_game->delta.y;
+	cur_game->last_delt.x = cur_game->delta.x;
     }
-    if (on(player, ISHUH) && rnd(5) == 0)
+    if (on(cur_game->player, ISHUH) && rnd(5) == 0)
 	do
 	{
-	    delta.y = rnd(3) - 1;
-	    delta.x = rnd(3) - 1;
-	} while (delta.y == 0 && delta.x == 0);
-    mpos = 0;
+	    cur_game->delta.y = rnd(3) - 1;
+	    cur_game->delta.x = rnd(3) - 1;
+	} while (cur_game->delta.y == 0 && cur_game->delta.x == 0);
+    cur_game->mpos = 0;
     return true;
 }
 
@@ -573,13 +571,13 @@ call_it(struct obj_info *info)
     }
     else if (!info->oi_guess)
     {
-	msg(terse ? "call it: " : "what do you want to call it? ");
-	if (get_str(prbuf, stdscr) == NORM)
+	msg(cur_game->terse ? "call it: " : "what do you want to call it? ");
+	if (get_str(cur_game->prbuf, cur_game->cw) == NORM)
 	{
 	    if (info->oi_guess != nullptr)
 		free(info->oi_guess);
-        info->oi_guess = static_cast<char*>(std::malloc(std::strlen(prbuf) + 1));
-	    strcpy(info->oi_guess, prbuf);
+        info->oi_guess = static_cast<char*>(std::malloc(std::strlen(cur_game->prbuf) + 1));
+	    strcpy(info->oi_guess, cur_game->prbuf);
 	}
     }
 }
@@ -596,7 +594,7 @@ rnd_thing()
 	POTION, SCROLL, RING, STICK, FOOD, WEAPON, ARMOR, STAIRS, GOLD, AMULET
     };
 
-    if (level >= AMULETLEVEL)
+    if (cur_game->level >= AMULETLEVEL)
         i = rnd(sizeof thing_list / sizeof (char));
     else
         i = rnd(sizeof thing_list / sizeof (char) - 1);
@@ -13,8 +13,6 @@
 #include <cctype>
 #include <cstring>
 
-#include <ncurses.h>
-
 #include <roguepp/roguepp.hpp>
 
 /*
@@ -44,7 +42,7 @@ randmonster(bool wander)
     mons = (wander ? wand_mons : lvl_mons);
     do
     {
-	d = level + (rnd(10) - 6);
+	d = cur_game->level + (rnd(10) - 6);
 	if (d < 0)
 	    d = rnd(5);
 	if (d > 25)
@@ -64,17 +62,17 @@ new_monster(THING *tp, char type, coord *cp)
     struct monster *mp;
     int lev_add;
 
-    if ((lev_add = level - AMULETLEVEL) < 0)
+    if ((lev_add = cur_game->level - AMULETLEVEL) < 0)
 	lev_add = 0;
-    attach(mlist, tp);
+    attach(cur_game->mlist, tp);
     tp->t_type = type;
     tp->t_disguise = type;
     tp->t_pos = *cp;
-    move(cp->y, cp->x);
-    tp->t_oldch = CCHAR( inch() );
+    cur_game->cw->move(cp->y, cp->x);
+    tp->t_oldch = CCHAR( cur_game->cw->inch() );
     tp->t_room = roomin(cp);
     moat(cp->y, cp->x) = tp;
-    mp = &monsters[tp->t_type-'A'];
+    mp = &cur_game->monsters[tp->t_type-'A'];
     tp->t_stats.s_lvl = mp->m_stats.s_lvl + lev_add;
     tp->t_stats.s_maxhp = tp->t_stats.s_hpt = roll(tp->t_stats.s_lvl, 8);
     tp->t_stats.s_arm = mp->m_stats.s_arm - lev_add;
@@ -82,7 +80,7 @@ new_monster(THING *tp, char type, coord *cp)
     tp->t_stats.s_str = mp->m_stats.s_str;
     tp->t_stats.s_exp = mp->m_stats.s_exp + lev_add * 10 + exp_add(tp);
     tp->t_flags = mp->m_flags;
-    if (level > 29)
+    if (cur_game->level > 29)
 	tp->t_flags |= ISHASTE;
     tp->t_turn = true;
     tp->t_pack = nullptr;
@@ -121,7 +119,8 @@ void
 wanderer()
 {
     THING *tp;
-    static coord cp;
+    static thread_local coord cp;
+    rng_scope stream(RNG_MONSTER);
 
     tp = new_item();
     do
@@ -129,19 +128,19 @@ wanderer()
 	find_floor(nullptr, &cp, false, true);
     } while (roomin(&cp) == proom);
     new_monster(tp, randmonster(true), &cp);
-    if (on(player, SEEMONST))
+    if (on(cur_game->player, SEEMONST))
     {
-	standout();
-	if (!on(player, ISHALU))
-	    addch(tp->t_type);
+	cur_game->cw->standout();
+	if (!on(cur_game->player, ISHALU))
+	    cur_game->cw->addch(tp->t_type);
 	else
-	    addch(rnd(26) + 'A');
-	standend();
+	    cur_game->cw->addch(rnd(26) + 'A');
+	cur_game->cw->standend();
     }
     runto(&tp->t_pos);
 #ifdef MASTER
-    if (wizard)
-	msg("started a wandering %s", monsters[tp->t_type-'A'].m_name);
+    if (cur_game->wizard)
+	msg("started a wandering %s", cur_game->monsters[tp->t_type-'A'].m_name);
 #endif
 }
 
@@ -163,19 +162,20 @@ wake_monster(int y, int x)
 #else
     tp = moat(y, x);
     if (tp == nullptr)
-	endwin(), abort();
+	cur_game->display->end(), abort();
 #endif
     ch = tp->t_type;
     /*
      * Every time he sees mean monster, it might start chasing him
      */
     if (!on(*tp, ISRUN) && rnd(3) != 0 && on(*tp, ISMEAN) && !on(*tp, ISHELD)
-	&& !ISWEARING(R_STEALTH) && !on(player, ISLEVIT))
+	&& !ISWEARING(R_STEALTH) && !on(cur_game->player, ISLEVIT))
     {
 	tp->t_dest = &hero;
 	tp->t_flags |= ISRUN;
+	cur_game->awake_stale = true;
     }
-    if (ch == 'M' && !on(player, ISBLIND) && !on(player, ISHALU)
+    if (ch == 'M' && !on(cur_game->player, ISBLIND) && !on(cur_game->player, ISHALU)
 	&& !on(*tp, ISFOUND) && !on(*tp, ISCANC) && on(*tp, ISRUN))
     {
         rp = proom;
@@ -185,11 +185,11 @@ wake_monster(int y, int x)
 	    tp->t_flags |= ISFOUND;
 	    if (!save(VS_MAGIC))
 	    {
-		if (on(player, ISHUH))
+		if (on(cur_game->player, ISHUH))
 		    lengthen(unconfuse, spread(HUHDURATION));
 		else
 		    fuse(unconfuse, 0, spread(HUHDURATION), AFTER);
-		player.t_flags |= ISHUH;
+		cur_game->player.t_flags |= ISHUH;
 		mname = set_mname(tp);
 		addmsg("%s", mname);
 		if (strcmp(mname, "it") != 0)
@@ -204,6 +204,7 @@ wake_monster(int y, int x)
     if (on(*tp, ISGREED) && !on(*tp, ISRUN))
     {
 	tp->t_flags |= ISRUN;
+	cur_game->awake_stale = true;
 	if (proom->r_goldval)
 	    tp->t_dest = &proom->r_gold;
 	else
@@ -220,7 +221,7 @@ wake_monster(int y, int x)
 void
 give_pack(THING *tp)
 {
-    if (level >= max_level && rnd(100) < monsters[tp->t_type-'A'].m_carry)
+    if (cur_game->level >= cur_game->max_level && rnd(100) < cur_game->monsters[tp->t_type-'A'].m_carry)
 	attach(tp->t_pack, new_thing());
 }
 
@@ -247,9 +248,9 @@ save(int which)
     if (which == VS_MAGIC)
     {
 	if (ISRING(LEFT, R_PROTECT))
-	    which -= cur_ring[LEFT]->o_arm;
+	    which -= cur_game->cur_ring[LEFT]->o_arm;
 	if (ISRING(RIGHT, R_PROTECT))
-	    which -= cur_ring[RIGHT]->o_arm;
+	    which -= cur_game->cur_ring[RIGHT]->o_arm;
     }
-    return save_throw(which, &player);
+    return save_throw(which, &cur_game->player);
 }
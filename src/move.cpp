@@ -12,16 +12,8 @@
 
 #include <cctype>
 
-#include <ncurses.h>
-
 #include <roguepp/roguepp.hpp>
 
-/*
- * used to hold the new hero position
- */
-
-coord nh;
-
 /*
  * do_run:
  *	Start the hero running
@@ -30,9 +22,9 @@ coord nh;
 void
 do_run(char ch)
 {
-    running = true;
-    after = false;
-    runch = ch;
+    cur_game->running = true;
+    cur_game->after = false;
+    cur_game->runch = ch;
 }
 
 /*
@@ -46,59 +38,59 @@ do_move(int dy, int dx)
 {
     char ch, fl;
 
-    firstmove = false;
-    if (no_move)
+    cur_game->firstmove = false;
+    if (cur_game->no_move)
     {
-	no_move--;
+	cur_game->no_move--;
 	msg("you are still stuck in the bear trap");
 	return;
     }
     /*
      * Do a confused move (maybe)
      */
-    if (on(player, ISHUH) && rnd(5) != 0)
+    if (on(cur_game->player, ISHUH) && rnd(5) != 0)
     {
-	nh = *rndmove(&player);
-	if (ce(nh, hero))
+	cur_game->nh = *rndmove(&cur_game->player);
+	if (ce(cur_game->nh, hero))
 	{
-	    after = false;
-	    running = false;
-	    to_death = false;
+	    cur_game->after = false;
+	    cur_game->running = false;
+	    cur_game->to_death = false;
 	    return;
 	}
     }
     else
     {
 over:
-	nh.y = hero.y + dy;
-	nh.x = hero.x + dx;
+	cur_game->nh.y = hero.y + dy;
+	cur_game->nh.x = hero.x + dx;
     }
 
     /*
      * Check if he tried to move off the screen or make an illegal
      * diagonal move, and stop him if he did.
      */
-    if (nh.x < 0 || nh.x >= NUMCOLS || nh.y <= 0 || nh.y >= NUMLINES - 1)
+    if (cur_game->nh.x < 0 || cur_game->nh.x >= NUMCOLS || cur_game->nh.y <= 0 || cur_game->nh.y >= NUMLINES - 1)
 	goto hit_bound;
-    if (!diag_ok(&hero, &nh))
+    if (!diag_ok(&hero, &cur_game->nh))
     {
-	after = false;
-	running = false;
+	cur_game->after = false;
+	cur_game->running = false;
 	return;
     }
-    if (running && ce(hero, nh))
-	after = running = false;
-    fl = flat(nh.y, nh.x);
-    ch = winat(nh.y, nh.x);
+    if (cur_game->running && ce(hero, cur_game->nh))
+	cur_game->after = cur_game->running = false;
+    fl = flat(cur_game->nh.y, cur_game->nh.x);
+    ch = winat(cur_game->nh.y, cur_game->nh.x);
     if (!(fl & F_REAL) && ch == FLOOR)
     {
-	if (!on(player, ISLEVIT))
+	if (!on(cur_game->player, ISLEVIT))
 	{
-	    chat(nh.y, nh.x) = ch = TRAP;
-	    flat(nh.y, nh.x) |= F_REAL;
+	    chat(cur_game->nh.y, cur_game->nh.x) = ch = TRAP;
+	    flat(cur_game->nh.y, cur_game->nh.x) |= F_REAL;
 	}
     }
-    else if (on(player, ISHELD) && ch != 'F')
+    else if (on(cur_game->player, ISHELD) && ch != 'F')
     {
 	msg("you are being held");
 	return;
@@ -109,12 +101,12 @@ over:
 	case '|':
 	case '-':
 hit_bound:
-	    if (passgo && running && (proom->r_flags & ISGONE)
-		&& !on(player, ISBLIND))
+	    if (cur_game->passgo && cur_game->running && (proom->r_flags & ISGONE)
+		&& !on(cur_game->player, ISBLIND))
 	    {
 		bool	b1, b2;
 
-		switch (runch)
+		switch (cur_game->runch)
 		{
 		    case 'h':
 		    case 'l':
@@ -124,12 +116,12 @@ hit_bound:
 			    break;
 			if (b1)
 			{
-			    runch = 'k';
+			    cur_game->runch = 'k';
 			    dy = -1;
 			}
 			else
 			{
-			    runch = 'j';
+			    cur_game->runch = 'j';
 			    dy = 1;
 			}
 			dx = 0;
@@ -143,12 +135,12 @@ hit_bound:
 			    break;
 			if (b1)
 			{
-			    runch = 'h';
+			    cur_game->runch = 'h';
 			    dx = -1;
 			}
 			else
 			{
-			    runch = 'l';
+			    cur_game->runch = 'l';
 			    dx = 1;
 			}
 			dy = 0;
@@ -156,16 +148,16 @@ hit_bound:
 			goto over;
 		}
 	    }
-	    running = false;
-	    after = false;
+	    cur_game->running = false;
+	    cur_game->after = false;
 	    break;
 	case DOOR:
-	    running = false;
+	    cur_game->running = false;
 	    if (flat(hero.y, hero.x) & F_PASS)
-		enter_room(&nh);
+		enter_room(&cur_game->nh);
 	    goto move_stuff;
 	case TRAP:
-	    ch = be_trapped(&nh);
+	    ch = be_trapped(&cur_game->nh);
 	    if (ch == T_DOOR || ch == T_TELEP)
 		return;
 	    goto move_stuff;
@@ -183,21 +175,21 @@ hit_bound:
 		be_trapped(&hero);
 	    goto move_stuff;
 	case STAIRS:
-	    seenstairs = true;
+	    cur_game->seenstairs = true;
 	    /* FALLTHROUGH */
 	default:
-	    running = false;
-	    if (isupper(ch) || moat(nh.y, nh.x))
-		fight(&nh, cur_weapon, false);
+	    cur_game->running = false;
+	    if (isupper(ch) || moat(cur_game->nh.y, cur_game->nh.x))
+		fight(&cur_game->nh, cur_game->cur_weapon, false);
 	    else
 	    {
 		if (ch != STAIRS)
-		    take = ch;
+		    cur_game->take = ch;
 move_stuff:
-		mvaddch(hero.y, hero.x, floor_at());
-		if ((fl & F_PASS) && chat(oldpos.y, oldpos.x) == DOOR)
-		    leave_room(&nh);
-		hero = nh;
+		cur_game->cw->mvaddch(hero.y, hero.x, floor_at());
+		if ((fl & F_PASS) && chat(cur_game->oldpos.y, cur_game->oldpos.x) == DOOR)
+		    leave_room(&cur_game->nh);
+		hero = cur_game->nh;
 	    }
     }
 }
@@ -229,12 +221,8 @@ turnref()
     pp = INDEX(hero.y, hero.x);
     if (!(pp->p_flags & F_SEEN))
     {
-	if (jump)
-	{
-	    leaveok(stdscr, true);
-	    refresh();
-	    leaveok(stdscr, false);
-	}
+	if (cur_game->jump)
+	    cur_game->cw->refresh();
 	pp->p_flags |= F_SEEN;
     }
 }
@@ -268,10 +256,10 @@ be_trapped(coord *tc)
     THING *arrow;
     char tr;
 
-    if (on(player, ISLEVIT))
+    if (on(cur_game->player, ISLEVIT))
 	return T_RUST;	/* anything that's not a door or teleport */
-    running = false;
-    count = false;
+    cur_game->running = false;
+    cur_game->count = false;
     pp = INDEX(tc->y, tc->x);
     pp->p_ch = TRAP;
     tr = pp->p_flags & F_TMASK;
@@ -279,11 +267,11 @@ be_trapped(coord *tc)
     switch (tr)
     {
 	case T_DOOR:
-	    level++;
+	    cur_game->level++;
 	    new_level();
 	    msg("you fell into a trap!");
 	when T_BEAR:
-	    no_move += BEARTIME;
+	    cur_game->no_move += BEARTIME;
 	    msg("you are caught in a bear trap");
         when T_MYST:
             switch(rnd(11))
@@ -333,8 +321,8 @@ be_trapped(coord *tc)
                     break;
             }
 	when T_SLEEP:
-	    no_command += SLEEPTIME;
-	    player.t_flags &= ~ISRUN;
+	    cur_game->no_command += SLEEPTIME;
+	    cur_game->player.t_flags &= ~ISRUN;
 	    msg("a strange white mist envelops you and you fall asleep");
 	when T_ARROW:
 	    if (swing(pstats.s_lvl - 1, pstats.s_arm, 1))
@@ -363,7 +351,7 @@ be_trapped(coord *tc)
 	     * down for us, so we have to do it ourself
 	     */
 	    teleport();
-	    mvaddch(tc->y, tc->x, TRAP);
+	    cur_game->cw->mvaddch(tc->y, tc->x, TRAP);
 	when T_DART:
 	    if (!swing(pstats.s_lvl+1, pstats.s_arm, 1))
 		msg("a small dart whizzes by your ear and vanishes");
@@ -381,7 +369,7 @@ be_trapped(coord *tc)
 	    }
 	when T_RUST:
 	    msg("a gush of water hits you on the head");
-	    rust_armor(cur_armor);
+	    rust_armor(cur_game->cur_armor);
     }
     flush_type();
     return tr;
@@ -397,17 +385,16 @@ rndmove(THING *who)
     THING *obj;
     int x, y;
     char ch;
-    static coord ret;  /* what we will be returning */
 
-    y = ret.y = who->t_pos.y + rnd(3) - 1;
-    x = ret.x = who->t_pos.x + rnd(3) - 1;
+    y = cur_game->rnd_ret.y = who->t_pos.y + rnd(3) - 1;
+    x = cur_game->rnd_ret.x = who->t_pos.x + rnd(3) - 1;
     /*
      * Now check to see if that's a legal move.  If not, don't move.
      * (I.e., bump into the wall or whatever)
      */
     if (y == who->t_pos.y && x == who->t_pos.x)
-	return &ret;
-    if (!diag_ok(&who->t_pos, &ret))
+	return &cur_game->rnd_ret;
+    if (!diag_ok(&who->t_pos, &cur_game->rnd_ret))
 	goto bad;
     else
     {
@@ -416,18 +403,16 @@ rndmove(THING *who)
 	    goto bad;
 	if (ch == SCROLL)
 	{
-	    for (obj = lvl_obj; obj != nullptr; obj = next(obj))
-		if (y == obj->o_pos.y && x == obj->o_pos.x)
-		    break;
+	    obj = obat(y, x);
 	    if (obj != nullptr && obj->o_which == S_SCARE)
 		goto bad;
 	}
     }
-    return &ret;
+    return &cur_game->rnd_ret;
 
 bad:
-    ret = who->t_pos;
-    return &ret;
+    cur_game->rnd_ret = who->t_pos;
+    return &cur_game->rnd_ret;
 }
 
 /*
@@ -445,13 +430,13 @@ rust_armor(THING *arm)
 
     if ((arm->o_flags & ISPROT) || ISWEARING(R_SUSTARM))
     {
-	if (!to_death)
+	if (!cur_game->to_death)
 	    msg("the rust vanishes instantly");
     }
     else
     {
 	arm->o_arm++;
-	if (!terse)
+	if (!cur_game->terse)
 	    msg("your armor appears to be weaker now. Oh my!");
 	else
 	    msg("your armor weakens");
@@ -13,8 +13,6 @@
 
 #include <cstring>
 
-#include <ncurses.h>
-
 #include <roguepp/roguepp.hpp>
 
 #define TREAS_ROOM 20	/* one chance in TREAS_ROOM for a treasure room */
@@ -28,43 +26,45 @@ new_level()
     PLACE *pp;
     char *sp;
     int i;
+    rng_scope stream(RNG_LEVEL);
 
-    player.t_flags &= ~ISHELD;	/* unhold when you go down just in case */
-    if (level > max_level)
-	max_level = level;
+    cur_game->player.t_flags &= ~ISHELD;	/* unhold when you go down just in case */
+    if (cur_game->level > cur_game->max_level)
+	cur_game->max_level = cur_game->level;
     /*
      * Clean things off from last level
      */
-    for (pp = places; pp < &places[MAXCOLS*MAXLINES]; pp++)
+    for (pp = cur_game->places; pp < &cur_game->places[MAXCOLS*MAXLINES]; pp++)
     {
 	pp->p_ch = ' ';
 	pp->p_flags = F_REAL;
+	pp->p_room = -1;
 	pp->p_monst = nullptr;
+	pp->p_obj = nullptr;
     }
-    clear();
-    /*
-     * Free up the monsters on the last level
-     */
-    for (tp = mlist; tp != nullptr; tp = next(tp))
-	free_list(tp->t_pack);
-    free_list(mlist);
+    cur_game->cw->clear();
     /*
-     * Throw away stuff left on the previous level (if anything)
+     * Throw away the monsters and stuff left on the previous level.
+     * Everything the hero carries lives outside the level pool.
      */
-    free_list(lvl_obj);
+    cur_game->mlist = nullptr;
+    cur_game->awake_stale = true;
+    cur_game->lvl_obj = nullptr;
+    cur_game->level_pool.reset();
+    cur_game->chase_fields.clear();
     do_rooms();				/* Draw rooms */
     do_passages();			/* Draw passages */
-    no_food++;
+    cur_game->no_food++;
     put_things();			/* Place objects (if any) */
     /*
      * Place the traps
      */
-    if (rnd(10) < level)
+    if (rnd(10) < cur_game->level)
     {
-	ntraps = rnd(level / 4) + 1;
-	if (ntraps > MAXTRAPS)
-	    ntraps = MAXTRAPS;
-	i = ntraps;
+	cur_game->ntraps = rnd(cur_game->level / 4) + 1;
+	if (cur_game->ntraps > MAXTRAPS)
+	    cur_game->ntraps = MAXTRAPS;
+	i = cur_game->ntraps;
 	while (i--)
 	{
 	    /*
@@ -75,9 +75,9 @@ new_level()
 	     */
 	    do
 	    {
-		find_floor(nullptr, &stairs, false, false);
-	    } while (chat(stairs.y, stairs.x) != FLOOR);
-	    sp = &flat(stairs.y, stairs.x);
+		find_floor(nullptr, &cur_game->stairs, false, false);
+	    } while (chat(cur_game->stairs.y, cur_game->stairs.x) != FLOOR);
+	    sp = &flat(cur_game->stairs.y, cur_game->stairs.x);
 	    *sp &= ~F_REAL;
 	    *sp |= rnd(NTRAPS);
 	}
@@ -85,19 +85,19 @@ new_level()
     /*
      * Place the staircase down.
      */
-    find_floor(nullptr, &stairs, false, false);
-    chat(stairs.y, stairs.x) = STAIRS;
-    seenstairs = false;
+    find_floor(nullptr, &cur_game->stairs, false, false);
+    chat(cur_game->stairs.y, cur_game->stairs.x) = STAIRS;
+    cur_game->seenstairs = false;
 
-    for (tp = mlist; tp != nullptr; tp = next(tp))
+    for (tp = cur_game->mlist; tp != nullptr; tp = next(tp))
 	tp->t_room = roomin(&tp->t_pos);
 
     find_floor(nullptr, &hero, false, true);
     enter_room(&hero);
-    mvaddch(hero.y, hero.x, PLAYER);
-    if (on(player, SEEMONST))
+    cur_game->cw->mvaddch(hero.y, hero.x, PLAYER);
+    if (on(cur_game->player, SEEMONST))
 	turn_see(false);
-    if (on(player, ISHALU))
+    if (on(cur_game->player, ISHALU))
 	visuals(0);
 }
 
@@ -113,7 +113,7 @@ rnd_room()
     do
     {
 	rm = rnd(MAXROOMS);
-    } while (rooms[rm].r_flags & ISGONE);
+    } while (cur_game->rooms[rm].r_flags & ISGONE);
     return rm;
 }
 
@@ -132,7 +132,7 @@ put_things()
      * Once you have found the amulet, the only way to get new stuff is
      * go down into the dungeon.
      */
-    if (amulet && level < max_level)
+    if (cur_game->amulet && cur_game->level < cur_game->max_level)
 	return;
     /*
      * check for treasure rooms, and if so, put it in.
@@ -149,21 +149,20 @@ put_things()
 	     * Pick a new object and link it in the list
 	     */
 	    obj = new_thing();
-	    attach(lvl_obj, obj);
 	    /*
 	     * Put it somewhere
 	     */
 	    find_floor(nullptr, &obj->o_pos, false, false);
+	    attach(cur_game->lvl_obj, obj);
 	    chat(obj->o_pos.y, obj->o_pos.x) = (char) obj->o_type;
 	}
     /*
      * If he is really deep in the dungeon and he hasn't found the
      * amulet yet, put it somewhere on the ground
      */
-    if (level >= AMULETLEVEL && !amulet)
+    if (cur_game->level >= AMULETLEVEL && !cur_game->amulet)
     {
 	obj = new_item();
-	attach(lvl_obj, obj);
 	obj->o_hplus = 0;
 	obj->o_dplus = 0;
 	strncpy(obj->o_damage,"0x0",sizeof(obj->o_damage));
@@ -174,6 +173,7 @@ put_things()
 	 * Put it somewhere
 	 */
 	find_floor(nullptr, &obj->o_pos, false, false);
+	attach(cur_game->lvl_obj, obj);
 	chat(obj->o_pos.y, obj->o_pos.x) = AMULET;
     }
 }
@@ -192,9 +192,9 @@ treas_room()
     THING *tp;
     struct room *rp;
     int spots, num_monst;
-    static coord mp;
+    static thread_local coord mp;
 
-    rp = &rooms[rnd_room()];
+    rp = &cur_game->rooms[rnd_room()];
     spots = (rp->r_max.y - 2) * (rp->r_max.x - 2) - MINTREAS;
     if (spots > (MAXTREAS - MINTREAS))
 	spots = (MAXTREAS - MINTREAS);
@@ -204,7 +204,7 @@ treas_room()
 	find_floor(rp, &mp, 2 * MAXTRIES, false);
 	tp = new_thing();
 	tp->o_pos = mp;
-	attach(lvl_obj, tp);
+	attach(cur_game->lvl_obj, tp);
 	chat(mp.y, mp.x) = (char) tp->o_type;
     }
 
@@ -217,7 +217,7 @@ treas_room()
     spots = (rp->r_max.y - 2) * (rp->r_max.x - 2);
     if (nm > spots)
 	nm = spots;
-    level++;
+    cur_game->level++;
     while (nm--)
     {
 	spots = 0;
@@ -229,5 +229,5 @@ treas_room()
 	    give_pack(tp);
 	}
     }
-    level--;
+    cur_game->level--;
 }
@@ -0,0 +1,167 @@
+/*
+ * Renderer that draws nothing
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+
+#include <utility>
+
+#include <roguepp/renderer.hpp>
+
+namespace
+{
+    /**
+     * Canvas that throws everything away.  The game reads the screen
+     * back from its shadow canvases, so nothing needs to be kept.
+     */
+    class null_canvas : public canvas
+    {
+    public:
+        null_canvas(int lines, int cols)
+            : m_lines(lines)
+            , m_cols(cols) {}
+
+        int lines() const override
+        {
+            return m_lines;
+        }
+
+        int cols() const override
+        {
+            return m_cols;
+        }
+
+        void move(int, int) override {}
+
+        void getyx(int& y, int& x) const override
+        {
+            y = x = 0;
+        }
+
+        void addch(int) override {}
+        void addstr(const char*) override {}
+
+        int inch() const override
+        {
+            return ' ';
+        }
+
+        void clrtoeol() override {}
+        void clear() override {}
+        void erase() override {}
+        void standout() override {}
+        void standend() override {}
+        void refresh() override {}
+        void touch() override {}
+        void place(int, int) override {}
+
+    private:
+        const int m_lines;
+        const int m_cols;
+    };
+
+    class null_screen : public renderer
+    {
+    public:
+        null_screen(int lines, int cols, std::function<int()> keys)
+            : m_lines(lines)
+            , m_cols(cols)
+            , m_keys(std::move(keys))
+            , m_screen(lines, cols)
+            , m_scratch(lines, cols)
+            , m_ended(true) {}
+
+        void begin() override
+        {
+            m_ended = false;
+        }
+
+        void end() override
+        {
+            m_ended = true;
+        }
+
+        bool ended() const override
+        {
+            return m_ended;
+        }
+
+        void suspend() override {}
+        void resume() override {}
+
+        int lines() const override
+        {
+            return m_lines;
+        }
+
+        int cols() const override
+        {
+            return m_cols;
+        }
+
+        canvas& screen() override
+        {
+            return m_screen;
+        }
+
+        canvas& scratch() override
+        {
+            return m_scratch;
+        }
+
+        std::unique_ptr<canvas> new_canvas(int lines, int cols, int, int) override
+        {
+            return std::make_unique<null_canvas>(lines, cols);
+        }
+
+        void redraw() override {}
+
+        int readchar() override
+        {
+            return m_keys();
+        }
+
+        void flush_input() override {}
+
+        int erasechar() override
+        {
+            return '\b';
+        }
+
+        int killchar() override
+        {
+            return 'U' & 037;
+        }
+
+        bool has_clreol() const override
+        {
+            return true;
+        }
+
+        bool slow() const override
+        {
+            return false;
+        }
+
+        void raw_standout() override {}
+        void raw_standend() override {}
+
+    private:
+        const int m_lines;
+        const int m_cols;
+        std::function<int()> m_keys;
+        null_canvas m_screen;
+        null_canvas m_scratch;
+        bool m_ended;
+    };
+}
+
+std::unique_ptr<renderer>
+null_renderer(int lines, int cols, std::function<int()> keys)
+{
+    return std::make_unique<null_screen>(lines, cols, std::move(keys));
+}
@@ -12,18 +12,15 @@
  * See the file LICENSE.TXT for full copyright and licensing information.
  */
 
+#include <array>
 #include <cctype>
 #include <cstdlib>
 #include <cstring>
 
-#include <ncurses.h>
-
 #include <roguepp/roguepp.hpp>
 
 #define	EQSTR(a, b, c)	(strncmp(a, b, c) == 0)
 
-#define	NUM_OPTS	(sizeof optlist / sizeof (OPTION))
-
 /*
  * description of an option and what to do with it
  */
@@ -37,35 +34,45 @@ struct optstruct
 				/* function to print value */
     void 	(*o_putfunc)(void *opt);
 				/* function to get value interactively */
-    int		(*o_getfunc)(void *opt, WINDOW *win);
+    int		(*o_getfunc)(void *opt, canvas* win);
 };
 
 typedef struct optstruct	OPTION;
 
 void	pr_optname(OPTION *op);
 
-OPTION	optlist[] = {
+/*
+ * game_options:
+ *	The options of the game being played
+ */
+static std::array<OPTION, 11>
+game_options()
+{
+    return {{
     {"terse",	 "Terse output",
-		 &terse,	put_bool,	get_bool	},
+		 &cur_game->terse,	put_bool,	get_bool	},
     {"flush",	 "Flush typeahead during battle",
-		 &fight_flush,	put_bool,	get_bool	},
+		 &cur_game->fight_flush,	put_bool,	get_bool	},
     {"jump",	 "Show position only at end of run",
-		 &jump,		put_bool,	get_bool	},
+		 &cur_game->jump,		put_bool,	get_bool	},
     {"seefloor", "Show the lamp-illuminated floor",
-		 &see_floor,	put_bool,	get_sf		},
+		 &cur_game->see_floor,	put_bool,	get_sf		},
     {"passgo",	"Follow turnings in passageways",
-		 &passgo,	put_bool,	get_bool	},
+		 &cur_game->passgo,	put_bool,	get_bool	},
     {"tombstone", "Print out tombstone when killed",
-		 &tombstone,	put_bool,	get_bool	},
+		 &cur_game->tombstone,	put_bool,	get_bool	},
     {"inven",	"Inventory style",
-		 &inv_type,	put_inv_t,	get_inv_t	},
+		 &cur_game->inv_type,	put_inv_t,	get_inv_t	},
     {"name",	 "Name",
-		 whoami,	put_str,	get_str		},
+		 cur_game->whoami,	put_str,	get_str		},
     {"fruit",	 "Fruit",
-		 fruit,		put_str,	get_str		},
+		 cur_game->fruit,		put_str,	get_str		},
     {"file",	 "Save file",
-		 file_name,	put_str,	get_str		}
-};
+		 cur_game->file_name,	put_str,	get_str		},
+    {"display",	 "Display (next game)",
+		 cur_game->display_name,	put_str,	get_str		}
+    }};
+}
 
 /*
  * option:
@@ -77,37 +84,38 @@ option()
 {
     OPTION	*op;
     int		retval;
+    auto	optlist = game_options();
 
-    wclear(hw);
+    cur_game->hw->clear();
     /*
      * Display current values of options
      */
-    for (op = optlist; op <= &optlist[NUM_OPTS-1]; op++)
+    for (op = optlist.data(); op <= &optlist.back(); op++)
     {
 	pr_optname(op);
 	(*op->o_putfunc)(op->o_opt);
-	waddch(hw, '\n');
+	cur_game->hw->addch('\n');
     }
     /*
      * Set values
      */
-    wmove(hw, 0, 0);
-    for (op = optlist; op <= &optlist[NUM_OPTS-1]; op++)
+    cur_game->hw->move(0, 0);
+    for (op = optlist.data(); op <= &optlist.back(); op++)
     {
 	pr_optname(op);
-	retval = (*op->o_getfunc)(op->o_opt, hw);
+	retval = (*op->o_getfunc)(op->o_opt, cur_game->hw);
 	if (retval)
 	{
 	    if (retval == QUIT)
 		break;
-	    else if (op > optlist) {	/* MINUS */
-		wmove(hw, (int)(op - optlist) - 1, 0);
+	    else if (op > optlist.data()) {	/* MINUS */
+		cur_game->hw->move((int)(op - optlist.data()) - 1, 0);
 		op -= 2;
 	    }
 	    else	/* trying to back up beyond the top */
 	    {
 		putchar('\007');
-		wmove(hw, 0, 0);
+		cur_game->hw->move(0, 0);
 		op--;
 	    }
 	}
@@ -115,13 +123,13 @@ option()
     /*
      * Switch back to original screen
      */
-    wmove(hw, LINES - 1, 0);
-    waddstr(hw, "--Press space to continue--");
-    wrefresh(hw);
+    cur_game->hw->move(cur_game->display->lines() - 1, 0);
+    cur_game->hw->addstr("--Press space to continue--");
+    cur_game->hw->refresh();
     wait_for(' ');
-    clearok(curscr, true);
-    touchwin(stdscr);
-    after = false;
+    cur_game->display->redraw();
+    cur_game->cw->touch();
+    cur_game->after = false;
 }
 
 /*
@@ -132,7 +140,7 @@ option()
 void
 pr_optname(OPTION *op)
 {
-    wprintw(hw, "%s (\"%s\"): ", op->o_prompt, op->o_name);
+    cur_game->hw->printw("%s (\"%s\"): ", op->o_prompt, op->o_name);
 }
 
 /*
@@ -143,7 +151,7 @@ pr_optname(OPTION *op)
 void
 put_bool(void *b)
 {
-    waddstr(hw, *(bool *) b ? "True" : "False");
+    cur_game->hw->addstr(*(bool *) b ? "True" : "False");
 }
 
 /*
@@ -154,7 +162,7 @@ put_bool(void *b)
 void
 put_str(void *str)
 {
-    waddstr(hw, (char *) str);
+    cur_game->hw->addstr((char *) str);
 }
 
 /*
@@ -165,7 +173,7 @@ put_str(void *str)
 void
 put_inv_t(void *ip)
 {
-    waddstr(hw, inv_t_name[*(int *) ip]);
+    cur_game->hw->addstr(inv_t_name[*(int *) ip]);
 }
 
 /*
@@ -173,19 +181,19 @@ put_inv_t(void *ip)
  *	Allow changing a boolean option and print it out
  */
 int
-get_bool(void *vp, WINDOW *win)
+get_bool(void *vp, canvas* win)
 {
     bool *bp = (bool *) vp;
     int oy, ox;
     bool op_bad;
 
     op_bad = true;
-    getyx(win, oy, ox);
-    waddstr(win, *bp ? "True" : "False");
+    win->getyx(oy, ox);
+    win->addstr(*bp ? "True" : "False");
     while (op_bad)
     {
-	wmove(win, oy, ox);
-	wrefresh(win);
+	win->move(oy, ox);
+	win->refresh();
 	switch (readchar())
 	{
 	    case 't':
@@ -207,13 +215,13 @@ get_bool(void *vp, WINDOW *win)
 	    case '-':
 		return MINUS;
 	    default:
-		wmove(win, oy, ox + 10);
-		waddstr(win, "(T or F)");
+		win->move(oy, ox + 10);
+		win->addstr("(T or F)");
 	}
     }
-    wmove(win, oy, ox);
-    waddstr(win, *bp ? "True" : "False");
-    waddch(win, '\n');
+    win->move(oy, ox);
+    win->addstr(*bp ? "True" : "False");
+    win->addch('\n');
     return NORM;
 }
 
@@ -223,21 +231,21 @@ get_bool(void *vp, WINDOW *win)
  *	!see_floor.
  */
 int
-get_sf(void *vp, WINDOW *win)
+get_sf(void *vp, canvas* win)
 {
     bool	*bp = (bool *) vp;
     bool	was_sf;
     int		retval;
 
-    was_sf = see_floor;
+    was_sf = cur_game->see_floor;
     retval = get_bool(bp, win);
     if (retval == QUIT) return(QUIT);
-    if (was_sf != see_floor)
+    if (was_sf != cur_game->see_floor)
     {
-	if (!see_floor) {
-	    see_floor = true;
+	if (!cur_game->see_floor) {
+	    cur_game->see_floor = true;
 	    erase_lamp(hero, *proom);
-	    see_floor = false;
+	    cur_game->see_floor = false;
 	}
 	else
 	    look(false);
@@ -252,49 +260,49 @@ get_sf(void *vp, WINDOW *win)
 #define MAXINP	50	/* max string to read from terminal or environment */
 
 int
-get_str(void *vopt, WINDOW *win)
+get_str(void *vopt, canvas* win)
 {
     char *opt = (char *) vopt;
     char *sp;
     int oy, ox;
     int i;
     signed char c;
-    static char buf[MAXSTR];
+    char buf[MAXSTR];
 
-    getyx(win, oy, ox);
-    wrefresh(win);
+    win->getyx(oy, ox);
+    win->refresh();
     /*
      * loop reading in the string, and put it in a temporary buffer
      */
     for (sp = buf; (c = readchar()) != '\n' && c != '\r' && c != ESCAPE;
-	wclrtoeol(win), wrefresh(win))
+	win->clrtoeol(), win->refresh())
     {
 	if (c == -1)
 	    continue;
-	else if (c == erasechar())	/* process erase character */
+	else if (c == cur_game->display->erasechar())	/* process erase character */
 	{
 	    if (sp > buf)
 	    {
 		sp--;
 		for (i = (int) strlen(unctrl(*sp)); i; i--)
-		    waddch(win, '\b');
+		    win->addch('\b');
 	    }
 	    continue;
 	}
-	else if (c == killchar())	/* process kill character */
+	else if (c == cur_game->display->killchar())	/* process kill character */
 	{
 	    sp = buf;
-	    wmove(win, oy, ox);
+	    win->move(oy, ox);
 	    continue;
 	}
 	else if (sp == buf)
 	{
-	    if (c == '-' && win != stdscr)
+	    if (c == '-' && win != cur_game->cw)
 		break;
 	    else if (c == '~')
 	    {
 		strcpy(buf, home);
-		waddstr(win, home);
+		win->addstr(home);
 		sp += strlen(home);
 		continue;
 	    }
@@ -304,16 +312,16 @@ get_str(void *vopt, WINDOW *win)
 	else
 	{
 	    *sp++ = c;
-	    waddstr(win, unctrl(c));
+	    win->addstr(unctrl(c));
 	}
     }
     *sp = '\0';
     if (sp > buf)	/* only change option if something has been typed */
 	strucpy(opt, buf, (int) strlen(buf));
-    mvwprintw(win, oy, ox, "%s\n", opt);
-    wrefresh(win);
-    if (win == stdscr)
-	mpos += (int)(sp - buf);
+    win->mvprintw(oy, ox, "%s\n", opt);
+    win->refresh();
+    if (win == cur_game->cw)
+	cur_game->mpos += (int)(sp - buf);
     if (c == '-')
 	return MINUS;
     else if (c == ESCAPE)
@@ -327,19 +335,19 @@ get_str(void *vopt, WINDOW *win)
  *	Get an inventory type name
  */
 int
-get_inv_t(void *vp, WINDOW *win)
+get_inv_t(void *vp, canvas* win)
 {
     int *ip = (int *) vp;
     int oy, ox;
     bool op_bad;
 
     op_bad = true;
-    getyx(win, oy, ox);
-    waddstr(win, inv_t_name[*ip]);
+    win->getyx(oy, ox);
+    win->addstr(inv_t_name[*ip]);
     while (op_bad)
     {
-	wmove(win, oy, ox);
-	wrefresh(win);
+	win->move(oy, ox);
+	win->refresh();
 	switch (readchar())
 	{
 	    case 'o':
@@ -366,11 +374,11 @@ get_inv_t(void *vp, WINDOW *win)
 	    case '-':
 		return MINUS;
 	    default:
-		wmove(win, oy, ox + 15);
-		waddstr(win, "(O, S, or C)");
+		win->move(oy, ox + 15);
+		win->addstr("(O, S, or C)");
 	}
     }
-    mvwprintw(win, oy, ox, "%s\n", inv_t_name[*ip]);
+    win->mvprintw(oy, ox, "%s\n", inv_t_name[*ip]);
     return NORM;
 }
 
@@ -381,11 +389,11 @@ get_inv_t(void *vp, WINDOW *win)
  *	Get a numeric option
  */
 int
-get_num(void *vp, WINDOW *win)
+get_num(void *vp, canvas* win)
 {
     short *opt = (short *) vp;
     int i;
-    static char buf[MAXSTR];
+    char buf[MAXSTR];
 
     if ((i = get_str(buf, win)) == NORM)
     {
@@ -411,6 +419,7 @@ parse_opts(char *str)
     OPTION *op;
     int len;
     char *start;
+    auto optlist = game_options();
 
     while (*str)
     {
@@ -423,7 +432,7 @@ parse_opts(char *str)
 	/*
 	 * Look it up and deal with it
 	 */
-	for (op = optlist; op <= &optlist[NUM_OPTS-1]; op++)
+	for (op = optlist.data(); op <= &optlist.back(); op++)
 	    if (EQSTR(str, op->o_name, len))
 	    {
 		if (op->o_putfunc == put_bool)	/* if option is a boolean */
@@ -462,7 +471,7 @@ parse_opts(char *str)
                 {
                     if (!std::strncmp(str, inv_t_name[i], sp - str))
                     {
-                        inv_type = static_cast<int>(i);
+                        cur_game->inv_type = static_cast<int>(i);
                         break;
                     }
                 }
@@ -13,8 +13,6 @@
 #include <cctype>
 #include <cstring>
 
-#include <ncurses.h>
-
 #include <roguepp/roguepp.hpp>
 
 static inline char pack_char();
@@ -46,8 +44,8 @@ add_pack(THING *obj, bool silent)
     if (obj->o_type == SCROLL && obj->o_which == S_SCARE)
 	if (obj->o_flags & ISFOUND)
 	{
-	    detach(lvl_obj, obj);
-	    mvaddch(hero.y, hero.x, floor_ch());
+	    detach(cur_game->lvl_obj, obj);
+	    cur_game->cw->mvaddch(hero.y, hero.x, floor_ch());
 	    chat(hero.y, hero.x) = (proom->r_flags & ISGONE) ? PASSAGE : FLOOR;
 	    discard(obj);
 	    msg("the scroll turns to dust as you pick it up");
@@ -56,9 +54,10 @@ add_pack(THING *obj, bool silent)
 
     if (pack == nullptr)
     {
+	if (!pack_room(from_floor, obj))
+	    return;
 	pack = obj;
 	obj->o_packch = pack_char();
-	inpack++;
     }
     else
     {
@@ -108,7 +107,7 @@ dump_it:
 			    && op->o_group == obj->o_group)
 			{
 				op->o_count += obj->o_count;
-				inpack--;
+				cur_game->inpack--;
 				if (!pack_room(from_floor, obj))
 				    return;
 				goto dump_it;
@@ -144,20 +143,21 @@ out:
      * If this was the object of something's desire, that monster will
      * get mad and run at the hero.
      */
-    for (op = mlist; op != nullptr; op = next(op))
+    for (op = cur_game->mlist; op != nullptr; op = next(op))
 	if (op->t_dest == &obj->o_pos)
 	    op->t_dest = &hero;
+    obj = keep_item(&pack, obj);
 
     if (obj->o_type == AMULET)
-	amulet = true;
+	cur_game->amulet = true;
     /*
      * Notify the user
      */
     if (!silent)
     {
-	if (!terse)
+	if (!cur_game->terse)
 	    addmsg("you now have ");
-	msg("%s (%c)", inv_name(obj, !terse), obj->o_packch);
+	msg("%s (%c)", inv_name(obj, !cur_game->terse), obj->o_packch);
     }
 }
 
@@ -169,24 +169,24 @@ out:
 bool
 pack_room(bool from_floor, THING *obj)
 {
-    if (++inpack > MAXPACK)
+    if (++cur_game->inpack > MAXPACK)
     {
-	if (!terse)
+	if (!cur_game->terse)
 	    addmsg("there's ");
 	addmsg("no room");
-	if (!terse)
+	if (!cur_game->terse)
 	    addmsg(" in your pack");
 	endmsg();
 	if (from_floor)
 	    move_msg(obj);
-	inpack = MAXPACK;
+	cur_game->inpack = MAXPACK;
 	return false;
     }
 
     if (from_floor)
     {
-	detach(lvl_obj, obj);
-	mvaddch(hero.y, hero.x, floor_ch());
+	detach(cur_game->lvl_obj, obj);
+	cur_game->cw->mvaddch(hero.y, hero.x, floor_ch());
 	chat(hero.y, hero.x) = (proom->r_flags & ISGONE) ? PASSAGE : FLOOR;
     }
 
@@ -202,14 +202,14 @@ leave_pack(THING *obj, bool newobj, bool all)
 {
     THING *nobj;
 
-    inpack--;
+    cur_game->inpack--;
     nobj = obj;
     if (obj->o_count > 1 && !all)
     {
-	last_pick = obj;
+	cur_game->last_pick = obj;
 	obj->o_count--;
 	if (obj->o_group)
-	    inpack++;
+	    cur_game->inpack++;
 	if (newobj)
 	{
 	    nobj = new_item();
@@ -221,8 +221,8 @@ leave_pack(THING *obj, bool newobj, bool all)
     }
     else
     {
-	last_pick = nullptr;
-	pack_used[obj->o_packch - 'a'] = false;
+	cur_game->last_pick = nullptr;
+	cur_game->pack_used[obj->o_packch - 'a'] = false;
 	detach(pack, obj);
     }
     return nobj;
@@ -237,8 +237,8 @@ pack_char()
 {
     std::size_t i;
 
-    for (i = 0; pack_used[i]; ++i);
-    pack_used[i] = true;
+    for (i = 0; cur_game->pack_used[i]; ++i);
+    cur_game->pack_used[i] = true;
 
     return static_cast<char>(static_cast<int>(i) + 'a');
 }
@@ -251,34 +251,34 @@ pack_char()
 bool
 inventory(THING *list, int type)
 {
-    static char inv_temp[MAXSTR];
+    char inv_temp[MAXSTR];
 
-    n_objs = 0;
+    cur_game->n_objs = 0;
     for (; list != nullptr; list = next(list))
     {
 	if (type && type != list->o_type && !(type == CALLABLE &&
 	    list->o_type != FOOD && list->o_type != AMULET) &&
 	    !(type == R_OR_S && (list->o_type == RING || list->o_type == STICK)))
 		continue;
-	n_objs++;
+	cur_game->n_objs++;
 #ifdef MASTER
 	if (!list->o_packch)
 	    strcpy(inv_temp, "%s");
 	else
 #endif
 	    sprintf(inv_temp, "%c) %%s", list->o_packch);
-	msg_esc = true;
+	cur_game->msg_esc = true;
 	if (add_line(inv_temp, inv_name(list, false)) == ESCAPE)
 	{
-	    msg_esc = false;
+	    cur_game->msg_esc = false;
 	    msg("");
 	    return true;
 	}
-	msg_esc = false;
+	cur_game->msg_esc = false;
     }
-    if (n_objs == 0)
+    if (cur_game->n_objs == 0)
     {
-	if (terse)
+	if (cur_game->terse)
 	    msg(type == 0 ? "empty handed" :
 			    "nothing appropriate");
 	else
@@ -300,11 +300,11 @@ pick_up(char ch)
 {
     THING *obj;
 
-    if (on(player, ISLEVIT))
+    if (on(cur_game->player, ISLEVIT))
 	return;
 
     obj = find_obj(hero.y, hero.x);
-    if (move_on)
+    if (cur_game->move_on)
 	move_msg(obj);
     else
 	switch (ch)
@@ -313,7 +313,7 @@ pick_up(char ch)
 		if (obj == nullptr)
 		    return;
 		money(obj->o_goldval);
-		detach(lvl_obj, obj);
+		detach(cur_game->lvl_obj, obj);
 		discard(obj);
 		proom->r_goldval = 0;
 		break;
@@ -342,7 +342,7 @@ pick_up(char ch)
 void
 move_msg(THING *obj)
 {
-    if (!terse)
+    if (!cur_game->terse)
 	addmsg("you ");
     msg("moved onto %s", inv_name(obj, true));
 }
@@ -364,8 +364,8 @@ picky_inven()
 	msg("a) %s", inv_name(pack, false));
     else
     {
-	msg(terse ? "item: " : "which item do you wish to inventory: ");
-	mpos = 0;
+	msg(cur_game->terse ? "item: " : "which item do you wish to inventory: ");
+	cur_game->mpos = 0;
 	if ((mch = readchar()) == ESCAPE)
 	{
 	    msg("");
@@ -393,40 +393,40 @@ get_item(const char* purpose, int type)
 
     if (pack == nullptr)
 	msg("you aren't carrying anything");
-    else if (again)
-	if (last_pick)
-	    return last_pick;
+    else if (cur_game->again)
+	if (cur_game->last_pick)
+	    return cur_game->last_pick;
 	else
 	    msg("you ran out");
     else
     {
 	for (;;)
 	{
-	    if (!terse)
+	    if (!cur_game->terse)
 		addmsg("which object do you want to ");
 	    addmsg(purpose);
-	    if (terse)
+	    if (cur_game->terse)
 		addmsg(" what");
 	    msg("? (* for list): ");
 	    ch = readchar();
-	    mpos = 0;
+	    cur_game->mpos = 0;
 	    /*
 	     * Give the poor player a chance to abort the command
 	     */
 	    if (ch == ESCAPE)
 	    {
 		reset_last();
-		after = false;
+		cur_game->after = false;
 		msg("");
 		return nullptr;
 	    }
-	    n_objs = 1;		/* normal case: person types one char */
+	    cur_game->n_objs = 1;		/* normal case: person types one char */
 	    if (ch == '*')
 	    {
-		mpos = 0;
+		cur_game->mpos = 0;
 		if (inventory(pack, type) == 0)
 		{
-		    after = false;
+		    cur_game->after = false;
 		    return nullptr;
 		}
 		continue;
@@ -454,12 +454,12 @@ get_item(const char* purpose, int type)
 void
 money(int value)
 {
-    purse += value;
-    mvaddch(hero.y, hero.x, floor_ch());
+    cur_game->purse += value;
+    cur_game->cw->mvaddch(hero.y, hero.x, floor_ch());
     chat(hero.y, hero.x) = (proom->r_flags & ISGONE) ? PASSAGE : FLOOR;
     if (value > 0)
     {
-	if (!terse)
+	if (!cur_game->terse)
 	    addmsg("you found ");
 	msg("%d gold pieces", value);
     }
@@ -501,7 +501,7 @@ floor_at()
 void
 reset_last()
 {
-    last_comm = l_last_comm;
-    last_dir = l_last_dir;
-    last_pick = l_last_pick;
+    cur_game->last_comm = cur_game->l_last_comm;
+    cur_game->last_dir = cur_game->l_last_dir;
+    cur_game->last_pick = cur_game->l_last_pick;
 }
@@ -12,8 +12,6 @@
 
 #include <cstdlib>
 
-#include <ncurses.h>
-
 #include <roguepp/roguepp.hpp>
 
 static void passnum();
@@ -29,7 +27,7 @@ do_passages()
     struct rdes *r1, *r2 = nullptr;
     int i, j;
     int roomcount;
-    static struct rdes
+    static thread_local struct rdes
     {
 	bool	conn[MAXROOMS];		/* possible to connect to room i? */
 	bool	isconn[MAXROOMS];	/* connection been made to room i? */
@@ -141,7 +139,7 @@ conn(int r1, int r2)
     int distance = 0, turn_spot, turn_distance = 0;
     int rm;
     char direc;
-    static coord del, curr, turn_delta, spos, epos;
+    static thread_local coord del, curr, turn_delta, spos, epos;
 
     if (r1 < r2)
     {
@@ -159,7 +157,7 @@ conn(int r1, int r2)
 	else
 	    direc = 'd';
     }
-    rpf = &rooms[rm];
+    rpf = &cur_game->rooms[rm];
     /*
      * Set up the movement variables, in two cases:
      * first drawing one down.
@@ -167,7 +165,7 @@ conn(int r1, int r2)
     if (direc == 'd')
     {
 	rmt = rm + 3;				/* room # of dest */
-	rpt = &rooms[rmt];			/* room pointer of dest */
+	rpt = &cur_game->rooms[rmt];			/* room pointer of dest */
 	del.x = 0;				/* direction of move */
 	del.y = 1;
 	spos.x = rpf->r_pos.x;			/* start of move */
@@ -193,7 +191,7 @@ conn(int r1, int r2)
     else if (direc == 'r')			/* setup for moving right */
     {
 	rmt = rm + 1;
-	rpt = &rooms[rmt];
+	rpt = &cur_game->rooms[rmt];
 	del.x = 1;
 	del.y = 0;
 	spos.x = rpf->r_pos.x;
@@ -281,7 +279,7 @@ putpass(coord *cp)
 
     pp = INDEX(cp->y, cp->x);
     pp->p_flags |= F_PASS;
-    if (rnd(10) + 1 < level && rnd(40) == 0)
+    if (rnd(10) + 1 < cur_game->level && rnd(40) == 0)
 	pp->p_flags &= ~F_REAL;
     else
 	pp->p_ch = PASSAGE;
@@ -304,7 +302,7 @@ door(struct room *rm, coord *cp)
 	return;
 
     pp = INDEX(cp->y, cp->x);
-    if (rnd(10) + 1 < level && rnd(5) == 0)
+    if (rnd(10) + 1 < cur_game->level && rnd(5) == 0)
     {
 	if (cp->y == rm->r_pos.y || cp->y == rm->r_pos.y + rm->r_max.y - 1)
 		pp->p_ch = '-';
@@ -340,24 +338,24 @@ add_pass()
 		if (pp->p_flags & F_PASS)
 		    ch = PASSAGE;
 		pp->p_flags |= F_SEEN;
-		move(y, x);
+		cur_game->cw->move(y, x);
 		if (pp->p_monst != nullptr)
 		    pp->p_monst->t_oldch = pp->p_ch;
 		else if (pp->p_flags & F_REAL)
-		    addch(ch);
+		    cur_game->cw->addch(ch);
 		else
 		{
-		    standout();
-		    addch((pp->p_flags & F_PASS) ? PASSAGE : DOOR);
-		    standend();
+		    cur_game->cw->standout();
+		    cur_game->cw->addch((pp->p_flags & F_PASS) ? PASSAGE : DOOR);
+		    cur_game->cw->standend();
 		}
 	    }
 	}
 }
 #endif
 
-static int pnum;
-static int newpnum;
+static thread_local int pnum;
+static thread_local int newpnum;
 
 /**
  *  Assign a number to each passageway
@@ -369,11 +367,11 @@ passnum()
     newpnum = 0;
     for (std::size_t i = 0; i < MAXPASS; ++i)
     {
-        passages[i].r_nexits = 0;
+        cur_game->passages[i].r_nexits = 0;
     }
     for (std::size_t i = 0; i < MAXROOMS; ++i)
     {
-        const auto& rp = rooms[i];
+        const auto& rp = cur_game->rooms[i];
 
         for (std::size_t j = 0; j < rp.r_nexits; ++j)
         {
@@ -412,7 +410,7 @@ numpass(int y, int x)
     if ((ch = chat(y, x)) == DOOR ||
 	(!(*fp & F_REAL) && (ch == '|' || ch == '-')))
     {
-	rp = &passages[pnum];
+	rp = &cur_game->passages[pnum];
 	rp->r_exit[rp->r_nexits].y = y;
 	rp->r_exit[rp->r_nexits++].x = x;
     }
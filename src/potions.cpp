@@ -12,8 +12,6 @@
 
 #include <cctype>
 
-#include <ncurses.h>
-
 #include <roguepp/roguepp.hpp>
 
 struct PACT
@@ -36,8 +34,8 @@ static PACT p_actions[] =
 	{ 0,		nullptr,	0 },			/* P_POISON */
 	{ 0,		nullptr,	0 },			/* P_STRENGTH */
 	{ CANSEE,	unsee,	SEEDURATION,		/* P_SEEINVIS */
-		prbuf,
-		prbuf },
+		nullptr,				/* message is in prbuf */
+		nullptr },
 	{ 0,		nullptr,	0 },			/* P_HEALING */
 	{ 0,		nullptr,	0 },			/* P_MFIND */
 	{ 0,		nullptr,	0 },			/* P_TFIND  */
@@ -79,19 +77,19 @@ quaff()
 	return;
     if (obj->o_type != POTION)
     {
-	if (!terse)
+	if (!cur_game->terse)
 	    msg("yuk! Why would you want to drink that?");
 	else
 	    msg("that's undrinkable");
 	return;
     }
-    if (obj == cur_weapon)
-	cur_weapon = nullptr;
+    if (obj == cur_game->cur_weapon)
+	cur_game->cur_weapon = nullptr;
 
     /*
      * Calculate the effect it has on the poor guy.
      */
-    trip = on(player, ISHALU);
+    trip = on(cur_game->player, ISHALU);
     discardit = (bool)(obj->o_count == 1);
     leave_pack(obj, false, false);
     switch (obj->o_which)
@@ -99,7 +97,7 @@ quaff()
 	case P_CONFUSE:
 	    do_pot(P_CONFUSE, !trip);
 	when P_POISON:
-	    pot_info[P_POISON].oi_know = true;
+	    cur_game->pot_info[P_POISON].oi_know = true;
 	    if (ISWEARING(R_SUSTSTR))
 		msg("you feel momentarily sick");
 	    else
@@ -109,17 +107,17 @@ quaff()
 		come_down(0);
 	    }
 	when P_HEALING:
-	    pot_info[P_HEALING].oi_know = true;
+	    cur_game->pot_info[P_HEALING].oi_know = true;
 	    if ((pstats.s_hpt += roll(pstats.s_lvl, 4)) > max_hp)
 		pstats.s_hpt = ++max_hp;
 	    sight(0);
 	    msg("you begin to feel better");
 	when P_STRENGTH:
-	    pot_info[P_STRENGTH].oi_know = true;
+	    cur_game->pot_info[P_STRENGTH].oi_know = true;
 	    chg_str(1);
 	    msg("you feel stronger, now.  What bulging muscles!");
 	when P_MFIND:
-	    player.t_flags |= SEEMONST;
+	    cur_game->player.t_flags |= SEEMONST;
         fuse(turn_see_wrapper, true, HUHDURATION, AFTER);
 	    if (!turn_see(false))
 		msg("you have a %s feeling for a moment, then it passes",
@@ -129,35 +127,35 @@ quaff()
 	     * Potion of magic detection.  Show the potions and scrolls
 	     */
 	    show = false;
-	    if (lvl_obj != nullptr)
+	    if (cur_game->lvl_obj != nullptr)
 	    {
-		wclear(hw);
-		for (tp = lvl_obj; tp != nullptr; tp = next(tp))
+		cur_game->hw->clear();
+		for (tp = cur_game->lvl_obj; tp != nullptr; tp = next(tp))
 		{
 		    if (is_magic(tp))
 		    {
 			show = true;
-			wmove(hw, tp->o_pos.y, tp->o_pos.x);
-			waddch(hw, MAGIC);
-			pot_info[P_TFIND].oi_know = true;
+			cur_game->hw->move(tp->o_pos.y, tp->o_pos.x);
+			cur_game->hw->addch(MAGIC);
+			cur_game->pot_info[P_TFIND].oi_know = true;
 		    }
 		}
-		for (mp = mlist; mp != nullptr; mp = next(mp))
+		for (mp = cur_game->mlist; mp != nullptr; mp = next(mp))
 		{
 		    for (tp = mp->t_pack; tp != nullptr; tp = next(tp))
 		    {
 			if (is_magic(tp))
 			{
 			    show = true;
-			    wmove(hw, mp->t_pos.y, mp->t_pos.x);
-			    waddch(hw, MAGIC);
+			    cur_game->hw->move(mp->t_pos.y, mp->t_pos.x);
+			    cur_game->hw->addch(MAGIC);
 			}
 		    }
 		}
 	    }
 	    if (show)
 	    {
-		pot_info[P_TFIND].oi_know = true;
+		cur_game->pot_info[P_TFIND].oi_know = true;
 		show_win("You sense the presence of magic on this level.--More--");
 	    }
 	    else
@@ -166,25 +164,25 @@ quaff()
 	when P_LSD:
 	    if (!trip)
 	    {
-		if (on(player, SEEMONST))
+		if (on(cur_game->player, SEEMONST))
 		    turn_see(false);
 		start_daemon(visuals, 0, BEFORE);
-		seenstairs = seen_stairs();
+		cur_game->seenstairs = seen_stairs();
 	    }
 	    do_pot(P_LSD, true);
 	when P_SEEINVIS:
-	    sprintf(prbuf, "this potion tastes like %s juice", fruit);
-	    show = on(player, CANSEE);
+	    sprintf(cur_game->prbuf, "this potion tastes like %s juice", cur_game->fruit);
+	    show = on(cur_game->player, CANSEE);
 	    do_pot(P_SEEINVIS, false);
 	    if (!show)
 		invis_on();
 	    sight(0);
 	when P_RAISE:
-	    pot_info[P_RAISE].oi_know = true;
+	    cur_game->pot_info[P_RAISE].oi_know = true;
 	    msg("you suddenly feel much more skillful");
 	    raise_level();
 	when P_XHEAL:
-	    pot_info[P_XHEAL].oi_know = true;
+	    cur_game->pot_info[P_XHEAL].oi_know = true;
 	    if ((pstats.s_hpt += roll(pstats.s_lvl, 8)) > max_hp)
 	    {
 		if (pstats.s_hpt > max_hp + pstats.s_lvl + 1)
@@ -195,21 +193,21 @@ quaff()
 	    come_down(0);
 	    msg("you begin to feel much better");
 	when P_HASTE:
-	    pot_info[P_HASTE].oi_know = true;
-	    after = false;
+	    cur_game->pot_info[P_HASTE].oi_know = true;
+	    cur_game->after = false;
 	    if (add_haste(true))
 		msg("you feel yourself moving much faster");
 	when P_RESTORE:
 	    if (ISRING(LEFT, R_ADDSTR))
-		add_str(&pstats.s_str, -cur_ring[LEFT]->o_arm);
+		add_str(&pstats.s_str, -cur_game->cur_ring[LEFT]->o_arm);
 	    if (ISRING(RIGHT, R_ADDSTR))
-		add_str(&pstats.s_str, -cur_ring[RIGHT]->o_arm);
-	    if (pstats.s_str < max_stats.s_str)
-		pstats.s_str = max_stats.s_str;
+		add_str(&pstats.s_str, -cur_game->cur_ring[RIGHT]->o_arm);
+	    if (pstats.s_str < cur_game->max_stats.s_str)
+		pstats.s_str = cur_game->max_stats.s_str;
 	    if (ISRING(LEFT, R_ADDSTR))
-		add_str(&pstats.s_str, cur_ring[LEFT]->o_arm);
+		add_str(&pstats.s_str, cur_game->cur_ring[LEFT]->o_arm);
 	    if (ISRING(RIGHT, R_ADDSTR))
-		add_str(&pstats.s_str, cur_ring[RIGHT]->o_arm);
+		add_str(&pstats.s_str, cur_game->cur_ring[RIGHT]->o_arm);
 	    msg("hey, this tastes great.  It make you feel warm all over");
 	when P_BLIND:
 	    do_pot(P_BLIND, true);
@@ -226,7 +224,7 @@ quaff()
      * Throw the item away
      */
 
-    call_it(&pot_info[obj->o_which]);
+    call_it(&cur_game->pot_info[obj->o_which]);
 
     if (discardit)
 	discard(obj);
@@ -266,10 +264,10 @@ invis_on()
 {
     THING *mp;
 
-    player.t_flags |= CANSEE;
-    for (mp = mlist; mp != nullptr; mp = next(mp))
-	if (on(*mp, ISINVIS) && see_monst(mp) && !on(player, ISHALU))
-	    mvaddch(mp->t_pos.y, mp->t_pos.x, mp->t_disguise);
+    cur_game->player.t_flags |= CANSEE;
+    for (mp = cur_game->mlist; mp != nullptr; mp = next(mp))
+	if (on(*mp, ISINVIS) && see_monst(mp) && !on(cur_game->player, ISHALU))
+	    cur_game->cw->mvaddch(mp->t_pos.y, mp->t_pos.x, mp->t_disguise);
 }
 
 /*
@@ -283,34 +281,34 @@ turn_see(bool turn_off)
     bool can_see;
     int add_new = false;
 
-    for (mp = mlist; mp != nullptr; mp = next(mp))
+    for (mp = cur_game->mlist; mp != nullptr; mp = next(mp))
     {
-	move(mp->t_pos.y, mp->t_pos.x);
+	cur_game->cw->move(mp->t_pos.y, mp->t_pos.x);
 	can_see = see_monst(mp);
 	if (turn_off)
 	{
 	    if (!can_see)
-		addch(mp->t_oldch);
+		cur_game->cw->addch(mp->t_oldch);
 	}
 	else
 	{
 	    if (!can_see)
-		standout();
-	    if (!on(player, ISHALU))
-		addch(mp->t_type);
+		cur_game->cw->standout();
+	    if (!on(cur_game->player, ISHALU))
+		cur_game->cw->addch(mp->t_type);
 	    else
-		addch(rnd(26) + 'A');
+		cur_game->cw->addch(rnd(26) + 'A');
 	    if (!can_see)
 	    {
-		standend();
+		cur_game->cw->standend();
 		add_new++;
 	    }
 	}
     }
     if (turn_off)
-	player.t_flags &= ~SEEMONST;
+	cur_game->player.t_flags &= ~SEEMONST;
     else
-	player.t_flags |= SEEMONST;
+	cur_game->player.t_flags |= SEEMONST;
     return add_new;
 }
 
@@ -323,21 +321,21 @@ seen_stairs()
 {
     THING	*tp;
 
-    move(stairs.y, stairs.x);
-    if (inch() == STAIRS)			/* it's on the map */
+    cur_game->cw->move(cur_game->stairs.y, cur_game->stairs.x);
+    if (cur_game->cw->inch() == STAIRS)			/* it's on the map */
 	return true;
-    if (ce(hero, stairs))			/* It's under him */
+    if (ce(hero, cur_game->stairs))			/* It's under him */
 	return true;
 
     /*
      * if a monster is on the stairs, this gets hairy
      */
-    if ((tp = moat(stairs.y, stairs.x)) != nullptr)
+    if ((tp = moat(cur_game->stairs.y, cur_game->stairs.x)) != nullptr)
     {
 	if (see_monst(tp) && on(*tp, ISRUN))	/* if it's visible and awake */
 	    return true;			/* it must have moved there */
 
-	if (on(player, SEEMONST)		/* if she can detect monster */
+	if (on(cur_game->player, SEEMONST)		/* if she can detect monster */
 	    && tp->t_oldch == STAIRS)		/* and there once were stairs */
 		return true;			/* it must have moved there */
     }
@@ -369,16 +367,19 @@ do_pot(int type, bool knowit)
     int t;
 
     pp = &p_actions[type];
-    if (!pot_info[type].oi_know)
-	pot_info[type].oi_know = knowit;
+    if (!cur_game->pot_info[type].oi_know)
+	cur_game->pot_info[type].oi_know = knowit;
     t = spread(pp->pa_time);
-    if (!on(player, pp->pa_flags))
+    if (!on(cur_game->player, pp->pa_flags))
     {
-	player.t_flags |= pp->pa_flags;
+	cur_game->player.t_flags |= pp->pa_flags;
 	fuse(pp->pa_daemon, 0, t, AFTER);
 	look(false);
     }
     else
 	lengthen(pp->pa_daemon, t);
-    msg(choose_str(pp->pa_high, pp->pa_straight));
+    if (pp->pa_high == nullptr)
+	msg(cur_game->prbuf);
+    else
+	msg(choose_str(pp->pa_high, pp->pa_straight));
 }
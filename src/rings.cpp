@@ -12,8 +12,6 @@
 
 #include <cstdio>
 
-#include <ncurses.h>
-
 #include <roguepp/roguepp.hpp>
 
 /*
@@ -35,7 +33,7 @@ ring_on()
 	return;
     if (obj->o_type != RING)
     {
-	if (!terse)
+	if (!cur_game->terse)
 	    msg("it would be difficult to wrap that around a finger");
 	else
 	    msg("not a ring");
@@ -48,24 +46,24 @@ ring_on()
     if (is_current(obj))
 	return;
 
-    if (cur_ring[LEFT] == nullptr && cur_ring[RIGHT] == nullptr)
+    if (cur_game->cur_ring[LEFT] == nullptr && cur_game->cur_ring[RIGHT] == nullptr)
     {
 	if ((ring = gethand()) < 0)
 	    return;
     }
-    else if (cur_ring[LEFT] == nullptr)
+    else if (cur_game->cur_ring[LEFT] == nullptr)
 	ring = LEFT;
-    else if (cur_ring[RIGHT] == nullptr)
+    else if (cur_game->cur_ring[RIGHT] == nullptr)
 	ring = RIGHT;
     else
     {
-	if (!terse)
+	if (!cur_game->terse)
 	    msg("you already have a ring on each hand");
 	else
 	    msg("wearing two");
 	return;
     }
-    cur_ring[ring] = obj;
+    cur_game->cur_ring[ring] = obj;
 
     /*
      * Calculate the effect it has on the poor guy.
@@ -83,7 +81,7 @@ ring_on()
 	    break;
     }
 
-    if (!terse)
+    if (!cur_game->terse)
 	addmsg("you are now wearing ");
     msg("%s (%c)", inv_name(obj, true), obj->o_packch);
 }
@@ -99,23 +97,23 @@ ring_off()
     int ring;
     THING *obj;
 
-    if (cur_ring[LEFT] == nullptr && cur_ring[RIGHT] == nullptr)
+    if (cur_game->cur_ring[LEFT] == nullptr && cur_game->cur_ring[RIGHT] == nullptr)
     {
-	if (terse)
+	if (cur_game->terse)
 	    msg("no rings");
 	else
 	    msg("you aren't wearing any rings");
 	return;
     }
-    else if (cur_ring[LEFT] == nullptr)
+    else if (cur_game->cur_ring[LEFT] == nullptr)
 	ring = RIGHT;
-    else if (cur_ring[RIGHT] == nullptr)
+    else if (cur_game->cur_ring[RIGHT] == nullptr)
 	ring = LEFT;
     else
 	if ((ring = gethand()) < 0)
 	    return;
-    mpos = 0;
-    obj = cur_ring[ring];
+    cur_game->mpos = 0;
+    obj = cur_game->cur_ring[ring];
     if (obj == nullptr)
     {
 	msg("not wearing such a ring");
@@ -136,18 +134,18 @@ gethand()
 
     for (;;)
     {
-	if (terse)
+	if (cur_game->terse)
 	    msg("left or right ring? ");
 	else
 	    msg("left hand or right hand? ");
 	if ((c = readchar()) == ESCAPE)
 	    return -1;
-	mpos = 0;
+	cur_game->mpos = 0;
 	if (c == 'l' || c == 'L')
 	    return LEFT;
 	else if (c == 'r' || c == 'R')
 	    return RIGHT;
-	if (terse)
+	if (cur_game->terse)
 	    msg("L or R");
 	else
 	    msg("please type L or R");
@@ -173,7 +171,7 @@ ring_eat(int hand)
 	 1,	/* R_STEALTH */		 1	/* R_SUSTARM */
     };
 
-    if ((ring = cur_ring[hand]) == nullptr)
+    if ((ring = cur_game->cur_ring[hand]) == nullptr)
 	return 0;
     if ((eat = uses[ring->o_which]) < 0)
 	eat = (rnd(-eat) == 0);
@@ -189,7 +187,7 @@ ring_eat(int hand)
 std::string
 ring_num(const THING& obj)
 {
-    static char buffer[10];
+    static thread_local char buffer[10];
     int length;
 
     if (!(obj.o_flags & ISKNOW))
@@ -21,8 +21,6 @@
 #include <fcntl.h>
 #include <sys/types.h>
 
-#include <ncurses.h>
-
 #include <roguepp/roguepp.hpp>
 #include <roguepp/score.hpp>
 
@@ -44,6 +42,50 @@ static const char* rip[] =
     nullptr
 };
 
+#ifdef MASTER
+/*
+ * drop_score:
+ *	Take the entry at the given rank out of the score list
+ */
+static bool
+drop_score(score_table& top_ten, int rank)
+{
+    if (score_keeper >= 0)
+	return score_client(score_keeper).remove(rank, top_ten);
+    if (!lock_sc())
+	return false;
+    top_ten.remove(rank);
+    unlock_sc();
+    return true;
+}
+#endif
+
+/*
+ * put_line:
+ *	Show a line of the score list where the game is played: on its
+ *	own window if it is embedded, or else on the terminal it ran on
+ */
+static void
+put_line(const char* line, bool highlight)
+{
+    if (cur_game->embedded)
+    {
+	if (highlight)
+	    cur_game->cw->standout();
+	cur_game->cw->addstr(line);
+	if (highlight)
+	    cur_game->cw->standend();
+	cur_game->cw->addch('\n');
+	return;
+    }
+    if (highlight)
+	cur_game->display->raw_standout();
+    printf("%s", line);
+    if (highlight)
+	cur_game->display->raw_standend();
+    putchar('\n');
+}
+
 /*
  * score:
  *	Figure score and post it.
@@ -60,169 +102,168 @@ score(int amount, int flags, char monst)
         "A total winner",
         "killed with Amulet",
     };
-    SCORE *scp;
+    score_table top_ten(scoreboard, numscores);
+    SCORE entry;
+    char line[2 * MAXSTR];
+    int len;
     int i;
-    SCORE *sc2;
-    SCORE *top_ten, *endp;
+    int rank = -1;
+    bool answered = false;
+    bool journaled = false;
 # ifdef MASTER
     int prflags = 0;
 # endif
     void (*fp)(int);
-    unsigned int uid;
+
+    /*
+     * Some games just hand the result back to whoever runs them
+     */
+    cur_game->end_score = amount;
+    cur_game->end_flags = flags;
+    cur_game->end_monst = monst;
+    if (cur_game->hand_back)
+	my_exit(0);
 
     start_score();
 
  if (flags >= 0
 #ifdef MASTER
-            || wizard
+            || cur_game->wizard
 #endif
         )
     {
-	mvaddstr(LINES - 1, 0 , "[Press return to continue]");
-        refresh();
-        wgetnstr(stdscr,prbuf,80);
- 	endwin();
-        printf("\n");
-        resetltchars();
-	/*
-	 * free up space to "guarantee" there is space for the top_ten
-	 */
-	delwin(stdscr);
-	delwin(curscr);
-	if (hw != nullptr)
-	    delwin(hw);
-    }
-
-    top_ten = (SCORE *) malloc(numscores * sizeof (SCORE));
-    endp = &top_ten[numscores];
-    for (scp = top_ten; scp < endp; scp++)
-    {
-	scp->sc_score = 0;
-	for (i = 0; i < MAXSTR; i++)
-	    scp->sc_name[i] = (unsigned char) rnd(255);
-	scp->sc_flags = RN;
-	scp->sc_level = RN;
-	scp->sc_monster = (unsigned short) RN;
-	scp->sc_uid = RN;
+	cur_game->cw->mvaddstr(cur_game->display->lines() - 1, 0 , "[Press return to continue]");
+        cur_game->cw->refresh();
+        cur_game->prbuf[0] = '\0';
+        get_str(cur_game->prbuf, cur_game->cw);
+	if (cur_game->embedded)
+	    cur_game->cw->clear();
+	else
+	{
+	    cur_game->display->end();
+	    printf("\n");
+	    resetltchars();
+	}
     }
 
-    signal(SIGINT, SIG_DFL);
+    if (!cur_game->embedded)
+	signal(SIGINT, SIG_DFL);
 
 #ifdef MASTER
-    if (wizard)
-	if (strcmp(prbuf, "names") == 0)
+    if (cur_game->wizard && !cur_game->embedded)
+	if (strcmp(cur_game->prbuf, "names") == 0)
 	    prflags = 1;
-	else if (strcmp(prbuf, "edit") == 0)
+	else if (strcmp(cur_game->prbuf, "edit") == 0)
 	    prflags = 2;
 #endif
-    rd_score(top_ten);
+    std::memset(&entry, 0, sizeof(entry));
+    entry.sc_uid = cur_game->uid >= 0 ? cur_game->uid : md_getuid();
+    entry.sc_score = amount;
+    strncpy(entry.sc_name, cur_game->whoami, MAXSTR - 1);
+    entry.sc_flags = flags;
+    if (flags == 2)
+	entry.sc_level = cur_game->max_level;
+    else
+	entry.sc_level = cur_game->level;
+    entry.sc_monster = monst;
+    entry.sc_time = static_cast<unsigned int>(std::time(nullptr));
     /*
-     * Insert her in list if need be
+     * Post the score if need be, through the score keeper if there is
+     * one, or else reading the list afresh under the lock so that
+     * nobody else's goes missing.  A game the keeper answered when it
+     * started has no score file of its own: if the keeper has gone
+     * since, the journal keeps the score until it is back.  Every game
+     * goes in the journal, whether it makes the list or not.
      */
-    sc2 = nullptr;
-    if (!noscore)
+    if (score_keeper >= 0)
     {
-	uid = md_getuid();
-	for (scp = top_ten; scp < endp; scp++)
-	    if (amount > scp->sc_score)
-		break;
-	    else if (!allscore &&	/* only one score per nowin uid */
-		flags != 2 && scp->sc_uid == uid && scp->sc_flags != 2)
-		    scp = endp;
-	if (scp < endp)
+	score_client keeper(score_keeper);
+	score_table kept(nullptr, numscores);
+
+	if (!cur_game->noscore)
+	    answered = keeper.post(entry, kept, rank);
+	else
+	    answered = keeper.list(kept);
+	if (answered)
+	    top_ten = kept;
+	else
 	{
-	    if (flags != 2 && !allscore)
-	    {
-		for (sc2 = scp; sc2 < endp; sc2++)
-		{
-		    if (sc2->sc_uid == uid && sc2->sc_flags != 2)
-			break;
-		}
-		if (sc2 >= endp)
-		    sc2 = endp - 1;
-	    }
-	    else
-		sc2 = endp - 1;
-	    while (sc2 > scp)
-	    {
-		*sc2 = sc2[-1];
-		sc2--;
-	    }
-	    scp->sc_score = amount;
-	    strncpy(scp->sc_name, whoami, MAXSTR);
-	    scp->sc_flags = flags;
-	    if (flags == 2)
-		scp->sc_level = max_level;
-	    else
-		scp->sc_level = level;
-	    scp->sc_monster = monst;
-	    scp->sc_uid = uid;
-	    sc2 = scp;
+	    put_line("The score keeper can't be reached.", false);
+	    rank = -1;
 	}
     }
+    if (!answered && !cur_game->noscore)
+	journaled = score_journal(score_log).append(entry);
+    if (score_keeper >= 0)
+    {
+	if (journaled)
+	    put_line("It will post your score when it is back.", false);
+    }
+    else if (!cur_game->noscore && amount > 0 && lock_sc())
+    {
+	fp = signal(SIGINT, SIG_IGN);
+	if (top_ten.load())
+	    rank = top_ten.post(entry, allscore);
+	unlock_sc();
+	signal(SIGINT, fp);
+    }
+    else
+	top_ten.load();
     /*
      * Print the list
      */
     if (flags != -1)
-	putchar('\n');
-    printf("Top %s %s:\n", Numname, allscore ? "Scores" : "Rogueists");
-    printf("   Score Name\n");
-    for (scp = top_ten; scp < endp; scp++)
+	put_line("", false);
+    sprintf(line, "Top %s %s:", Numname, allscore ? "Scores" : "Rogueists");
+    put_line(line, false);
+    put_line("   Score Name", false);
+    for (i = 0; i < static_cast<int>(top_ten.size()); i++)
     {
-	if (scp->sc_score) {
-	    if (sc2 == scp)
-            md_raw_standout();
-	    printf("%2d %5d %s: %s on level %d", (int) (scp - top_ten + 1),
-		scp->sc_score, scp->sc_name, reason[scp->sc_flags],
-		scp->sc_level);
-	    if (scp->sc_flags == 0 || scp->sc_flags == 3)
-		printf(" by %s", killname((char) scp->sc_monster, true));
+	const SCORE& scp = top_ten.entry(i);
+
+	len = snprintf(line, sizeof(line), "%2d %5d %s: %s on level %d", i + 1,
+	    scp.sc_score, scp.sc_name, reason[scp.sc_flags],
+	    scp.sc_level);
+	if (scp.sc_flags == 0 || scp.sc_flags == 3)
+	    len += snprintf(line + len, sizeof(line) - len, " by %s",
+		killname((char) scp.sc_monster, true));
 #ifdef MASTER
-	    if (prflags == 1)
-	    {
-	    printf(" (%s)", md_getrealname(scp->sc_uid).c_str());
-	    }
-	    else if (prflags == 2)
+	if (prflags == 1)
+	{
+	snprintf(line + len, sizeof(line) - len, " (%s)", md_getrealname(scp.sc_uid).c_str());
+	}
+	else if (prflags == 2)
+	{
+	    if (rank == i)
+		cur_game->display->raw_standout();
+	    printf("%s", line);
+	    fflush(stdout);
+	    (void) fgets(cur_game->prbuf,10,stdin);
+	    if (cur_game->prbuf[0] == 'd' && drop_score(top_ten, i))
 	    {
-		fflush(stdout);
-		(void) fgets(prbuf,10,stdin);
-		if (prbuf[0] == 'd')
+		putchar('\n');
+		if (rank == i)
 		{
-		    for (sc2 = scp; sc2 < endp - 1; sc2++)
-			*sc2 = *(sc2 + 1);
-		    sc2 = endp - 1;
-		    sc2->sc_score = 0;
-		    for (i = 0; i < MAXSTR; i++)
-			sc2->sc_name[i] = (char) rnd(255);
-		    sc2->sc_flags = RN;
-		    sc2->sc_level = RN;
-		    sc2->sc_monster = (unsigned short) RN;
-		    scp--;
+		    cur_game->display->raw_standend();
+		    rank = -1;
 		}
+		else if (rank > i)
+		    rank--;
+		i--;
+		continue;
 	    }
-	    else
-#endif /* MASTER */
-                printf(".");
-	    if (sc2 == scp)
-		    md_raw_standend();
-            putchar('\n');
+	    if (rank == i)
+		cur_game->display->raw_standend();
+	    putchar('\n');
+	    continue;
 	}
 	else
-	    break;
-    }
-    /*
-     * Update the list file
-     */
-    if (sc2 != nullptr)
-    {
-	if (lock_sc())
-	{
-	    fp = signal(SIGINT, SIG_IGN);
-	    wr_score(top_ten);
-	    unlock_sc();
-	    signal(SIGINT, fp);
-	}
+#endif /* MASTER */
+	    strcat(line, ".");
+	put_line(line, rank == i);
     }
+    if (cur_game->embedded)
+	cur_game->cw->refresh();
 }
 
 /*
@@ -246,47 +287,50 @@ death(char monst)
     const char** dp;
     const char* killer;
     struct tm *lt;
-    static time_t date;
+    static thread_local time_t date;
 
     signal(SIGINT, SIG_IGN);
-    purse -= purse / 10;
+    cur_game->purse -= cur_game->purse / 10;
     signal(SIGINT, leave);
-    clear();
+    cur_game->cw->clear();
     killer = killname(monst, false);
-    if (!tombstone)
+    if (!cur_game->tombstone)
     {
-	mvprintw(LINES - 2, 0, "Killed by ");
+	cur_game->cw->mvprintw(cur_game->display->lines() - 2, 0, "Killed by ");
 	killer = killname(monst, false);
 	if (monst != 's' && monst != 'h')
-	    printw("a%s ", vowelstr(killer));
-	printw("%s with %d gold", killer, purse);
+	    cur_game->cw->printw("a%s ", vowelstr(killer));
+	cur_game->cw->printw("%s with %d gold", killer, cur_game->purse);
     }
     else
     {
         std::time(&date);
 	lt = std::localtime(&date);
-	move(8, 0);
+	cur_game->cw->move(8, 0);
 	dp = rip;
 	while (*dp)
-	    addstr(*dp++);
-	mvaddstr(17, center(killer), killer);
+	    cur_game->cw->addstr(*dp++);
+	cur_game->cw->mvaddstr(17, center(killer), killer);
 	if (monst == 's' || monst == 'h')
-	    mvaddch(16, 32, ' ');
+	    cur_game->cw->mvaddch(16, 32, ' ');
 	else
-	    mvaddstr(16, 33, vowelstr(killer));
-	mvaddstr(14, center(whoami), whoami);
-	sprintf(prbuf, "%d Au", purse);
-	move(15, center(prbuf));
-	addstr(prbuf);
-	sprintf(prbuf, "%4d", 1900+lt->tm_year);
-	mvaddstr(18, 26, prbuf);
+	    cur_game->cw->mvaddstr(16, 33, vowelstr(killer));
+	cur_game->cw->mvaddstr(14, center(cur_game->whoami), cur_game->whoami);
+	sprintf(cur_game->prbuf, "%d Au", cur_game->purse);
+	cur_game->cw->move(15, center(cur_game->prbuf));
+	cur_game->cw->addstr(cur_game->prbuf);
+	sprintf(cur_game->prbuf, "%4d", 1900+lt->tm_year);
+	cur_game->cw->mvaddstr(18, 26, cur_game->prbuf);
+    }
+    cur_game->cw->move(cur_game->display->lines() - 1, 0);
+    cur_game->cw->refresh();
+    score(cur_game->purse, cur_game->amulet ? 3 : 0, monst);
+    if (!cur_game->embedded)
+    {
+	printf("[Press return to continue]");
+	fflush(stdout);
+	(void) fgets(cur_game->prbuf,10,stdin);
     }
-    move(LINES - 1, 0);
-    refresh();
-    score(purse, amulet ? 3 : 0, monst);
-    printf("[Press return to continue]");
-    fflush(stdout);
-    (void) fgets(prbuf,10,stdin);
     my_exit(0);
 }
 
@@ -303,28 +347,28 @@ total_winner()
     int worth = 0;
     int oldpurse;
 
-    clear();
-    standout();
-    addstr("                                                               \n");
-    addstr("  @   @               @   @           @          @@@  @     @  \n");
-    addstr("  @   @               @@ @@           @           @   @     @  \n");
-    addstr("  @   @  @@@  @   @   @ @ @  @@@   @@@@  @@@      @  @@@    @  \n");
-    addstr("   @@@@ @   @ @   @   @   @     @ @   @ @   @     @   @     @  \n");
-    addstr("      @ @   @ @   @   @   @  @@@@ @   @ @@@@@     @   @     @  \n");
-    addstr("  @   @ @   @ @  @@   @   @ @   @ @   @ @         @   @  @     \n");
-    addstr("   @@@   @@@   @@ @   @   @  @@@@  @@@@  @@@     @@@   @@   @  \n");
-    addstr("                                                               \n");
-    addstr("     Congratulations, you have made it to the light of day!    \n");
-    standend();
-    addstr("\nYou have joined the elite ranks of those who have escaped the\n");
-    addstr("Dungeons of Doom alive.  You journey home and sell all your loot at\n");
-    addstr("a great profit and are admitted to the Fighters' Guild.\n");
-    mvaddstr(LINES - 1, 0, "--Press space to continue--");
-    refresh();
+    cur_game->cw->clear();
+    cur_game->cw->standout();
+    cur_game->cw->addstr("                                                               \n");
+    cur_game->cw->addstr("  @   @               @   @           @          @@@  @     @  \n");
+    cur_game->cw->addstr("  @   @               @@ @@           @           @   @     @  \n");
+    cur_game->cw->addstr("  @   @  @@@  @   @   @ @ @  @@@   @@@@  @@@      @  @@@    @  \n");
+    cur_game->cw->addstr("   @@@@ @   @ @   @   @   @     @ @   @ @   @     @   @     @  \n");
+    cur_game->cw->addstr("      @ @   @ @   @   @   @  @@@@ @   @ @@@@@     @   @     @  \n");
+    cur_game->cw->addstr("  @   @ @   @ @  @@   @   @ @   @ @   @ @         @   @  @     \n");
+    cur_game->cw->addstr("   @@@   @@@   @@ @   @   @  @@@@  @@@@  @@@     @@@   @@   @  \n");
+    cur_game->cw->addstr("                                                               \n");
+    cur_game->cw->addstr("     Congratulations, you have made it to the light of day!    \n");
+    cur_game->cw->standend();
+    cur_game->cw->addstr("\nYou have joined the elite ranks of those who have escaped the\n");
+    cur_game->cw->addstr("Dungeons of Doom alive.  You journey home and sell all your loot at\n");
+    cur_game->cw->addstr("a great profit and are admitted to the Fighters' Guild.\n");
+    cur_game->cw->mvaddstr(cur_game->display->lines() - 1, 0, "--Press space to continue--");
+    cur_game->cw->refresh();
     wait_for(' ');
-    clear();
-    mvaddstr(0, 0, "   Worth  Item\n");
-    oldpurse = purse;
+    cur_game->cw->clear();
+    cur_game->cw->mvaddstr(0, 0, "   Worth  Item\n");
+    oldpurse = cur_game->purse;
     for (obj = pack; obj != nullptr; obj = next(obj))
     {
 	switch (obj->o_type)
@@ -332,30 +376,30 @@ total_winner()
 	    case FOOD:
 		worth = 2 * obj->o_count;
 	    when WEAPON:
-		worth = weap_info[obj->o_which].oi_worth;
+		worth = cur_game->weap_info[obj->o_which].oi_worth;
 		worth *= 3 * (obj->o_hplus + obj->o_dplus) + obj->o_count;
 		obj->o_flags |= ISKNOW;
 	    when ARMOR:
-		worth = arm_info[obj->o_which].oi_worth;
+		worth = cur_game->arm_info[obj->o_which].oi_worth;
 		worth += (9 - obj->o_arm) * 100;
 		worth += (10 * (a_class[obj->o_which] - obj->o_arm));
 		obj->o_flags |= ISKNOW;
 	    when SCROLL:
-		worth = scr_info[obj->o_which].oi_worth;
+		worth = cur_game->scr_info[obj->o_which].oi_worth;
 		worth *= obj->o_count;
-		op = &scr_info[obj->o_which];
+		op = &cur_game->scr_info[obj->o_which];
 		if (!op->oi_know)
 		    worth /= 2;
 		op->oi_know = true;
 	    when POTION:
-		worth = pot_info[obj->o_which].oi_worth;
+		worth = cur_game->pot_info[obj->o_which].oi_worth;
 		worth *= obj->o_count;
-		op = &pot_info[obj->o_which];
+		op = &cur_game->pot_info[obj->o_which];
 		if (!op->oi_know)
 		    worth /= 2;
 		op->oi_know = true;
 	    when RING:
-		op = &ring_info[obj->o_which];
+		op = &cur_game->ring_info[obj->o_which];
 		worth = op->oi_worth;
 		if (obj->o_which == R_ADDSTR || obj->o_which == R_ADDDAM ||
 		    obj->o_which == R_PROTECT || obj->o_which == R_ADDHIT)
@@ -370,7 +414,7 @@ total_winner()
 		obj->o_flags |= ISKNOW;
 		op->oi_know = true;
 	    when STICK:
-		op = &ws_info[obj->o_which];
+		op = &cur_game->ws_info[obj->o_which];
 		worth = op->oi_worth;
 		worth += 20 * obj->o_charges;
 		if (!(obj->o_flags & ISKNOW))
@@ -382,12 +426,12 @@ total_winner()
 	}
 	if (worth < 0)
 	    worth = 0;
-	printw("%c) %5d  %s\n", obj->o_packch, worth, inv_name(obj, false));
-	purse += worth;
+	cur_game->cw->printw("%c) %5d  %s\n", obj->o_packch, worth, inv_name(obj, false));
+	cur_game->purse += worth;
     }
-    printw("   %5d  Gold Pieces          ", oldpurse);
-    refresh();
-    score(purse, 2, ' ');
+    cur_game->cw->printw("   %5d  Gold Pieces          ", oldpurse);
+    cur_game->cw->refresh();
+    score(cur_game->purse, 2, ' ');
     my_exit(0);
 }
 
@@ -412,7 +456,7 @@ killname(char monst, bool doart)
 
     if (isupper(monst))
     {
-	sp = monsters[monst-'A'].m_name;
+	sp = cur_game->monsters[monst-'A'].m_name;
 	article = true;
     }
     else
@@ -428,11 +472,11 @@ killname(char monst, bool doart)
 	    }
     }
     if (doart && article)
-	sprintf(prbuf, "a%s ", vowelstr(sp));
+	sprintf(cur_game->prbuf, "a%s ", vowelstr(sp));
     else
-	prbuf[0] = '\0';
-    strcat(prbuf, sp);
-    return prbuf;
+	cur_game->prbuf[0] = '\0';
+    strcat(cur_game->prbuf, sp);
+    return cur_game->prbuf;
 }
 
 /*
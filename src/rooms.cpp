@@ -12,8 +12,6 @@
 
 #include <cctype>
 
-#include <ncurses.h>
-
 #include <roguepp/roguepp.hpp>
 
 /**
@@ -32,6 +30,7 @@ static void draw_room(const room&);
 static void horiz(const room&, const int);
 static void vert(const room&, const int);
 static void do_maze(const room&);
+static void map_room(std::size_t);
 
 /**
  * Create rooms and corridors with a connectivity graph
@@ -39,7 +38,7 @@ static void do_maze(const room&);
 void
 do_rooms()
 {
-    static coord top;
+    static thread_local coord top;
     int left_out;
     // Maximum room size.
     coord bsze;
@@ -49,7 +48,7 @@ do_rooms()
     bsze.y = NUMLINES / 3;
 
     // Clear things for a new level
-    for (auto& rp : rooms)
+    for (auto& rp : cur_game->rooms)
     {
         rp.r_goldval = 0;
         rp.r_nexits = 0;
@@ -60,13 +59,13 @@ do_rooms()
     left_out = rnd(4);
     for (int i = 0; i < left_out; ++i)
     {
-        rooms[rnd_room()].r_flags |= ISGONE;
+        cur_game->rooms[rnd_room()].r_flags |= ISGONE;
     }
 
     // dig and populate all the rooms on the level
     for (std::size_t i = 0; i < MAXROOMS; ++i)
     {
-        auto* rp = &rooms[i];
+        auto* rp = &cur_game->rooms[i];
 
         // Find upper left corner of box that this room goes in
         top.x = (i % 3) * bsze.x + 1;
@@ -87,7 +86,7 @@ do_rooms()
         }
 
         // set room type
-        if (rnd(10) < level - 1)
+        if (rnd(10) < cur_game->level - 1)
         {
             rp->r_flags |= ISDARK;      /* dark room */
             if (rnd(15) == 0)
@@ -120,9 +119,10 @@ do_rooms()
         }
 
         draw_room(*rp);
+        map_room(i);
 
         // Put the gold in
-        if (rnd(2) == 0 && (!amulet || level >= max_level))
+        if (rnd(2) == 0 && (!cur_game->amulet || cur_game->level >= cur_game->max_level))
         {
             auto* gold = new_item();
 
@@ -133,7 +133,7 @@ do_rooms()
             gold->o_flags = ISMANY;
             gold->o_group = GOLDGRP;
             gold->o_type = GOLD;
-            attach(lvl_obj, gold);
+            attach(cur_game->lvl_obj, gold);
         }
 
         // Put the monster in
@@ -148,6 +148,48 @@ do_rooms()
     }
 }
 
+/**
+ * Record which places belong to the given room, so that roomin() can
+ * look them up instead of testing every room.
+ */
+static void
+map_room(std::size_t i)
+{
+    const auto& rp = cur_game->rooms[i];
+
+    for (int x = max(rp.r_pos.x, 0);
+         x <= rp.r_pos.x + rp.r_max.x && x < MAXCOLS;
+         ++x)
+    {
+        for (int y = max(rp.r_pos.y, 0);
+             y <= rp.r_pos.y + rp.r_max.y && y < MAXLINES;
+             ++y)
+        {
+            INDEX(y, x)->p_room = static_cast<signed char>(i);
+        }
+    }
+}
+
+/**
+ * Rebuild the room map of the whole level, after the rooms have been
+ * read back from a saved game.
+ */
+void
+map_rooms()
+{
+    for (auto& pp : cur_game->places)
+    {
+        pp.p_room = -1;
+    }
+    for (std::size_t i = 0; i < MAXROOMS; ++i)
+    {
+        if (!(cur_game->rooms[i].r_flags & ISGONE))
+        {
+            map_room(i);
+        }
+    }
+}
+
 /*
  * draw_room:
  *	Draw a box around a room and lay down the floor for normal
@@ -213,11 +255,11 @@ horiz(const room& rp, const int starty)
     }
 }
 
-static int Maxy;
-static int Maxx;
-static int Starty;
-static int Startx;
-static spot maze[NUMLINES / 3 + 1][NUMCOLS / 3 + 1];
+static thread_local int Maxy;
+static thread_local int Maxx;
+static thread_local int Starty;
+static thread_local int Startx;
+static thread_local spot maze[NUMLINES / 3 + 1][NUMCOLS / 3 + 1];
 
 /*
  * do_maze:
@@ -226,7 +268,7 @@ static spot maze[NUMLINES / 3 + 1][NUMCOLS / 3 + 1];
 static void
 do_maze(const room& rp)
 {
-    static coord pos;
+    static thread_local coord pos;
     int starty;
     int startx;
 
@@ -258,8 +300,8 @@ dig(int y, int x)
 {
     coord *cp;
     int cnt, newy, newx, nexty = 0, nextx = 0;
-    static coord pos;
-    static coord del[4] = {
+    static thread_local coord pos;
+    static thread_local coord del[4] = {
 	{2, 0}, {-2, 0}, {0, 2}, {0, -2}
     };
 
@@ -362,7 +404,7 @@ find_floor(struct room *rp, coord *cp, int limit, bool monst)
 	    return false;
 	if (pickroom)
 	{
-	    rp = &rooms[rnd_room()];
+	    rp = &cur_game->rooms[rnd_room()];
 	    compchar = ((rp->r_flags & ISMAZE) ? PASSAGE : FLOOR);
 	}
 	rnd_pos(*rp, *cp);
@@ -392,33 +434,33 @@ enter_room(coord *cp)
 
     rp = proom = roomin(cp);
     door_open(rp);
-    if (!(rp->r_flags & ISDARK) && !on(player, ISBLIND))
+    if (!(rp->r_flags & ISDARK) && !on(cur_game->player, ISBLIND))
 	for (y = rp->r_pos.y; y < rp->r_max.y + rp->r_pos.y; y++)
 	{
-	    move(y, rp->r_pos.x);
+	    cur_game->cw->move(y, rp->r_pos.x);
 	    for (x = rp->r_pos.x; x < rp->r_max.x + rp->r_pos.x; x++)
 	    {
 		tp = moat(y, x);
 		ch = chat(y, x);
 		if (tp == nullptr)
-		    if (CCHAR(inch()) != ch)
-			addch(ch);
+		    if (CCHAR(cur_game->cw->inch()) != ch)
+			cur_game->cw->addch(ch);
 		    else
-			move(y, x + 1);
+			cur_game->cw->move(y, x + 1);
 		else
 		{
 		    tp->t_oldch = ch;
 		    if (!see_monst(tp))
-			if (on(player, SEEMONST))
+			if (on(cur_game->player, SEEMONST))
 			{
-			    standout();
-			    addch(tp->t_disguise);
-			    standend();
+			    cur_game->cw->standout();
+			    cur_game->cw->addch(tp->t_disguise);
+			    cur_game->cw->standend();
 			}
 			else
-			    addch(ch);
+			    cur_game->cw->addch(ch);
 		    else
-			addch(tp->t_disguise);
+			cur_game->cw->addch(tp->t_disguise);
 		}
 	    }
 	}
@@ -445,21 +487,21 @@ leave_room(coord *cp)
 
     if (rp->r_flags & ISGONE)
 	floor = PASSAGE;
-    else if (!(rp->r_flags & ISDARK) || on(player, ISBLIND))
+    else if (!(rp->r_flags & ISDARK) || on(cur_game->player, ISBLIND))
 	floor = FLOOR;
     else
 	floor = ' ';
 
-    proom = &passages[flat(cp->y, cp->x) & F_PNUM];
+    proom = &cur_game->passages[flat(cp->y, cp->x) & F_PNUM];
     for (y = rp->r_pos.y; y < rp->r_max.y + rp->r_pos.y; y++)
 	for (x = rp->r_pos.x; x < rp->r_max.x + rp->r_pos.x; x++)
 	{
-	    move(y, x);
-	    switch ( ch = CCHAR(inch()) )
+	    cur_game->cw->move(y, x);
+	    switch ( ch = CCHAR(cur_game->cw->inch()) )
 	    {
 		case FLOOR:
 		    if (floor == ' ' && ch != ' ')
-			addch(' ');
+			cur_game->cw->addch(' ');
 		    break;
 		default:
 		    /*
@@ -468,15 +510,15 @@ leave_room(coord *cp)
 		     */
 		    if (isupper(toascii(ch)))
 		    {
-			if (on(player, SEEMONST))
+			if (on(cur_game->player, SEEMONST))
 			{
-			    standout();
-			    addch(ch);
-			    standend();
+			    cur_game->cw->standout();
+			    cur_game->cw->addch(ch);
+			    cur_game->cw->standend();
 			    break;
 			}
                         pp = INDEX(y,x);
-			addch(pp->p_ch == DOOR ? DOOR : floor);
+			cur_game->cw->addch(pp->p_ch == DOOR ? DOOR : floor);
 		    }
 	    }
 	}
@@ -10,23 +10,23 @@
  * See the file LICENSE.TXT for full copyright and licensing information.
  */
 
+#include <algorithm>
 #include <cerrno>
 #include <csignal>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <string>
 
 #include <sys/types.h>
 #include <sys/stat.h>
 
-#include <ncurses.h>
-
 #include <roguepp/roguepp.hpp>
-#include <roguepp/score.hpp>
 
 typedef struct stat STAT;
 
-extern char version[], encstr[];
+extern const char* encstr;
+extern const char* statlist;
 
 static STAT sbuf;
 
@@ -42,18 +42,44 @@ save_game()
     int c;
     char buf[MAXSTR];
 
+    /*
+     * Embedded games are saved where whoever runs them says, if anywhere
+     */
+    if (cur_game->embedded)
+    {
+	if (cur_game->file_name[0] == '\0')
+	{
+	    msg("this game can't be saved");
+	    return;
+	}
+	msg("really save?");
+	if (readchar() != 'y')
+	{
+	    msg("");
+	    return;
+	}
+	if (!save_embedded())
+	{
+	    msg("can't save the game: %s", strerror(errno));
+	    return;
+	}
+	cur_game->cw->clear();
+	cur_game->cw->mvaddstr(0, 0, "Your game is saved.  Come back to pick it up where you left it.");
+	cur_game->cw->refresh();
+	my_exit(0);
+    }
     /*
      * get file name
      */
-    mpos = 0;
+    cur_game->mpos = 0;
 over:
-    if (file_name[0] != '\0')
+    if (cur_game->file_name[0] != '\0')
     {
 	for (;;)
 	{
-	    msg("save file (%s)? ", file_name);
+	    msg("save file (%s)? ", cur_game->file_name);
 	    c = readchar();
-	    mpos = 0;
+	    cur_game->mpos = 0;
 	    if (c == ESCAPE)
 	    {
 		msg("");
@@ -66,25 +92,25 @@ over:
 	}
 	if (c == 'y' || c == 'Y')
 	{
-	    addstr("Yes\n");
-	    refresh();
-	    strcpy(buf, file_name);
+	    cur_game->cw->addstr("Yes\n");
+	    cur_game->cw->refresh();
+	    strcpy(buf, cur_game->file_name);
 	    goto gotfile;
 	}
     }
 
     do
     {
-	mpos = 0;
+	cur_game->mpos = 0;
 	msg("file name: ");
 	buf[0] = '\0';
-	if (get_str(buf, stdscr) == QUIT)
+	if (get_str(buf, cur_game->cw) == QUIT)
 	{
 quit_it:
 	    msg("");
 	    return;
 	}
-	mpos = 0;
+	cur_game->mpos = 0;
 gotfile:
 	/*
 	 * test to see if the file exists
@@ -94,7 +120,7 @@ gotfile:
 	    for (;;)
 	    {
 		msg("File exists.  Do you wish to overwrite it?");
-		mpos = 0;
+		cur_game->mpos = 0;
 		if ((c = readchar()) == ESCAPE)
 		    goto quit_it;
 		if (c == 'y' || c == 'Y')
@@ -105,10 +131,10 @@ gotfile:
 		    msg("Please answer Y or N");
 	    }
 	    msg("file name: %s", buf);
-	    md_unlink(file_name);
+	    md_unlink(cur_game->file_name);
 	}
-	strcpy(file_name, buf);
-	if ((savef = std::fopen(file_name, "wb")) == nullptr)
+	strcpy(cur_game->file_name, buf);
+	if ((savef = std::fopen(cur_game->file_name, "wb")) == nullptr)
 	    msg(strerror(errno));
     } while (savef == nullptr);
 
@@ -129,12 +155,35 @@ auto_save(int sig)
     NOOP(sig);
 
     md_ignoreallsignals();
-    if (file_name[0] != '\0' && ((savef = std::fopen(file_name, "wb")) != nullptr ||
-	(md_unlink_open_file(file_name, savef) >= 0 && (savef = std::fopen(file_name, "wb")) != nullptr)))
+    if (cur_game->file_name[0] != '\0' && ((savef = std::fopen(cur_game->file_name, "wb")) != nullptr ||
+	(md_unlink_open_file(cur_game->file_name, savef) >= 0 && (savef = std::fopen(cur_game->file_name, "wb")) != nullptr)))
 	    save_file(savef);
     exit(0);
 }
 
+/*
+ * save_embedded:
+ *	Write a game run by another program to its file, and carry on;
+ *	false if it couldn't be
+ */
+
+bool
+save_embedded()
+{
+    std::string out;
+    FILE *savef;
+    bool ok;
+
+    md_unlink(cur_game->file_name);
+    if ((savef = std::fopen(cur_game->file_name, "wb")) == nullptr)
+	return false;
+    rs_save_file(out);
+    ok = fwrite(out.data(), 1, out.size(), savef) == out.size();
+    ok = fclose(savef) == 0 && ok;
+    md_chmod(cur_game->file_name, 0400);
+    return ok;
+}
+
 /*
  * save_file:
  *	Write the saved game on the file
@@ -143,138 +192,153 @@ auto_save(int sig)
 void
 save_file(FILE *savef)
 {
-    char buf[80];
-    mvcur(0, COLS - 1, LINES - 1, 0);
+    std::string out;
+    cur_game->display->end();
     putchar('\n');
-    endwin();
     resetltchars();
-    md_chmod(file_name, 0400);
-    encwrite(version, strlen(version)+1, savef);
-    sprintf(buf,"%d x %d\n", LINES, COLS);
-    encwrite(buf,80,savef);
-    rs_save_file(savef);
+    md_chmod(cur_game->file_name, 0400);
+    rs_save_file(out);
+    fwrite(out.data(), 1, out.size(), savef);
     fflush(savef);
     fclose(savef);
     exit(0);
 }
 
 /*
- * restore:
- *	Restore a saved game from a file with elaborate checks for file
- *	integrity from cheaters
+ * load_game:
+ *	Read the saved game in file and make it the one played, with
+ *	elaborate checks for file integrity from cheaters.  Returns why it
+ *	couldn't be, or nothing.  started tells whether the display was
+ *	started by then.
  */
-bool
-restore(const char* file, char** envp)
+static std::string
+load_game(const char* file, bool& started)
 {
-    extern char** environ;
     FILE* inf;
-    char buf[MAXSTR];
+    saved_game save;
     int syml;
     STAT sbuf2;
-    int lines;
-    int cols;
-
-    if (!std::strcmp(file, "-r"))
-    {
-        file = file_name;
-    }
+    char why[2 * MAXSTR];
 
-    md_tstphold();
+    // A served game's file is closed again; a game of its own holds
+    // on to the inode for as long as it runs.
+    const auto fail = [&](const char* reason) {
+        if (cur_game->embedded)
+        {
+            std::fclose(inf);
+        }
+        return std::string(reason);
+    };
 
+    started = false;
     if (!(inf = std::fopen(file, "rb")))
     {
-        std::perror(file);
-
-        return false;
+        return std::string(file) + ": " + std::strerror(errno);
     }
 
     stat(file, &sbuf2);
     syml = is_symlink(file);
 
-    std::fflush(stdout);
-    encread(buf, std::strlen(version) + 1, inf);
-    if (std::strcmp(buf, version))
+    save.image.resize(static_cast<std::size_t>(sbuf2.st_size));
+    if (std::fread(save.image.data(), 1, save.image.size(), inf) != save.image.size()
+        || rs_open_file(save))
     {
-        std::printf("Sorry, saved game is out of date.\n");
-
-        return false;
+        return fail(save.stale ? "Sorry, saved game is out of date." : "Sorry, saved game is damaged.");
     }
-    encread(buf, 80, inf);
-    std::sscanf(buf, "%d x %d\n", &lines, &cols);
 
     // Start up cursor package
-    initscr();
-    keypad(stdscr, 1);
+    init_display();
+    started = true;
 
-    if (lines > LINES)
+    if (save.lines > cur_game->display->lines())
     {
-        endwin();
-        std::printf(
-            "Sorry, original game was played on a screen with %d lines.\n",
-            lines
-        );
-        std::printf(
-            "Current screen only has %d lines. Unable to restore game\n",
-            LINES
-        );
+        std::snprintf(why, sizeof(why),
+            "Sorry, original game was played on a screen with %d lines.\n"
+            "Current screen only has %d lines. Unable to restore game",
+            save.lines, cur_game->display->lines());
 
-        return false;
+        return fail(why);
     }
-    if (cols > COLS)
+    if (save.cols > cur_game->display->cols())
     {
-        endwin();
-        std::printf(
-            "Sorry, original game was played on a screen with %d columns.\n",
-            cols
-        );
-        std::printf(
-            "Current screen only has %d columns. Unable to restore game\n",
-            COLS
-        );
+        std::snprintf(why, sizeof(why),
+            "Sorry, original game was played on a screen with %d columns.\n"
+            "Current screen only has %d columns. Unable to restore game",
+            save.cols, cur_game->display->cols());
 
-        return false;
+        return fail(why);
     }
 
-    hw = newwin(LINES, COLS, 0, 0);
-    setup();
+    if (!cur_game->embedded)
+    {
+        setup();
+    }
 
-    rs_restore_file(inf);
-    /*
-     * we do not close the file so that we will have a hold of the
-     * inode for as long as possible
-     */
+    if (rs_restore_file(save))
+    {
+        return fail("\nSorry, saved game is damaged.");
+    }
 
     if (
 #if defined(MASTER)
-    !wizard &&
+    !cur_game->wizard &&
 #endif
         md_unlink_open_file(file, inf) < 0)
     {
-        std::printf("Cannot unlink file\n");
-
-        return false;
+        return fail("Cannot unlink file");
     }
-    mpos = 0;
+    if (cur_game->embedded)
+    {
+        std::fclose(inf);
+    }
+    cur_game->mpos = 0;
 
-    clearok(stdscr,true);
+    cur_game->display->redraw();
     /*
      * defeat multiple restarting from the same place
      */
 #if defined(MASTER)
-    if (!wizard)
+    if (!cur_game->wizard)
 #endif
     if (sbuf2.st_nlink != 1 || syml)
     {
-        endwin();
-        std::printf("\nCannot restore from a linked file\n");
-
-        return false;
+        return "\nCannot restore from a linked file";
     }
 
     if (pstats.s_hpt <= 0)
     {
-        endwin();
-        std::printf("\n\"He's dead, Jim\"\n");
+        return "\n\"He's dead, Jim\"";
+    }
+
+    return "";
+}
+
+/*
+ * restore:
+ *	Restore a saved game from a file
+ */
+bool
+restore(const char* file, char** envp)
+{
+    extern char** environ;
+    std::string why;
+    bool started;
+
+    if (!std::strcmp(file, "-r"))
+    {
+        file = cur_game->file_name;
+    }
+
+    md_tstphold();
+
+    std::fflush(stdout);
+    if (!(why = load_game(file, started)).empty())
+    {
+        if (started)
+        {
+            cur_game->display->end();
+        }
+        std::printf("%s\n", why.c_str());
 
         return false;
     }
@@ -282,8 +346,8 @@ restore(const char* file, char** envp)
     md_tstpresume();
 
     environ = envp;
-    std::strcpy(file_name, file);
-    clearok(curscr, true);
+    std::strcpy(cur_game->file_name, file);
+    cur_game->display->redraw();
     std::srand(md_getpid());
     msg("file name: %s", file);
     playit();
@@ -292,133 +356,181 @@ restore(const char* file, char** envp)
 }
 
 /*
- * encwrite:
- *	Perform an encrypted write
+ * restore_embedded:
+ *	Pick up a game run by another program where it was saved, if it
+ *	was.  false if there is no such game; one that can't be played
+ *	any more ends here.
  */
-std::size_t
-encwrite(const char* start, std::size_t size, FILE* outf)
+bool
+restore_embedded()
 {
-    extern char statlist[];
-    const std::size_t o_size = size;
-    const char* e1 = encstr;
-    const char* e2 = statlist;
-    char fb = 0;
+    std::string why;
+    bool started;
 
-    while (size)
-    {
-        int temp;
+    char file[MAXSTR];
 
-        if (std::fputc(*start++ ^ *e1 ^ *e2 ^ fb, outf) == EOF)
+    if (cur_game->file_name[0] == '\0' || stat(cur_game->file_name, &sbuf) < 0)
+    {
+        return false;
+    }
+    std::strcpy(file, cur_game->file_name);
+    if (!(why = load_game(file, started)).empty())
+    {
+        // Put aside, so that the next game isn't stopped by it.
+        std::rename(file, (std::string(file) + ".bad").c_str());
+        if (!started)
         {
-            break;
+            init_display();
         }
+        cur_game->cw->clear();
+        cur_game->cw->mvaddstr(0, 0, why.c_str());
+        cur_game->cw->refresh();
+        my_exit(1);
+    }
+    std::strcpy(cur_game->file_name, file);
+    cur_game->display->redraw();
+    msg("welcome back, %s", cur_game->whoami);
 
-        temp = *e1++;
-        fb = fb + static_cast<char>(temp * *e2++);
-        if (*e1 == '\0')
+    return true;
+}
+
+namespace
+{
+    /** Bytes of keystream made at a time. */
+    constexpr std::size_t KEY_BLOCK = 4096;
+
+    /**
+     * The bytes saved games and the score file are XORed with.  Each
+     * encwrite() and encread() starts the stream afresh, so the key for a
+     * byte depends only on how far into the buffer it is.
+     */
+    class keystream
+    {
+    public:
+        keystream()
+            : m_e1(encstr)
+            , m_e2(statlist)
+            , m_fb(0) {}
+
+        /** Make the next size bytes of the stream. */
+        void fill(char* key, std::size_t size)
         {
-            e1 = encstr;
+            while (size--)
+            {
+                int temp;
+
+                *key++ = *m_e1 ^ *m_e2 ^ m_fb;
+                temp = *m_e1++;
+                m_fb = m_fb + static_cast<char>(temp * *m_e2++);
+                if (*m_e1 == '\0')
+                {
+                    m_e1 = encstr;
+                }
+                if (*m_e2 == '\0')
+                {
+                    m_e2 = statlist;
+                }
+            }
         }
-        if (*e2 == '\0')
+
+    private:
+        const char* m_e1;
+        const char* m_e2;
+        char m_fb;
+    };
+
+    /**
+     * The first block of the stream, made once, and where the stream
+     * goes on from after it.  Scores and every field of a saved game fit
+     * in the first block.
+     */
+    struct key_start
+    {
+        key_start()
         {
-            e2 = statlist;
+            rest.fill(key, KEY_BLOCK);
         }
-        --size;
-    }
 
-    return o_size - size;
+        char key[KEY_BLOCK];
+        keystream rest;
+    };
 }
 
 /*
- * encread:
- *	Perform an encrypted read
+ * encxor:
+ *	XOR size bytes from src with the keystream into dst, a block at a
+ *	time.  dst and src may be the same.
  */
-std::size_t
-encread(char* start, std::size_t size, FILE* inf)
+void
+encxor(char* dst, const char* src, std::size_t size)
 {
-    extern char statlist[];
-    char fb = 0;
-    const char* e1 = encstr;
-    const char* e2 = statlist;
-    const auto read_size = std::fread(start, 1, size, inf);
+    static const key_start start;
+    keystream more = start.rest;
+    char next[KEY_BLOCK];
+    const char* key = start.key;
 
-    if (read_size < size)
-    {
-        return read_size;
-    }
-
-    while (size--)
+    for (;;)
     {
-        int temp;
+        const std::size_t n = std::min(size, KEY_BLOCK);
 
-        *start++ ^= *e1 ^ *e2 ^ fb;
-        temp = *e1++;
-        fb = fb + static_cast<char>(temp * *e2++);
-        if (*e1 == '\0')
+        for (std::size_t i = 0; i < n; ++i)
         {
-            e1 = encstr;
+            dst[i] = src[i] ^ key[i];
         }
-        if (*e2 == '\0')
+        if ((size -= n) == 0)
         {
-            e2 = statlist;
+            break;
         }
+        dst += n;
+        src += n;
+        more.fill(next, std::min(size, KEY_BLOCK));
+        key = next;
     }
-
-    return read_size;
 }
 
-static char scoreline[100];
 /*
- * read_scrore
- *	Read in the score file
+ * encwrite:
+ *	Perform an encrypted write
  */
-void
-rd_score(SCORE *top_ten)
+std::size_t
+encwrite(const char* start, std::size_t size, FILE* outf)
 {
-    unsigned int i;
+    std::string out;
 
-	if (scoreboard == nullptr)
-		return;
-
-	rewind(scoreboard);
-
-	for(i = 0; i < numscores; i++)
-    {
-        encread(top_ten[i].sc_name, MAXSTR, scoreboard);
-        encread(scoreline, 100, scoreboard);
-        sscanf(scoreline, " %u %d %u %hu %d %x \n",
-            &top_ten[i].sc_uid, &top_ten[i].sc_score,
-            &top_ten[i].sc_flags, &top_ten[i].sc_monster,
-            &top_ten[i].sc_level, &top_ten[i].sc_time);
-    }
+    encwrite(start, size, out);
 
-	rewind(scoreboard);
+    return std::fwrite(out.data(), 1, out.size(), outf);
 }
 
 /*
- * write_scrore
- *	Read in the score file
+ * encwrite:
+ *	Perform an encrypted write onto the end of a buffer
  */
-void
-wr_score(SCORE *top_ten)
+std::size_t
+encwrite(const char* start, std::size_t size, std::string& out)
 {
-    unsigned int i;
+    const std::size_t at = out.size();
 
-	if (scoreboard == nullptr)
-		return;
+    out.resize(at + size);
+    encxor(&out[at], start, size);
 
-	rewind(scoreboard);
+    return size;
+}
 
-    for(i = 0; i < numscores; i++)
+/*
+ * encread:
+ *	Perform an encrypted read
+ */
+std::size_t
+encread(char* start, std::size_t size, FILE* inf)
+{
+    const auto read_size = std::fread(start, 1, size, inf);
+
+    if (read_size < size)
     {
-          memset(scoreline,0,100);
-          encwrite(top_ten[i].sc_name, MAXSTR, scoreboard);
-          sprintf(scoreline, " %u %d %u %hu %d %x \n",
-              top_ten[i].sc_uid, top_ten[i].sc_score,
-              top_ten[i].sc_flags, top_ten[i].sc_monster,
-              top_ten[i].sc_level, top_ten[i].sc_time);
-          encwrite(scoreline,100,scoreboard);
+        return read_size;
     }
+    encxor(start, start, size);
 
-	rewind(scoreboard);
+    return read_size;
 }
@@ -0,0 +1,323 @@
+/*
+ * Timer wheel for daemons and fuses
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+
+#include <algorithm>
+#include <functional>
+
+#include <roguepp/scheduler.hpp>
+
+timer_handle
+scheduler::start_daemon(callback_type func, int arg, int type)
+{
+    const auto handle = add(func, arg, type);
+
+    m_entries[handle.slot].daemon = true;
+    m_daemons.insert(
+        std::lower_bound(m_daemons.begin(), m_daemons.end(), handle.slot),
+        handle.slot
+    );
+
+    return handle;
+}
+
+timer_handle
+scheduler::fuse(callback_type func, int arg, int time, int type)
+{
+    const auto handle = add(func, arg, type);
+    auto& e = m_entries[handle.slot];
+
+    e.expiry = lane_of(type).now + time;
+    wheel(handle.slot);
+
+    return handle;
+}
+
+bool
+scheduler::cancel(timer_handle handle)
+{
+    if (!lookup(handle))
+    {
+        return false;
+    }
+    release(handle.slot);
+
+    return true;
+}
+
+bool
+scheduler::lengthen(timer_handle handle, int xtime)
+{
+    auto e = lookup(handle);
+
+    if (!e || e->daemon)
+    {
+        return false;
+    }
+    unwheel(handle.slot);
+    e->expiry += xtime;
+    wheel(handle.slot);
+
+    return true;
+}
+
+timer_handle
+scheduler::find(callback_type func) const
+{
+    for (std::uint32_t slot = 0; slot < m_entries.size(); ++slot)
+    {
+        const auto& e = m_entries[slot];
+
+        if (e.live && e.func == func)
+        {
+            return { slot, e.generation };
+        }
+    }
+
+    return {};
+}
+
+void
+scheduler::run_daemons(int type)
+{
+    // A daemon may start or kill daemons, so look for the next one
+    // after each call instead of holding on to a position.
+    for (auto it = m_daemons.begin(); it != m_daemons.end();)
+    {
+        const auto slot = *it;
+        const auto& e = m_entries[slot];
+
+        if (e.type == type)
+        {
+            (*e.func)(e.arg);
+        }
+        it = std::upper_bound(m_daemons.begin(), m_daemons.end(), slot);
+    }
+}
+
+void
+scheduler::run_fuses(int type)
+{
+    auto& l = lane_of(type);
+    const auto now = ++l.now;
+
+    m_due.clear();
+    for (auto slot = l.notches[now % WHEEL_SIZE]; slot != NONE; slot = m_entries[slot].next)
+    {
+        if (m_entries[slot].expiry == now)
+        {
+            m_due.push_back(slot);
+        }
+    }
+    std::sort(m_due.begin(), m_due.end());
+    for (const auto slot : m_due)
+    {
+        auto& e = m_entries[slot];
+
+        // An earlier fuse may have put this one out or lengthened it.
+        if (!e.wheeled || e.expiry != now || e.type != type)
+        {
+            continue;
+        }
+
+        const auto func = e.func;
+        const auto arg = e.arg;
+
+        release(slot);
+        (*func)(arg);
+    }
+}
+
+void
+scheduler::clear()
+{
+    m_entries.clear();
+    m_free.clear();
+    m_daemons.clear();
+    m_due.clear();
+    for (auto& l : m_lanes)
+    {
+        l = lane();
+    }
+}
+
+std::vector<delayed_action>
+scheduler::dump(std::size_t count) const
+{
+    std::vector<delayed_action> list(std::max(count, m_entries.size()), delayed_action{});
+
+    for (std::size_t slot = 0; slot < m_entries.size(); ++slot)
+    {
+        const auto& e = m_entries[slot];
+
+        if (!e.live)
+        {
+            continue;
+        }
+        list[slot].d_type = e.type;
+        list[slot].d_func = e.func;
+        list[slot].d_arg = e.arg;
+        if (e.daemon)
+        {
+            list[slot].d_time = DAEMON;
+        } else {
+            list[slot].d_time = static_cast<int>(e.expiry - m_lanes[e.type].now);
+        }
+    }
+
+    return list;
+}
+
+void
+scheduler::load(const std::vector<delayed_action>& list)
+{
+    std::vector<timer_handle> holes;
+
+    clear();
+    // Fill the slots in order, putting out the empty ones afterwards,
+    // so that everything lands in the slot it was saved from.
+    for (const auto& d : list)
+    {
+        if (d.d_type == 0 || d.d_func == nullptr)
+        {
+            holes.push_back(add(nullptr, 0, 0));
+        }
+        else if (d.d_time == DAEMON)
+        {
+            start_daemon(d.d_func, d.d_arg, d.d_type);
+        } else {
+            fuse(d.d_func, d.d_arg, d.d_time, d.d_type);
+        }
+    }
+    for (const auto handle : holes)
+    {
+        release(handle.slot);
+    }
+}
+
+scheduler::entry*
+scheduler::lookup(timer_handle handle)
+{
+    if (!handle || handle.slot >= m_entries.size())
+    {
+        return nullptr;
+    }
+
+    auto& e = m_entries[handle.slot];
+
+    return e.live && e.generation == handle.generation ? &e : nullptr;
+}
+
+const scheduler::entry*
+scheduler::lookup(timer_handle handle) const
+{
+    return const_cast<scheduler*>(this)->lookup(handle);
+}
+
+timer_handle
+scheduler::add(callback_type func, int arg, int type)
+{
+    std::uint32_t slot;
+
+    if (m_free.empty())
+    {
+        slot = static_cast<std::uint32_t>(m_entries.size());
+        m_entries.push_back(entry{});
+    } else {
+        std::pop_heap(m_free.begin(), m_free.end(), std::greater<std::uint32_t>());
+        slot = m_free.back();
+        m_free.pop_back();
+    }
+
+    auto& e = m_entries[slot];
+    const auto generation = e.generation + 1 ? e.generation + 1 : 1;
+
+    e = entry{};
+    e.func = func;
+    e.arg = arg;
+    e.type = type < 0 || type > MAX_TYPE ? 0 : type;
+    e.generation = generation;
+    e.live = true;
+    e.prev = e.next = NONE;
+
+    return { slot, generation };
+}
+
+void
+scheduler::release(std::uint32_t slot)
+{
+    auto& e = m_entries[slot];
+
+    if (e.daemon)
+    {
+        m_daemons.erase(std::lower_bound(m_daemons.begin(), m_daemons.end(), slot));
+    } else {
+        unwheel(slot);
+    }
+    e.live = false;
+    e.daemon = false;
+    m_free.push_back(slot);
+    std::push_heap(m_free.begin(), m_free.end(), std::greater<std::uint32_t>());
+}
+
+/**
+ * Put a fuse in the notch it goes off in.  Fuses with no time left
+ * stay off the wheel, as they can only go off after being lengthened.
+ */
+void
+scheduler::wheel(std::uint32_t slot)
+{
+    auto& e = m_entries[slot];
+    auto& l = m_lanes[e.type];
+
+    if (e.expiry <= l.now)
+    {
+        return;
+    }
+
+    auto& head = l.notches[e.expiry % WHEEL_SIZE];
+
+    e.prev = NONE;
+    e.next = head;
+    if (head != NONE)
+    {
+        m_entries[head].prev = slot;
+    }
+    head = slot;
+    e.wheeled = true;
+}
+
+void
+scheduler::unwheel(std::uint32_t slot)
+{
+    auto& e = m_entries[slot];
+
+    if (!e.wheeled)
+    {
+        return;
+    }
+    if (e.prev != NONE)
+    {
+        m_entries[e.prev].next = e.next;
+    } else {
+        m_lanes[e.type].notches[e.expiry % WHEEL_SIZE] = e.next;
+    }
+    if (e.next != NONE)
+    {
+        m_entries[e.next].prev = e.prev;
+    }
+    e.prev = e.next = NONE;
+    e.wheeled = false;
+}
+
+scheduler::lane&
+scheduler::lane_of(int type)
+{
+    return m_lanes[type < 0 || type > MAX_TYPE ? 0 : type];
+}
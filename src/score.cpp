@@ -0,0 +1,1364 @@
+/*
+ * The score file
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <unordered_map>
+
+#include <roguepp/roguepp.hpp>
+#include <roguepp/score.hpp>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#if defined(HAVE_UNISTD_H)
+#include <unistd.h>
+#endif
+
+#if defined(HAVE_SYS_MMAN_H) && defined(HAVE_UNISTD_H)
+#include <sys/mman.h>
+#endif
+
+namespace
+{
+    const char magic[8] = { 'R', 'o', 'g', 'u', 'e', 'S', 'c', '\032' };
+    /** Format of the file written. */
+    constexpr std::uint32_t FORMAT = 1;
+    /** Bytes in front of the index. */
+    constexpr long HEADER_SIZE = 24;
+    /** Length of an entry's line of text in the old format. */
+    constexpr std::size_t OLD_LINE = 100;
+
+    const char journal_magic[8] = { 'R', 'o', 'g', 'u', 'e', 'J', 'n', '\032' };
+    /** Format of the journal written. */
+    constexpr std::uint32_t JOURNAL_FORMAT = 1;
+    /** Bytes in front of the journal's records. */
+    constexpr off_t JOURNAL_HEADER = 16;
+    /** Records read from the journal at a time. */
+    constexpr std::size_t JOURNAL_CHUNK = 256;
+
+    /*
+     * The index compact() writes next to a journal, every number in it
+     * four bytes:
+     *
+     *     header      magic, format, entries it covers, winners, 0,
+     *                 and a copy of the last entry it covers
+     *     order       entry numbers best first
+     *     rank        the rank of each entry
+     *     by uid      uid and entry number, by uid and then best first
+     *     by monster  monster and entry number, the same way
+     *     by time     time and entry number, earliest first
+     *     winners     entry numbers of the total winners, best first
+     */
+    const char index_magic[8] = { 'R', 'o', 'g', 'u', 'e', 'I', 'x', '\032' };
+    /** Format of the index written. */
+    constexpr std::uint32_t INDEX_FORMAT = 1;
+    /** Bytes in front of the index's lists. */
+    constexpr std::size_t INDEX_HEADER = 24 + score_table::RECORD_SIZE;
+
+    void
+    put32(char* out, std::uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            out[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+        }
+    }
+
+    std::uint32_t
+    get32(const char* in)
+    {
+        const auto* b = reinterpret_cast<const unsigned char*>(in);
+
+        return static_cast<std::uint32_t>(b[0])
+            | static_cast<std::uint32_t>(b[1]) << 8
+            | static_cast<std::uint32_t>(b[2]) << 16
+            | static_cast<std::uint32_t>(b[3]) << 24;
+    }
+
+    void
+    put_record(char* out, const SCORE& score)
+    {
+        std::memset(out, 0, score_table::RECORD_SIZE);
+        put32(out, score.sc_uid);
+        put32(out + 4, static_cast<std::uint32_t>(score.sc_score));
+        put32(out + 8, score.sc_flags);
+        put32(out + 12, score.sc_monster);
+        put32(out + 16, static_cast<std::uint32_t>(score.sc_level));
+        put32(out + 20, score.sc_time);
+        std::strncpy(out + 24, score.sc_name, score_table::NAME_LENGTH - 1);
+    }
+
+    void
+    get_record(const char* plain, SCORE& score)
+    {
+        score = SCORE();
+        score.sc_uid = get32(plain);
+        score.sc_score = static_cast<int>(get32(plain + 4));
+        score.sc_flags = get32(plain + 8);
+        score.sc_monster = static_cast<unsigned short>(get32(plain + 12));
+        score.sc_level = static_cast<int>(get32(plain + 16));
+        score.sc_time = get32(plain + 20);
+        std::memcpy(score.sc_name, plain + 24, score_table::NAME_LENGTH - 1);
+    }
+}
+
+score_table::score_table(std::FILE* file, unsigned int slots)
+    : m_file(file)
+    , m_slots(slots)
+    , m_count(0)
+    , m_index(slots)
+    , m_records(slots)
+    , m_rewrite(true)
+    , m_defer(false)
+    , m_dirty_first(slots)
+    , m_dirty_last(0)
+    , m_header_dirty(false)
+{
+    for (std::uint32_t i = 0; i < m_slots; ++i)
+    {
+        m_index[i] = i;
+    }
+}
+
+bool
+score_table::load()
+{
+    char header[HEADER_SIZE];
+    std::vector<char> data;
+    std::uint32_t slots;
+    std::uint32_t count;
+
+    if (m_file == nullptr)
+    {
+        return true;
+    }
+    std::fflush(m_file);
+    std::rewind(m_file);
+    if (std::fread(header, 1, sizeof(header), m_file) != sizeof(header)
+        || std::memcmp(header, magic, sizeof(magic)))
+    {
+        return load_old();
+    }
+    slots = get32(header + 16);
+    count = get32(header + 20);
+    if (get32(header + 8) != FORMAT || get32(header + 12) != RECORD_SIZE || count > slots)
+    {
+        return false;
+    }
+
+    // The index and every record, in one read.
+    data.resize(slots * (4 + RECORD_SIZE));
+    if (std::fread(data.data(), 1, data.size(), m_file) != data.size())
+    {
+        return false;
+    }
+    m_slots = slots;
+    m_count = count;
+    clean();
+    m_index.resize(slots);
+    m_records.assign(slots, SCORE());
+    for (std::uint32_t i = 0; i < slots; ++i)
+    {
+        if ((m_index[i] = get32(&data[i * 4])) >= slots)
+        {
+            return false;
+        }
+    }
+    for (std::size_t rank = 0; rank < m_count; ++rank)
+    {
+        char* const record = &data[slots * 4 + m_index[rank] * RECORD_SIZE];
+
+        encxor(record, record, RECORD_SIZE);
+        get_record(record, m_records[m_index[rank]]);
+    }
+    m_rewrite = false;
+
+    return true;
+}
+
+/**
+ * Read a file in the old format, numscores entries of a whole name and
+ * a line of text.  An empty file reads as an empty table.
+ */
+bool
+score_table::load_old()
+{
+    char line[OLD_LINE];
+    SCORE score;
+
+    m_count = 0;
+    m_rewrite = true;
+    clean();
+    m_records.assign(m_slots, SCORE());
+    for (std::uint32_t i = 0; i < m_slots; ++i)
+    {
+        m_index[i] = i;
+    }
+    std::rewind(m_file);
+    for (std::uint32_t i = 0; i < m_slots; ++i)
+    {
+        score = SCORE();
+        if (encread(score.sc_name, MAXSTR, m_file) != MAXSTR
+            || encread(line, OLD_LINE, m_file) != OLD_LINE)
+        {
+            break;
+        }
+        line[OLD_LINE - 1] = '\0';
+        std::sscanf(line, " %u %d %u %hu %d %x \n",
+            &score.sc_uid, &score.sc_score,
+            &score.sc_flags, &score.sc_monster,
+            &score.sc_level, &score.sc_time);
+        if (score.sc_score <= 0)
+        {
+            break;
+        }
+        score.sc_name[NAME_LENGTH - 1] = '\0';
+        m_records[i] = score;
+        ++m_count;
+    }
+
+    return true;
+}
+
+int
+score_table::post(const SCORE& score, bool all)
+{
+    std::size_t rank;
+    std::size_t drop;
+    std::size_t low = 0;
+    std::size_t high = m_count;
+    std::uint32_t slot;
+
+    // As before, nothing scoring zero gets in.
+    if (score.sc_score <= 0)
+    {
+        return -1;
+    }
+    while (low < high)
+    {
+        const std::size_t mid = low + (high - low) / 2;
+
+        if (entry(mid).sc_score >= score.sc_score)
+        {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if ((rank = low) >= m_slots)
+    {
+        return -1;
+    }
+    drop = m_count < m_slots ? m_count : m_slots - 1;
+    if (!all && score.sc_flags != 2)
+    {
+        for (std::size_t i = 0; i < m_count; ++i)
+        {
+            if (entry(i).sc_uid == score.sc_uid && entry(i).sc_flags != 2)
+            {
+                if (i < rank)
+                {
+                    return -1;
+                }
+                drop = i;
+                break;
+            }
+        }
+    }
+
+    // The slot of the entry dropped, or the first free one, moves up
+    // to the new rank and the ranks in between move down one.
+    slot = m_index[drop];
+    for (std::size_t i = drop; i > rank; --i)
+    {
+        m_index[i] = m_index[i - 1];
+    }
+    m_index[rank] = slot;
+    m_records[slot] = score;
+    m_records[slot].sc_name[NAME_LENGTH - 1] = '\0';
+    if (drop == m_count)
+    {
+        ++m_count;
+        m_header_dirty = true;
+    }
+    changed(slot, rank, drop);
+
+    return static_cast<int>(rank);
+}
+
+void
+score_table::remove(std::size_t rank)
+{
+    std::uint32_t slot;
+
+    if (rank >= m_count)
+    {
+        return;
+    }
+    slot = m_index[rank];
+    for (std::size_t i = rank; i + 1 < m_count; ++i)
+    {
+        m_index[i] = m_index[i + 1];
+    }
+    m_index[--m_count] = slot;
+    m_records[slot] = SCORE();
+    m_header_dirty = true;
+    changed(slot, rank, m_count);
+}
+
+void
+score_table::defer(bool on)
+{
+    m_defer = on;
+    if (!on)
+    {
+        flush();
+    }
+}
+
+void
+score_table::flush()
+{
+    if (!pending())
+    {
+        return;
+    }
+    if (m_rewrite)
+    {
+        write_all();
+    } else {
+        for (const auto slot : m_dirty_slots)
+        {
+            write_record(slot);
+        }
+        if (m_dirty_first <= m_dirty_last)
+        {
+            write_index(m_dirty_first, m_dirty_last);
+        }
+        if (m_header_dirty)
+        {
+            write_header();
+        }
+    }
+    clean();
+}
+
+/**
+ * Forget what was to be written.
+ */
+void
+score_table::clean()
+{
+    m_dirty_slots.clear();
+    m_dirty_first = m_slots;
+    m_dirty_last = 0;
+    m_header_dirty = false;
+}
+
+/**
+ * Note a record and a stretch of the index to be written, and write
+ * them unless writes are being held back.
+ */
+void
+score_table::changed(std::uint32_t slot, std::size_t first, std::size_t last)
+{
+    if (m_dirty_first > first)
+    {
+        m_dirty_first = first;
+    }
+    if (m_dirty_last < last)
+    {
+        m_dirty_last = last;
+    }
+    m_dirty_slots.push_back(slot);
+    if (!m_defer)
+    {
+        flush();
+    }
+}
+
+/**
+ * Write the whole file, when it isn't in this format yet.
+ */
+void
+score_table::write_all()
+{
+    std::vector<char> data(HEADER_SIZE + m_slots * (4 + RECORD_SIZE));
+
+    std::memcpy(data.data(), magic, sizeof(magic));
+    put32(&data[8], FORMAT);
+    put32(&data[12], RECORD_SIZE);
+    put32(&data[16], m_slots);
+    put32(&data[20], static_cast<std::uint32_t>(m_count));
+    for (std::uint32_t i = 0; i < m_slots; ++i)
+    {
+        char* const record = &data[HEADER_SIZE + m_slots * 4 + i * RECORD_SIZE];
+
+        put32(&data[HEADER_SIZE + i * 4], m_index[i]);
+        put_record(record, m_records[i]);
+        encxor(record, record, RECORD_SIZE);
+    }
+    write_at(0, data.data(), data.size());
+#if defined(HAVE_UNISTD_H)
+    // What is left of a file in the old format is a lot longer.
+    if (m_file != nullptr && ftruncate(fileno(m_file), static_cast<off_t>(data.size())) < 0)
+    {
+        return;
+    }
+#endif
+    m_rewrite = false;
+}
+
+void
+score_table::write_header()
+{
+    char header[HEADER_SIZE];
+
+    std::memcpy(header, magic, sizeof(magic));
+    put32(header + 8, FORMAT);
+    put32(header + 12, RECORD_SIZE);
+    put32(header + 16, m_slots);
+    put32(header + 20, static_cast<std::uint32_t>(m_count));
+    write_at(0, header, sizeof(header));
+}
+
+void
+score_table::write_index(std::size_t first, std::size_t last)
+{
+    std::vector<char> data((last - first + 1) * 4);
+
+    for (std::size_t i = first; i <= last; ++i)
+    {
+        put32(&data[(i - first) * 4], m_index[i]);
+    }
+    write_at(HEADER_SIZE + static_cast<long>(first) * 4, data.data(), data.size());
+}
+
+void
+score_table::write_record(std::uint32_t slot)
+{
+    char record[RECORD_SIZE];
+
+    put_record(record, m_records[slot]);
+    encxor(record, record, sizeof(record));
+    write_at(HEADER_SIZE + static_cast<long>(m_slots) * 4 + static_cast<long>(slot) * RECORD_SIZE, record, sizeof(record));
+}
+
+void
+score_table::write_at(long offset, const char* data, std::size_t size)
+{
+    if (m_file == nullptr)
+    {
+        return;
+    }
+    std::fseek(m_file, offset, SEEK_SET);
+    std::fwrite(data, 1, size, m_file);
+    std::fflush(m_file);
+}
+
+#if defined(HAVE_UNISTD_H) && defined(F_SETLKW)
+namespace
+{
+    /**
+     * Lock or unlock the whole of a journal.  Appends hold it only for
+     * as long as a write takes.
+     */
+    void
+    lock_journal(int fd, short type)
+    {
+        struct flock fl;
+
+        std::memset(&fl, 0, sizeof(fl));
+        fl.l_type = type;
+        fl.l_whence = SEEK_SET;
+        while (fcntl(fd, F_SETLKW, &fl) < 0 && errno == EINTR)
+        {
+        }
+    }
+
+    bool
+    write_journal_header(int fd)
+    {
+        char header[JOURNAL_HEADER];
+
+        std::memset(header, 0, sizeof(header));
+        std::memcpy(header, journal_magic, sizeof(journal_magic));
+        put32(header + 8, JOURNAL_FORMAT);
+        put32(header + 12, score_table::RECORD_SIZE);
+
+        return write(fd, header, sizeof(header)) == static_cast<ssize_t>(sizeof(header));
+    }
+
+    /**
+     * Replace the file at path with data, through a file next to it
+     * that takes its place only once it is all there.
+     */
+    bool
+    replace_file(const std::string& path, const char* data, std::size_t size)
+    {
+        const std::string temp = path + ".new";
+        int fd;
+        bool ok;
+
+        if ((fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0664)) < 0)
+        {
+            return false;
+        }
+        ok = write(fd, data, size) == static_cast<ssize_t>(size);
+        ok = close(fd) == 0 && ok;
+
+        return ok && std::rename(temp.c_str(), path.c_str()) == 0;
+    }
+
+    /** What the index needs of each entry of a journal. */
+    struct index_key
+    {
+        int score;
+        std::uint32_t uid;
+        std::uint32_t monster;
+        std::uint32_t flags;
+        std::uint32_t time;
+    };
+
+    /**
+     * Write the index of a journal holding the given entries, the last
+     * of which is in the form of a record at last, to path.
+     */
+    bool
+    write_index(const std::string& path, const std::vector<index_key>& keys, const char* last)
+    {
+        const std::uint32_t count = static_cast<std::uint32_t>(keys.size());
+        std::vector<std::uint32_t> order(count);
+        std::vector<std::uint32_t> by;
+        std::vector<std::uint32_t> winners;
+        std::vector<char> data;
+        char* out;
+
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            order[i] = i;
+        }
+        // Equal scores stay in the order the games ended, as they do in
+        // the table.
+        std::stable_sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) {
+            return keys[a].score > keys[b].score;
+        });
+        for (const auto number : order)
+        {
+            if (keys[number].flags == 2)
+            {
+                winners.push_back(number);
+            }
+        }
+        data.resize(INDEX_HEADER + 32 * static_cast<std::size_t>(count) + 4 * winners.size());
+        out = data.data();
+        std::memcpy(out, index_magic, sizeof(index_magic));
+        put32(out + 8, INDEX_FORMAT);
+        put32(out + 12, count);
+        put32(out + 16, static_cast<std::uint32_t>(winners.size()));
+        if (count > 0)
+        {
+            std::memcpy(out + 24, last, score_table::RECORD_SIZE);
+        }
+        out += INDEX_HEADER;
+        for (std::uint32_t rank = 0; rank < count; ++rank)
+        {
+            put32(out + 4 * rank, order[rank]);
+            put32(out + 4 * (count + order[rank]), rank);
+        }
+        out += 8 * static_cast<std::size_t>(count);
+
+        // The pairs, each list sorted from one best first already.
+        const auto pairs = [&](std::uint32_t index_key::* field) {
+            by = order;
+            std::stable_sort(by.begin(), by.end(), [&](std::uint32_t a, std::uint32_t b) {
+                return keys[a].*field < keys[b].*field;
+            });
+            for (const auto number : by)
+            {
+                put32(out, keys[number].*field);
+                put32(out + 4, number);
+                out += 8;
+            }
+        };
+        pairs(&index_key::uid);
+        pairs(&index_key::monster);
+        // Earliest first, whatever the score.
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            order[i] = i;
+        }
+        pairs(&index_key::time);
+        for (const auto number : winners)
+        {
+            put32(out, number);
+            out += 4;
+        }
+
+        return replace_file(path, data.data(), data.size());
+    }
+
+    /**
+     * Write a journal of the given entries to path, through a file
+     * next to it that replaces it only once it is all there, and its
+     * index to path.idx.
+     */
+    bool
+    write_journal(const std::string& path, const std::vector<SCORE>& entries)
+    {
+        std::vector<char> data(JOURNAL_HEADER + entries.size() * score_table::RECORD_SIZE);
+        std::vector<index_key> keys;
+        char* const records = &data[JOURNAL_HEADER];
+
+        std::memcpy(data.data(), journal_magic, sizeof(journal_magic));
+        put32(&data[8], JOURNAL_FORMAT);
+        put32(&data[12], score_table::RECORD_SIZE);
+        keys.reserve(entries.size());
+        for (std::size_t i = 0; i < entries.size(); ++i)
+        {
+            put_record(records + i * score_table::RECORD_SIZE, entries[i]);
+            keys.push_back({ entries[i].sc_score, entries[i].sc_uid, entries[i].sc_monster,
+                entries[i].sc_flags, entries[i].sc_time });
+        }
+        if (!replace_file(path, data.data(), data.size()))
+        {
+            return false;
+        }
+
+        return write_index(path + ".idx", keys,
+            records + (entries.empty() ? 0 : (entries.size() - 1) * score_table::RECORD_SIZE));
+    }
+}
+
+int
+score_journal::open(const char* path, bool append)
+{
+    char header[JOURNAL_HEADER];
+    struct stat sb;
+    int fd;
+
+    if ((fd = ::open(path, append ? O_RDWR | O_APPEND | O_CREAT : O_RDONLY, 0664)) < 0)
+    {
+        return -1;
+    }
+    if (append)
+    {
+        lock_journal(fd, F_WRLCK);
+    }
+    if (fstat(fd, &sb) == 0 && sb.st_size == 0 && append)
+    {
+        write_journal_header(fd);
+    } else if (pread(fd, header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))
+        || std::memcmp(header, journal_magic, sizeof(journal_magic))
+        || get32(header + 8) != JOURNAL_FORMAT
+        || get32(header + 12) != score_table::RECORD_SIZE)
+    {
+        close(fd);
+        return -1;
+    }
+    if (append)
+    {
+        lock_journal(fd, F_UNLCK);
+    }
+
+    return fd;
+}
+
+bool
+score_journal::append(const SCORE& score)
+{
+    char record[score_table::RECORD_SIZE];
+    struct stat sb;
+    off_t torn;
+    bool ok;
+
+    if (m_fd < 0)
+    {
+        return false;
+    }
+    put_record(record, score);
+    lock_journal(m_fd, F_WRLCK);
+    // Cut off what a game that died writing left of its record, so
+    // that the records after it don't straddle two.
+    if (fstat(m_fd, &sb) == 0
+        && (torn = (sb.st_size - JOURNAL_HEADER) % static_cast<off_t>(score_table::RECORD_SIZE)) != 0)
+    {
+        if (ftruncate(m_fd, sb.st_size - torn) < 0)
+        {
+            lock_journal(m_fd, F_UNLCK);
+            return false;
+        }
+    }
+    ok = write(m_fd, record, sizeof(record)) == static_cast<ssize_t>(sizeof(record));
+    lock_journal(m_fd, F_UNLCK);
+
+    return ok;
+}
+
+bool
+score_journal::scan(const std::function<void(const SCORE&)>& fn, std::size_t first) const
+{
+    std::vector<char> data(JOURNAL_CHUNK * score_table::RECORD_SIZE);
+    off_t at = JOURNAL_HEADER + static_cast<off_t>(first * score_table::RECORD_SIZE);
+    ssize_t n;
+    SCORE score;
+
+    if (m_fd < 0)
+    {
+        return false;
+    }
+    while ((n = pread(m_fd, data.data(), data.size(), at)) > 0)
+    {
+        const std::size_t whole = static_cast<std::size_t>(n) / score_table::RECORD_SIZE;
+
+        for (std::size_t i = 0; i < whole; ++i)
+        {
+            get_record(&data[i * score_table::RECORD_SIZE], score);
+            fn(score);
+        }
+        if (whole == 0)
+        {
+            // Only a torn record is left.
+            break;
+        }
+        at += static_cast<off_t>(whole * score_table::RECORD_SIZE);
+    }
+
+    return n >= 0;
+}
+
+bool
+score_journal::compact(const std::string& path, unsigned int slots, bool all) const
+{
+    std::unordered_map<unsigned int, SCORE> best;
+    std::vector<SCORE> bests;
+    std::vector<index_key> keys;
+    char last[score_table::RECORD_SIZE];
+    score_table top(nullptr, slots);
+    std::FILE* view;
+    bool ok;
+
+    ok = scan([&](const SCORE& score) {
+        const auto it = best.find(score.sc_uid);
+
+        keys.push_back({ score.sc_score, score.sc_uid, score.sc_monster, score.sc_flags, score.sc_time });
+        put_record(last, score);
+        top.post(score, all);
+        if (it == best.end())
+        {
+            best.emplace(score.sc_uid, score);
+        } else if (it->second.sc_score < score.sc_score)
+        {
+            it->second = score;
+        }
+    });
+    if (!ok || !write_index(path + ".idx", keys, last))
+    {
+        return false;
+    }
+    keys = std::vector<index_key>();
+
+    // The table, as a score file of its own.
+    if ((view = std::fopen((path + ".top.new").c_str(), "w+")) == nullptr)
+    {
+        return false;
+    }
+    score_table written(view, slots);
+
+    written.defer(true);
+    for (std::size_t i = 0; i < top.size(); ++i)
+    {
+        written.post(top.entry(i), true);
+    }
+    written.flush();
+    ok = std::fclose(view) == 0
+        && std::rename((path + ".top.new").c_str(), (path + ".top").c_str()) == 0;
+
+    // Each player's best, best first.
+    bests.reserve(best.size());
+    for (const auto& b : best)
+    {
+        bests.push_back(b.second);
+    }
+    std::sort(bests.begin(), bests.end(), [](const SCORE& a, const SCORE& b) {
+        return a.sc_score > b.sc_score || (a.sc_score == b.sc_score && a.sc_time < b.sc_time);
+    });
+
+    return write_journal(path + ".best", bests) && ok;
+}
+#else
+int
+score_journal::open(const char* path, bool append)
+{
+    (void) path;
+    (void) append;
+    return -1;
+}
+
+bool
+score_journal::append(const SCORE& score)
+{
+    (void) score;
+    return false;
+}
+
+bool
+score_journal::scan(const std::function<void(const SCORE&)>& fn, std::size_t first) const
+{
+    (void) fn;
+    (void) first;
+    return false;
+}
+
+bool
+score_journal::compact(const std::string& path, unsigned int slots, bool all) const
+{
+    (void) path;
+    (void) slots;
+    (void) all;
+    return false;
+}
+#endif
+
+score_view::score_view()
+    : m_data(nullptr)
+    , m_length(0)
+    , m_mapped(false)
+    , m_records(nullptr)
+    , m_journal(false)
+    , m_count(0)
+    , m_slots(nullptr)
+    , m_index(nullptr)
+    , m_index_length(0)
+    , m_covered(0)
+    , m_winners(0) {}
+
+score_view::~score_view()
+{
+    close();
+}
+
+void
+score_view::close()
+{
+#if defined(HAVE_SYS_MMAN_H) && defined(HAVE_UNISTD_H)
+    if (m_mapped)
+    {
+        munmap(const_cast<char*>(m_data), m_length);
+    }
+    if (m_index != nullptr)
+    {
+        munmap(const_cast<char*>(m_index), m_index_length);
+    }
+#endif
+    m_data = nullptr;
+    m_length = 0;
+    m_mapped = false;
+    m_copy.clear();
+    m_records = nullptr;
+    m_count = 0;
+    m_slots = nullptr;
+    m_index = nullptr;
+    m_index_length = 0;
+    m_covered = 0;
+    m_winners = 0;
+    m_tail.clear();
+    m_tail_rank.clear();
+    m_tail_scores.clear();
+}
+
+bool
+score_view::open(const char* path)
+{
+    close();
+#if defined(HAVE_SYS_MMAN_H) && defined(HAVE_UNISTD_H)
+    struct stat sb;
+    const int fd = ::open(path, O_RDONLY);
+    void* map;
+
+    if (fd < 0)
+    {
+        return false;
+    }
+    if (fstat(fd, &sb) == 0 && sb.st_size > 0
+        && (map = mmap(nullptr, static_cast<std::size_t>(sb.st_size), PROT_READ, MAP_SHARED, fd, 0)) != MAP_FAILED)
+    {
+        m_data = static_cast<const char*>(map);
+        m_length = static_cast<std::size_t>(sb.st_size);
+        m_mapped = true;
+    }
+    ::close(fd);
+#endif
+    if (!m_mapped)
+    {
+        std::FILE* const f = std::fopen(path, "rb");
+        char buf[4096];
+        std::size_t n;
+
+        if (f == nullptr)
+        {
+            return false;
+        }
+        while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0)
+        {
+            m_copy.insert(m_copy.end(), buf, buf + n);
+        }
+        std::fclose(f);
+        m_data = m_copy.data();
+        m_length = m_copy.size();
+    }
+
+    if (m_length >= static_cast<std::size_t>(JOURNAL_HEADER)
+        && !std::memcmp(m_data, journal_magic, sizeof(journal_magic))
+        && get32(m_data + 8) == JOURNAL_FORMAT
+        && get32(m_data + 12) == score_table::RECORD_SIZE)
+    {
+        m_journal = true;
+        m_records = m_data + JOURNAL_HEADER;
+        m_count = static_cast<std::uint32_t>((m_length - JOURNAL_HEADER) / score_table::RECORD_SIZE);
+        open_index(std::string(path) + ".idx");
+    } else if (m_length >= static_cast<std::size_t>(HEADER_SIZE)
+        && !std::memcmp(m_data, magic, sizeof(magic))
+        && get32(m_data + 8) == FORMAT
+        && get32(m_data + 12) == score_table::RECORD_SIZE)
+    {
+        const std::uint32_t slots = get32(m_data + 16);
+        const std::uint32_t count = get32(m_data + 20);
+
+        if (count > slots || m_length < HEADER_SIZE + slots * (4 + score_table::RECORD_SIZE))
+        {
+            close();
+            return false;
+        }
+        m_journal = false;
+        m_slots = m_data + HEADER_SIZE;
+        m_records = m_slots + slots * 4;
+        m_count = count;
+        for (std::uint32_t rank = 0; rank < count; ++rank)
+        {
+            if (get32(m_slots + rank * 4) >= slots)
+            {
+                close();
+                return false;
+            }
+        }
+    } else {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Map the journal's index, if there is one that belongs to it: one
+ * that covers no more entries than the journal has, the last of them
+ * as it is there.  The entries journaled since are ranked here, among
+ * those it covers.
+ */
+bool
+score_view::open_index(const std::string& path)
+{
+#if defined(HAVE_SYS_MMAN_H) && defined(HAVE_UNISTD_H)
+    struct stat sb;
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    void* map = MAP_FAILED;
+    std::uint32_t covered;
+    std::uint32_t winners;
+
+    if (fd < 0)
+    {
+        return false;
+    }
+    if (fstat(fd, &sb) == 0 && sb.st_size >= static_cast<off_t>(INDEX_HEADER))
+    {
+        map = mmap(nullptr, static_cast<std::size_t>(sb.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (map == MAP_FAILED)
+    {
+        return false;
+    }
+    m_index = static_cast<const char*>(map);
+    m_index_length = static_cast<std::size_t>(sb.st_size);
+    covered = get32(m_index + 12);
+    winners = get32(m_index + 16);
+    if (std::memcmp(m_index, index_magic, sizeof(index_magic))
+        || get32(m_index + 8) != INDEX_FORMAT
+        || covered > m_count || winners > covered
+        || m_index_length != INDEX_HEADER + 32 * static_cast<std::size_t>(covered) + 4 * winners
+        || (covered > 0 && std::memcmp(m_index + 24,
+            m_records + (covered - 1) * score_table::RECORD_SIZE, score_table::RECORD_SIZE)))
+    {
+        munmap(map, m_index_length);
+        m_index = nullptr;
+        m_index_length = 0;
+        return false;
+    }
+    m_covered = covered;
+    m_winners = winners;
+
+    for (std::uint32_t number = covered; number < m_count; ++number)
+    {
+        m_tail.push_back(number);
+    }
+    std::stable_sort(m_tail.begin(), m_tail.end(), [this](std::uint32_t a, std::uint32_t b) {
+        return points(a) > points(b);
+    });
+    m_tail_rank.resize(m_tail.size());
+    for (std::size_t i = 0; i < m_tail.size(); ++i)
+    {
+        const int score = points(m_tail[i]);
+        std::uint32_t low = 0;
+        std::uint32_t high = covered;
+
+        // Those it covers that are as good go first, having ended first.
+        while (low < high)
+        {
+            const std::uint32_t mid = low + (high - low) / 2;
+
+            if (points(list(0, mid)) >= score)
+            {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        m_tail_rank[m_tail[i] - covered] = low + static_cast<std::uint32_t>(i);
+        m_tail_scores.push_back(score);
+    }
+
+    return true;
+#else
+    (void) path;
+    return false;
+#endif
+}
+
+SCORE
+score_view::entry(std::uint32_t number) const
+{
+    char record[score_table::RECORD_SIZE];
+    SCORE score;
+
+    if (m_journal)
+    {
+        get_record(m_records + number * score_table::RECORD_SIZE, score);
+    } else {
+        encxor(record, m_records + get32(m_slots + number * 4) * score_table::RECORD_SIZE, sizeof(record));
+        get_record(record, score);
+    }
+
+    return score;
+}
+
+/**
+ * Score of an entry of a journal, read where it lies.
+ */
+int
+score_view::points(std::uint32_t number) const
+{
+    return static_cast<int>(get32(m_records + number * score_table::RECORD_SIZE + 4));
+}
+
+/**
+ * Number at the given place of one of the index's lists: 0 for the
+ * order, then 2 for uids, 4 for monsters, 6 for times, each a list of
+ * pairs and counted in fours of bytes as far as the start of the
+ * list, and 8 for the winners.  Places in a list of pairs are pairs.
+ */
+std::uint32_t
+score_view::list(int which, std::size_t place) const
+{
+    const char* const start = m_index + INDEX_HEADER + 4 * static_cast<std::size_t>(which) * m_covered;
+
+    return which == 0 || which == 8 ? get32(start + 4 * place) : get32(start + 8 * place + 4);
+}
+
+/**
+ * The places in one of the index's lists of pairs that hold the keys
+ * from low to high.
+ */
+std::pair<std::size_t, std::size_t>
+score_view::keys(int which, std::uint32_t low, std::uint32_t high) const
+{
+    const char* const start = m_index + INDEX_HEADER + 4 * static_cast<std::size_t>(which) * m_covered;
+    std::size_t first = 0;
+    std::size_t last = m_covered;
+    std::size_t end;
+
+    while (first < last)
+    {
+        const std::size_t mid = first + (last - first) / 2;
+
+        if (get32(start + 8 * mid) < low)
+        {
+            first = mid + 1;
+        } else {
+            last = mid;
+        }
+    }
+    for (end = m_covered; last < end; )
+    {
+        const std::size_t mid = last + (end - last) / 2;
+
+        if (get32(start + 8 * mid) <= high)
+        {
+            last = mid + 1;
+        } else {
+            end = mid;
+        }
+    }
+
+    return { first, last };
+}
+
+bool
+score_view::matches(std::uint32_t number, const query& q) const
+{
+    std::uint32_t uid;
+    std::uint32_t flags;
+    std::uint32_t monster;
+    std::uint32_t time;
+
+    if (m_journal)
+    {
+        const char* const record = m_records + number * score_table::RECORD_SIZE;
+
+        uid = get32(record);
+        flags = get32(record + 8);
+        monster = get32(record + 12);
+        time = get32(record + 20);
+    } else {
+        const SCORE score = entry(number);
+
+        uid = score.sc_uid;
+        flags = score.sc_flags;
+        monster = score.sc_monster;
+        time = score.sc_time;
+    }
+
+    return (q.uid < 0 || uid == static_cast<std::uint32_t>(q.uid))
+        && (q.monster < 0 || monster == static_cast<std::uint32_t>(q.monster))
+        && (!q.winners || flags == 2)
+        && time >= q.from && time <= q.to;
+}
+
+std::vector<score_view::match>
+score_view::find(const query& q) const
+{
+    std::vector<match> found;
+
+    if (m_index != nullptr)
+    {
+        return find_indexed(q);
+    }
+    if (m_journal)
+    {
+        return find_unindexed(q);
+    }
+    // A score file is in order of rank, and short.
+    for (std::uint32_t rank = 0; rank < m_count && (q.limit == 0 || found.size() < q.limit); ++rank)
+    {
+        if (matches(rank, q))
+        {
+            found.push_back({ rank, rank });
+        }
+    }
+
+    return found;
+}
+
+/**
+ * Look up a journal through its index, starting from the narrowest of
+ * its lists that applies, and add what was journaled since.
+ */
+std::vector<score_view::match>
+score_view::find_indexed(const query& q) const
+{
+    std::vector<match> found;
+    int which = 0;
+    std::pair<std::size_t, std::size_t> places(0, m_covered);
+
+    // Where an entry the index covers ranks among them all.
+    const auto ranked = [this](std::uint32_t number) {
+        const std::uint32_t rank = get32(m_index + INDEX_HEADER + 4 * (static_cast<std::size_t>(m_covered) + number));
+        const auto later = std::lower_bound(m_tail_scores.begin(), m_tail_scores.end(),
+            points(number), std::greater<int>());
+
+        return match{ number, rank + static_cast<std::uint32_t>(later - m_tail_scores.begin()) };
+    };
+
+    if (q.uid >= 0)
+    {
+        which = 2;
+        places = keys(2, static_cast<std::uint32_t>(q.uid), static_cast<std::uint32_t>(q.uid));
+    }
+    if (q.monster >= 0)
+    {
+        const auto monster = keys(4, static_cast<std::uint32_t>(q.monster), static_cast<std::uint32_t>(q.monster));
+
+        if (monster.second - monster.first < places.second - places.first)
+        {
+            which = 4;
+            places = monster;
+        }
+    }
+    if (q.winners && m_winners < places.second - places.first)
+    {
+        which = 8;
+        places = { 0, m_winners };
+    }
+
+    // A stretch of time narrower than that is looked up by time, and
+    // what is in it put back in order of rank.
+    const auto times = keys(6, q.from, q.to);
+
+    if (times.second - times.first < places.second - places.first)
+    {
+        for (auto place = times.first; place < times.second; ++place)
+        {
+            if (matches(list(6, place), q))
+            {
+                found.push_back(ranked(list(6, place)));
+            }
+        }
+        std::sort(found.begin(), found.end(), [](const match& a, const match& b) {
+            return a.rank < b.rank;
+        });
+        if (q.limit != 0 && found.size() > q.limit)
+        {
+            found.resize(q.limit);
+        }
+    } else {
+        for (auto place = places.first; place < places.second; ++place)
+        {
+            if (q.limit != 0 && found.size() == q.limit)
+            {
+                break;
+            }
+            if (matches(list(which, place), q))
+            {
+                found.push_back(ranked(list(which, place)));
+            }
+        }
+    }
+    if (m_tail.empty())
+    {
+        return found;
+    }
+
+    // Those journaled since, among the rest.
+    const std::size_t covered = found.size();
+
+    for (const auto number : m_tail)
+    {
+        if (q.limit != 0 && found.size() - covered == q.limit)
+        {
+            break;
+        }
+        if (matches(number, q))
+        {
+            found.push_back({ number, m_tail_rank[number - m_covered] });
+        }
+    }
+    std::inplace_merge(found.begin(), found.begin() + static_cast<std::ptrdiff_t>(covered), found.end(),
+        [](const match& a, const match& b) { return a.rank < b.rank; });
+    if (q.limit != 0 && found.size() > q.limit)
+    {
+        found.resize(q.limit);
+    }
+
+    return found;
+}
+
+/**
+ * Look up a journal without an index: one pass for the entries that
+ * match, the best of which are kept, and one to rank them.
+ */
+std::vector<score_view::match>
+score_view::find_unindexed(const query& q) const
+{
+    std::vector<match> found;
+    std::vector<int> scores;
+    std::vector<std::uint32_t> above;
+    std::unordered_map<int, std::uint32_t> level;
+    std::unordered_map<std::uint32_t, std::size_t> at;
+
+    const auto better = [this](const match& a, const match& b) {
+        return points(a.number) > points(b.number)
+            || (points(a.number) == points(b.number) && a.number < b.number);
+    };
+
+    for (std::uint32_t number = 0; number < m_count; ++number)
+    {
+        if (matches(number, q))
+        {
+            found.push_back({ number, 0 });
+        }
+    }
+    if (q.limit != 0 && found.size() > q.limit)
+    {
+        std::partial_sort(found.begin(), found.begin() + static_cast<std::ptrdiff_t>(q.limit), found.end(), better);
+        found.resize(q.limit);
+    } else {
+        std::sort(found.begin(), found.end(), better);
+    }
+    if (found.empty())
+    {
+        return found;
+    }
+
+    // An entry ranks after every better one, and after those as good
+    // that ended before it.
+    for (std::size_t i = 0; i < found.size(); ++i)
+    {
+        scores.push_back(points(found[i].number));
+        at.emplace(found[i].number, i);
+    }
+    scores.erase(std::unique(scores.begin(), scores.end()), scores.end());
+    above.assign(scores.size() + 1, 0);
+    for (const auto score : scores)
+    {
+        level.emplace(score, 0);
+    }
+    for (std::uint32_t number = 0; number < m_count; ++number)
+    {
+        const int score = points(number);
+        const auto same = level.find(score);
+
+        // Better than every score found below it.
+        ++above[static_cast<std::size_t>(std::upper_bound(scores.begin(), scores.end(),
+            score, std::greater<int>()) - scores.begin())];
+        if (same != level.end())
+        {
+            const auto it = at.find(number);
+
+            if (it != at.end())
+            {
+                found[it->second].rank = same->second;
+            }
+            ++same->second;
+        }
+    }
+    for (std::size_t i = 1; i < above.size(); ++i)
+    {
+        above[i] += above[i - 1];
+    }
+    for (auto& m : found)
+    {
+        m.rank += above[static_cast<std::size_t>(std::lower_bound(scores.begin(), scores.end(),
+            points(m.number), std::greater<int>()) - scores.begin())];
+    }
+
+    return found;
+}
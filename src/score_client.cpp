@@ -0,0 +1,208 @@
+/*
+ * Talking to rogue++-scored, which keeps the score file for every game
+ * on the host
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include <roguepp/roguepp.hpp>
+#include <roguepp/score.hpp>
+
+#if defined(HAVE_SYS_UN_H) && defined(HAVE_UNISTD_H)
+#define HAVE_SCORED 1
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#if defined(HAVE_SCORED)
+namespace
+{
+    /** Seconds to wait for the keeper to answer. */
+    constexpr int TIMEOUT = 5;
+}
+#endif
+
+int
+score_client::connect(const char* path)
+{
+#if defined(HAVE_SCORED)
+    struct sockaddr_un addr;
+    struct timeval tv = { TIMEOUT, 0 };
+    int fd;
+
+    if (std::strlen(path) >= sizeof(addr.sun_path))
+    {
+        return -1;
+    }
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strcpy(addr.sun_path, path);
+    if ((fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)) < 0)
+    {
+        return -1;
+    }
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    if (::connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0)
+    {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+#else
+    (void) path;
+    return -1;
+#endif
+}
+
+bool
+score_client::post(const SCORE& score, score_table& table, int& rank)
+{
+    return request("post " + format(score), &table, rank);
+}
+
+bool
+score_client::list(score_table& table)
+{
+    int rank;
+
+    return request("list\n", &table, rank);
+}
+
+bool
+score_client::remove(std::size_t rank, score_table& table)
+{
+    char line[32];
+    int ignored;
+
+    std::snprintf(line, sizeof(line), "drop %zu\n", rank);
+    if (!request(line, nullptr, ignored))
+    {
+        return false;
+    }
+    table.remove(rank);
+
+    return true;
+}
+
+std::string
+score_client::format(const SCORE& score)
+{
+    char line[96 + score_table::NAME_LENGTH];
+
+    std::snprintf(line, sizeof(line), "%u %d %u %hu %d %u %.*s\n",
+        score.sc_uid, score.sc_score, score.sc_flags, score.sc_monster,
+        score.sc_level, score.sc_time,
+        static_cast<int>(score_table::NAME_LENGTH - 1), score.sc_name);
+    // A name can't break the line it is on.
+    for (char* p = std::strchr(line, '\n'); p != nullptr && p[1] != '\0'; p = std::strchr(p, '\n'))
+    {
+        *p = ' ';
+    }
+
+    return line;
+}
+
+bool
+score_client::parse(const char* line, SCORE& score)
+{
+    int name = 0;
+
+    std::memset(&score, 0, sizeof(score));
+    if (std::sscanf(line, "%u %d %u %hu %d %u%n",
+            &score.sc_uid, &score.sc_score, &score.sc_flags, &score.sc_monster,
+            &score.sc_level, &score.sc_time, &name) < 6
+        || line[name] != ' ' || score.sc_flags > 3)
+    {
+        return false;
+    }
+    std::strncpy(score.sc_name, line + name + 1, score_table::NAME_LENGTH - 1);
+    score.sc_name[std::strcspn(score.sc_name, "\n")] = '\0';
+
+    return true;
+}
+
+/**
+ * Send one request and read the answer: the rank of what was posted
+ * and then the table as it stands, one entry to a line.  The entries
+ * are put into table, which should be empty, unless it is null.  A
+ * connection that fails once is shut, as what is left on it can't be
+ * trusted to answer the next request.
+ */
+bool
+score_client::request(const std::string& line, score_table* table, int& rank)
+{
+#if defined(HAVE_SCORED)
+    std::string answer;
+    char buf[1024];
+    ssize_t n;
+    std::size_t count = 0;
+    std::size_t at = std::string::npos;
+    std::size_t end;
+    SCORE score;
+
+    if (m_fd < 0)
+    {
+        return false;
+    }
+    if (send(m_fd, line.data(), line.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(line.size()))
+    {
+        shutdown(m_fd, SHUT_RDWR);
+        return false;
+    }
+    // The answer is whole once the head and as many lines as it counts are in.
+    while (at == std::string::npos
+        || static_cast<std::size_t>(std::count(answer.begin() + at, answer.end(), '\n')) < count)
+    {
+        if ((n = read(m_fd, buf, sizeof(buf))) < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            shutdown(m_fd, SHUT_RDWR);
+            return false;
+        }
+        answer.append(buf, static_cast<std::size_t>(n));
+        if (at == std::string::npos && (end = answer.find('\n')) != std::string::npos)
+        {
+            if (std::sscanf(answer.c_str(), "%d %zu", &rank, &count) < 2)
+            {
+                return false;
+            }
+            at = end + 1;
+        }
+    }
+    for (; count > 0; --count, at = end + 1)
+    {
+        end = answer.find('\n', at);
+        if (!parse(answer.c_str() + at, score))
+        {
+            return false;
+        }
+        if (table != nullptr)
+        {
+            table->post(score, true);
+        }
+    }
+
+    return true;
+#else
+    NOOP(rank);
+    (void) line;
+    (void) table;
+    return false;
+#endif
+}
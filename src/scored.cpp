@@ -0,0 +1,688 @@
+/*
+ * rogue++-scored: keeps the score file for every game on the host and
+ * answers them over a Unix domain socket
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include <roguepp/roguepp.hpp>
+#include <roguepp/score.hpp>
+
+#if defined(HAVE_SYS_EPOLL_H) && defined(HAVE_SYS_UN_H) && defined(HAVE_UNISTD_H)
+#define HAVE_SCORED 1
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#if defined(HAVE_SCORED)
+namespace
+{
+    /** Milliseconds a change may wait before it is written. */
+    constexpr int FLUSH_DELAY = 1000;
+    /** Changes that are written at once, however soon. */
+    constexpr int FLUSH_AFTER = 32;
+    /** Games journaled between compactions. */
+    constexpr int COMPACT_AFTER = 256;
+    /** Milliseconds to wait for a game still writing the file itself. */
+    constexpr int LOCK_WAIT = 5000;
+    /** Longest request taken. */
+    constexpr std::size_t MAX_REQUEST = 512;
+    /** Events taken from the kernel at a time. */
+    constexpr int MAX_EVENTS = 64;
+
+    volatile std::sig_atomic_t stopping = 0;
+
+    void
+    stop(int)
+    {
+        stopping = 1;
+    }
+
+    /**
+     * A game's connection: its requests as they arrive, and the answer
+     * to one of them as it goes out.  A game asks one thing at a time.
+     */
+    struct request
+    {
+        /** Who is asking, or -1 if the system won't say. */
+        long uid = -1;
+        std::string in;
+        std::string out;
+        bool answered = false;
+    };
+
+    /**
+     * The score table and the socket it is kept behind.  Changes are
+     * answered from memory at once and written to the file a batch at
+     * a time.
+     */
+    class keeper
+    {
+    public:
+        keeper()
+            : m_file(nullptr)
+            , m_table(nullptr, numscores)
+            , m_listen(-1)
+            , m_epoll(-1)
+            , m_changes(0)
+            , m_log(-1)
+            , m_journaled(0)
+            , m_seen(0)
+            , m_compacting(false) {}
+
+        ~keeper()
+        {
+            if (m_compactor.joinable())
+            {
+                m_compactor.join();
+            }
+            if (m_log >= 0)
+            {
+                close(m_log);
+            }
+            if (m_listen >= 0)
+            {
+                close(m_listen);
+                unlink(m_path.c_str());
+            }
+            if (m_epoll >= 0)
+            {
+                close(m_epoll);
+            }
+            if (m_file != nullptr)
+            {
+                std::fclose(m_file);
+            }
+        }
+
+        bool open(const char* scorefile, const std::string& path, const char* journal);
+        void run();
+
+    private:
+        void accept_games();
+        void receive(int fd, request& r);
+        void answer_all(int fd, request& r);
+        void answer(request& r, const std::string& line);
+        bool send(int fd, request& r);
+        void watch(int fd, std::uint32_t events);
+        void drop(int fd);
+        bool load_seen();
+        int catch_up(const SCORE* mine);
+        void changed();
+        void flush();
+        void compact();
+        int timeout() const;
+
+        std::FILE* m_file;
+        score_table m_table;
+        std::string m_path;
+        int m_listen;
+        int m_epoll;
+        /** Changes not written yet, and since when. */
+        int m_changes;
+        std::chrono::steady_clock::time_point m_since;
+        std::unordered_map<int, request> m_requests;
+        /**
+         * The journal, games added to it since it was compacted, and
+         * how many of its records have been posted to the table.
+         */
+        int m_log;
+        std::string m_log_path;
+        int m_journaled;
+        std::size_t m_seen;
+        std::thread m_compactor;
+        std::atomic<bool> m_compacting;
+    };
+
+    bool
+    keeper::open(const char* scorefile, const std::string& path, const char* journal)
+    {
+        struct sockaddr_un addr;
+        struct epoll_event ev;
+
+        if (journal != nullptr)
+        {
+            if ((m_log = score_journal::open(journal, true)) < 0)
+            {
+                std::fprintf(stderr, "rogue++-scored: can't keep a journal in %s\n", journal);
+                return false;
+            }
+            m_log_path = journal;
+        }
+
+        if ((m_file = std::fopen(scorefile, "r+")) == nullptr && errno == ENOENT)
+        {
+            m_file = std::fopen(scorefile, "w+");
+            md_chmod(scorefile, 0664);
+        }
+        if (m_file == nullptr)
+        {
+            std::perror(scorefile);
+            return false;
+        }
+        // Held for as long as the keeper runs: the file is its alone.
+        if (md_lockfile(m_file, LOCK_WAIT) < 0)
+        {
+            std::fprintf(stderr, "rogue++-scored: %s is in use\n", scorefile);
+            return false;
+        }
+        m_table = score_table(m_file, numscores);
+        if (!m_table.load())
+        {
+            std::fprintf(stderr, "rogue++-scored: %s is not a score file\n", scorefile);
+            return false;
+        }
+        m_table.defer(true);
+        // Games that couldn't reach the keeper journaled their scores
+        // and left them for it.
+        if (m_log >= 0 && (!load_seen() || catch_up(nullptr) < -1))
+        {
+            std::fprintf(stderr, "rogue++-scored: can't read %s\n", journal);
+            return false;
+        }
+
+        if (path.length() >= sizeof(addr.sun_path))
+        {
+            std::fprintf(stderr, "rogue++-scored: socket path \"%s\" is too long\n", path.c_str());
+            return false;
+        }
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        std::strcpy(addr.sun_path, path.c_str());
+        if ((m_listen = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0)) < 0
+            || (unlink(path.c_str()) < 0 && errno != ENOENT)
+            || bind(m_listen, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0
+            || listen(m_listen, SOMAXCONN) < 0
+            || (m_epoll = epoll_create1(EPOLL_CLOEXEC)) < 0)
+        {
+            std::perror(path.c_str());
+            return false;
+        }
+        m_path = path;
+        // Only games, which run with the keeper's group, get through.
+        md_chmod(path, 0660);
+        std::memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.fd = m_listen;
+        epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_listen, &ev);
+
+        return true;
+    }
+
+    void
+    keeper::run()
+    {
+        struct epoll_event events[MAX_EVENTS];
+        int n;
+
+        while (!stopping)
+        {
+            if ((n = epoll_wait(m_epoll, events, MAX_EVENTS, timeout())) < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                std::perror("epoll_wait");
+                break;
+            }
+            for (int i = 0; i < n; ++i)
+            {
+                const int fd = events[i].data.fd;
+
+                if (fd == m_listen)
+                {
+                    accept_games();
+                    continue;
+                }
+
+                const auto it = m_requests.find(fd);
+
+                if (it == m_requests.end())
+                {
+                    continue;
+                }
+                if (!it->second.answered)
+                {
+                    receive(fd, it->second);
+                } else if (send(fd, it->second))
+                {
+                    it->second.answered = false;
+                    watch(fd, EPOLLIN | EPOLLRDHUP);
+                    answer_all(fd, it->second);
+                }
+            }
+            if (m_changes >= FLUSH_AFTER || (m_changes > 0 && timeout() == 0))
+            {
+                flush();
+            }
+            if (m_journaled >= COMPACT_AFTER && !m_compacting)
+            {
+                compact();
+            }
+        }
+        flush();
+    }
+
+    /**
+     * Milliseconds until the oldest change not written is due, or -1
+     * if there is none.
+     */
+    int
+    keeper::timeout() const
+    {
+        if (m_changes == 0)
+        {
+            return -1;
+        }
+
+        const auto waited = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - m_since).count();
+
+        return waited >= FLUSH_DELAY ? 0 : static_cast<int>(FLUSH_DELAY - waited);
+    }
+
+    /**
+     * Find how much of the journal has been posted, from the file next
+     * to it that says so.  Without one, the journal is taken to be in
+     * the table already, as games used to post their own scores.
+     */
+    bool
+    keeper::load_seen()
+    {
+        const std::string seen = m_log_path + ".seen";
+        std::size_t records = 0;
+        unsigned long long n = 0;
+        std::FILE* fp;
+
+        if (!score_journal(m_log).scan([&records](const SCORE&) { ++records; }))
+        {
+            return false;
+        }
+        m_seen = records;
+        if ((fp = std::fopen(seen.c_str(), "r")) != nullptr)
+        {
+            // A count past the end is of a journal since replaced.
+            if (std::fscanf(fp, "%llu", &n) == 1 && n <= records)
+            {
+                m_seen = static_cast<std::size_t>(n);
+            } else if (n > records)
+            {
+                m_seen = 0;
+            }
+            std::fclose(fp);
+        }
+
+        return true;
+    }
+
+    /**
+     * Post whatever has been journaled since the keeper last looked,
+     * by it or by games that couldn't reach it.  A record the table has
+     * already, from a game that posted it itself, isn't posted again.
+     * The rank of the record that is the same as mine, -1 if it didn't
+     * make the table or isn't there, or -2 if the journal can't be read.
+     */
+    int
+    keeper::catch_up(const SCORE* mine)
+    {
+        int rank = -1;
+        const auto same = [](const SCORE& a, const SCORE& b) {
+            return a.sc_uid == b.sc_uid && a.sc_score == b.sc_score && a.sc_flags == b.sc_flags
+                && a.sc_monster == b.sc_monster && a.sc_level == b.sc_level
+                && a.sc_time == b.sc_time && std::strcmp(a.sc_name, b.sc_name) == 0;
+        };
+
+        if (!score_journal(m_log).scan([&](const SCORE& score) {
+            int at = -1;
+
+            ++m_seen;
+            ++m_journaled;
+            for (std::size_t i = 0; i < m_table.size() && at < 0; ++i)
+            {
+                if (same(m_table.entry(i), score))
+                {
+                    at = static_cast<int>(i);
+                }
+            }
+            if (at < 0 && (at = m_table.post(score, allscore)) >= 0)
+            {
+                changed();
+            }
+            if (mine != nullptr && same(score, *mine))
+            {
+                rank = at;
+            }
+        }, m_seen))
+        {
+            return -2;
+        }
+
+        return rank;
+    }
+
+    void
+    keeper::changed()
+    {
+        if (m_changes++ == 0)
+        {
+            m_since = std::chrono::steady_clock::now();
+        }
+    }
+
+    /**
+     * Write the table, then how much of the journal is in it, so that
+     * a keeper that stops in between posts some records again rather
+     * than not at all.
+     */
+    void
+    keeper::flush()
+    {
+        const std::string seen = m_log_path + ".seen";
+        const std::string temp = seen + ".new";
+        std::FILE* fp;
+        bool ok;
+
+        m_table.flush();
+        m_changes = 0;
+        if (m_log >= 0 && (fp = std::fopen(temp.c_str(), "w")) != nullptr)
+        {
+            ok = std::fprintf(fp, "%llu\n", static_cast<unsigned long long>(m_seen)) > 0;
+            if (std::fclose(fp) != 0 || !ok || std::rename(temp.c_str(), seen.c_str()) != 0)
+            {
+                std::fprintf(stderr, "rogue++-scored: can't write %s\n", seen.c_str());
+            }
+        }
+    }
+
+    /**
+     * Compact the journal on a thread of its own, so that games are
+     * answered all the while.  The keeper only ever adds to the journal,
+     * which the compaction only reads.
+     */
+    void
+    keeper::compact()
+    {
+        if (m_compactor.joinable())
+        {
+            m_compactor.join();
+        }
+        m_journaled = 0;
+        m_compacting = true;
+        m_compactor = std::thread([this] {
+            if (!score_journal(m_log).compact(m_log_path, numscores, allscore))
+            {
+                std::fprintf(stderr, "rogue++-scored: compacting %s failed\n", m_log_path.c_str());
+            }
+            m_compacting = false;
+        });
+    }
+
+    void
+    keeper::accept_games()
+    {
+        struct epoll_event ev;
+        int fd;
+
+        while ((fd = accept4(m_listen, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0)
+        {
+            long uid = -1;
+
+#if defined(SO_PEERCRED)
+            struct ucred cred;
+            socklen_t len = sizeof(cred);
+
+            /*
+             * The socket's mode keeps others out where it is honoured;
+             * the group the game connected with is checked as well.  It
+             * is what a setgid game had the score file open with.
+             */
+            if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) < 0
+                || (cred.uid != 0 && cred.uid != getuid() && cred.gid != getegid()))
+            {
+                close(fd);
+                continue;
+            }
+            uid = static_cast<long>(cred.uid);
+#endif
+            m_requests[fd].uid = uid;
+            std::memset(&ev, 0, sizeof(ev));
+            ev.events = EPOLLIN | EPOLLRDHUP;
+            ev.data.fd = fd;
+            epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &ev);
+        }
+    }
+
+    void
+    keeper::receive(int fd, request& r)
+    {
+        char buf[MAX_REQUEST];
+        ssize_t n;
+
+        while ((n = read(fd, buf, sizeof(buf))) > 0)
+        {
+            r.in.append(buf, static_cast<std::size_t>(n));
+            if (r.in.size() > MAX_REQUEST)
+            {
+                drop(fd);
+                return;
+            }
+        }
+        const bool gone = n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR);
+
+        answer_all(fd, r);
+        if (gone)
+        {
+            drop(fd);
+        }
+    }
+
+    /**
+     * Answer the requests that have come in whole, in turn.  Once an
+     * answer can't be sent at once, the rest wait until it has been.
+     */
+    void
+    keeper::answer_all(int fd, request& r)
+    {
+        std::size_t end;
+
+        while (!r.answered && (end = r.in.find('\n')) != std::string::npos)
+        {
+            answer(r, r.in.substr(0, end + 1));
+            r.in.erase(0, end + 1);
+            if (!send(fd, r))
+            {
+                r.answered = true;
+                watch(fd, EPOLLOUT);
+            }
+        }
+    }
+
+    /**
+     * Carry out a request: post, list or drop.  The answer is the rank
+     * of anything posted and the table as it stands.
+     */
+    void
+    keeper::answer(request& r, const std::string& line)
+    {
+        char head[32];
+        bool posted = false;
+        int rank = -1;
+        SCORE score;
+
+        if (line.compare(0, 5, "post ") == 0 && score_client::parse(line.c_str() + 5, score))
+        {
+            // A game can't post for someone else, but root and the
+            // keeper's own user, who may run rogue++ --serve, can.
+            if (r.uid > 0 && r.uid != static_cast<long>(getuid()))
+            {
+                score.sc_uid = static_cast<unsigned int>(r.uid);
+            }
+            // Posting it goes through the journal, along with anything
+            // games have journaled since.
+            if (m_log >= 0 && score_journal(m_log).append(score))
+            {
+                posted = (rank = catch_up(&score)) >= -1;
+            }
+            if (!posted && (rank = m_table.post(score, allscore)) >= 0)
+            {
+                changed();
+            }
+        } else if (line.compare(0, 5, "drop ") == 0)
+        {
+            // Only whoever runs the keeper, or root, edits the table.
+            if (r.uid != 0 && r.uid != static_cast<long>(getuid()))
+            {
+                r.out = "denied\n";
+                return;
+            }
+            m_table.remove(std::strtoul(line.c_str() + 5, nullptr, 10));
+            changed();
+        } else if (line != "list\n")
+        {
+            r.out = "unknown\n";
+            return;
+        }
+        std::snprintf(head, sizeof(head), "%d %zu\n", rank, m_table.size());
+        r.out = head;
+        for (std::size_t i = 0; i < m_table.size(); ++i)
+        {
+            r.out += score_client::format(m_table.entry(i));
+        }
+    }
+
+    /**
+     * Send as much of the answer as the connection takes.  true once
+     * it is all sent, or the game has gone.
+     */
+    bool
+    keeper::send(int fd, request& r)
+    {
+        ssize_t n;
+
+        while (!r.out.empty())
+        {
+            if ((n = ::send(fd, r.out.data(), r.out.size(), MSG_NOSIGNAL)) < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                return errno != EAGAIN && errno != EWOULDBLOCK;
+            }
+            r.out.erase(0, static_cast<std::size_t>(n));
+        }
+
+        return true;
+    }
+
+    void
+    keeper::watch(int fd, std::uint32_t events)
+    {
+        struct epoll_event ev;
+
+        std::memset(&ev, 0, sizeof(ev));
+        ev.events = events;
+        ev.data.fd = fd;
+        epoll_ctl(m_epoll, EPOLL_CTL_MOD, fd, &ev);
+    }
+
+    void
+    keeper::drop(int fd)
+    {
+        epoll_ctl(m_epoll, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        m_requests.erase(fd);
+    }
+}
+#endif
+
+/*
+ * main:
+ *	Keep the score file given, or SCOREFILE, behind the socket given,
+ *	or SCORESOCK, until told to stop.  Every game posted also goes in
+ *	the journal given, or SCORELOG, if there is one.  With -c, just
+ *	compact the journal.
+ */
+int
+main(int argc, char **argv)
+{
+    const char* scorefile = nullptr;
+    const char* path = nullptr;
+    const char* journal = nullptr;
+    int fd;
+
+#ifdef SCOREFILE
+    scorefile = SCOREFILE;
+#endif
+#ifdef SCORESOCK
+    path = SCORESOCK;
+#endif
+#ifdef SCORELOG
+    journal = SCORELOG;
+#endif
+    if (argc >= 2 && strcmp(argv[1], "-c") == 0)
+    {
+	if (argc >= 3)
+	    journal = argv[2];
+	if (journal == nullptr)
+	{
+	    std::fprintf(stderr, "usage: rogue++-scored -c journal\n");
+	    return 1;
+	}
+	if ((fd = score_journal::open(journal, false)) < 0
+	    || !score_journal(fd).compact(journal, numscores, allscore))
+	{
+	    std::fprintf(stderr, "rogue++-scored: compacting %s failed\n", journal);
+	    return 1;
+	}
+	return 0;
+    }
+#if defined(HAVE_SCORED)
+    keeper k;
+
+    if (argc >= 2)
+	scorefile = argv[1];
+    if (argc >= 3)
+	path = argv[2];
+    if (argc >= 4)
+	journal = argv[3];
+    if (scorefile == nullptr || path == nullptr)
+    {
+	std::fprintf(stderr, "usage: rogue++-scored [scorefile [socket [journal]]]\n");
+	return 1;
+    }
+    std::signal(SIGPIPE, SIG_IGN);
+    std::signal(SIGINT, stop);
+    std::signal(SIGTERM, stop);
+    std::signal(SIGHUP, stop);
+    if (!k.open(scorefile, path, journal))
+	return 1;
+    k.run();
+    return 0;
+#else
+    std::fprintf(stderr, "rogue++-scored is not supported here\n");
+    (void) scorefile;
+    (void) path;
+    return 1;
+#endif
+}
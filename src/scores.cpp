@@ -0,0 +1,88 @@
+/*
+ * rogue++-scores: answers questions about a score file or journal
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <roguepp/roguepp.hpp>
+#include <roguepp/score.hpp>
+
+/*
+ * usage:
+ *	Say how to call it, and give up
+ */
+static int
+usage()
+{
+    std::fprintf(stderr, "usage: rogue++-scores [-u uid] [-k monster] [-w] "
+	"[-a after] [-b before] [-n count] [file]\n");
+    return 1;
+}
+
+/*
+ * main:
+ *	Print the entries of the file given, or SCORELOG or SCOREFILE,
+ *	that match, best first.  Each goes on a line of its own: the
+ *	rank, uid, score, flags, monster, level, time and name.
+ */
+int
+main(int argc, char **argv)
+{
+    const char* file = nullptr;
+    score_view view;
+    score_view::query q;
+    int i;
+
+#ifdef SCOREFILE
+    file = SCOREFILE;
+#endif
+#ifdef SCORELOG
+    file = SCORELOG;
+#endif
+    for (i = 1; i < argc && argv[i][0] == '-'; i++)
+    {
+	if (strcmp(argv[i], "-w") == 0)
+	{
+	    q.winners = true;
+	    continue;
+	}
+	if (i + 1 >= argc || argv[i][1] == '\0' || argv[i][2] != '\0')
+	    return usage();
+	switch (argv[i++][1])
+	{
+	    case 'u':
+		q.uid = std::strtol(argv[i], nullptr, 10);
+	    when 'k':
+		// The letter of the monster, as in the score file
+		q.monster = static_cast<unsigned char>(argv[i][0]);
+	    when 'a':
+		q.from = static_cast<unsigned int>(std::strtoul(argv[i], nullptr, 10));
+	    when 'b':
+		q.to = static_cast<unsigned int>(std::strtoul(argv[i], nullptr, 10));
+	    when 'n':
+		q.limit = std::strtoul(argv[i], nullptr, 10);
+	    otherwise:
+		return usage();
+	}
+    }
+    if (i < argc)
+	file = argv[i++];
+    if (file == nullptr || i < argc)
+	return usage();
+    if (!view.open(file))
+    {
+	std::fprintf(stderr, "rogue++-scores: %s is not a score file or journal\n", file);
+	return 1;
+    }
+    for (const auto& m : view.find(q))
+	std::printf("%u %s", m.rank + 1, score_client::format(view.entry(m.number)).c_str());
+    return 0;
+}
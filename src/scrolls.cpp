@@ -12,8 +12,6 @@
 
 #include <cctype>
 
-#include <ncurses.h>
-
 #include <roguepp/roguepp.hpp>
 
 /*
@@ -32,14 +30,14 @@ read_scroll()
     bool discardit = false;
     struct room *cur_room;
     THING *orig_obj;
-    static coord mp;
+    coord mp;
 
     obj = get_item("read", SCROLL);
     if (obj == nullptr)
 	return;
     if (obj->o_type != SCROLL)
     {
-	if (!terse)
+	if (!cur_game->terse)
 	    msg("there is nothing on it to read");
 	else
 	    msg("nothing to read");
@@ -48,8 +46,8 @@ read_scroll()
     /*
      * Calculate the effect it has on the poor guy.
      */
-    if (obj == cur_weapon)
-	cur_weapon = nullptr;
+    if (obj == cur_game->cur_weapon)
+	cur_game->cur_weapon = nullptr;
     /*
      * Get rid of the thing
      */
@@ -63,13 +61,13 @@ read_scroll()
 	    /*
 	     * Scroll of monster confusion.  Give him that power.
 	     */
-	    player.t_flags |= CANHUH;
+	    cur_game->player.t_flags |= CANHUH;
 	    msg("your hands begin to glow %s", pick_color("red").c_str());
 	when S_ARMOR:
-	    if (cur_armor != nullptr)
+	    if (cur_game->cur_armor != nullptr)
 	    {
-		cur_armor->o_arm--;
-		cur_armor->o_flags &= ~ISCURSED;
+		cur_game->cur_armor->o_arm--;
+		cur_game->cur_armor->o_flags &= ~ISCURSED;
 		msg("your armor glows %s for a moment", pick_color("silver").c_str());
 	    }
 	when S_HOLD:
@@ -87,6 +85,7 @@ read_scroll()
 			    {
 				obj->t_flags &= ~ISRUN;
 				obj->t_flags |= ISHELD;
+				cur_game->awake_stale = true;
 				ch++;
 			    }
 	    if (ch)
@@ -98,7 +97,7 @@ read_scroll()
 		if (ch == 1)
 		    addmsg("s");
 		endmsg();
-		scr_info[S_HOLD].oi_know = true;
+		cur_game->scr_info[S_HOLD].oi_know = true;
 	    }
 	    else
 		msg("you feel a strange sense of loss");
@@ -106,9 +105,9 @@ read_scroll()
 	    /*
 	     * Scroll which makes you fall asleep
 	     */
-	    scr_info[S_SLEEP].oi_know = true;
-	    no_command += rnd(SLEEPTIME) + 4;
-	    player.t_flags &= ~ISRUN;
+	    cur_game->scr_info[S_SLEEP].oi_know = true;
+	    cur_game->no_command += rnd(SLEEPTIME) + 4;
+	    cur_game->player.t_flags &= ~ISRUN;
 	    msg("you fall asleep");
 	when S_CREATE:
 	    /*
@@ -156,15 +155,15 @@ read_scroll()
 	    /*
 	     * Identify, let him figure something out
 	     */
-	    scr_info[obj->o_which].oi_know = true;
-	    msg("this scroll is an %s scroll", scr_info[obj->o_which].oi_name);
+	    cur_game->scr_info[obj->o_which].oi_know = true;
+	    msg("this scroll is an %s scroll", cur_game->scr_info[obj->o_which].oi_name);
 	    whatis(true, id_type[obj->o_which]);
 	}
 	when S_MAP:
 	    /*
 	     * Scroll of magic mapping.
 	     */
-	    scr_info[S_MAP].oi_know = true;
+	    cur_game->scr_info[S_MAP].oi_know = true;
 	    msg("oh, now this scroll has a map on it");
 	    /*
 	     * take all the things we want to keep hidden out of the window
@@ -225,26 +224,27 @@ def:
 		    {
 			if ((obj = pp->p_monst) != nullptr)
 			    obj->t_oldch = ch;
-			if (obj == nullptr || !on(player, SEEMONST))
-			    mvaddch(y, x, ch);
+			if (obj == nullptr || !on(cur_game->player, SEEMONST))
+			    cur_game->cw->mvaddch(y, x, ch);
 		    }
 		}
+	    cur_game->chase_fields.clear();	/* hidden ways are open now */
 	when S_FDET:
 	    /*
 	     * Potion of gold detection
 	     */
 	    ch = false;
-	    wclear(hw);
-	    for (obj = lvl_obj; obj != nullptr; obj = next(obj))
+	    cur_game->hw->clear();
+	    for (obj = cur_game->lvl_obj; obj != nullptr; obj = next(obj))
 		if (obj->o_type == FOOD)
 		{
 		    ch = true;
-		    wmove(hw, obj->o_pos.y, obj->o_pos.x);
-		    waddch(hw, FOOD);
+		    cur_game->hw->move(obj->o_pos.y, obj->o_pos.x);
+		    cur_game->hw->addch(FOOD);
 		}
 	    if (ch)
 	    {
-		scr_info[S_FDET].oi_know = true;
+		cur_game->scr_info[S_FDET].oi_know = true;
 		show_win("Your nose tingles and you smell food.--More--");
 	    }
 	    else
@@ -258,20 +258,20 @@ def:
 		cur_room = proom;
 		teleport();
 		if (cur_room != proom)
-		    scr_info[S_TELEP].oi_know = true;
+		    cur_game->scr_info[S_TELEP].oi_know = true;
 	    }
 	when S_ENCH:
-	    if (cur_weapon == nullptr || cur_weapon->o_type != WEAPON)
+	    if (cur_game->cur_weapon == nullptr || cur_game->cur_weapon->o_type != WEAPON)
 		msg("you feel a strange sense of loss");
 	    else
 	    {
-		cur_weapon->o_flags &= ~ISCURSED;
+		cur_game->cur_weapon->o_flags &= ~ISCURSED;
 		if (rnd(2) == 0)
-		    cur_weapon->o_hplus++;
+		    cur_game->cur_weapon->o_hplus++;
 		else
-		    cur_weapon->o_dplus++;
+		    cur_game->cur_weapon->o_dplus++;
 		msg("your %s glows %s for a moment",
-		    weap_info[cur_weapon->o_which].oi_name, pick_color("blue").c_str());
+		    cur_game->weap_info[cur_game->cur_weapon->o_which].oi_name, pick_color("blue").c_str());
 	    }
 	when S_SCARE:
 	    /*
@@ -280,10 +280,10 @@ def:
 	     */
 	    msg("you hear maniacal laughter in the distance");
 	when S_REMOVE:
-	    uncurse(cur_armor);
-	    uncurse(cur_weapon);
-	    uncurse(cur_ring[LEFT]);
-	    uncurse(cur_ring[RIGHT]);
+	    uncurse(cur_game->cur_armor);
+	    uncurse(cur_game->cur_weapon);
+	    uncurse(cur_game->cur_ring[LEFT]);
+	    uncurse(cur_game->cur_ring[RIGHT]);
 	    msg(choose_str("you feel in touch with the Universal Onenes",
 			   "you feel as if somebody is watching over you"));
 	when S_AGGR:
@@ -294,9 +294,9 @@ def:
 	    aggravate();
 	    msg("you hear a high pitched humming noise");
 	when S_PROTECT:
-	    if (cur_armor != nullptr)
+	    if (cur_game->cur_armor != nullptr)
 	    {
-		cur_armor->o_flags |= ISPROT;
+		cur_game->cur_armor->o_flags |= ISPROT;
 		msg("your armor is covered by a shimmering %s shield",
 		    pick_color("gold").c_str());
 	    }
@@ -312,7 +312,7 @@ def:
     look(true);	/* put the result of the scroll on the screen */
     status();
 
-    call_it(&scr_info[obj->o_which]);
+    call_it(&cur_game->scr_info[obj->o_which]);
 
     if (discardit)
 	discard(obj);
@@ -0,0 +1,476 @@
+/*
+ * Server mode: one process playing many games, each over its own
+ * connection to a Unix domain socket
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <exception>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <roguepp/game_stepper.hpp>
+#include <roguepp/roguepp.hpp>
+
+#if defined(HAVE_SYS_EPOLL_H) && defined(HAVE_SYS_UN_H) && defined(HAVE_UNISTD_H)
+#define HAVE_SERVE 1
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#if defined(HAVE_SERVE)
+namespace
+{
+    /** Output a player may fall behind by before he is dropped. */
+    constexpr std::size_t MAX_OUTPUT = 1024 * 1024;
+    /** Events taken from the kernel at a time. */
+    constexpr int MAX_EVENTS = 64;
+
+    /**
+     * One game and the connection it is played over.  The game is
+     * stepped whenever bytes arrive, and is put aside in between.  A
+     * game the player drops out of is saved in the file given, and
+     * picked up from it the next time they come.
+     */
+    class session
+    {
+    public:
+        session(int fd, long uid, int dnum, const std::string& save);
+        ~session();
+
+        session(const session&) = delete;
+        session& operator=(const session&) = delete;
+
+        int fd() const
+        {
+            return m_fd;
+        }
+
+        /** Has the game finished, successfully or not? */
+        bool over() const
+        {
+            return m_steps.over();
+        }
+
+        /** Has the game drawn something that isn't sent yet? */
+        bool has_output() const
+        {
+            return !m_out.empty();
+        }
+
+        /**
+         * Pass what has arrived on the connection to the game.  Notes
+         * the hangup if the player has gone.
+         */
+        void receive();
+
+        /**
+         * Send as much of the output as the connection takes.  false if
+         * the player has gone or can't keep up.
+         */
+        bool send();
+
+        /**
+         * Let the game run until it waits for a key that hasn't come
+         * yet, or ends.  After a hangup the game is ended.
+         */
+        void step();
+
+        /** The player has gone; save the game at the next step. */
+        void hangup()
+        {
+            m_gone = true;
+            m_steps.hangup();
+        }
+
+    private:
+        void play();
+
+        int m_fd;
+        std::unique_ptr<game> m_game;
+        std::unique_ptr<renderer> m_screen;
+        game_stepper m_steps;
+        std::string m_out;
+        /** Has the player gone, and was the game under way by then? */
+        bool m_gone;
+        bool m_playing;
+    };
+
+    session::session(int fd, long uid, int dnum, const std::string& save)
+        : m_fd(fd)
+        , m_game(std::make_unique<game>())
+        , m_screen(ansi_renderer(
+            NUMLINES,
+            NUMCOLS,
+            [this](bool wait) { return m_steps.take(wait); },
+            [this](const std::string& bytes) { m_out += bytes; }
+        ))
+        , m_steps(*m_game, [this] { play(); })
+        , m_gone(false)
+        , m_playing(false)
+    {
+        const std::string name = uid >= 0 ? md_getrealname(static_cast<int>(uid)) : "rogue";
+
+        m_game->display = m_screen.get();
+        m_game->embedded = true;
+        m_game->uid = static_cast<int>(uid);
+        m_game->dnum = dnum;
+        strucpy(m_game->whoami, name.c_str(), name.length());
+        strucpy(m_game->file_name, save.c_str(), save.length());
+    }
+
+    session::~session()
+    {
+        m_steps.end();
+        // A game frees what it holds through cur_game.
+        cur_game = m_game.get();
+        m_game.reset();
+        cur_game = nullptr;
+        close(m_fd);
+    }
+
+    void
+    session::receive()
+    {
+        unsigned char buf[512];
+        ssize_t n;
+
+        while ((n = read(m_fd, buf, sizeof(buf))) > 0)
+        {
+            for (ssize_t i = 0; i < n; ++i)
+            {
+                m_steps.feed(buf[i]);
+            }
+        }
+        if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+        {
+            hangup();
+        }
+    }
+
+    bool
+    session::send()
+    {
+        ssize_t n;
+
+        while (!m_out.empty())
+        {
+            if ((n = ::send(m_fd, m_out.data(), m_out.size(), MSG_NOSIGNAL)) < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                if (errno != EAGAIN && errno != EWOULDBLOCK)
+                {
+                    return false;
+                }
+                break;
+            }
+            m_out.erase(0, static_cast<std::size_t>(n));
+        }
+
+        return m_out.size() <= MAX_OUTPUT;
+    }
+
+    void
+    session::step()
+    {
+        try
+        {
+            m_steps.step();
+        }
+        catch (const std::exception& e)
+        {
+            std::fprintf(stderr, "rogue++: game of %s failed: %s\n", m_game->whoami, e.what());
+        }
+    }
+
+    /**
+     * Play the game from start, or from where it was saved, to end,
+     * then show how it ended until return is pressed.
+     */
+    void
+    session::play()
+    {
+        srnd(m_game->dnum);
+        try
+        {
+            if (!restore_embedded())
+            {
+                init_display();
+                init_game();
+                start_game();
+            }
+            m_playing = true;
+            playit();
+        }
+        catch (const game_over&)
+        {
+            // Dropping out isn't the end of the game, as a hangup never
+            // was: it is saved for when the player comes back.
+            if (m_gone && m_playing && m_game->end_flags < 0
+                && m_game->file_name[0] != '\0' && !save_embedded())
+            {
+                std::fprintf(stderr, "rogue++: can't save the game of %s in %s\n",
+                    m_game->whoami, m_game->file_name);
+            }
+        }
+        if (!m_screen->ended())
+        {
+            m_game->cw->mvaddstr(NUMLINES - 1, 0, "[Press return to continue]");
+            m_game->cw->clrtoeol();
+            m_game->cw->refresh();
+            wait_for('\n');
+            m_screen->end();
+        }
+    }
+
+    /**
+     * User at the other end of a connection; -1 if that can't be told.
+     */
+    long
+    peer_uid(int fd)
+    {
+#if defined(SO_PEERCRED)
+        struct ucred cred;
+        socklen_t len = sizeof(cred);
+
+        if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) == 0)
+        {
+            return static_cast<long>(cred.uid);
+        }
+#else
+        NOOP(fd);
+#endif
+        return -1;
+    }
+
+    /**
+     * The event loop: accepts players, hands their keys to their games
+     * and sends back what the games draw.
+     */
+    class server
+    {
+    public:
+        explicit server(std::string saves)
+            : m_saves(std::move(saves))
+            , m_listen(-1)
+            , m_epoll(-1)
+            , m_games(0) {}
+
+        ~server()
+        {
+            if (m_listen >= 0)
+            {
+                close(m_listen);
+            }
+            if (m_epoll >= 0)
+            {
+                close(m_epoll);
+            }
+        }
+
+        bool open(const std::string& path);
+        void run();
+
+    private:
+        void accept_players();
+        void update(session& s);
+        void watch(int fd, std::uint32_t events, int op);
+
+        /** Where players' games are saved, one file for each. */
+        std::string m_saves;
+        int m_listen;
+        int m_epoll;
+        int m_games;
+        std::unordered_map<int, std::unique_ptr<session>> m_sessions;
+        /** Sessions waiting for the connection to take more output. */
+        std::unordered_map<int, bool> m_writing;
+    };
+
+    bool
+    server::open(const std::string& path)
+    {
+        struct sockaddr_un addr;
+
+        if (path.length() >= sizeof(addr.sun_path))
+        {
+            std::fprintf(stderr, "rogue++: socket path \"%s\" is too long\n", path.c_str());
+            return false;
+        }
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        std::strcpy(addr.sun_path, path.c_str());
+        if ((m_listen = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0)) < 0
+            || (unlink(path.c_str()) < 0 && errno != ENOENT)
+            || bind(m_listen, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0
+            || listen(m_listen, SOMAXCONN) < 0
+            || (m_epoll = epoll_create1(EPOLL_CLOEXEC)) < 0)
+        {
+            std::perror(path.c_str());
+            return false;
+        }
+        watch(m_listen, EPOLLIN, EPOLL_CTL_ADD);
+
+        return true;
+    }
+
+    void
+    server::watch(int fd, std::uint32_t events, int op)
+    {
+        struct epoll_event ev;
+
+        std::memset(&ev, 0, sizeof(ev));
+        ev.events = events;
+        ev.data.fd = fd;
+        epoll_ctl(m_epoll, op, fd, &ev);
+    }
+
+    void
+    server::run()
+    {
+        struct epoll_event events[MAX_EVENTS];
+        int n;
+
+        for (;;)
+        {
+            if ((n = epoll_wait(m_epoll, events, MAX_EVENTS, -1)) < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                std::perror("epoll_wait");
+                return;
+            }
+            for (int i = 0; i < n; ++i)
+            {
+                const int fd = events[i].data.fd;
+
+                if (fd == m_listen)
+                {
+                    accept_players();
+                    continue;
+                }
+
+                const auto it = m_sessions.find(fd);
+
+                if (it == m_sessions.end())
+                {
+                    continue;
+                }
+                if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR | EPOLLRDHUP))
+                {
+                    it->second->receive();
+                }
+                update(*it->second);
+            }
+        }
+    }
+
+    void
+    server::accept_players()
+    {
+        int fd;
+
+        while ((fd = accept4(m_listen, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0)
+        {
+            const long uid = peer_uid(fd);
+            // Nobody can come back for a game that isn't known to be theirs.
+            auto s = std::make_unique<session>(
+                fd,
+                uid,
+                static_cast<int>(std::time(nullptr)) + md_getpid() + ++m_games,
+                uid >= 0 ? m_saves + "rogue++-" + std::to_string(uid) + ".save" : std::string()
+            );
+            auto& ref = *s;
+
+            m_sessions.emplace(fd, std::move(s));
+            watch(fd, EPOLLIN | EPOLLRDHUP, EPOLL_CTL_ADD);
+            update(ref);
+        }
+    }
+
+    /**
+     * Run a game on as far as its input goes, send what it drew, and
+     * drop it once it is over and everything has been sent.
+     */
+    void
+    server::update(session& s)
+    {
+        const int fd = s.fd();
+
+        s.step();
+        if (!s.send())
+        {
+            s.hangup();
+            s.step();
+            m_sessions.erase(fd);
+            m_writing.erase(fd);
+            return;
+        }
+        if (s.over() && !s.has_output())
+        {
+            m_sessions.erase(fd);
+            m_writing.erase(fd);
+            return;
+        }
+
+        bool& writing = m_writing[fd];
+
+        if (writing != s.has_output())
+        {
+            writing = s.has_output();
+            std::uint32_t events = EPOLLIN | EPOLLRDHUP;
+
+            if (writing)
+            {
+                events |= EPOLLOUT;
+            }
+            watch(fd, events, EPOLL_CTL_MOD);
+        }
+    }
+}
+#endif
+
+/*
+ * serve:
+ *	Play games for everyone connecting to the socket at the given
+ *	path, until killed, saving those they drop out of in the
+ *	directory saves
+ */
+int
+serve(const std::string& path, const std::string& saves)
+{
+#if defined(HAVE_SERVE)
+    server srv(saves);
+
+    std::signal(SIGPIPE, SIG_IGN);
+    if (!srv.open(path))
+	return 1;
+    std::printf("Serving games on %s\n", path.c_str());
+    std::fflush(stdout);
+    srv.run();
+    return 1;
+#else
+    std::fprintf(stderr, "rogue++: server mode is not supported here\n");
+    (void) path;
+    (void) saves;
+    return 1;
+#endif
+}
@@ -0,0 +1,320 @@
+/*
+ * Engine side copy of what is on the screen
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+
+#include <algorithm>
+
+#include <roguepp/shadow_canvas.hpp>
+
+static const shadow_canvas::cell blank = { ' ', false };
+
+shadow_canvas::shadow_canvas(canvas& target)
+    : m_target(target)
+    , m_lines(target.lines())
+    , m_cols(target.cols())
+    , m_cells(m_lines * m_cols, blank)
+    , m_front(m_lines * m_cols, blank)
+    , m_first(m_lines, m_cols)
+    , m_last(m_lines, -1)
+    , m_y(0)
+    , m_x(0)
+    , m_standout(false)
+    , m_cleared(false)
+    , m_target_standout(false)
+    , m_target_y(-1)
+    , m_target_x(-1) {}
+
+void
+shadow_canvas::move(int y, int x)
+{
+    if (y < 0 || y >= m_lines || x < 0 || x >= m_cols)
+    {
+        return;
+    }
+    m_y = y;
+    m_x = x;
+}
+
+void
+shadow_canvas::getyx(int& y, int& x) const
+{
+    y = m_y;
+    x = m_x;
+}
+
+/**
+ * Same as waddch() would do with the cursor and the cells, so that the
+ * copy never drifts away from what the terminal library has.
+ */
+void
+shadow_canvas::addch(int ch)
+{
+    ch &= 0xff;
+    switch (ch)
+    {
+        case '\n':
+            clrtoeol();
+            if (m_y < m_lines - 1)
+            {
+                ++m_y;
+            }
+            m_x = 0;
+            break;
+        case '\r':
+            m_x = 0;
+            break;
+        case '\b':
+            if (m_x > 0)
+            {
+                --m_x;
+            }
+            break;
+        case '\t':
+            for (auto n = 8 - m_x % 8; n > 0; --n)
+            {
+                put(' ');
+            }
+            break;
+        default:
+            if (ch < ' ' || ch == 0x7f)
+            {
+                put('^');
+                put(ch == 0x7f ? '?' : static_cast<char>(ch + '@'));
+            } else {
+                put(static_cast<char>(ch));
+            }
+            break;
+    }
+}
+
+void
+shadow_canvas::addstr(const char* str)
+{
+    while (*str)
+    {
+        addch(static_cast<unsigned char>(*str++));
+    }
+}
+
+int
+shadow_canvas::inch() const
+{
+    return static_cast<unsigned char>(at(m_y, m_x).ch);
+}
+
+void
+shadow_canvas::clrtoeol()
+{
+    std::fill(
+        m_cells.begin() + m_y * m_cols + m_x,
+        m_cells.begin() + (m_y + 1) * m_cols,
+        blank
+    );
+    touch_cells(m_y, m_x, m_cols - 1);
+}
+
+void
+shadow_canvas::clear()
+{
+    erase();
+    m_cleared = true;
+}
+
+void
+shadow_canvas::erase()
+{
+    std::fill(m_cells.begin(), m_cells.end(), blank);
+    for (int y = 0; y < m_lines; ++y)
+    {
+        touch_cells(y, 0, m_cols - 1);
+    }
+    m_y = m_x = 0;
+}
+
+void
+shadow_canvas::standout()
+{
+    m_standout = true;
+}
+
+void
+shadow_canvas::standend()
+{
+    m_standout = false;
+}
+
+void
+shadow_canvas::refresh()
+{
+    flush();
+    m_target.refresh();
+}
+
+void
+shadow_canvas::touch()
+{
+    m_target.touch();
+}
+
+void
+shadow_canvas::place(int y, int x)
+{
+    m_target.place(y, x);
+}
+
+void
+shadow_canvas::flush()
+{
+    if (m_cleared)
+    {
+        // Let the renderer repaint everything, as clear() asks for.
+        m_target.clear();
+        std::fill(m_front.begin(), m_front.end(), blank);
+        m_cleared = false;
+        m_target_y = m_target_x = -1;
+    }
+    for (int y = 0; y < m_lines; ++y)
+    {
+        if (m_first[y] <= m_last[y])
+        {
+            flush_line(y);
+        }
+    }
+    if (m_target_standout)
+    {
+        m_target.standend();
+        m_target_standout = false;
+    }
+    if (m_y != m_target_y || m_x != m_target_x)
+    {
+        m_target.move(m_y, m_x);
+        m_target_y = m_y;
+        m_target_x = m_x;
+    }
+}
+
+/**
+ * Put a printable character at the cursor.
+ */
+void
+shadow_canvas::put(char ch)
+{
+    auto& c = m_cells[m_y * m_cols + m_x];
+    const cell now = { ch, m_standout };
+
+    if (c != now)
+    {
+        c = now;
+        touch_cells(m_y, m_x, m_x);
+    }
+    advance();
+}
+
+void
+shadow_canvas::advance()
+{
+    if (++m_x < m_cols)
+    {
+        return;
+    }
+    if (m_y < m_lines - 1)
+    {
+        m_x = 0;
+        ++m_y;
+    } else {
+        m_x = m_cols - 1;
+    }
+}
+
+void
+shadow_canvas::touch_cells(int y, int first, int last)
+{
+    m_first[y] = std::min(m_first[y], first);
+    m_last[y] = std::max(m_last[y], last);
+}
+
+/**
+ * Is there a changed cell soon after the given one, so that drawing the
+ * few unchanged ones in between is cheaper than moving past them?
+ */
+static bool
+bridge(std::vector<shadow_canvas::cell>::const_iterator back,
+    std::vector<shadow_canvas::cell>::const_iterator front, int left)
+{
+    for (int i = 1; i <= std::min(left, 4); ++i)
+    {
+        if (back[i] != front[i])
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Send the touched part of a line.  Runs of changed cells are drawn
+ * with one move, short gaps between them are drawn over rather than
+ * moved across, and a line whose rest has gone blank is cleared to its
+ * end instead of being overwritten with spaces.
+ */
+void
+shadow_canvas::flush_line(int y)
+{
+    const auto back = m_cells.begin() + y * m_cols;
+    const auto front = m_front.begin() + y * m_cols;
+    const auto last = m_last[y];
+    int tail = m_cols;
+    int x;
+    bool moved = false;
+
+    while (tail > m_first[y] && back[tail - 1] == blank)
+    {
+        --tail;
+    }
+    for (x = m_first[y]; x <= last && x < tail; ++x)
+    {
+        if (back[x] == front[x] && !(moved && bridge(back + x, front + x, std::min(last, tail - 1) - x)))
+        {
+            moved = false;
+            continue;
+        }
+        if (!moved)
+        {
+            m_target.move(y, x);
+            m_target_y = -1;
+            moved = true;
+        }
+        if (back[x].standout != m_target_standout)
+        {
+            if (back[x].standout)
+            {
+                m_target.standout();
+            } else {
+                m_target.standend();
+            }
+            m_target_standout = back[x].standout;
+        }
+        m_target.addch(static_cast<unsigned char>(back[x].ch));
+        front[x] = back[x];
+        if (x == m_cols - 1)
+        {
+            moved = false;
+        }
+    }
+    if (x <= last && std::any_of(front + x, front + m_cols, [](const cell& c) { return c != blank; }))
+    {
+        m_target.move(y, x);
+        m_target_y = -1;
+        m_target.clrtoeol();
+        std::fill(front + x, front + m_cols, blank);
+    }
+    m_first[y] = m_cols;
+    m_last[y] = -1;
+}
@@ -0,0 +1,643 @@
+/*
+ * Batch simulation runner: plays many games without a terminal and
+ * prints a summary line for each one
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <roguepp/game_stepper.hpp>
+#include <roguepp/work_pool.hpp>
+#include <roguepp/roguepp.hpp>
+
+namespace
+{
+    /**
+     * Text of the given line of the screen.
+     */
+    std::string
+    line(const shadow_canvas& screen, int y)
+    {
+        std::string text(screen.cols(), ' ');
+
+        for (int x = 0; x < screen.cols(); ++x)
+        {
+            text[x] = screen.at(y, x).ch;
+        }
+
+        return text;
+    }
+
+    /**
+     * Where the keys typed into a simulated game come from.
+     */
+    class policy
+    {
+    public:
+        virtual ~policy() = default;
+
+        /** Next key for the game, which is showing the given screen. */
+        virtual int next_key(const shadow_canvas& screen) = 0;
+    };
+
+    /**
+     * Types the same keystrokes over and over again.
+     */
+    class script_policy : public policy
+    {
+    public:
+        explicit script_policy(const std::string& keys)
+            : m_keys(keys)
+            , m_pos(0) {}
+
+        int next_key(const shadow_canvas&) override
+        {
+            const int ch = static_cast<unsigned char>(m_keys[m_pos]);
+
+            m_pos = (m_pos + 1) % m_keys.size();
+
+            return ch;
+        }
+
+    private:
+        const std::string& m_keys;
+        std::size_t m_pos;
+    };
+
+    /**
+     * Simple player: fights whatever is next to it, eats when hungry,
+     * rests when hurt and otherwise walks to the stairs or to the
+     * nearest spot it hasn't been to that borders on the unknown.  It
+     * only looks at what is on the screen and in its own pack.
+     */
+    class bot_policy : public policy
+    {
+    public:
+        explicit bot_policy(int seed)
+            : m_rng(static_cast<unsigned int>(seed))
+            , m_visited(NUMLINES * NUMCOLS)
+            , m_level(0)
+            , m_last{-1, -1}
+            , m_stuck(0) {}
+
+        int next_key(const shadow_canvas& screen) override;
+
+    private:
+        int answer(const shadow_canvas& screen);
+        int fight(const shadow_canvas& screen);
+        int eat();
+        int walk(const shadow_canvas& screen);
+        int wander(const shadow_canvas& screen);
+
+        std::minstd_rand m_rng;
+        std::deque<int> m_plan;
+        std::vector<bool> m_visited;
+        int m_level;
+        coord m_last;
+        int m_stuck;
+    };
+
+    /**
+     * Summary of one simulated game.
+     */
+    struct record
+    {
+        int seed;
+        const char* result;
+        int level;
+        int max_level;
+        int turns;
+        int gold;
+        int score;
+        std::string killer;
+    };
+
+    /**
+     * Settings shared by every game of the run.
+     */
+    struct settings
+    {
+        int max_turns = 20000;
+        bool scripted = false;
+        std::string keys;
+    };
+
+    std::mutex output_mutex;
+
+    const char move_keys[3][3] =
+    {
+        { 'y', 'k', 'u' },
+        { 'h', '.', 'l' },
+        { 'b', 'j', 'n' },
+    };
+
+    /**
+     * Can the bot walk on the given screen character?
+     */
+    bool
+    walkable(char ch)
+    {
+        switch (ch)
+        {
+            case FLOOR: case PASSAGE: case DOOR: case STAIRS:
+            case GOLD: case POTION: case SCROLL: case FOOD:
+            case WEAPON: case ARMOR: case RING: case STICK:
+            case AMULET:
+                return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * What the bot knows to be on the given square.  The hero hides
+     * the square he is standing on, but he can feel that one.
+     */
+    char
+    ground(const shadow_canvas& screen, int y, int x)
+    {
+        if (y == hero.y && x == hero.x)
+        {
+            return chat(y, x);
+        }
+
+        return screen.at(y, x).ch;
+    }
+
+    /**
+     * Can the hero move or attack diagonally between the given
+     * squares?  Doors can't be entered or left diagonally and corners
+     * can't be cut.
+     */
+    bool
+    diagonal(const shadow_canvas& screen, int y, int x, int ny, int nx)
+    {
+        return ground(screen, y, x) != DOOR && ground(screen, ny, nx) != DOOR
+            && walkable(ground(screen, y, nx)) && walkable(ground(screen, ny, x));
+    }
+
+    /**
+     * Can the bot step from one square to a neighbouring one?
+     */
+    bool
+    step(const shadow_canvas& screen, int y, int x, int ny, int nx)
+    {
+        if (ny < 1 || ny >= NUMLINES - 1 || nx < 0 || nx >= NUMCOLS)
+        {
+            return false;
+        }
+        if (!walkable(ground(screen, ny, nx)))
+        {
+            return false;
+        }
+
+        return ny == y || nx == x || diagonal(screen, y, x, ny, nx);
+    }
+
+    int
+    bot_policy::next_key(const shadow_canvas& screen)
+    {
+        int ch;
+
+        if (!m_plan.empty())
+        {
+            ch = m_plan.front();
+            m_plan.pop_front();
+
+            return ch;
+        }
+        if ((ch = answer(screen)) != 0)
+        {
+            return ch;
+        }
+        if (m_last.y == hero.y && m_last.x == hero.x)
+        {
+            ++m_stuck;
+        } else {
+            m_stuck = 0;
+        }
+        m_last = hero;
+        if (m_level != cur_game->level)
+        {
+            m_level = cur_game->level;
+            std::fill(std::begin(m_visited), std::end(m_visited), false);
+        }
+        m_visited[hero.y * NUMCOLS + hero.x] = true;
+        if ((m_stuck < 8 && (ch = fight(screen)) != 0) || (ch = eat()) != 0)
+        {
+            return ch;
+        }
+        if (pstats.s_hpt < max_hp / 2 && m_stuck < 40)
+        {
+            return 's';
+        }
+        if (chat(hero.y, hero.x) == STAIRS)
+        {
+            return '>';
+        }
+        if (m_stuck < 4 && (ch = walk(screen)) != 0)
+        {
+            return ch;
+        }
+
+        return wander(screen);
+    }
+
+    /**
+     * Deal with prompts and pauses.
+     */
+    int
+    bot_policy::answer(const shadow_canvas& screen)
+    {
+        const auto top = line(screen, 0);
+        const auto bottom = line(screen, NUMLINES - 1);
+        const auto end = top.find_last_not_of(' ');
+
+        if (top.find("--More--") != std::string::npos
+            || bottom.find("--Press space") != std::string::npos)
+        {
+            return ' ';
+        }
+        if (bottom.find("[Press return") != std::string::npos)
+        {
+            return '\n';
+        }
+        if (end != std::string::npos && (top[end] == '?' || top[end] == ':'))
+        {
+            return ESCAPE;
+        }
+
+        return 0;
+    }
+
+    /**
+     * Attack a monster standing next to the hero.
+     */
+    int
+    bot_policy::fight(const shadow_canvas& screen)
+    {
+        for (int dy = -1; dy <= 1; ++dy)
+        {
+            for (int dx = -1; dx <= 1; ++dx)
+            {
+                const int y = hero.y + dy;
+                const int x = hero.x + dx;
+
+                if ((dy || dx) && y > 0 && y < NUMLINES - 1
+                    && x >= 0 && x < NUMCOLS
+                    && std::isupper(static_cast<unsigned char>(screen.at(y, x).ch))
+                    && (!dy || !dx || diagonal(screen, hero.y, hero.x, y, x)))
+                {
+                    return move_keys[dy + 1][dx + 1];
+                }
+            }
+        }
+
+        return 0;
+    }
+
+    /**
+     * Eat something when getting weak.
+     */
+    int
+    bot_policy::eat()
+    {
+        if (cur_game->hungry_state < 2)
+        {
+            return 0;
+        }
+        for (THING* obj = pack; obj != nullptr; obj = next(obj))
+        {
+            if (obj->o_type == FOOD)
+            {
+                m_plan.push_back(obj->o_packch);
+
+                return 'e';
+            }
+        }
+
+        return 0;
+    }
+
+    /**
+     * Take one step along the shortest known path to the stairs or,
+     * if they haven't been found, to the nearest unexplored square.
+     */
+    int
+    bot_policy::walk(const shadow_canvas& screen)
+    {
+        std::vector<int> from(NUMLINES * NUMCOLS, -1);
+        std::deque<int> todo;
+        const int start = hero.y * NUMCOLS + hero.x;
+        int goal = -1;
+        int frontier = -1;
+
+        from[start] = start;
+        todo.push_back(start);
+        while (!todo.empty() && goal < 0)
+        {
+            const int here = todo.front();
+            const int y = here / NUMCOLS;
+            const int x = here % NUMCOLS;
+
+            todo.pop_front();
+            for (int dy = -1; dy <= 1; ++dy)
+            {
+                for (int dx = -1; dx <= 1; ++dx)
+                {
+                    const int ny = y + dy;
+                    const int nx = x + dx;
+
+                    if (ny < 1 || ny >= NUMLINES - 1 || nx < 0 || nx >= NUMCOLS)
+                    {
+                        continue;
+                    }
+                    if (frontier < 0 && !m_visited[here] && screen.at(ny, nx).ch == ' ')
+                    {
+                        frontier = here;
+                    }
+                    if ((!dy && !dx) || from[ny * NUMCOLS + nx] >= 0
+                        || !step(screen, y, x, ny, nx))
+                    {
+                        continue;
+                    }
+                    from[ny * NUMCOLS + nx] = here;
+                    if (screen.at(ny, nx).ch == STAIRS)
+                    {
+                        goal = ny * NUMCOLS + nx;
+                    }
+                    todo.push_back(ny * NUMCOLS + nx);
+                }
+            }
+        }
+        if (goal < 0)
+        {
+            goal = frontier;
+        }
+        if (goal < 0)
+        {
+            return 0;
+        }
+        while (from[goal] != start)
+        {
+            goal = from[goal];
+        }
+
+        return move_keys[goal / NUMCOLS - hero.y + 1][goal % NUMCOLS - hero.x + 1];
+    }
+
+    /**
+     * Look for hidden doors, or walk somewhere at random.
+     */
+    int
+    bot_policy::wander(const shadow_canvas& screen)
+    {
+        if (m_rng() % 3 == 0)
+        {
+            return 's';
+        }
+        for (int tries = 0; tries < 8; ++tries)
+        {
+            const int dy = static_cast<int>(m_rng() % 3) - 1;
+            const int dx = static_cast<int>(m_rng() % 3) - 1;
+
+            if ((dy || dx) && step(screen, hero.y, hero.x, hero.y + dy, hero.x + dx))
+            {
+                return move_keys[dy + 1][dx + 1];
+            }
+        }
+
+        return 's';
+    }
+
+    /**
+     * Play one game from start to finish.
+     */
+    record
+    play(int seed, const settings& opts)
+    {
+        static const char* const results[] =
+        {
+            "killed",
+            "quit",
+            "winner",
+            "killed with amulet",
+        };
+        std::unique_ptr<policy> input;
+        std::unique_ptr<game_stepper> steps;
+        auto g = std::make_unique<game>();
+        record r = { seed, "timeout", 0, 0, 0, 0, 0, "" };
+
+        if (opts.scripted)
+        {
+            input = std::make_unique<script_policy>(opts.keys);
+        } else {
+            input = std::make_unique<bot_policy>(seed);
+        }
+
+        const auto screen = null_renderer(NUMLINES, NUMCOLS, [&]()
+        {
+            return steps->take(true);
+        });
+
+        cur_game = g.get();
+        g->display = screen.get();
+        g->embedded = true;
+        g->hand_back = true;
+        g->tombstone = false;
+        g->dnum = seed;
+        srnd(seed);
+        std::strcpy(g->whoami, "sim");
+        steps = std::make_unique<game_stepper>(*g, [&]()
+        {
+            init_display();
+            init_game();
+            start_game();
+            g->oldpos = hero;
+            g->oldrp = roomin(&hero);
+            while (g->playing)
+            {
+                command();
+            }
+        });
+
+        long keys = 0;
+        while (steps->step())
+        {
+            // Give up on games that go nowhere, and on policies that
+            // keep typing without the game moving on.
+            if (g->turns >= opts.max_turns || ++keys > 4L * opts.max_turns + 1000)
+            {
+                steps->end();
+                break;
+            }
+            steps->feed(input->next_key(*g->cw_shadow));
+        }
+        steps.reset();
+        if (g->end_flags >= 0 && g->end_flags <= 3)
+        {
+            r.result = results[g->end_flags];
+            if (g->end_flags == 0 || g->end_flags == 3)
+            {
+                r.killer = killname(g->end_monst, true);
+            }
+        }
+        r.level = g->level;
+        r.max_level = g->max_level;
+        r.turns = g->turns;
+        r.gold = g->purse;
+        r.score = g->end_score;
+        g.reset();
+        cur_game = nullptr;
+
+        return r;
+    }
+
+    /**
+     * Play the games in [first, last).  Halves of the range are handed
+     * to the pool so that idle workers can take them over.
+     */
+    void
+    play_range(work_pool& pool, long first, long last, const settings& opts)
+    {
+        while (last - first > 1)
+        {
+            const long middle = first + (last - first) / 2;
+
+            pool.submit([&pool, middle, last, &opts]
+            {
+                play_range(pool, middle, last, opts);
+            });
+            last = middle;
+        }
+
+        const auto r = play(static_cast<int>(first), opts);
+        std::lock_guard<std::mutex> lock(output_mutex);
+
+        std::printf(
+            "%d,%s,%d,%d,%d,%d,%d,%s\n",
+            r.seed,
+            r.result,
+            r.level,
+            r.max_level,
+            r.turns,
+            r.gold,
+            r.score,
+            r.killer.c_str()
+        );
+    }
+
+    void
+    usage(const char* prog)
+    {
+        std::fprintf(
+            stderr,
+            "usage: %s [-j threads] [-t max-turns] [-k keyfile] first-seed [count]\n",
+            prog
+        );
+        std::exit(1);
+    }
+}
+
+/*
+ * main:
+ *	Run the simulations
+ */
+int
+main(int argc, char** argv)
+{
+    settings opts;
+    unsigned int threads = 0;
+    long first;
+    long count = 1;
+    int i;
+
+    for (i = 1; i < argc && argv[i][0] == '-'; ++i)
+    {
+        if (i + 1 >= argc)
+        {
+            usage(argv[0]);
+        }
+        if (!std::strcmp(argv[i], "-j"))
+        {
+            threads = static_cast<unsigned int>(std::atoi(argv[++i]));
+        }
+        else if (!std::strcmp(argv[i], "-t"))
+        {
+            opts.max_turns = std::atoi(argv[++i]);
+        }
+        else if (!std::strcmp(argv[i], "-k"))
+        {
+            std::ifstream keyfile(argv[++i], std::ios::binary);
+
+            opts.keys.assign(
+                std::istreambuf_iterator<char>(keyfile),
+                std::istreambuf_iterator<char>()
+            );
+            if (opts.keys.empty())
+            {
+                std::fprintf(stderr, "%s: no keys in %s\n", argv[0], argv[i]);
+                return 1;
+            }
+            opts.scripted = true;
+        } else {
+            usage(argv[0]);
+        }
+    }
+    if (i >= argc || argc - i > 2)
+    {
+        usage(argv[0]);
+    }
+    first = std::atol(argv[i]);
+    if (i + 1 < argc)
+    {
+        count = std::atol(argv[i + 1]);
+    }
+    if (count < 1 || opts.max_turns < 1)
+    {
+        usage(argv[0]);
+    }
+
+    const auto started = std::chrono::steady_clock::now();
+
+    std::printf("seed,result,level,max_level,turns,gold,score,killer\n");
+    {
+        work_pool pool(threads);
+
+        pool.submit([&pool, first, count, &opts]
+        {
+            play_range(pool, first, first + count, opts);
+        });
+        pool.wait();
+        std::fflush(stdout);
+        std::fprintf(
+            stderr,
+            "%ld games on %zu threads in %.2f seconds\n",
+            count,
+            pool.size(),
+            std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - started
+            ).count()
+        );
+    }
+
+    return 0;
+}
@@ -29,10 +29,13 @@
     SUCH DAMAGE.
 */
 
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
-
-#include <ncurses.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <roguepp/roguepp.hpp>
 
@@ -64,50 +67,94 @@
 #define RSID_CTYPES       0XABCD0015
 #define RSID_COORDLIST    0XABCD0016
 #define RSID_ROOMS        0XABCD0017
+#define RSID_MEMORY       0XABCD0018
 
 #define READSTAT (format_error || read_error )
 #define WRITESTAT (write_error)
 
-static bool read_error = false;
-static bool write_error = false;
-static bool format_error = false;
+/*
+ * Saved game format 2: a header, a table of sections and then the
+ * sections themselves.  Numbers are little-endian and fixed width.
+ * Each section is encrypted on its own and has a checksum of what was
+ * stored, and sections a reader doesn't know are skipped, so newer
+ * versions can add to the format without older saves going stale.
+ */
+#define SAVE_FORMAT       2           /* format written */
+#define SAVE_COMPAT       2           /* oldest format that can read it */
+#define SAVE_HEADER       20          /* magic, format, compat, sections */
+#define SAVE_ENTRY        16          /* tag, offset, length, checksum */
+
+#define RSEC_INFO         0x4f464e49  /* "INFO" */
+#define RSEC_GAME         0x454d4147  /* "GAME" */
+#define RSEC_HERO         0x4f524548  /* "HERO" */
+#define RSEC_OBJECTS      0x4a424f4c  /* "LOBJ" */
+#define RSEC_MONSTERS     0x534e4f4d  /* "MONS" */
+#define RSEC_LEVEL        0x4c56454c  /* "LEVL" */
+#define RSEC_KNOWLEDGE    0x574f4e4b  /* "KNOW" */
+#define RSEC_TIME         0x454d4954  /* "TIME" */
+#define RSEC_SCREEN       0x4e524353  /* "SCRN", before "SEEN" */
+#define RSEC_MEMORY       0x4e454553  /* "SEEN" */
+
+static const char save_magic[8] = { 'R', 'o', 'g', 'u', 'e', '+', '+', '\032' };
+
+/*
+ * Where a saved game is read from: what is left of one section, or of
+ * a whole file in the old format, which encrypted every field on its
+ * own.
+ */
+struct save_reader
+{
+    const char* next;
+    const char* end;
+    bool legacy;
+};
+
+static thread_local bool read_error = false;
+static thread_local bool write_error = false;
+static thread_local bool format_error = false;
 static int endian = 0x01020304;
 #define  big_endian ( *((char *)&endian) == 0x01 )
 
 static bool
-rs_write(FILE* savef, const void* ptr, const std::size_t size)
+rs_write(std::string& savef, const void* ptr, const std::size_t size)
 {
     if (write_error)
     {
         return WRITESTAT;
     }
 
-    if (encwrite(static_cast<const char*>(ptr), size, savef) != size)
-    {
-        write_error = true;
-    }
+    savef.append(static_cast<const char*>(ptr), size);
 
     return WRITESTAT;
 }
 
 static bool
-rs_read(FILE* inf, void* ptr, const std::size_t size)
+rs_read(save_reader& inf, void* ptr, const std::size_t size)
 {
     if (read_error || format_error)
     {
         return READSTAT;
     }
 
-    if (encread(static_cast<char*>(ptr), size, inf) != size)
+    if (static_cast<std::size_t>(inf.end - inf.next) < size)
     {
         read_error = true;
+
+        return READSTAT;
+    }
+    if (inf.legacy)
+    {
+        encxor(static_cast<char*>(ptr), inf.next, size);
+    } else {
+        std::memcpy(ptr, inf.next, size);
     }
+    inf.next += size;
 
     return READSTAT;
 }
 
 static bool
-rs_write_int(FILE *savef, int c)
+rs_write_int(std::string& savef, int c)
 {
     unsigned char bytes[4];
     unsigned char *buf = (unsigned char *) &c;
@@ -130,7 +177,7 @@ rs_write_int(FILE *savef, int c)
 }
 
 static bool
-rs_read_int(FILE* inf, int& i)
+rs_read_int(save_reader& inf, int& i)
 {
     unsigned char bytes[4];
     int input = 0;
@@ -158,7 +205,7 @@ rs_read_int(FILE* inf, int& i)
 }
 
 static bool
-rs_read_int(FILE* inf, std::size_t& i)
+rs_read_int(save_reader& inf, std::size_t& i)
 {
     int value = 0;
 
@@ -173,7 +220,7 @@ rs_read_int(FILE* inf, std::size_t& i)
 }
 
 static bool
-rs_write_char(FILE *savef, char c)
+rs_write_char(std::string& savef, char c)
 {
     if (write_error)
         return(WRITESTAT);
@@ -184,7 +231,7 @@ rs_write_char(FILE *savef, char c)
 }
 
 static bool
-rs_read_char(FILE *inf, char *c)
+rs_read_char(save_reader& inf, char *c)
 {
     if (read_error || format_error)
         return(READSTAT);
@@ -195,7 +242,7 @@ rs_read_char(FILE *inf, char *c)
 }
 
 static bool
-rs_write_chars(FILE* savef, const char* c, const std::size_t count)
+rs_write_chars(std::string& savef, const char* c, const std::size_t count)
 {
     if (write_error)
     {
@@ -209,7 +256,7 @@ rs_write_chars(FILE* savef, const char* c, const std::size_t count)
 }
 
 static bool
-rs_read_chars(FILE* inf, char* i, const std::size_t count)
+rs_read_chars(save_reader& inf, char* i, const std::size_t count)
 {
     int value = 0;
 
@@ -227,7 +274,7 @@ rs_read_chars(FILE* inf, char* i, const std::size_t count)
 }
 
 static bool
-rs_write_ints(FILE *savef, const int* c, const std::size_t count)
+rs_write_ints(std::string& savef, const int* c, const std::size_t count)
 {
     if (write_error)
         return(WRITESTAT);
@@ -242,7 +289,7 @@ rs_write_ints(FILE *savef, const int* c, const std::size_t count)
 }
 
 static bool
-rs_read_ints(FILE *inf, int* i, const std::size_t count)
+rs_read_ints(save_reader& inf, int* i, const std::size_t count)
 {
     int value = 0;
 
@@ -262,7 +309,7 @@ rs_read_ints(FILE *inf, int* i, const std::size_t count)
 }
 
 static bool
-rs_write_boolean(FILE* savef, bool c)
+rs_write_boolean(std::string& savef, bool c)
 {
     const unsigned char buf = c ? 1  : 0;
 
@@ -275,7 +322,7 @@ rs_write_boolean(FILE* savef, bool c)
 }
 
 static bool
-rs_read_boolean(FILE* inf, bool& i)
+rs_read_boolean(save_reader& inf, bool& i)
 {
     unsigned char buf = 0;
 
@@ -293,7 +340,7 @@ rs_read_boolean(FILE* inf, bool& i)
 
 template<std::size_t N>
 static bool
-rs_write_booleans(FILE* savef, const std::array<bool, N>& container)
+rs_write_booleans(std::string& savef, const std::array<bool, N>& container)
 {
     if (write_error)
     {
@@ -315,7 +362,7 @@ rs_write_booleans(FILE* savef, const std::array<bool, N>& container)
 
 template<std::size_t N>
 static bool
-rs_read_booleans(FILE* inf, std::array<bool, N>& container)
+rs_read_booleans(save_reader& inf, std::array<bool, N>& container)
 {
     int value = 0;
 
@@ -343,7 +390,7 @@ rs_read_booleans(FILE* inf, std::array<bool, N>& container)
 }
 
 static bool
-rs_write_short(FILE *savef, short c)
+rs_write_short(std::string& savef, short c)
 {
     unsigned char bytes[2];
     unsigned char *buf = (unsigned char *) &c;
@@ -364,7 +411,7 @@ rs_write_short(FILE *savef, short c)
 }
 
 static bool
-rs_read_short(FILE *inf, short *i)
+rs_read_short(save_reader& inf, short *i)
 {
     unsigned char bytes[2];
     short  input;
@@ -388,7 +435,7 @@ rs_read_short(FILE *inf, short *i)
 }
 
 static bool
-rs_write_uint(FILE *savef, unsigned int c)
+rs_write_uint(std::string& savef, unsigned int c)
 {
     unsigned char bytes[4];
     unsigned char *buf = (unsigned char *) &c;
@@ -411,7 +458,7 @@ rs_write_uint(FILE *savef, unsigned int c)
 }
 
 static bool
-rs_read_uint(FILE *inf, unsigned int *i)
+rs_read_uint(save_reader& inf, unsigned int *i)
 {
     unsigned char bytes[4];
     int  input;
@@ -437,7 +484,7 @@ rs_read_uint(FILE *inf, unsigned int *i)
 }
 
 static bool
-rs_write_marker(FILE *savef, int id)
+rs_write_marker(std::string& savef, int id)
 {
     if (write_error)
         return(WRITESTAT);
@@ -448,7 +495,7 @@ rs_write_marker(FILE *savef, int id)
 }
 
 static bool
-rs_read_marker(FILE *inf, int id)
+rs_read_marker(save_reader& inf, int id)
 {
     int nid;
 
@@ -467,7 +514,7 @@ rs_read_marker(FILE *inf, int id)
 /******************************************************************************/
 
 static bool
-rs_write_string(FILE* savef, const std::string& s)
+rs_write_string(std::string& savef, const std::string& s)
 {
     if (write_error)
     {
@@ -481,7 +528,7 @@ rs_write_string(FILE* savef, const std::string& s)
 }
 
 static bool
-rs_write_string(FILE *savef, const char* s)
+rs_write_string(std::string& savef, const char* s)
 {
     const auto len = s ? std::strlen(s) + 1 : 0;
 
@@ -497,7 +544,7 @@ rs_write_string(FILE *savef, const char* s)
 }
 
 static bool
-rs_read_new_string(FILE* inf, std::string& container)
+rs_read_new_string(save_reader& inf, std::string& container)
 {
     int len = 0;
     char* buffer = nullptr;
@@ -526,7 +573,7 @@ rs_read_new_string(FILE* inf, std::string& container)
 }
 
 static bool
-rs_read_new_string(FILE* inf, char** s)
+rs_read_new_string(save_reader& inf, char** s)
 {
     int len = 0;
     char* buf = nullptr;
@@ -555,7 +602,7 @@ rs_read_new_string(FILE* inf, char** s)
 }
 
 static bool
-rs_read_new_string(FILE* inf, const char*& s)
+rs_read_new_string(save_reader& inf, const char*& s)
 {
     int len = 0;
     char* buf = nullptr;
@@ -585,7 +632,7 @@ rs_read_new_string(FILE* inf, const char*& s)
 
 template<std::size_t N>
 static bool
-rs_write_strings(FILE* savef, const std::array<const char*, N>& container)
+rs_write_strings(std::string& savef, const std::array<const char*, N>& container)
 {
     if (write_error)
     {
@@ -607,7 +654,7 @@ rs_write_strings(FILE* savef, const std::array<const char*, N>& container)
 
 template<std::size_t N>
 static bool
-rs_read_new_strings(FILE* inf, std::array<const char*, N>& container)
+rs_read_new_strings(save_reader& inf, std::array<const char*, N>& container)
 {
     int value = 0;
 
@@ -637,7 +684,7 @@ rs_read_new_strings(FILE* inf, std::array<const char*, N>& container)
 template<std::size_t N>
 static bool
 rs_write_string_index(
-    FILE* savef,
+    std::string& savef,
     const std::array<std::string, N>& master,
     const std::optional<std::string>& str
 )
@@ -661,7 +708,7 @@ rs_write_string_index(
 template<std::size_t N>
 static bool
 rs_read_string_index(
-    FILE* inf,
+    save_reader& inf,
     const std::array<std::string, N>& master,
     std::optional<std::string>& str
 )
@@ -690,7 +737,7 @@ rs_read_string_index(
 }
 
 static bool
-rs_write_str_t(FILE *savef, stats::str_t st)
+rs_write_str_t(std::string& savef, stats::str_t st)
 {
     if (write_error)
         return(WRITESTAT);
@@ -701,7 +748,7 @@ rs_write_str_t(FILE *savef, stats::str_t st)
 }
 
 static bool
-rs_read_str_t(FILE *inf, stats::str_t *st)
+rs_read_str_t(save_reader& inf, stats::str_t *st)
 {
     if (read_error || format_error)
         return(READSTAT);
@@ -711,8 +758,54 @@ rs_read_str_t(FILE *inf, stats::str_t *st)
     return(READSTAT);
 }
 
+/*
+ * The streams are keyed by the seed, so only their positions are kept.
+ */
 static bool
-rs_write_coord(FILE* savef, const coord& c)
+rs_write_rng(std::string& savef, const std::array<rng_stream, NRNG>& rng)
+{
+    if (write_error)
+    {
+        return WRITESTAT;
+    }
+
+    for (const auto& stream : rng)
+    {
+        const auto position = stream.position();
+
+        rs_write_uint(savef, static_cast<unsigned int>(position >> 32));
+        rs_write_uint(savef, static_cast<unsigned int>(position));
+    }
+
+    return WRITESTAT;
+}
+
+static bool
+rs_read_rng(save_reader& inf, std::array<rng_stream, NRNG>& rng)
+{
+    if (read_error || format_error)
+    {
+        return READSTAT;
+    }
+
+    for (auto& stream : rng)
+    {
+        unsigned int high = 0;
+        unsigned int low = 0;
+
+        rs_read_uint(inf, &high);
+        rs_read_uint(inf, &low);
+        if (!READSTAT)
+        {
+            stream.seek(static_cast<std::uint64_t>(high) << 32 | low);
+        }
+    }
+
+    return READSTAT;
+}
+
+static bool
+rs_write_coord(std::string& savef, const coord& c)
 {
     if (write_error)
     {
@@ -726,7 +819,7 @@ rs_write_coord(FILE* savef, const coord& c)
 }
 
 static bool
-rs_read_coord(FILE* inf, coord& c)
+rs_read_coord(save_reader& inf, coord& c)
 {
     coord in;
 
@@ -747,39 +840,96 @@ rs_read_coord(FILE* inf, coord& c)
     return READSTAT;
 }
 
+/*
+ * rs_write_memory:
+ *	What is on the screen, the map as the player remembers it, as runs
+ *	of a character per line
+ */
 static bool
-rs_write_window(FILE *savef, WINDOW *win)
+rs_write_memory(std::string& savef, canvas* win)
 {
-    int row,col,height,width;
+    const int height = win->lines();
+    const int width = win->cols();
+    std::string runs;
 
     if (write_error)
         return(WRITESTAT);
 
-    width  = getmaxx(win);
-    height = getmaxy(win);
-
-    rs_write_marker(savef,RSID_WINDOW);
-    rs_write_int(savef,height);
-    rs_write_int(savef,width);
+    rs_write_marker(savef, RSID_MEMORY);
+    rs_write_int(savef, height);
+    rs_write_int(savef, width);
 
-    for(row=0;row<height;row++)
-        for(col=0;col<width;col++)
-            if (rs_write_int(savef, mvwinch(win,row,col)))
-                return(WRITESTAT);
+    for (int row = 0; row < height; row++)
+    {
+        runs.clear();
+        for (int col = 0; col < width; )
+        {
+            const int ch = win->mvinch(row, col);
+            int run = 1;
+
+            while (col + run < width && run < 255 && win->mvinch(row, col + run) == ch)
+                run++;
+            runs += static_cast<char>(run);
+            runs += static_cast<char>(ch);
+            col += run;
+        }
+        rs_write_int(savef, static_cast<int>(runs.size() / 2));
+        rs_write(savef, runs.data(), runs.size());
+    }
 
     return(WRITESTAT);
 }
 
 static bool
-rs_read_window(FILE *inf, WINDOW *win)
+rs_read_memory(save_reader& inf, canvas* win)
+{
+    const int height = win->lines();
+    const int width = win->cols();
+    int maxlines, maxcols, count;
+    unsigned char run[2];
+
+    if (read_error || format_error)
+        return(READSTAT);
+
+    rs_read_marker(inf, RSID_MEMORY);
+    rs_read_int(inf, maxlines);
+    rs_read_int(inf, maxcols);
+
+    win->erase();
+    for (int row = 0; row < maxlines; row++)
+    {
+        int col = 0;
+
+        if (rs_read_int(inf, count))
+            return(READSTAT);
+        while (count-- > 0)
+        {
+            if (rs_read(inf, run, 2))
+                return(READSTAT);
+            if (run[0] == 0 || col + run[0] > maxcols)
+            {
+                format_error = true;
+                return(READSTAT);
+            }
+            for (const int end = col + run[0]; col < end; col++)
+                if (row < height && col < width)
+                    win->mvaddch(row, col, run[1]);
+        }
+    }
+
+    return(READSTAT);
+}
+
+static bool
+rs_read_window(save_reader& inf, canvas* win)
 {
     int row,col,maxlines,maxcols,value,width,height;
 
     if (read_error || format_error)
         return(READSTAT);
 
-    width  = getmaxx(win);
-    height = getmaxy(win);
+    width  = win->cols();
+    height = win->lines();
 
     rs_read_marker(inf, RSID_WINDOW);
 
@@ -793,7 +943,7 @@ rs_read_window(FILE *inf, WINDOW *win)
                 return(READSTAT);
 
             if ((row < height) && (col < width))
-                mvwaddch(win,row,col,value);
+                win->mvaddch(row,col,value);
         }
 
     return(READSTAT);
@@ -801,30 +951,63 @@ rs_read_window(FILE *inf, WINDOW *win)
 
 /******************************************************************************/
 
-static THING*
-get_list_item(THING* l, int i)
+/*
+ * The lists references in a saved game point into, numbered once per
+ * save or restore so that a reference is looked up instead of found by
+ * walking the list.  Items are keyed both by themselves and by where
+ * they are, since t_dest points at the position.
+ */
+struct list_index
 {
+    std::vector<THING*> items;
+    std::unordered_map<const void*, int> ids;
+};
+
+static thread_local list_index pack_index;
+static thread_local list_index object_index;
+static thread_local list_index monster_index;
+
+static void
+index_list(list_index& index, THING* l, bool monsters)
+{
+    index.items.clear();
+    index.ids.clear();
     for (int count = 0; l != nullptr; ++count, l = l->l_next)
     {
-        if (count == i)
-        {
-            return l;
-        }
+        index.items.push_back(l);
+        index.ids[l] = count;
+        if (monsters)
+            index.ids[&l->t_pos] = count;
+        else
+            index.ids[&l->o_pos] = count;
     }
+}
 
-    return nullptr;
+static void
+clear_indexes()
+{
+    for (list_index* index : { &pack_index, &object_index, &monster_index })
+    {
+        index->items = std::vector<THING*>();
+        index->ids = std::unordered_map<const void*, int>();
+    }
 }
 
-static int
-find_list_ptr(THING *l, void *ptr)
+static THING*
+get_list_item(const list_index& index, int i)
 {
-    int count;
+    if (i < 0 || i >= static_cast<int>(index.items.size()))
+        return nullptr;
 
-    for(count = 0; l != nullptr; count++, l = l->l_next)
-        if (l == ptr)
-            return(count);
+    return index.items[i];
+}
+
+static int
+find_list_ptr(const list_index& index, const void* ptr)
+{
+    const auto it = index.ids.find(ptr);
 
-    return(-1);
+    return it == index.ids.end() ? -1 : it->second;
 }
 
 static int
@@ -841,7 +1024,7 @@ list_size(THING *l)
 /******************************************************************************/
 
 static bool
-rs_write_stats(FILE* savef, const stats& s)
+rs_write_stats(std::string& savef, const stats& s)
 {
     if (write_error)
         return(WRITESTAT);
@@ -859,7 +1042,7 @@ rs_write_stats(FILE* savef, const stats& s)
 }
 
 static bool
-rs_read_stats(FILE* inf, stats& s)
+rs_read_stats(save_reader& inf, stats& s)
 {
     if (read_error || format_error)
         return(READSTAT);
@@ -879,7 +1062,7 @@ rs_read_stats(FILE* inf, stats& s)
 template<std::size_t N>
 static bool
 rs_write_stone_index(
-    FILE* savef,
+    std::string& savef,
     const std::array<STONE, N>& master,
     const std::optional<std::string>& str
 )
@@ -903,7 +1086,7 @@ rs_write_stone_index(
 template<std::size_t N>
 static bool
 rs_read_stone_index(
-    FILE* inf,
+    save_reader& inf,
     const std::array<STONE, N>& master,
     std::optional<std::string>& str
 )
@@ -932,7 +1115,7 @@ rs_read_stone_index(
 }
 
 static bool
-rs_write_scrolls(FILE* savef)
+rs_write_scrolls(std::string& savef)
 {
     if (write_error)
     {
@@ -941,14 +1124,14 @@ rs_write_scrolls(FILE* savef)
 
     for (std::size_t i = 0; i < MAXSCROLLS; ++i)
     {
-        rs_write_string(savef, s_names[i]);
+        rs_write_string(savef, cur_game->s_names[i]);
     }
 
     return WRITESTAT;
 }
 
 static bool
-rs_read_scrolls(FILE* inf)
+rs_read_scrolls(save_reader& inf)
 {
     if (read_error || format_error)
     {
@@ -957,14 +1140,14 @@ rs_read_scrolls(FILE* inf)
 
     for (std::size_t i = 0; i < MAXSCROLLS; ++i)
     {
-        rs_read_new_string(inf, s_names[i]);
+        rs_read_new_string(inf, cur_game->s_names[i]);
     }
 
     return READSTAT;
 }
 
 static bool
-rs_write_potions(FILE* savef)
+rs_write_potions(std::string& savef)
 {
     if (write_error)
     {
@@ -973,14 +1156,14 @@ rs_write_potions(FILE* savef)
 
     for (std::size_t i = 0; i < MAXPOTIONS; ++i)
     {
-        rs_write_string_index<NCOLORS>(savef, rainbow, p_colors[i]);
+        rs_write_string_index<NCOLORS>(savef, rainbow, cur_game->p_colors[i]);
     }
 
     return WRITESTAT;
 }
 
 static bool
-rs_read_potions(FILE* inf)
+rs_read_potions(save_reader& inf)
 {
     if (read_error || format_error)
     {
@@ -989,14 +1172,14 @@ rs_read_potions(FILE* inf)
 
     for (std::size_t i = 0; i < MAXPOTIONS; ++i)
     {
-        rs_read_string_index<NCOLORS>(inf, rainbow, p_colors[i]);
+        rs_read_string_index<NCOLORS>(inf, rainbow, cur_game->p_colors[i]);
     }
 
     return READSTAT;
 }
 
 static bool
-rs_write_rings(FILE* savef)
+rs_write_rings(std::string& savef)
 {
     if (write_error)
     {
@@ -1005,14 +1188,14 @@ rs_write_rings(FILE* savef)
 
     for (std::size_t i = 0; i < MAXRINGS; ++i)
     {
-        rs_write_stone_index<NSTONES>(savef, stones, r_stones[i]);
+        rs_write_stone_index<NSTONES>(savef, stones, cur_game->r_stones[i]);
     }
 
     return WRITESTAT;
 }
 
 static bool
-rs_read_rings(FILE* inf)
+rs_read_rings(save_reader& inf)
 {
     if (read_error || format_error)
     {
@@ -1021,14 +1204,14 @@ rs_read_rings(FILE* inf)
 
     for (std::size_t i = 0; i < MAXRINGS; ++i)
     {
-        rs_read_stone_index<NSTONES>(inf, stones, r_stones[i]);
+        rs_read_stone_index<NSTONES>(inf, stones, cur_game->r_stones[i]);
     }
 
     return READSTAT;
 }
 
 static bool
-rs_write_sticks(FILE* savef)
+rs_write_sticks(std::string& savef)
 {
     if (write_error)
     {
@@ -1037,13 +1220,13 @@ rs_write_sticks(FILE* savef)
 
     for (std::size_t i = 0; i < MAXSTICKS; ++i)
     {
-        if (ws_type[i] && !ws_type[i]->compare("staff"))
+        if (cur_game->ws_type[i] && !cur_game->ws_type[i]->compare("staff"))
         {
             rs_write_int(savef, 0);
-            rs_write_string_index<NWOOD>(savef, wood, ws_made[i]);
+            rs_write_string_index<NWOOD>(savef, wood, cur_game->ws_made[i]);
         } else {
             rs_write_int(savef, 1);
-            rs_write_string_index<NMETAL>(savef, metal, ws_made[i]);
+            rs_write_string_index<NMETAL>(savef, metal, cur_game->ws_made[i]);
         }
     }
 
@@ -1051,7 +1234,7 @@ rs_write_sticks(FILE* savef)
 }
 
 static bool
-rs_read_sticks(FILE* inf)
+rs_read_sticks(save_reader& inf)
 {
     if (read_error || format_error)
     {
@@ -1066,11 +1249,11 @@ rs_read_sticks(FILE* inf)
 
         if (list == 0)
         {
-            rs_read_string_index<NWOOD>(inf, wood, ws_made[i]);
-            ws_type[i] = "staff";
+            rs_read_string_index<NWOOD>(inf, wood, cur_game->ws_made[i]);
+            cur_game->ws_type[i] = "staff";
         } else {
-            rs_read_string_index<NMETAL>(inf, metal, ws_made[i]);
-            ws_type[i] = "wand";
+            rs_read_string_index<NMETAL>(inf, metal, cur_game->ws_made[i]);
+            cur_game->ws_type[i] = "wand";
         }
     }
 
@@ -1078,57 +1261,58 @@ rs_read_sticks(FILE* inf)
 }
 
 static bool
-rs_write_daemons(FILE *savef, struct delayed_action *d_list, int count)
+rs_write_daemons(std::string& savef, const scheduler& timers)
 {
-    int i = 0;
     int func = 0;
+    const auto d_list = timers.dump(MAXDAEMONS);
 
     if (write_error)
         return(WRITESTAT);
 
     rs_write_marker(savef, RSID_DAEMONS);
-    rs_write_int(savef, count);
+    rs_write_int(savef, static_cast<int>(d_list.size()));
 
-    for(i = 0; i < count; i++)
+    for (const auto& d : d_list)
     {
-        if (d_list[i].d_func == rollwand)
+        if (d.d_func == rollwand)
             func = 1;
-        else if (d_list[i].d_func == doctor)
+        else if (d.d_func == doctor)
             func = 2;
-        else if (d_list[i].d_func == stomach)
+        else if (d.d_func == stomach)
             func = 3;
-        else if (d_list[i].d_func == runners)
+        else if (d.d_func == runners)
             func = 4;
-        else if (d_list[i].d_func == swander)
+        else if (d.d_func == swander)
             func = 5;
-        else if (d_list[i].d_func == nohaste)
+        else if (d.d_func == nohaste)
             func = 6;
-        else if (d_list[i].d_func == unconfuse)
+        else if (d.d_func == unconfuse)
             func = 7;
-        else if (d_list[i].d_func == unsee)
+        else if (d.d_func == unsee)
             func = 8;
-        else if (d_list[i].d_func == sight)
+        else if (d.d_func == sight)
             func = 9;
-        else if (d_list[i].d_func == nullptr)
+        else if (d.d_func == nullptr)
             func = 0;
         else
             func = -1;
 
-        rs_write_int(savef, d_list[i].d_type);
+        rs_write_int(savef, d.d_type);
         rs_write_int(savef, func);
-        rs_write_int(savef, d_list[i].d_arg);
-        rs_write_int(savef, d_list[i].d_time);
+        rs_write_int(savef, d.d_arg);
+        rs_write_int(savef, d.d_time);
     }
 
     return(WRITESTAT);
 }
 
 static bool
-rs_read_daemons(FILE* inf, delayed_action* d_list, const std::size_t count)
+rs_read_daemons(save_reader& inf, scheduler& timers)
 {
     int i = 0;
     int func = 0;
     int value = 0;
+    std::vector<delayed_action> d_list;
 
     if (read_error || format_error)
         return(READSTAT);
@@ -1136,54 +1320,52 @@ rs_read_daemons(FILE* inf, delayed_action* d_list, const std::size_t count)
     rs_read_marker(inf, RSID_DAEMONS);
     rs_read_int(inf, value);
 
-    if (value > static_cast<const int>(count))
+    if (value < 0)
         format_error = true;
 
-    for(i=0; i < count; i++)
+    for(i=0; i < value && !read_error && !format_error; i++)
     {
+        delayed_action d = {};
+
         func = 0;
-        rs_read_int(inf, d_list[i].d_type);
+        rs_read_int(inf, d.d_type);
         rs_read_int(inf, func);
-        rs_read_int(inf, d_list[i].d_arg);
-        rs_read_int(inf, d_list[i].d_time);
+        rs_read_int(inf, d.d_arg);
+        rs_read_int(inf, d.d_time);
 
         switch(func)
         {
-            case 1: d_list[i].d_func = rollwand;
+            case 1: d.d_func = rollwand;
                     break;
-            case 2: d_list[i].d_func = doctor;
+            case 2: d.d_func = doctor;
                     break;
-            case 3: d_list[i].d_func = stomach;
+            case 3: d.d_func = stomach;
                     break;
-            case 4: d_list[i].d_func = runners;
+            case 4: d.d_func = runners;
                     break;
-            case 5: d_list[i].d_func = swander;
+            case 5: d.d_func = swander;
                     break;
-            case 6: d_list[i].d_func = nohaste;
+            case 6: d.d_func = nohaste;
                     break;
-            case 7: d_list[i].d_func = unconfuse;
+            case 7: d.d_func = unconfuse;
                     break;
-            case 8: d_list[i].d_func = unsee;
+            case 8: d.d_func = unsee;
                     break;
-            case 9: d_list[i].d_func = sight;
+            case 9: d.d_func = sight;
                     break;
-            default:d_list[i].d_func = nullptr;
+            default:d.d_func = nullptr;
                     break;
         }
+        d_list.push_back(d);
     }
 
-    if (d_list[i].d_func == nullptr)
-    {
-        d_list[i].d_type = 0;
-        d_list[i].d_arg = 0;
-        d_list[i].d_time = 0;
-    }
+    timers.load(d_list);
 
     return(READSTAT);
 }
 
 static bool
-rs_write_obj_info(FILE *savef, struct obj_info *i, int count)
+rs_write_obj_info(std::string& savef, struct obj_info *i, int count)
 {
     int n;
 
@@ -1206,7 +1388,7 @@ rs_write_obj_info(FILE *savef, struct obj_info *i, int count)
 }
 
 static bool
-rs_read_obj_info(FILE* inf, obj_info* mi, const std::size_t count)
+rs_read_obj_info(save_reader& inf, obj_info* mi, const std::size_t count)
 {
     int value = 0;
 
@@ -1233,7 +1415,7 @@ rs_read_obj_info(FILE* inf, obj_info* mi, const std::size_t count)
 }
 
 static bool
-rs_write_room(FILE* savef, const room& r)
+rs_write_room(std::string& savef, const room& r)
 {
     if (write_error)
     {
@@ -1255,7 +1437,7 @@ rs_write_room(FILE* savef, const room& r)
 }
 
 static bool
-rs_read_room(FILE* inf, room& r)
+rs_read_room(save_reader& inf, room& r)
 {
     if (read_error || format_error)
     {
@@ -1278,7 +1460,7 @@ rs_read_room(FILE* inf, room& r)
 
 template<std::size_t N>
 static bool
-rs_write_rooms(FILE* savef, const std::array<room, N>& r)
+rs_write_rooms(std::string& savef, const std::array<room, N>& r)
 {
     if (write_error)
     {
@@ -1297,7 +1479,7 @@ rs_write_rooms(FILE* savef, const std::array<room, N>& r)
 
 template<std::size_t N>
 static bool
-rs_read_rooms(FILE* inf, std::array<room, N>& r)
+rs_read_rooms(save_reader& inf, std::array<room, N>& r)
 {
     int value = 0;
 
@@ -1322,7 +1504,7 @@ rs_read_rooms(FILE* inf, std::array<room, N>& r)
 }
 
 static bool
-rs_write_room_reference(FILE *savef, struct room *rp)
+rs_write_room_reference(std::string& savef, struct room *rp)
 {
     int i, room = -1;
 
@@ -1330,7 +1512,7 @@ rs_write_room_reference(FILE *savef, struct room *rp)
         return(WRITESTAT);
 
     for (i = 0; i < MAXROOMS; i++)
-        if (&rooms[i] == rp)
+        if (&cur_game->rooms[i] == rp)
             room = i;
 
     rs_write_int(savef, room);
@@ -1339,7 +1521,7 @@ rs_write_room_reference(FILE *savef, struct room *rp)
 }
 
 static bool
-rs_read_room_reference(FILE *inf, struct room **rp)
+rs_read_room_reference(save_reader& inf, struct room **rp)
 {
     int i;
 
@@ -1348,13 +1530,13 @@ rs_read_room_reference(FILE *inf, struct room **rp)
 
     rs_read_int(inf, i);
 
-    *rp = &rooms[i];
+    *rp = &cur_game->rooms[i];
 
     return(READSTAT);
 }
 
 static bool
-rs_write_monsters(FILE* savef, const monster* m, const std::size_t count)
+rs_write_monsters(std::string& savef, const monster* m, const std::size_t count)
 {
     if (write_error)
         return(WRITESTAT);
@@ -1369,7 +1551,7 @@ rs_write_monsters(FILE* savef, const monster* m, const std::size_t count)
 }
 
 static bool
-rs_read_monsters(FILE* inf, monster* m, const std::size_t count)
+rs_read_monsters(save_reader& inf, monster* m, const std::size_t count)
 {
     int value = 0;
 
@@ -1392,7 +1574,7 @@ rs_read_monsters(FILE* inf, monster* m, const std::size_t count)
 }
 
 static bool
-rs_write_object(FILE* savef, const THING* o)
+rs_write_object(std::string& savef, const THING* o)
 {
     if (write_error)
         return(WRITESTAT);
@@ -1416,7 +1598,7 @@ rs_write_object(FILE* savef, const THING* o)
 }
 
 static bool
-rs_read_object(FILE* inf, THING* o)
+rs_read_object(save_reader& inf, THING* o)
 {
     if (read_error || format_error)
         return(READSTAT);
@@ -1441,7 +1623,7 @@ rs_read_object(FILE* inf, THING* o)
 }
 
 static bool
-rs_write_object_list(FILE *savef, THING *l)
+rs_write_object_list(std::string& savef, THING *l)
 {
     if (write_error)
         return(WRITESTAT);
@@ -1456,7 +1638,7 @@ rs_write_object_list(FILE *savef, THING *l)
 }
 
 static bool
-rs_read_object_list(FILE *inf, THING **list)
+rs_read_object_list(save_reader& inf, THING **list)
 {
     int i, cnt;
     THING *l = nullptr, *previous = nullptr, *head = nullptr;
@@ -1495,7 +1677,7 @@ rs_read_object_list(FILE *inf, THING **list)
 }
 
 static bool
-rs_write_object_reference(FILE *savef, THING *list, THING *item)
+rs_write_object_reference(std::string& savef, const list_index& list, THING *item)
 {
     int i;
 
@@ -1510,7 +1692,7 @@ rs_write_object_reference(FILE *savef, THING *list, THING *item)
 }
 
 static bool
-rs_read_object_reference(FILE *inf, THING *list, THING **item)
+rs_read_object_reference(save_reader& inf, const list_index& list, THING **item)
 {
     int i;
 
@@ -1539,48 +1721,8 @@ find_room_coord(const std::array<room, N>& rmlist, const coord* c)
     return -1;
 }
 
-static int
-find_thing_coord(THING *monlist, coord *c)
-{
-    THING *mitem;
-    THING *tp;
-    int i = 0;
-
-    for(mitem = monlist; mitem != nullptr; mitem = mitem->l_next)
-    {
-        tp = mitem;
-
-        if (c == &tp->t_pos)
-            return(i);
-
-        i++;
-    }
-
-    return(-1);
-}
-
-static int
-find_object_coord(THING *objlist, coord *c)
-{
-    THING *oitem;
-    THING *obj;
-    int i = 0;
-
-    for(oitem = objlist; oitem != nullptr; oitem = oitem->l_next)
-    {
-        obj = oitem;
-
-        if (c == &obj->o_pos)
-            return(i);
-
-        i++;
-    }
-
-    return(-1);
-}
-
 static bool
-rs_write_thing(FILE *savef, THING *t)
+rs_write_thing(std::string& savef, THING *t)
 {
     int i = -1;
 
@@ -1621,7 +1763,7 @@ rs_write_thing(FILE *savef, THING *t)
     }
     else if (t->t_dest != nullptr)
     {
-        i = find_thing_coord(mlist, t->t_dest);
+        i = find_list_ptr(monster_index, t->t_dest);
 
         if (i >=0 )
         {
@@ -1630,7 +1772,7 @@ rs_write_thing(FILE *savef, THING *t)
         }
         else
         {
-            i = find_object_coord(lvl_obj, t->t_dest);
+            i = find_list_ptr(object_index, t->t_dest);
 
             if (i >= 0)
             {
@@ -1639,7 +1781,7 @@ rs_write_thing(FILE *savef, THING *t)
             }
             else
             {
-                i = find_room_coord<MAXROOMS>(rooms, t->t_dest);
+                i = find_room_coord<MAXROOMS>(cur_game->rooms, t->t_dest);
 
                 if (i >= 0)
                 {
@@ -1669,7 +1811,7 @@ rs_write_thing(FILE *savef, THING *t)
 }
 
 static bool
-rs_read_thing(FILE *inf, THING *t)
+rs_read_thing(save_reader& inf, THING *t)
 {
     int listid = 0, index = -1;
     THING *item;
@@ -1722,7 +1864,7 @@ rs_read_thing(FILE *inf, THING *t)
     {
         THING *obj;
 
-        item = get_list_item(lvl_obj, index);
+        item = get_list_item(object_index, index);
 
         if (item != nullptr)
         {
@@ -1732,7 +1874,7 @@ rs_read_thing(FILE *inf, THING *t)
     }
     else if (listid == 3) /* gold */
     {
-        t->_t._t_dest = &rooms[index].r_gold;
+        t->_t._t_dest = &cur_game->rooms[index].r_gold;
     }
     else
         t->_t._t_dest = nullptr;
@@ -1754,7 +1896,7 @@ rs_fix_thing(THING *t)
     if (t->t_reserved < 0)
         return;
 
-    item = get_list_item(mlist,t->t_reserved);
+    item = get_list_item(monster_index, t->t_reserved);
 
     if (item != nullptr)
     {
@@ -1764,7 +1906,7 @@ rs_fix_thing(THING *t)
 }
 
 static bool
-rs_write_thing_list(FILE *savef, THING *l)
+rs_write_thing_list(std::string& savef, THING *l)
 {
     int cnt = 0;
 
@@ -1789,7 +1931,7 @@ rs_write_thing_list(FILE *savef, THING *l)
 }
 
 int
-rs_read_thing_list(FILE *inf, THING **list)
+rs_read_thing_list(save_reader& inf, THING **list)
 {
     int i, cnt;
     THING *l = nullptr, *previous = nullptr, *head = nullptr;
@@ -1836,7 +1978,7 @@ rs_fix_thing_list(THING *list)
 }
 
 static bool
-rs_write_thing_reference(FILE *savef, THING *list, THING *item)
+rs_write_thing_reference(std::string& savef, const list_index& list, THING *item)
 {
     int i;
 
@@ -1856,7 +1998,7 @@ rs_write_thing_reference(FILE *savef, THING *list, THING *item)
 }
 
 static bool
-rs_read_thing_reference(FILE *inf, THING *list, THING **item)
+rs_read_thing_reference(save_reader& inf, const list_index& list, THING **item)
 {
     int i;
 
@@ -1874,7 +2016,7 @@ rs_read_thing_reference(FILE *inf, THING *list, THING **item)
 }
 
 static bool
-rs_write_places(FILE *savef, PLACE *places, int count)
+rs_write_places(std::string& savef, PLACE *places, int count)
 {
     int i = 0;
 
@@ -1885,14 +2027,14 @@ rs_write_places(FILE *savef, PLACE *places, int count)
     {
         rs_write_char(savef, places[i].p_ch);
         rs_write_char(savef, places[i].p_flags);
-        rs_write_thing_reference(savef, mlist, places[i].p_monst);
+        rs_write_thing_reference(savef, monster_index, places[i].p_monst);
     }
 
     return(WRITESTAT);
 }
 
 static bool
-rs_read_places(FILE *inf, PLACE *places, int count)
+rs_read_places(save_reader& inf, PLACE *places, int count)
 {
     int i = 0;
 
@@ -1903,263 +2045,766 @@ rs_read_places(FILE *inf, PLACE *places, int count)
     {
         rs_read_char(inf,&places[i].p_ch);
         rs_read_char(inf,&places[i].p_flags);
-        rs_read_thing_reference(inf, mlist, &places[i].p_monst);
+        rs_read_thing_reference(inf, monster_index, &places[i].p_monst);
+        places[i].p_obj = nullptr;
+    }
+
+    for (THING* obj = cur_game->lvl_obj; obj != nullptr; obj = obj->l_next)
+    {
+        obat(obj->o_pos.y, obj->o_pos.x) = obj;
     }
 
     return(READSTAT);
 }
 
-bool
-rs_save_file(FILE *savef)
+/*
+ * rs_write_game_section, rs_read_game_section:
+ *	The flags, counters and names kept for the whole game
+ */
+static bool
+rs_write_game_section(std::string& savef)
 {
     if (write_error)
         return(WRITESTAT);
 
-    rs_write_boolean(savef, after);                 /* 1  */    /* extern.c */
-    rs_write_boolean(savef, again);                 /* 2  */
-    rs_write_int(savef, noscore);                   /* 3  */
-    rs_write_boolean(savef, seenstairs);            /* 4  */
-    rs_write_boolean(savef, amulet);                /* 5  */
-    rs_write_boolean(savef, door_stop);             /* 6  */
-    rs_write_boolean(savef, fight_flush);           /* 7  */
-    rs_write_boolean(savef, firstmove);             /* 8  */
+    rs_write_boolean(savef, cur_game->after);                 /* 1  */    /* extern.c */
+    rs_write_boolean(savef, cur_game->again);                 /* 2  */
+    rs_write_int(savef, cur_game->noscore);                   /* 3  */
+    rs_write_boolean(savef, cur_game->seenstairs);            /* 4  */
+    rs_write_boolean(savef, cur_game->amulet);                /* 5  */
+    rs_write_boolean(savef, cur_game->door_stop);             /* 6  */
+    rs_write_boolean(savef, cur_game->fight_flush);           /* 7  */
+    rs_write_boolean(savef, cur_game->firstmove);             /* 8  */
     rs_write_boolean(savef, got_ltc);               /* 9  */
-    rs_write_boolean(savef, has_hit);               /* 10 */
+    rs_write_boolean(savef, cur_game->has_hit);               /* 10 */
     rs_write_boolean(savef, in_shell);              /* 11 */
-    rs_write_boolean(savef, inv_describe);          /* 12 */
-    rs_write_boolean(savef, jump);                  /* 13 */
-    rs_write_boolean(savef, kamikaze);              /* 14 */
-    rs_write_boolean(savef, lower_msg);             /* 15 */
-    rs_write_boolean(savef, move_on);               /* 16 */
-    rs_write_boolean(savef, msg_esc);               /* 17 */
-    rs_write_boolean(savef, passgo);                /* 18 */
-    rs_write_boolean(savef, playing);               /* 19 */
-    rs_write_boolean(savef, q_comm);                /* 20 */
-    rs_write_boolean(savef, running);               /* 21 */
-    rs_write_boolean(savef, save_msg);              /* 22 */
-    rs_write_boolean(savef, see_floor);             /* 23 */
-    rs_write_boolean(savef, stat_msg);              /* 24 */
-    rs_write_boolean(savef, terse);                 /* 25 */
-    rs_write_boolean(savef, to_death);              /* 26 */
-    rs_write_boolean(savef, tombstone);             /* 27 */
+    rs_write_boolean(savef, cur_game->inv_describe);          /* 12 */
+    rs_write_boolean(savef, cur_game->jump);                  /* 13 */
+    rs_write_boolean(savef, cur_game->kamikaze);              /* 14 */
+    rs_write_boolean(savef, cur_game->lower_msg);             /* 15 */
+    rs_write_boolean(savef, cur_game->move_on);               /* 16 */
+    rs_write_boolean(savef, cur_game->msg_esc);               /* 17 */
+    rs_write_boolean(savef, cur_game->passgo);                /* 18 */
+    rs_write_boolean(savef, cur_game->playing);               /* 19 */
+    rs_write_boolean(savef, cur_game->q_comm);                /* 20 */
+    rs_write_boolean(savef, cur_game->running);               /* 21 */
+    rs_write_boolean(savef, cur_game->save_msg);              /* 22 */
+    rs_write_boolean(savef, cur_game->see_floor);             /* 23 */
+    rs_write_boolean(savef, cur_game->stat_msg);              /* 24 */
+    rs_write_boolean(savef, cur_game->terse);                 /* 25 */
+    rs_write_boolean(savef, cur_game->to_death);              /* 26 */
+    rs_write_boolean(savef, cur_game->tombstone);             /* 27 */
 #ifdef MASTER
-    rs_write_int(savef, wizard);                    /* 28 */
+    rs_write_int(savef, cur_game->wizard);                    /* 28 */
 #else
     rs_write_int(savef, 0);                         /* 28 */
 #endif
-    rs_write_booleans(savef, pack_used);            /* 29 */
-    rs_write_char(savef, dir_ch);
-    rs_write_chars(savef, file_name, MAXSTR);
-    rs_write_chars(savef, huh, MAXSTR);
+    rs_write_booleans(savef, cur_game->pack_used);            /* 29 */
+    rs_write_char(savef, cur_game->dir_ch);
+    rs_write_chars(savef, cur_game->file_name, MAXSTR);
+    rs_write_chars(savef, cur_game->huh, MAXSTR);
     rs_write_potions(savef);
-    rs_write_chars(savef,prbuf,2*MAXSTR);
+    rs_write_chars(savef,cur_game->prbuf,2*MAXSTR);
     rs_write_rings(savef);
     rs_write_string(savef, release);
-    rs_write_char(savef, runch);
+    rs_write_char(savef, cur_game->runch);
     rs_write_scrolls(savef);
-    rs_write_char(savef, take);
-    rs_write_chars(savef, whoami, MAXSTR);
+    rs_write_char(savef, cur_game->take);
+    rs_write_chars(savef, cur_game->whoami, MAXSTR);
     rs_write_sticks(savef);
     rs_write_int(savef,orig_dsusp);
-    rs_write_chars(savef, fruit, MAXSTR);
+    rs_write_chars(savef, cur_game->fruit, MAXSTR);
     rs_write_chars(savef, home, MAXSTR);
     rs_write_strings(savef, inv_t_name);
-    rs_write_char(savef,l_last_comm);
-    rs_write_char(savef,l_last_dir);
-    rs_write_char(savef,last_comm);
-    rs_write_char(savef,last_dir);
+    rs_write_char(savef,cur_game->l_last_comm);
+    rs_write_char(savef,cur_game->l_last_dir);
+    rs_write_char(savef,cur_game->last_comm);
+    rs_write_char(savef,cur_game->last_dir);
     rs_write_strings(savef, tr_name);
-    rs_write_int(savef,n_objs);
-    rs_write_int(savef, ntraps);
-    rs_write_int(savef, hungry_state);
-    rs_write_int(savef, inpack);
-    rs_write_int(savef, inv_type);
-    rs_write_int(savef, level);
-    rs_write_int(savef, max_level);
-    rs_write_int(savef, mpos);
-    rs_write_int(savef, no_food);
+    rs_write_int(savef,cur_game->n_objs);
+    rs_write_int(savef, cur_game->ntraps);
+    rs_write_int(savef, cur_game->hungry_state);
+    rs_write_int(savef, cur_game->inpack);
+    rs_write_int(savef, cur_game->inv_type);
+    rs_write_int(savef, cur_game->level);
+    rs_write_int(savef, cur_game->max_level);
+    rs_write_int(savef, cur_game->mpos);
+    rs_write_int(savef, cur_game->no_food);
     rs_write_ints(savef,a_class,MAXARMORS);
-    rs_write_int(savef, count);
-    rs_write_int(savef, food_left);
-    rs_write_int(savef, lastscore);
-    rs_write_int(savef, no_command);
-    rs_write_int(savef, no_move);
-    rs_write_int(savef, purse);
-    rs_write_int(savef, quiet);
-    rs_write_int(savef, vf_hit);
-    rs_write_int(savef, dnum);
-    rs_write_int(savef, seed);
+    rs_write_int(savef, cur_game->count);
+    rs_write_int(savef, cur_game->food_left);
+    rs_write_int(savef, cur_game->lastscore);
+    rs_write_int(savef, cur_game->no_command);
+    rs_write_int(savef, cur_game->no_move);
+    rs_write_int(savef, cur_game->purse);
+    rs_write_int(savef, cur_game->quiet);
+    rs_write_int(savef, cur_game->vf_hit);
+    rs_write_int(savef, cur_game->dnum);
+    rs_write_int(savef, cur_game->seed);
+    rs_write_rng(savef, cur_game->rng);
     rs_write_ints(savef, e_levels, 21);
-    rs_write_coord(savef, delta);
-    rs_write_coord(savef, oldpos);
-    rs_write_coord(savef, stairs);
-
-    rs_write_thing(savef, &player);
-    rs_write_object_reference(savef, player.t_pack, cur_armor);
-    rs_write_object_reference(savef, player.t_pack, cur_ring[0]);
-    rs_write_object_reference(savef, player.t_pack, cur_ring[1]);
-    rs_write_object_reference(savef, player.t_pack, cur_weapon);
-    rs_write_object_reference(savef, player.t_pack, l_last_pick);
-    rs_write_object_reference(savef, player.t_pack, last_pick);
-
-    rs_write_object_list(savef, lvl_obj);
-    rs_write_thing_list(savef, mlist);
-
-    rs_write_places(savef,places,MAXLINES*MAXCOLS);
-
-    rs_write_stats(savef, max_stats);
-    rs_write_rooms<MAXROOMS>(savef, rooms);
-    rs_write_room_reference(savef, oldrp);
-    rs_write_rooms<MAXPASS>(savef, passages);
-
-    rs_write_monsters(savef,monsters,26);
-    rs_write_obj_info(savef, things,   NUMTHINGS);
-    rs_write_obj_info(savef, arm_info,  MAXARMORS);
-    rs_write_obj_info(savef, pot_info,  MAXPOTIONS);
-    rs_write_obj_info(savef, ring_info,  MAXRINGS);
-    rs_write_obj_info(savef, scr_info,  MAXSCROLLS);
-    rs_write_obj_info(savef, weap_info,  MAXWEAPONS+1);
-    rs_write_obj_info(savef, ws_info, MAXSTICKS);
-
-
-    rs_write_daemons(savef, &d_list[0], 20);            /* 5.4-daemon.c */
-#ifdef MASTER
-    rs_write_int(savef,total);                          /* 5.4-list.c   */
-#else
-    rs_write_int(savef, 0);
-#endif
-    rs_write_int(savef,between);                        /* 5.4-daemons.c*/
-    rs_write_coord(savef, nh);                          /* 5.4-move.c    */
-    rs_write_int(savef, group);                         /* 5.4-weapons.c */
-
-    rs_write_window(savef,stdscr);
+    rs_write_coord(savef, cur_game->delta);
+    rs_write_coord(savef, cur_game->oldpos);
+    rs_write_coord(savef, cur_game->stairs);
 
     return(WRITESTAT);
 }
 
-bool
-rs_restore_file(FILE *inf)
+static bool
+rs_read_game_section(save_reader& inf)
 {
     int dummyint;
 
     if (read_error || format_error)
         return(READSTAT);
 
-    rs_read_boolean(inf, after);                /* 1  */    /* extern.c */
-    rs_read_boolean(inf, again);                /* 2  */
-    rs_read_int(inf, noscore);                  /* 3  */
-    rs_read_boolean(inf, seenstairs);           /* 4  */
-    rs_read_boolean(inf, amulet);               /* 5  */
-    rs_read_boolean(inf, door_stop);            /* 6  */
-    rs_read_boolean(inf, fight_flush);          /* 7  */
-    rs_read_boolean(inf, firstmove);            /* 8  */
+    rs_read_boolean(inf, cur_game->after);                /* 1  */    /* extern.c */
+    rs_read_boolean(inf, cur_game->again);                /* 2  */
+    rs_read_int(inf, cur_game->noscore);                  /* 3  */
+    rs_read_boolean(inf, cur_game->seenstairs);           /* 4  */
+    rs_read_boolean(inf, cur_game->amulet);               /* 5  */
+    rs_read_boolean(inf, cur_game->door_stop);            /* 6  */
+    rs_read_boolean(inf, cur_game->fight_flush);          /* 7  */
+    rs_read_boolean(inf, cur_game->firstmove);            /* 8  */
     rs_read_boolean(inf, got_ltc);              /* 9  */
-    rs_read_boolean(inf, has_hit);              /* 10 */
+    rs_read_boolean(inf, cur_game->has_hit);              /* 10 */
     rs_read_boolean(inf, in_shell);             /* 11 */
-    rs_read_boolean(inf, inv_describe);         /* 12 */
-    rs_read_boolean(inf, jump);                 /* 13 */
-    rs_read_boolean(inf, kamikaze);             /* 14 */
-    rs_read_boolean(inf, lower_msg);            /* 15 */
-    rs_read_boolean(inf, move_on);              /* 16 */
-    rs_read_boolean(inf, msg_esc);              /* 17 */
-    rs_read_boolean(inf, passgo);               /* 18 */
-    rs_read_boolean(inf, playing);              /* 19 */
-    rs_read_boolean(inf, q_comm);               /* 20 */
-    rs_read_boolean(inf, running);              /* 21 */
-    rs_read_boolean(inf, save_msg);             /* 22 */
-    rs_read_boolean(inf, see_floor);            /* 23 */
-    rs_read_boolean(inf, stat_msg);             /* 24 */
-    rs_read_boolean(inf, terse);                /* 25 */
-    rs_read_boolean(inf, to_death);             /* 26 */
-    rs_read_boolean(inf, tombstone);            /* 27 */
+    rs_read_boolean(inf, cur_game->inv_describe);         /* 12 */
+    rs_read_boolean(inf, cur_game->jump);                 /* 13 */
+    rs_read_boolean(inf, cur_game->kamikaze);             /* 14 */
+    rs_read_boolean(inf, cur_game->lower_msg);            /* 15 */
+    rs_read_boolean(inf, cur_game->move_on);              /* 16 */
+    rs_read_boolean(inf, cur_game->msg_esc);              /* 17 */
+    rs_read_boolean(inf, cur_game->passgo);               /* 18 */
+    rs_read_boolean(inf, cur_game->playing);              /* 19 */
+    rs_read_boolean(inf, cur_game->q_comm);               /* 20 */
+    rs_read_boolean(inf, cur_game->running);              /* 21 */
+    rs_read_boolean(inf, cur_game->save_msg);             /* 22 */
+    rs_read_boolean(inf, cur_game->see_floor);            /* 23 */
+    rs_read_boolean(inf, cur_game->stat_msg);             /* 24 */
+    rs_read_boolean(inf, cur_game->terse);                /* 25 */
+    rs_read_boolean(inf, cur_game->to_death);             /* 26 */
+    rs_read_boolean(inf, cur_game->tombstone);            /* 27 */
 #ifdef MASTER
-    rs_read_int(inf, wizard);                   /* 28 */
+    rs_read_int(inf, cur_game->wizard);                   /* 28 */
 #else
     rs_read_int(inf, dummyint);                 /* 28 */
 #endif
-    rs_read_booleans(inf, pack_used);           /* 29 */
-    rs_read_char(inf, &dir_ch);
-    rs_read_chars(inf, file_name, MAXSTR);
-    rs_read_chars(inf, huh, MAXSTR);
+    rs_read_booleans(inf, cur_game->pack_used);           /* 29 */
+    rs_read_char(inf, &cur_game->dir_ch);
+    rs_read_chars(inf, cur_game->file_name, MAXSTR);
+    rs_read_chars(inf, cur_game->huh, MAXSTR);
     rs_read_potions(inf);
-    rs_read_chars(inf, prbuf, 2*MAXSTR);
+    rs_read_chars(inf, cur_game->prbuf, 2*MAXSTR);
     rs_read_rings(inf);
     rs_read_new_string(inf, release);
-    rs_read_char(inf, &runch);
+    rs_read_char(inf, &cur_game->runch);
     rs_read_scrolls(inf);
-    rs_read_char(inf, &take);
-    rs_read_chars(inf, whoami, MAXSTR);
+    rs_read_char(inf, &cur_game->take);
+    rs_read_chars(inf, cur_game->whoami, MAXSTR);
     rs_read_sticks(inf);
     rs_read_int(inf, orig_dsusp);
-    rs_read_chars(inf, fruit, MAXSTR);
+    rs_read_chars(inf, cur_game->fruit, MAXSTR);
     rs_read_chars(inf, home, MAXSTR);
     rs_read_new_strings(inf, inv_t_name);
-    rs_read_char(inf, &l_last_comm);
-    rs_read_char(inf, &l_last_dir);
-    rs_read_char(inf, &last_comm);
-    rs_read_char(inf, &last_dir);
+    rs_read_char(inf, &cur_game->l_last_comm);
+    rs_read_char(inf, &cur_game->l_last_dir);
+    rs_read_char(inf, &cur_game->last_comm);
+    rs_read_char(inf, &cur_game->last_dir);
     rs_read_new_strings(inf, tr_name);
-    rs_read_int(inf, n_objs);
-    rs_read_int(inf, ntraps);
-    rs_read_int(inf, hungry_state);
-    rs_read_int(inf, inpack);
-    rs_read_int(inf, inv_type);
-    rs_read_int(inf, level);
-    rs_read_int(inf, max_level);
-    rs_read_int(inf, mpos);
-    rs_read_int(inf, no_food);
+    rs_read_int(inf, cur_game->n_objs);
+    rs_read_int(inf, cur_game->ntraps);
+    rs_read_int(inf, cur_game->hungry_state);
+    rs_read_int(inf, cur_game->inpack);
+    rs_read_int(inf, cur_game->inv_type);
+    rs_read_int(inf, cur_game->level);
+    rs_read_int(inf, cur_game->max_level);
+    rs_read_int(inf, cur_game->mpos);
+    rs_read_int(inf, cur_game->no_food);
     rs_read_ints(inf,a_class,MAXARMORS);
-    rs_read_int(inf, count);
-    rs_read_int(inf, food_left);
-    rs_read_int(inf, lastscore);
-    rs_read_int(inf, no_command);
-    rs_read_int(inf, no_move);
-    rs_read_int(inf, purse);
-    rs_read_int(inf, quiet);
-    rs_read_int(inf, vf_hit);
-    rs_read_int(inf, dnum);
-    rs_read_int(inf, seed);
+    rs_read_int(inf, cur_game->count);
+    rs_read_int(inf, cur_game->food_left);
+    rs_read_int(inf, cur_game->lastscore);
+    rs_read_int(inf, cur_game->no_command);
+    rs_read_int(inf, cur_game->no_move);
+    rs_read_int(inf, cur_game->purse);
+    rs_read_int(inf, cur_game->quiet);
+    rs_read_int(inf, cur_game->vf_hit);
+    rs_read_int(inf, cur_game->dnum);
+    rs_read_int(inf, cur_game->seed);
+    srnd(cur_game->seed);
+    rs_read_rng(inf, cur_game->rng);
     rs_read_ints(inf,e_levels,21);
-    rs_read_coord(inf, delta);
-    rs_read_coord(inf, oldpos);
-    rs_read_coord(inf, stairs);
-
-    rs_read_thing(inf, &player);
-    rs_read_object_reference(inf, player.t_pack, &cur_armor);
-    rs_read_object_reference(inf, player.t_pack, &cur_ring[0]);
-    rs_read_object_reference(inf, player.t_pack, &cur_ring[1]);
-    rs_read_object_reference(inf, player.t_pack, &cur_weapon);
-    rs_read_object_reference(inf, player.t_pack, &l_last_pick);
-    rs_read_object_reference(inf, player.t_pack, &last_pick);
-
-    rs_read_object_list(inf, &lvl_obj);
-    rs_read_thing_list(inf, &mlist);
-    rs_fix_thing(&player);
-    rs_fix_thing_list(mlist);
-
-    rs_read_places(inf,places,MAXLINES*MAXCOLS);
-
-    rs_read_stats(inf, max_stats);
-    rs_read_rooms<MAXROOMS>(inf, rooms);
-    rs_read_room_reference(inf, &oldrp);
-    rs_read_rooms<MAXPASS>(inf, passages);
-
-    rs_read_monsters(inf,monsters,26);
-    rs_read_obj_info(inf, things,   NUMTHINGS);
-    rs_read_obj_info(inf, arm_info,   MAXARMORS);
-    rs_read_obj_info(inf, pot_info,  MAXPOTIONS);
-    rs_read_obj_info(inf, ring_info,  MAXRINGS);
-    rs_read_obj_info(inf, scr_info,  MAXSCROLLS);
-    rs_read_obj_info(inf, weap_info, MAXWEAPONS+1);
-    rs_read_obj_info(inf, ws_info, MAXSTICKS);
-
-    rs_read_daemons(inf, d_list, 20);                   /* 5.4-daemon.c     */
+    rs_read_coord(inf, cur_game->delta);
+    rs_read_coord(inf, cur_game->oldpos);
+    rs_read_coord(inf, cur_game->stairs);
+
+    return(READSTAT);
+}
+
+/*
+ * rs_write_hero_section, rs_read_hero_section:
+ *	The player, the pack and what is worn and wielded
+ */
+static bool
+rs_write_hero_section(std::string& savef)
+{
+    if (write_error)
+        return(WRITESTAT);
+
+    rs_write_thing(savef, &cur_game->player);
+    rs_write_object_reference(savef, pack_index, cur_game->cur_armor);
+    rs_write_object_reference(savef, pack_index, cur_game->cur_ring[0]);
+    rs_write_object_reference(savef, pack_index, cur_game->cur_ring[1]);
+    rs_write_object_reference(savef, pack_index, cur_game->cur_weapon);
+    rs_write_object_reference(savef, pack_index, cur_game->l_last_pick);
+    rs_write_object_reference(savef, pack_index, cur_game->last_pick);
+
+    return(WRITESTAT);
+}
+
+static bool
+rs_read_hero_section(save_reader& inf)
+{
+    if (read_error || format_error)
+        return(READSTAT);
+
+    rs_read_thing(inf, &cur_game->player);
+    for (THING* obj = cur_game->player.t_pack; obj != nullptr; obj = obj->l_next)
+        obj = keep_item(&cur_game->player.t_pack, obj);
+    index_list(pack_index, cur_game->player.t_pack, false);
+    rs_read_object_reference(inf, pack_index, &cur_game->cur_armor);
+    rs_read_object_reference(inf, pack_index, &cur_game->cur_ring[0]);
+    rs_read_object_reference(inf, pack_index, &cur_game->cur_ring[1]);
+    rs_read_object_reference(inf, pack_index, &cur_game->cur_weapon);
+    rs_read_object_reference(inf, pack_index, &cur_game->l_last_pick);
+    rs_read_object_reference(inf, pack_index, &cur_game->last_pick);
+
+    return(READSTAT);
+}
+
+/*
+ * rs_write_objects_section, rs_read_objects_section:
+ *	The objects lying on the level
+ */
+static bool
+rs_write_objects_section(std::string& savef)
+{
+    if (write_error)
+        return(WRITESTAT);
+
+    rs_write_object_list(savef, cur_game->lvl_obj);
+
+    return(WRITESTAT);
+}
+
+static bool
+rs_read_objects_section(save_reader& inf)
+{
+    if (read_error || format_error)
+        return(READSTAT);
+
+    rs_read_object_list(inf, &cur_game->lvl_obj);
+    index_list(object_index, cur_game->lvl_obj, false);
+
+    return(READSTAT);
+}
+
+/*
+ * rs_write_monsters_section, rs_read_monsters_section:
+ *	The monsters on the level, and what they are after
+ */
+static bool
+rs_write_monsters_section(std::string& savef)
+{
+    if (write_error)
+        return(WRITESTAT);
+
+    rs_write_thing_list(savef, cur_game->mlist);
+
+    return(WRITESTAT);
+}
+
+static bool
+rs_read_monsters_section(save_reader& inf)
+{
+    if (read_error || format_error)
+        return(READSTAT);
+
+    rs_read_thing_list(inf, &cur_game->mlist);
+    index_list(monster_index, cur_game->mlist, true);
+    rs_fix_thing(&cur_game->player);
+    rs_fix_thing_list(cur_game->mlist);
+    cur_game->awake_stale = true;
+
+    return(READSTAT);
+}
+
+/*
+ * rs_write_level_section, rs_read_level_section:
+ *	The map of the level and its rooms, after the player's best
+ *	stats, which is where the old format had them
+ */
+static bool
+rs_write_level_section(std::string& savef)
+{
+    if (write_error)
+        return(WRITESTAT);
+
+    rs_write_places(savef,cur_game->places,MAXLINES*MAXCOLS);
+
+    rs_write_stats(savef, cur_game->max_stats);
+    rs_write_rooms<MAXROOMS>(savef, cur_game->rooms);
+    rs_write_room_reference(savef, cur_game->oldrp);
+    rs_write_rooms<MAXPASS>(savef, cur_game->passages);
+
+    return(WRITESTAT);
+}
+
+static bool
+rs_read_level_section(save_reader& inf)
+{
+    if (read_error || format_error)
+        return(READSTAT);
+
+    rs_read_places(inf,cur_game->places,MAXLINES*MAXCOLS);
+
+    rs_read_stats(inf, cur_game->max_stats);
+    rs_read_rooms<MAXROOMS>(inf, cur_game->rooms);
+    map_rooms();
+    rs_read_room_reference(inf, &cur_game->oldrp);
+    rs_read_rooms<MAXPASS>(inf, cur_game->passages);
+
+    return(READSTAT);
+}
+
+/*
+ * rs_write_knowledge_section, rs_read_knowledge_section:
+ *	What the player knows of monsters and objects
+ */
+static bool
+rs_write_knowledge_section(std::string& savef)
+{
+    if (write_error)
+        return(WRITESTAT);
+
+    rs_write_monsters(savef,cur_game->monsters,26);
+    rs_write_obj_info(savef, cur_game->things,   NUMTHINGS);
+    rs_write_obj_info(savef, cur_game->arm_info,  MAXARMORS);
+    rs_write_obj_info(savef, cur_game->pot_info,  MAXPOTIONS);
+    rs_write_obj_info(savef, cur_game->ring_info,  MAXRINGS);
+    rs_write_obj_info(savef, cur_game->scr_info,  MAXSCROLLS);
+    rs_write_obj_info(savef, cur_game->weap_info,  MAXWEAPONS+1);
+    rs_write_obj_info(savef, cur_game->ws_info, MAXSTICKS);
+
+    return(WRITESTAT);
+}
+
+static bool
+rs_read_knowledge_section(save_reader& inf)
+{
+    if (read_error || format_error)
+        return(READSTAT);
+
+    rs_read_monsters(inf,cur_game->monsters,26);
+    rs_read_obj_info(inf, cur_game->things,   NUMTHINGS);
+    rs_read_obj_info(inf, cur_game->arm_info,   MAXARMORS);
+    rs_read_obj_info(inf, cur_game->pot_info,  MAXPOTIONS);
+    rs_read_obj_info(inf, cur_game->ring_info,  MAXRINGS);
+    rs_read_obj_info(inf, cur_game->scr_info,  MAXSCROLLS);
+    rs_read_obj_info(inf, cur_game->weap_info, MAXWEAPONS+1);
+    rs_read_obj_info(inf, cur_game->ws_info, MAXSTICKS);
+
+    return(READSTAT);
+}
+
+/*
+ * rs_write_time_section, rs_read_time_section:
+ *	The daemons and fuses, and what else has to do with turns
+ */
+static bool
+rs_write_time_section(std::string& savef)
+{
+    if (write_error)
+        return(WRITESTAT);
+
+    rs_write_daemons(savef, cur_game->timers);                    /* 5.4-daemon.c */
+#ifdef MASTER
+    rs_write_int(savef, static_cast<int>(cur_game->item_pool.statistics().live
+        + cur_game->level_pool.statistics().live)); /* 5.4-list.c */
+#else
+    rs_write_int(savef, 0);
+#endif
+    rs_write_int(savef,cur_game->between);                        /* 5.4-daemons.c*/
+    rs_write_coord(savef, cur_game->nh);                          /* 5.4-move.c    */
+    rs_write_int(savef, cur_game->group);                         /* 5.4-weapons.c */
+
+    return(WRITESTAT);
+}
+
+static bool
+rs_read_time_section(save_reader& inf)
+{
+    int dummyint;
+
+    if (read_error || format_error)
+        return(READSTAT);
+
+    rs_read_daemons(inf, cur_game->timers);                       /* 5.4-daemon.c     */
     rs_read_int(inf, dummyint);  /* total */            /* 5.4-list.c    */
-    rs_read_int(inf, between);                          /* 5.4-daemons.c    */
-    rs_read_coord(inf, nh);                             /* 5.4-move.c       */
-    rs_read_int(inf, group);                            /* 5.4-weapons.c    */
+    rs_read_int(inf, cur_game->between);                          /* 5.4-daemons.c    */
+    rs_read_coord(inf, cur_game->nh);                             /* 5.4-move.c       */
+    rs_read_int(inf, cur_game->group);                            /* 5.4-weapons.c    */
+
+    return(READSTAT);
+}
+
+/*
+ * rs_write_memory_section, rs_read_memory_section:
+ *	What the player remembers seeing
+ */
+static bool
+rs_write_memory_section(std::string& savef)
+{
+    if (write_error)
+        return(WRITESTAT);
+
+    rs_write_memory(savef, cur_game->cw);
+
+    return(WRITESTAT);
+}
+
+static bool
+rs_read_memory_section(save_reader& inf)
+{
+    if (read_error || format_error)
+        return(READSTAT);
+
+    rs_read_memory(inf, cur_game->cw);
+
+    return(READSTAT);
+}
+
+/*
+ * rs_read_screen_section:
+ *	The whole screen a cell at a time, as saves kept what the player
+ *	remembers before "SEEN"
+ */
+static bool
+rs_read_screen_section(save_reader& inf)
+{
+    if (read_error || format_error)
+        return(READSTAT);
+
+    rs_read_window(inf,cur_game->cw);
+
+    return(READSTAT);
+}
+
+/*
+ * The sections of a saved game, in the order they are restored.  A
+ * section that replaced another names it, and how to read it from saves
+ * that still have it and from the old format.
+ */
+static const struct
+{
+    std::uint32_t tag;
+    bool (*write)(std::string& savef);
+    bool (*read)(save_reader& inf);
+    std::uint32_t old_tag;
+    bool (*read_old)(save_reader& inf);
+} save_sections[] = {
+    { RSEC_GAME,      rs_write_game_section,      rs_read_game_section,      0, nullptr },
+    { RSEC_HERO,      rs_write_hero_section,      rs_read_hero_section,      0, nullptr },
+    { RSEC_OBJECTS,   rs_write_objects_section,   rs_read_objects_section,   0, nullptr },
+    { RSEC_MONSTERS,  rs_write_monsters_section,  rs_read_monsters_section,  0, nullptr },
+    { RSEC_LEVEL,     rs_write_level_section,     rs_read_level_section,     0, nullptr },
+    { RSEC_KNOWLEDGE, rs_write_knowledge_section, rs_read_knowledge_section, 0, nullptr },
+    { RSEC_TIME,      rs_write_time_section,      rs_read_time_section,      0, nullptr },
+    { RSEC_MEMORY,    rs_write_memory_section,    rs_read_memory_section,
+      RSEC_SCREEN,    rs_read_screen_section },
+};
+
+static void
+put_le32(std::string& out, std::uint32_t value)
+{
+    for (int i = 0; i < 4; ++i)
+        out += static_cast<char>((value >> (8 * i)) & 0xff);
+}
+
+static std::uint32_t
+get_le32(const char* in)
+{
+    const auto* b = reinterpret_cast<const unsigned char*>(in);
+
+    return static_cast<std::uint32_t>(b[0])
+        | static_cast<std::uint32_t>(b[1]) << 8
+        | static_cast<std::uint32_t>(b[2]) << 16
+        | static_cast<std::uint32_t>(b[3]) << 24;
+}
+
+/*
+ * save_checksum:
+ *	CRC-32 of the bytes a section was stored as
+ */
+static std::uint32_t
+save_checksum(const char* data, std::size_t size)
+{
+    static const auto table = [] {
+        std::array<std::uint32_t, 256> t{};
+
+        for (std::uint32_t n = 0; n < 256; ++n)
+        {
+            std::uint32_t c = n;
+
+            for (int k = 0; k < 8; ++k)
+                c = (c & 1) ? 0xedb88320 ^ (c >> 1) : c >> 1;
+            t[n] = c;
+        }
+        return t;
+    }();
+    std::uint32_t crc = 0xffffffff;
+
+    while (size--)
+        crc = table[(crc ^ static_cast<unsigned char>(*data++)) & 0xff] ^ (crc >> 8);
+
+    return crc ^ 0xffffffff;
+}
+
+/*
+ * add_section:
+ *	Encrypt a section onto the end of a saved game starting at start,
+ *	and fill in its entry in the table
+ */
+static void
+add_section(std::string& savef, std::size_t start, std::size_t n, std::uint32_t tag, const std::string& body)
+{
+    const std::size_t offset = savef.size() - start;
+    std::string entry;
+
+    encwrite(body.data(), body.size(), savef);
+    put_le32(entry, tag);
+    put_le32(entry, static_cast<std::uint32_t>(offset));
+    put_le32(entry, static_cast<std::uint32_t>(body.size()));
+    put_le32(entry, save_checksum(savef.data() + start + offset, body.size()));
+    savef.replace(start + SAVE_HEADER + n * SAVE_ENTRY, SAVE_ENTRY, entry);
+}
 
-    rs_read_window(inf,stdscr);
+/*
+ * rs_save_file:
+ *	Add the current game to the end of savef, in the sectioned format
+ */
+bool
+rs_save_file(std::string& savef)
+{
+    const std::size_t start = savef.size();
+    const std::size_t count = 1 + sizeof(save_sections) / sizeof(save_sections[0]);
+    std::string body;
+
+    write_error = false;
+    index_list(pack_index, cur_game->player.t_pack, false);
+    index_list(object_index, cur_game->lvl_obj, false);
+    index_list(monster_index, cur_game->mlist, true);
+    savef.append(save_magic, sizeof(save_magic));
+    put_le32(savef, SAVE_FORMAT);
+    put_le32(savef, SAVE_COMPAT);
+    put_le32(savef, static_cast<std::uint32_t>(count));
+    savef.append(count * SAVE_ENTRY, '\0');
+
+    rs_write_int(body, cur_game->display->lines());
+    rs_write_int(body, cur_game->display->cols());
+    add_section(savef, start, 0, RSEC_INFO, body);
+    for (std::size_t n = 1; n < count; ++n)
+    {
+        body.clear();
+        save_sections[n - 1].write(body);
+        add_section(savef, start, n, save_sections[n - 1].tag, body);
+    }
+    clear_indexes();
+
+    return(WRITESTAT);
+}
+
+/*
+ * rs_find_section:
+ *	Decrypt the section with the given tag into plain, if the saved
+ *	game has one
+ */
+static bool
+rs_find_section(const saved_game& save, std::uint32_t tag, std::string& plain)
+{
+    const char* const data = save.image.data();
+    const std::uint32_t count = get_le32(data + 16);
+
+    for (std::uint32_t n = 0; n < count; ++n)
+    {
+        const char* const entry = data + SAVE_HEADER + n * SAVE_ENTRY;
+
+        if (get_le32(entry) == tag)
+        {
+            plain.resize(get_le32(entry + 8));
+            encxor(&plain[0], data + get_le32(entry + 4), plain.size());
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * rs_open_file:
+ *	Check that a saved game read into memory is whole and can be
+ *	restored by this version, and find what screen it was saved on
+ */
+bool
+rs_open_file(saved_game& save)
+{
+    extern const char* version;
+    const char* const data = save.image.data();
+    const std::size_t size = save.image.size();
+
+    read_error = format_error = false;
+    save.legacy = false;
+    save.stale = false;
+
+    if (size < sizeof(save_magic) || std::memcmp(data, save_magic, sizeof(save_magic)))
+    {
+        // The old format: the version, the screen size and then the
+        // game, which only the same version can make sense of.
+        const std::size_t length = std::strlen(version) + 1;
+        std::string buf(length > 80 ? length : 80, '\0');
+
+        if (size < length + 80)
+        {
+            save.stale = true;
+            format_error = true;
+
+            return(READSTAT);
+        }
+        encxor(&buf[0], data, length);
+        if (std::memcmp(buf.data(), version, length))
+        {
+            save.stale = true;
+            format_error = true;
+
+            return(READSTAT);
+        }
+        encxor(&buf[0], data + length, 80);
+        buf[79] = '\0';
+        std::sscanf(buf.c_str(), "%d x %d\n", &save.lines, &save.cols);
+        save.legacy = true;
+
+        return(READSTAT);
+    }
+
+    if (size < SAVE_HEADER)
+    {
+        read_error = true;
+
+        return(READSTAT);
+    }
+    if (get_le32(data + 12) > SAVE_FORMAT)
+    {
+        save.stale = true;
+        format_error = true;
+
+        return(READSTAT);
+    }
+
+    const std::uint32_t count = get_le32(data + 16);
+
+    if (count > (size - SAVE_HEADER) / SAVE_ENTRY)
+    {
+        read_error = true;
+
+        return(READSTAT);
+    }
+    for (std::uint32_t n = 0; n < count; ++n)
+    {
+        const char* const entry = data + SAVE_HEADER + n * SAVE_ENTRY;
+        const std::uint32_t offset = get_le32(entry + 4);
+        const std::uint32_t length = get_le32(entry + 8);
+
+        if (offset > size || length > size - offset
+            || save_checksum(data + offset, length) != get_le32(entry + 12))
+        {
+            read_error = true;
+
+            return(READSTAT);
+        }
+    }
+
+    std::string plain;
+
+    if (!rs_find_section(save, RSEC_INFO, plain))
+    {
+        format_error = true;
+
+        return(READSTAT);
+    }
+
+    save_reader inf = { plain.data(), plain.data() + plain.size(), false };
+
+    rs_read_int(inf, save.lines);
+    rs_read_int(inf, save.cols);
+
+    return(READSTAT);
+}
+
+/*
+ * rs_restore_file:
+ *	Restore the game from a saved game rs_open_file() has checked.
+ *	Sections are found by their tags, and ones this version doesn't
+ *	know are left alone.
+ */
+bool
+rs_restore_file(const saved_game& save)
+{
+    extern const char* version;
+    std::string plain;
+
+    if (read_error || format_error)
+        return(READSTAT);
+
+    clear_indexes();
+    if (save.legacy)
+    {
+        const char* const data = save.image.data();
+        save_reader inf = {
+            data + std::strlen(version) + 1 + 80,
+            data + save.image.size(),
+            true
+        };
+
+        for (const auto& section : save_sections)
+            if ((section.read_old ? section.read_old : section.read)(inf))
+                break;
+        clear_indexes();
+
+        return(READSTAT);
+    }
+
+    for (const auto& section : save_sections)
+    {
+        auto read = section.read;
+
+        if (!rs_find_section(save, section.tag, plain))
+        {
+            if (!section.read_old || !rs_find_section(save, section.old_tag, plain))
+            {
+                format_error = true;
+                break;
+            }
+            read = section.read_old;
+        }
+
+        save_reader inf = { plain.data(), plain.data() + plain.size(), false };
+
+        if (read(inf))
+            break;
+    }
+    clear_indexes();
 
     return(READSTAT);
 }
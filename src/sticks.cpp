@@ -14,8 +14,6 @@
 #include <cctype>
 #include <cstring>
 
-#include <ncurses.h>
-
 #include <roguepp/roguepp.hpp>
 
 /*
@@ -25,7 +23,7 @@
 void
 fix_stick(THING& cur)
 {
-    if (ws_type[cur.o_which] && !ws_type[cur.o_which]->compare("staff"))
+    if (cur_game->ws_type[cur.o_which] && !cur_game->ws_type[cur.o_which]->compare("staff"))
     {
         std::strncpy(cur.o_damage, "2x3", sizeof(cur.o_damage));
     } else {
@@ -53,13 +51,13 @@ do_zap()
     int y, x;
     const char* name;
     char monster, oldch;
-    static THING bolt;
+    THING bolt = {};
 
     if ((obj = get_item("zap with", STICK)) == nullptr)
 	return;
     if (obj->o_type != STICK)
     {
-	after = false;
+	cur_game->after = false;
 	msg("you can't zap with that!");
 	return;
     }
@@ -74,7 +72,7 @@ do_zap()
 	    /*
 	     * Reddy Kilowat wand.  Light up the room
 	     */
-	    ws_info[WS_LIGHT].oi_know = true;
+	    cur_game->ws_info[WS_LIGHT].oi_know = true;
 	    if (proom->r_flags & ISGONE)
 		msg("the corridor glows and then fades");
 	    else
@@ -85,7 +83,7 @@ do_zap()
 		 */
 		enter_room(&hero);
 		addmsg("the room is lit");
-		if (!terse)
+		if (!cur_game->terse)
 		    addmsg(" by a shimmering %s light", pick_color("blue").c_str());
 		endmsg();
 	    }
@@ -111,37 +109,37 @@ do_zap()
 	    x = hero.x;
 	    while (step_ok(winat(y, x)))
 	    {
-		y += delta.y;
-		x += delta.x;
+		y += cur_game->delta.y;
+		x += cur_game->delta.x;
 	    }
 	    if ((tp = moat(y, x)) != nullptr)
 	    {
 		monster = tp->t_type;
 		if (monster == 'F')
-		    player.t_flags &= ~ISHELD;
+		    cur_game->player.t_flags &= ~ISHELD;
 		switch (obj->o_which) {
 		    case WS_INVIS:
 			tp->t_flags |= ISINVIS;
 			if (cansee(y, x))
-			    mvaddch(y, x, tp->t_oldch);
+			    cur_game->cw->mvaddch(y, x, tp->t_oldch);
 			break;
 		    case WS_POLYMORPH:
 		    {
 			THING *pp;
 
 			pp = tp->t_pack;
-			detach(mlist, tp);
+			detach(cur_game->mlist, tp);
 			if (see_monst(tp))
-			    mvaddch(y, x, chat(y, x));
+			    cur_game->cw->mvaddch(y, x, chat(y, x));
 			oldch = tp->t_oldch;
-			delta.y = y;
-			delta.x = x;
-			new_monster(tp, monster = (char)(rnd(26) + 'A'), &delta);
+			cur_game->delta.y = y;
+			cur_game->delta.x = x;
+			new_monster(tp, monster = (char)(rnd(26) + 'A'), &cur_game->delta);
 			if (see_monst(tp))
-			    mvaddch(y, x, monster);
+			    cur_game->cw->mvaddch(y, x, monster);
 			tp->t_oldch = oldch;
 			tp->t_pack = pp;
-			ws_info[WS_POLYMORPH].oi_know |= see_monst(tp);
+			cur_game->ws_info[WS_POLYMORPH].oi_know |= see_monst(tp);
 			break;
 		    }
 		    case WS_CANCEL:
@@ -149,7 +147,7 @@ do_zap()
 			tp->t_flags &= ~(ISINVIS|CANHUH);
 			tp->t_disguise = tp->t_type;
 			if (see_monst(tp))
-			    mvaddch(y, x, tp->t_disguise);
+			    cur_game->cw->mvaddch(y, x, tp->t_disguise);
 			break;
 		    case WS_TELAWAY:
 		    case WS_TELTO:
@@ -165,29 +163,30 @@ do_zap()
 			}
 			else
 			{
-			    new_pos.y = hero.y + delta.y;
-			    new_pos.x = hero.x + delta.x;
+			    new_pos.y = hero.y + cur_game->delta.y;
+			    new_pos.x = hero.x + cur_game->delta.x;
 			}
 			tp->t_dest = &hero;
 			tp->t_flags |= ISRUN;
+			cur_game->awake_stale = true;
 			relocate(tp, &new_pos);
 		    }
 		}
 	    }
 	when WS_MISSILE:
-	    ws_info[WS_MISSILE].oi_know = true;
+	    cur_game->ws_info[WS_MISSILE].oi_know = true;
 	    bolt.o_type = '*';
 	    strncpy(bolt.o_hurldmg,"1x4",sizeof(bolt.o_hurldmg));
 	    bolt.o_hplus = 100;
 	    bolt.o_dplus = 1;
 	    bolt.o_flags = ISMISL;
-	    if (cur_weapon != nullptr)
-		bolt.o_launch = cur_weapon->o_which;
-	    do_motion(&bolt, delta.y, delta.x);
+	    if (cur_game->cur_weapon != nullptr)
+		bolt.o_launch = cur_game->cur_weapon->o_which;
+	    do_motion(&bolt, cur_game->delta.y, cur_game->delta.x);
 	    if ((tp = moat(bolt.o_pos.y, bolt.o_pos.x)) != nullptr
 		&& !save_throw(VS_MAGIC, tp))
 		    hit_monster(unc(bolt.o_pos), &bolt);
-	    else if (terse)
+	    else if (cur_game->terse)
 		msg("missle vanishes");
 	    else
 		msg("the missle vanishes with a puff of smoke");
@@ -197,8 +196,8 @@ do_zap()
 	    x = hero.x;
 	    while (step_ok(winat(y, x)))
 	    {
-		y += delta.y;
-		x += delta.x;
+		y += cur_game->delta.y;
+		x += cur_game->delta.x;
 	    }
 	    if ((tp = moat(y, x)) != nullptr)
 	    {
@@ -217,9 +216,9 @@ do_zap()
 			tp->t_flags |= ISSLOW;
 		    tp->t_turn = true;
 		}
-		delta.y = y;
-		delta.x = x;
-		runto(&delta);
+		cur_game->delta.y = y;
+		cur_game->delta.x = x;
+		runto(&cur_game->delta);
 	    }
 	when WS_ELECT:
 	case WS_FIRE:
@@ -230,8 +229,8 @@ do_zap()
 		name = "flame";
 	    else
 		name = "ice";
-	    fire_bolt(&hero, &delta, name);
-	    ws_info[obj->o_which].oi_know = true;
+	    fire_bolt(&hero, &cur_game->delta, name);
+	    cur_game->ws_info[obj->o_which].oi_know = true;
 	when WS_NOP:
 	    break;
 #ifdef MASTER
@@ -255,22 +254,22 @@ drain()
     THING **dp;
     int cnt;
     bool inpass;
-    static THING *drainee[40];
+    THING *drainee[40];
 
     /*
      * First cnt how many things we need to spread the hit points among
      */
     cnt = 0;
     if (chat(hero.y, hero.x) == DOOR)
-	corp = &passages[flat(hero.y, hero.x) & F_PNUM];
+	corp = &cur_game->passages[flat(hero.y, hero.x) & F_PNUM];
     else
 	corp = nullptr;
     inpass = (bool)(proom->r_flags & ISGONE);
     dp = drainee;
-    for (mp = mlist; mp != nullptr; mp = next(mp))
+    for (mp = cur_game->mlist; mp != nullptr; mp = next(mp))
 	if (mp->t_room == proom || mp->t_room == corp ||
 	    (inpass && chat(mp->t_pos.y, mp->t_pos.x) == DOOR &&
-	    &passages[flat(mp->t_pos.y, mp->t_pos.x) & F_PNUM] == proom))
+	    &cur_game->passages[flat(mp->t_pos.y, mp->t_pos.x) & F_PNUM] == proom))
 		*dp++ = mp;
     if ((cnt = (int)(dp - drainee)) == 0)
     {
@@ -304,8 +303,8 @@ fire_bolt(const coord* start, coord* dir, const char* name)
     THING *tp;
     char dirch = 0, ch;
     bool hit_hero, used, changed;
-    static coord pos;
-    static coord spotpos[BOLT_LENGTH];
+    coord pos;
+    coord spotpos[BOLT_LENGTH];
     THING bolt;
 
     bolt.o_type = WEAPON;
@@ -313,7 +312,7 @@ fire_bolt(const coord* start, coord* dir, const char* name)
     strncpy(bolt.o_hurldmg,"6x6",sizeof(bolt.o_hurldmg));
     bolt.o_hplus = 100;
     bolt.o_dplus = 0;
-    weap_info[FLAME].oi_name = name;
+    cur_game->weap_info[FLAME].oi_name = name;
     switch (dir->y + dir->x)
     {
 	case 0: dirch = '/';
@@ -366,7 +365,7 @@ def:
 			if (tp->t_type == 'D' && strcmp(name, "flame") == 0)
 			{
 			    addmsg("the flame bounces");
-			    if (!terse)
+			    if (!cur_game->terse)
 				addmsg(" off the dragon");
 			    endmsg();
 			}
@@ -377,7 +376,7 @@ def:
 		    {
 			if (start == &hero)
 			    runto(&pos);
-			if (terse)
+			if (cur_game->terse)
 			    msg("%s misses", name);
 			else
 			    msg("the %s whizzes past %s", name, set_mname(tp));
@@ -397,7 +396,7 @@ def:
 				death(moat(start->y, start->x)->t_type);
 			}
 			used = true;
-			if (terse)
+			if (cur_game->terse)
 			    msg("the %s hits", name);
 			else
 			    msg("you are hit by the %s", name);
@@ -405,12 +404,12 @@ def:
 		    else
 			msg("the %s whizzes by you", name);
 		}
-		mvaddch(pos.y, pos.x, dirch);
-		refresh();
+		cur_game->cw->mvaddch(pos.y, pos.x, dirch);
+		cur_game->cw->refresh();
 	}
     }
     for (c2 = spotpos; c2 < c1; c2++)
-	mvaddch(c2->y, c2->x, chat(c2->y, c2->x));
+	cur_game->cw->mvaddch(c2->y, c2->x, chat(c2->y, c2->x));
 }
 
 /*
@@ -420,7 +419,7 @@ def:
 std::string
 charge_str(const THING& obj)
 {
-    static char buffer[20];
+    static thread_local char buffer[20];
     int length;
 
     if (!(obj.o_flags & ISKNOW))
@@ -428,7 +427,7 @@ charge_str(const THING& obj)
         buffer[0] = 0;
         length = 0;
     }
-    else if (terse)
+    else if (cur_game->terse)
     {
         length = std::snprintf(buffer, 20, " [%d]", obj.o_charges);
     } else {
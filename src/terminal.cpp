@@ -0,0 +1,1175 @@
+/*
+ * Front ends that talk to the terminal without curses: raw ANSI output
+ * and the binary frame stream
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <roguepp/config.hpp>
+#include <roguepp/frame_stream.hpp>
+#include <roguepp/roguepp.hpp>
+
+#if defined(HAVE_UNISTD_H)
+#include <unistd.h>
+#endif
+
+#if defined(HAVE_TERMIOS_H)
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#endif
+
+namespace
+{
+    /**
+     * Keyboard side shared by the front ends: cursor keys sent as
+     * escape sequences are turned into movement commands the same way
+     * md_readchar() does for curses.  Where the bytes come from is up
+     * to the subclass.
+     */
+    class key_input
+    {
+    public:
+        virtual ~key_input() = default;
+
+        virtual void raw() {}
+        virtual void restore() {}
+
+        int read_key()
+        {
+            int ch;
+
+            if (!m_pending.empty())
+            {
+                ch = m_pending.front();
+                m_pending.pop_front();
+
+                return ch;
+            }
+            if ((ch = read_byte(-1)) == ESCAPE)
+            {
+                return escape();
+            }
+
+            return ch;
+        }
+
+        virtual void flush()
+        {
+            m_pending.clear();
+        }
+
+        virtual int erasechar() const = 0;
+        virtual int killchar() const = 0;
+
+        virtual bool slow() const
+        {
+            return false;
+        }
+
+    protected:
+        /**
+         * Next byte of input, waiting at most the given number of
+         * milliseconds for it (forever if negative).  -1 if none came.
+         */
+        virtual int read_byte(int wait) = 0;
+
+    private:
+        /**
+         * Decode a cursor key sent as an escape sequence, or hand the
+         * escape back as it is.
+         */
+        int escape()
+        {
+            int c;
+            int code;
+
+            if ((c = read_byte(64)) < 0)
+            {
+                return ESCAPE;
+            }
+            if (c != '[' && c != 'O')
+            {
+                m_pending.push_back(c);
+
+                return ESCAPE;
+            }
+            if ((code = read_byte(64)) < 0)
+            {
+                m_pending.push_back(c);
+
+                return ESCAPE;
+            }
+            switch (code)
+            {
+                case 'A': return 'k';
+                case 'B': return 'j';
+                case 'C': return 'l';
+                case 'D': return 'h';
+                case 'H': return 'y';
+                case 'F': return 'b';
+                case 'E': return '.';
+                case '1':
+                case '4':
+                case '5':
+                case '6':
+                    // Home, End, PgUp and PgDn end in a tilde.
+                    if (read_byte(64) == '~')
+                    {
+                        switch (code)
+                        {
+                            case '1': return 'y';
+                            case '4': return 'b';
+                            case '5': return 'u';
+                            case '6': return 'n';
+                        }
+                    }
+                    break;
+            }
+
+            return ESCAPE;
+        }
+
+        std::deque<int> m_pending;
+    };
+
+    /**
+     * Keys typed on standard input, which is put in raw mode while the
+     * game runs.
+     */
+    class tty_input : public key_input
+    {
+    public:
+        tty_input()
+            : m_raw(false)
+#if defined(HAVE_TERMIOS_H)
+            , m_saved()
+            , m_tty(isatty(0) != 0)
+#endif
+        {
+#if defined(HAVE_TERMIOS_H)
+            if (m_tty)
+            {
+                tcgetattr(0, &m_saved);
+            }
+#endif
+        }
+
+        void raw() override
+        {
+#if defined(HAVE_TERMIOS_H)
+            struct termios attr = m_saved;
+
+            if (!m_tty || m_raw)
+            {
+                return;
+            }
+            attr.c_lflag &= ~(ICANON | ECHO | ISIG | IEXTEN);
+            attr.c_iflag &= ~(IXON | ICRNL);
+            attr.c_cc[VMIN] = 1;
+            attr.c_cc[VTIME] = 0;
+            tcsetattr(0, TCSADRAIN, &attr);
+#endif
+            m_raw = true;
+        }
+
+        void restore() override
+        {
+#if defined(HAVE_TERMIOS_H)
+            if (m_tty && m_raw)
+            {
+                tcsetattr(0, TCSADRAIN, &m_saved);
+            }
+#endif
+            m_raw = false;
+        }
+
+        void flush() override
+        {
+            key_input::flush();
+#if defined(HAVE_TERMIOS_H)
+            if (m_tty)
+            {
+                tcflush(0, TCIFLUSH);
+            }
+#endif
+        }
+
+        int erasechar() const override
+        {
+#if defined(HAVE_TERMIOS_H)
+            if (m_tty)
+            {
+                return m_saved.c_cc[VERASE];
+            }
+#endif
+            return '\b';
+        }
+
+        int killchar() const override
+        {
+#if defined(HAVE_TERMIOS_H)
+            if (m_tty)
+            {
+                return m_saved.c_cc[VKILL];
+            }
+#endif
+            return CTRL('U');
+        }
+
+        bool slow() const override
+        {
+#if defined(HAVE_TERMIOS_H)
+            return m_tty && cfgetospeed(&m_saved) <= B1200;
+#else
+            return false;
+#endif
+        }
+
+    protected:
+        /**
+         * When standard input is gone the game is saved like on a
+         * hangup.
+         */
+        int read_byte(int wait) override
+        {
+            unsigned char c;
+
+#if defined(HAVE_TERMIOS_H)
+            if (wait >= 0)
+            {
+                struct pollfd fd = { 0, POLLIN, 0 };
+
+                if (poll(&fd, 1, wait) <= 0)
+                {
+                    return -1;
+                }
+            }
+#endif
+            if (read(0, &c, 1) != 1)
+            {
+                auto_save(SIGHUP);
+            }
+
+            return c;
+        }
+
+    private:
+        bool m_raw;
+#if defined(HAVE_TERMIOS_H)
+        struct termios m_saved;
+        bool m_tty;
+#endif
+    };
+
+    /**
+     * Keys typed on a terminal at the other end of a connection.  The
+     * terminal there is assumed to be in raw mode already, sending DEL
+     * for backspace.  Escape sequences are only decoded when the whole
+     * sequence has arrived with the escape.
+     */
+    class remote_input : public key_input
+    {
+    public:
+        explicit remote_input(std::function<int(bool)> bytes)
+            : m_bytes(std::move(bytes)) {}
+
+        int erasechar() const override
+        {
+            return 0x7f;
+        }
+
+        int killchar() const override
+        {
+            return CTRL('U');
+        }
+
+    protected:
+        int read_byte(int wait) override
+        {
+            return m_bytes(wait < 0);
+        }
+
+    private:
+        std::function<int(bool)> m_bytes;
+    };
+
+    /**
+     * Size of the terminal on standard output.
+     */
+    void
+    terminal_size(int& lines, int& cols)
+    {
+        const char* env;
+
+        lines = NUMLINES;
+        cols = NUMCOLS;
+#if defined(HAVE_TERMIOS_H) && defined(TIOCGWINSZ)
+        struct winsize ws;
+
+        if (ioctl(1, TIOCGWINSZ, &ws) == 0 && ws.ws_row > 0 && ws.ws_col > 0)
+        {
+            lines = ws.ws_row;
+            cols = ws.ws_col;
+            return;
+        }
+#endif
+        if ((env = std::getenv("LINES")) != nullptr && std::atoi(env) > 0)
+        {
+            lines = std::atoi(env);
+        }
+        if ((env = std::getenv("COLUMNS")) != nullptr && std::atoi(env) > 0)
+        {
+            cols = std::atoi(env);
+        }
+    }
+
+    void
+    write_out(std::FILE* out, std::string& buf)
+    {
+        if (!buf.empty())
+        {
+            std::fwrite(buf.data(), 1, buf.size(), out);
+            buf.clear();
+        }
+        std::fflush(out);
+    }
+
+    class ansi_screen;
+
+    /**
+     * Canvas drawn with ANSI escape sequences.  It keeps its own cells
+     * so that it can be repainted after another window covered it,
+     * and collects the escapes for its changes until it is shown.
+     */
+    class ansi_canvas : public canvas
+    {
+    public:
+        ansi_canvas(ansi_screen& screen, int lines, int cols, int y, int x)
+            : m_screen(screen)
+            , m_lines(lines)
+            , m_cols(cols)
+            , m_top(y)
+            , m_left(x)
+            , m_chars(lines * cols, ' ')
+            , m_standouts(lines * cols, false)
+            , m_y(0)
+            , m_x(0)
+            , m_out_y(-1)
+            , m_out_x(-1)
+            , m_standout(false)
+            , m_touched(true) {}
+
+        int lines() const override
+        {
+            return m_lines;
+        }
+
+        int cols() const override
+        {
+            return m_cols;
+        }
+
+        void move(int y, int x) override
+        {
+            if (y >= 0 && y < m_lines && x >= 0 && x < m_cols)
+            {
+                m_y = y;
+                m_x = x;
+            }
+        }
+
+        void getyx(int& y, int& x) const override
+        {
+            y = m_y;
+            x = m_x;
+        }
+
+        void addch(int ch) override
+        {
+            const auto i = m_y * m_cols + m_x;
+
+            m_chars[i] = static_cast<char>(ch);
+            m_standouts[i] = m_standout;
+            if (!m_touched)
+            {
+                goto_cursor();
+                m_pending += static_cast<char>(ch);
+                m_out_x = m_x + 1 < m_cols ? m_out_x + 1 : -1;
+            }
+            if (++m_x >= m_cols)
+            {
+                m_x = 0;
+                if (m_y < m_lines - 1)
+                {
+                    ++m_y;
+                }
+            }
+        }
+
+        void addstr(const char* str) override
+        {
+            while (*str)
+            {
+                addch(static_cast<unsigned char>(*str++));
+            }
+        }
+
+        int inch() const override
+        {
+            return static_cast<unsigned char>(m_chars[m_y * m_cols + m_x]);
+        }
+
+        void clrtoeol() override
+        {
+            const auto first = m_y * m_cols + m_x;
+
+            for (auto i = first; i < (m_y + 1) * m_cols; ++i)
+            {
+                m_chars[i] = ' ';
+                m_standouts[i] = false;
+            }
+            if (!m_touched)
+            {
+                goto_cursor();
+                clear_line(m_x);
+            }
+        }
+
+        void clear() override
+        {
+            erase();
+        }
+
+        void erase() override
+        {
+            std::fill(m_chars.begin(), m_chars.end(), ' ');
+            std::fill(m_standouts.begin(), m_standouts.end(), false);
+            m_y = m_x = 0;
+            touch();
+        }
+
+        void standout() override
+        {
+            m_standout = true;
+            if (!m_touched)
+            {
+                m_pending += "\033[7m";
+            }
+        }
+
+        void standend() override
+        {
+            m_standout = false;
+            if (!m_touched)
+            {
+                m_pending += "\033[m";
+            }
+        }
+
+        void refresh() override;
+
+        void touch() override
+        {
+            m_touched = true;
+            m_pending.clear();
+        }
+
+        void place(int y, int x) override
+        {
+            m_top = y;
+            m_left = x;
+            touch();
+        }
+
+        /**
+         * Escapes for the changes made since the canvas was shown.  If
+         * the terminal has just been cleared, blank lines are left out
+         * of a repaint.
+         */
+        void take(std::string& out, bool cleared = false);
+
+    private:
+        void goto_cursor()
+        {
+            char buf[32];
+
+            if (m_out_y == m_y && m_out_x == m_x)
+            {
+                return;
+            }
+            std::snprintf(buf, sizeof(buf), "\033[%d;%dH", m_top + m_y + 1, m_left + m_x + 1);
+            m_pending += buf;
+            m_out_y = m_y;
+            m_out_x = m_x;
+        }
+
+        void clear_line(int x);
+        void repaint(bool cleared);
+
+        ansi_screen& m_screen;
+        const int m_lines;
+        const int m_cols;
+        int m_top;
+        int m_left;
+        std::vector<char> m_chars;
+        std::vector<bool> m_standouts;
+        int m_y;
+        int m_x;
+        /** Where the escapes so far leave the terminal's cursor. */
+        int m_out_y;
+        int m_out_x;
+        bool m_standout;
+        /** Has all of the canvas to be painted again? */
+        bool m_touched;
+        std::string m_pending;
+    };
+
+    /**
+     * Front end writing ANSI escape sequences to a terminal, standard
+     * output unless told otherwise.
+     */
+    class ansi_screen : public renderer
+    {
+    public:
+        ansi_screen(
+            int lines,
+            int cols,
+            std::unique_ptr<key_input> input,
+            std::function<void(const std::string&)> output
+        )
+            : m_lines(lines)
+            , m_cols(cols)
+            , m_input(std::move(input))
+            , m_output(std::move(output))
+            , m_started(false)
+            , m_ended(true)
+            , m_redraw(true)
+        {
+            m_screen = std::make_unique<ansi_canvas>(*this, m_lines, m_cols, 0, 0);
+            m_scratch = std::make_unique<ansi_canvas>(*this, m_lines, m_cols, 0, 0);
+        }
+
+        void begin() override
+        {
+            m_input->raw();
+            if (!m_started)
+            {
+                // Use the alternate screen, like curses does.
+                m_out += "\033[?1049h\033[H\033[2J";
+                m_started = true;
+            }
+            m_ended = false;
+            send();
+        }
+
+        void end() override
+        {
+            if (m_ended)
+            {
+                return;
+            }
+            m_out += "\033[m\033[?1049l";
+            send();
+            m_input->restore();
+            m_ended = true;
+        }
+
+        bool ended() const override
+        {
+            return m_ended;
+        }
+
+        void suspend() override
+        {
+            end();
+        }
+
+        void resume() override
+        {
+            m_input->raw();
+            m_out += "\033[?1049h";
+            m_ended = false;
+            m_redraw = true;
+            m_screen->touch();
+            m_screen->refresh();
+        }
+
+        int lines() const override
+        {
+            return m_lines;
+        }
+
+        int cols() const override
+        {
+            return m_cols;
+        }
+
+        canvas& screen() override
+        {
+            return *m_screen;
+        }
+
+        canvas& scratch() override
+        {
+            return *m_scratch;
+        }
+
+        std::unique_ptr<canvas> new_canvas(int lines, int cols, int y, int x) override
+        {
+            return std::make_unique<ansi_canvas>(*this, lines, cols, y, x);
+        }
+
+        void redraw() override
+        {
+            m_redraw = true;
+        }
+
+        int readchar() override
+        {
+            // The main screen is shown while waiting for a key, as it
+            // is with curses.
+            m_screen->take(m_out);
+            send();
+
+            return m_input->read_key() & 0x7f;
+        }
+
+        void flush_input() override
+        {
+            m_input->flush();
+        }
+
+        int erasechar() override
+        {
+            return m_input->erasechar();
+        }
+
+        int killchar() override
+        {
+            return m_input->killchar();
+        }
+
+        bool has_clreol() const override
+        {
+            return true;
+        }
+
+        bool slow() const override
+        {
+            return m_input->slow();
+        }
+
+        void raw_standout() override
+        {
+            m_output("\033[7m");
+        }
+
+        void raw_standend() override
+        {
+            m_output("\033[m");
+        }
+
+        /** Put the changes of a canvas on the screen. */
+        void show(ansi_canvas& win)
+        {
+            if (m_redraw)
+            {
+                m_out += "\033[m\033[H\033[2J";
+                win.touch();
+                m_redraw = false;
+                win.take(m_out, true);
+            } else {
+                win.take(m_out);
+            }
+            send();
+        }
+
+    private:
+        void send()
+        {
+            m_output(m_out);
+            m_out.clear();
+        }
+
+        int m_lines;
+        int m_cols;
+        std::unique_ptr<ansi_canvas> m_screen;
+        std::unique_ptr<ansi_canvas> m_scratch;
+        std::unique_ptr<key_input> m_input;
+        std::function<void(const std::string&)> m_output;
+        std::string m_out;
+        bool m_started;
+        bool m_ended;
+        bool m_redraw;
+    };
+
+    void
+    ansi_canvas::refresh()
+    {
+        m_screen.show(*this);
+    }
+
+    void
+    ansi_canvas::take(std::string& out, bool cleared)
+    {
+        if (m_touched)
+        {
+            repaint(cleared);
+        }
+        goto_cursor();
+        out += m_pending;
+        m_pending.clear();
+    }
+
+    /**
+     * Blank the rest of the line from the given column.
+     */
+    void
+    ansi_canvas::clear_line(int x)
+    {
+        if (m_left + m_cols >= m_screen.cols())
+        {
+            m_pending += "\033[K";
+        } else {
+            m_pending.append(m_cols - x, ' ');
+            m_out_y = -1;
+        }
+    }
+
+    /**
+     * Paint every line of the canvas.  Trailing blanks are cleared
+     * instead of written.
+     */
+    void
+    ansi_canvas::repaint(bool cleared)
+    {
+        const auto cy = m_y;
+        const auto cx = m_x;
+        bool standout = false;
+
+        m_pending.clear();
+        m_touched = false;
+        m_out_y = m_out_x = -1;
+        m_pending += "\033[m";
+        for (int y = 0; y < m_lines; ++y)
+        {
+            const auto row = y * m_cols;
+            int end = m_cols;
+
+            while (end > 0 && m_chars[row + end - 1] == ' ' && !m_standouts[row + end - 1])
+            {
+                --end;
+            }
+            if (end == 0 && cleared)
+            {
+                continue;
+            }
+            int start = 0;
+
+            // On a cleared terminal the leading blanks are skipped too.
+            while (cleared && start < end && m_chars[row + start] == ' ' && !m_standouts[row + start])
+            {
+                ++start;
+            }
+            m_y = y;
+            m_x = start;
+            goto_cursor();
+            for (int x = start; x < end; ++x)
+            {
+                if (m_standouts[row + x] != standout)
+                {
+                    standout = m_standouts[row + x];
+                    m_pending += standout ? "\033[7m" : "\033[m";
+                }
+                m_pending += m_chars[row + x];
+            }
+            if (standout)
+            {
+                m_pending += "\033[m";
+                standout = false;
+            }
+            if (!cleared)
+            {
+                m_x = end;
+                clear_line(end);
+            }
+            m_out_y = -1;
+        }
+        if (m_standout)
+        {
+            m_pending += "\033[7m";
+        }
+        m_y = cy;
+        m_x = cx;
+    }
+
+    /**
+     * Frame stream records not written out yet, shared by the windows
+     * of a stream front end.
+     */
+    struct frame_buffer
+    {
+        std::FILE* file;
+        std::string bytes;
+        /** Window whose FRAME_TEXT record is last, if any. */
+        const void* text_owner;
+        /** Where the length of that record is. */
+        std::size_t text_at;
+
+        void record(frame_op op, std::uint8_t id, std::initializer_list<int> args)
+        {
+            bytes += static_cast<char>(op);
+            bytes += static_cast<char>(id);
+            for (const auto arg : args)
+            {
+                bytes += static_cast<char>(arg);
+            }
+            text_owner = nullptr;
+        }
+
+        void write()
+        {
+            write_out(file, bytes);
+            text_owner = nullptr;
+        }
+    };
+
+    /**
+     * Canvas that writes its changes as frame stream records.
+     */
+    class stream_canvas : public canvas
+    {
+    public:
+        stream_canvas(frame_buffer& out, std::uint8_t id, int lines, int cols)
+            : m_out(out)
+            , m_id(id)
+            , m_lines(lines)
+            , m_cols(cols)
+            , m_y(0)
+            , m_x(0) {}
+
+        int lines() const override
+        {
+            return m_lines;
+        }
+
+        int cols() const override
+        {
+            return m_cols;
+        }
+
+        void move(int y, int x) override
+        {
+            if (y >= 0 && y < m_lines && x >= 0 && x < m_cols)
+            {
+                m_y = y;
+                m_x = x;
+                m_out.record(FRAME_MOVE, m_id, { y, x });
+            }
+        }
+
+        void getyx(int& y, int& x) const override
+        {
+            y = m_y;
+            x = m_x;
+        }
+
+        void addch(int ch) override
+        {
+            auto& bytes = m_out.bytes;
+
+            // Runs of characters go into one record.
+            if (m_out.text_owner != this
+                || static_cast<unsigned char>(bytes[m_out.text_at]) == 255)
+            {
+                m_out.record(FRAME_TEXT, m_id, { 0 });
+                m_out.text_owner = this;
+                m_out.text_at = bytes.size() - 1;
+            }
+            ++bytes[m_out.text_at];
+            bytes += static_cast<char>(ch);
+            if (++m_x >= m_cols)
+            {
+                m_x = 0;
+                if (m_y < m_lines - 1)
+                {
+                    ++m_y;
+                }
+            }
+        }
+
+        void addstr(const char* str) override
+        {
+            while (*str)
+            {
+                addch(static_cast<unsigned char>(*str++));
+            }
+        }
+
+        int inch() const override
+        {
+            return ' ';
+        }
+
+        void clrtoeol() override
+        {
+            m_out.record(FRAME_CLRTOEOL, m_id, {});
+        }
+
+        void clear() override
+        {
+            m_y = m_x = 0;
+            m_out.record(FRAME_CLEAR, m_id, {});
+        }
+
+        void erase() override
+        {
+            clear();
+        }
+
+        void standout() override
+        {
+            m_out.record(FRAME_STANDOUT, m_id, { 1 });
+        }
+
+        void standend() override
+        {
+            m_out.record(FRAME_STANDOUT, m_id, { 0 });
+        }
+
+        void refresh() override
+        {
+            m_out.record(FRAME_SHOW, m_id, {});
+            m_out.write();
+        }
+
+        void touch() override
+        {
+            m_out.record(FRAME_TOUCH, m_id, {});
+        }
+
+        void place(int y, int x) override
+        {
+            m_out.record(FRAME_PLACE, m_id, { y, x });
+        }
+
+    protected:
+        frame_buffer& m_out;
+        const std::uint8_t m_id;
+
+    private:
+        const int m_lines;
+        const int m_cols;
+        int m_y;
+        int m_x;
+    };
+
+    /**
+     * Window opened with new_canvas(), closed again when it goes away.
+     */
+    class stream_window : public stream_canvas
+    {
+    public:
+        stream_window(frame_buffer& out, std::uint8_t id, int lines, int cols, int y, int x)
+            : stream_canvas(out, id, lines, cols)
+        {
+            m_out.record(FRAME_OPEN, m_id, { lines, cols, y, x });
+        }
+
+        ~stream_window() override
+        {
+            m_out.record(FRAME_CLOSE, m_id, {});
+        }
+    };
+
+    /**
+     * Front end writing a frame stream to standard output.
+     */
+    class stream_screen : public renderer
+    {
+    public:
+        explicit stream_screen(std::FILE* out)
+            : m_out{ out, std::string(), nullptr, 0 }
+            , m_lines(0)
+            , m_cols(0)
+            , m_next_id(1)
+            , m_ended(true)
+        {
+            terminal_size(m_lines, m_cols);
+            m_screen = std::make_unique<stream_canvas>(m_out, 0, m_lines, m_cols);
+            m_scratch = std::make_unique<stream_canvas>(m_out, 1, m_lines, m_cols);
+            m_out.bytes.append(FRAME_MAGIC, sizeof(FRAME_MAGIC));
+            m_out.bytes += static_cast<char>(FRAME_VERSION);
+            m_out.bytes += static_cast<char>(m_lines);
+            m_out.bytes += static_cast<char>(m_cols);
+        }
+
+        void begin() override
+        {
+            m_input.raw();
+            m_ended = false;
+            m_out.write();
+        }
+
+        void end() override
+        {
+            m_out.write();
+            m_input.restore();
+            m_ended = true;
+        }
+
+        bool ended() const override
+        {
+            return m_ended;
+        }
+
+        void suspend() override
+        {
+            end();
+        }
+
+        void resume() override
+        {
+            begin();
+            redraw();
+        }
+
+        int lines() const override
+        {
+            return m_lines;
+        }
+
+        int cols() const override
+        {
+            return m_cols;
+        }
+
+        canvas& screen() override
+        {
+            return *m_screen;
+        }
+
+        canvas& scratch() override
+        {
+            return *m_scratch;
+        }
+
+        std::unique_ptr<canvas> new_canvas(int lines, int cols, int y, int x) override
+        {
+            // Window numbers wrap around, skipping the two fixed ones.
+            if (++m_next_id < 2)
+            {
+                m_next_id = 2;
+            }
+
+            return std::make_unique<stream_window>(m_out, m_next_id, lines, cols, y, x);
+        }
+
+        void redraw() override
+        {
+            m_out.bytes += static_cast<char>(FRAME_REDRAW);
+            m_out.text_owner = nullptr;
+        }
+
+        int readchar() override
+        {
+            if (!m_out.bytes.empty())
+            {
+                m_screen->refresh();
+            }
+
+            return m_input.read_key() & 0x7f;
+        }
+
+        void flush_input() override
+        {
+            m_input.flush();
+        }
+
+        int erasechar() override
+        {
+            return m_input.erasechar();
+        }
+
+        int killchar() override
+        {
+            return m_input.killchar();
+        }
+
+        bool has_clreol() const override
+        {
+            return true;
+        }
+
+        bool slow() const override
+        {
+            return false;
+        }
+
+        void raw_standout() override {}
+        void raw_standend() override {}
+
+    private:
+        frame_buffer m_out;
+        int m_lines;
+        int m_cols;
+        std::unique_ptr<stream_canvas> m_screen;
+        std::unique_ptr<stream_canvas> m_scratch;
+        std::uint8_t m_next_id;
+        tty_input m_input;
+        bool m_ended;
+    };
+}
+
+std::unique_ptr<renderer>
+ansi_renderer()
+{
+    int lines;
+    int cols;
+
+    terminal_size(lines, cols);
+
+    return std::make_unique<ansi_screen>(
+        lines,
+        cols,
+        std::make_unique<tty_input>(),
+        [](const std::string& bytes)
+        {
+            std::fwrite(bytes.data(), 1, bytes.size(), stdout);
+            std::fflush(stdout);
+        }
+    );
+}
+
+std::unique_ptr<renderer>
+ansi_renderer(int lines, int cols, std::function<int(bool)> input,
+    std::function<void(const std::string&)> output)
+{
+    return std::make_unique<ansi_screen>(
+        lines,
+        cols,
+        std::make_unique<remote_input>(std::move(input)),
+        std::move(output)
+    );
+}
+
+std::unique_ptr<renderer>
+stream_renderer(std::FILE* out)
+{
+    return std::make_unique<stream_screen>(out);
+}
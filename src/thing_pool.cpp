@@ -0,0 +1,81 @@
+/*
+ * Slab allocator for monsters and objects
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+
+#include <cstring>
+#include <functional>
+
+#include <roguepp/thing_pool.hpp>
+
+THING*
+thing_pool::allocate()
+{
+    THING* item;
+
+    if (m_free)
+    {
+        item = m_free;
+        m_free = item->_t._l_next;
+    } else {
+        // Carve the next slot, so consecutive allocations are next to
+        // each other in memory.
+        if (m_current == m_slabs.size())
+        {
+            m_slabs.push_back(std::make_unique<THING[]>(SLAB_SIZE));
+            ++m_stats.slabs;
+        }
+        item = &m_slabs[m_current][m_used];
+        if (++m_used == SLAB_SIZE)
+        {
+            ++m_current;
+            m_used = 0;
+        }
+    }
+    std::memset(static_cast<void*>(item), 0, sizeof(THING));
+    ++m_stats.allocations;
+    if (++m_stats.live > m_stats.peak)
+    {
+        m_stats.peak = m_stats.live;
+    }
+
+    return item;
+}
+
+void
+thing_pool::release(THING* item)
+{
+    item->_t._l_next = m_free;
+    m_free = item;
+    --m_stats.live;
+}
+
+void
+thing_pool::reset()
+{
+    m_current = 0;
+    m_used = 0;
+    m_free = nullptr;
+    m_stats.live = 0;
+}
+
+bool
+thing_pool::owns(const THING* item) const
+{
+    const std::less<const THING*> before;
+
+    for (const auto& slab : m_slabs)
+    {
+        if (!before(item, slab.get()) && before(item, slab.get() + SLAB_SIZE))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
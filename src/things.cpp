@@ -16,8 +16,6 @@
 #include <cstring>
 #include <functional>
 
-#include <ncurses.h>
-
 #include <roguepp/roguepp.hpp>
 
 static void set_order(int*, int);
@@ -44,15 +42,15 @@ inv_name(THING *obj, bool drop)
     const char* sp;
     int which;
 
-    pb = prbuf;
+    pb = cur_game->prbuf;
     which = obj->o_which;
     switch (obj->o_type)
     {
         case POTION:
             nameit(*obj,
                 "potion",
-                p_colors[which],
-                pot_info[which],
+                cur_game->p_colors[which],
+                cur_game->pot_info[which],
                 nullstr
             );
             break;
@@ -61,8 +59,8 @@ inv_name(THING *obj, bool drop)
             nameit(
                 *obj,
                 "ring",
-                r_stones[which],
-                ring_info[which],
+                cur_game->r_stones[which],
+                cur_game->ring_info[which],
                 ring_num
             );
             break;
@@ -70,9 +68,9 @@ inv_name(THING *obj, bool drop)
         case STICK:
             nameit(
                 *obj,
-                ws_type[which],
-                ws_made[which],
-                ws_info[which],
+                cur_game->ws_type[which],
+                cur_game->ws_made[which],
+                cur_game->ws_info[which],
                 charge_str
             );
             break;
@@ -81,38 +79,38 @@ inv_name(THING *obj, bool drop)
 	    if (obj->o_count == 1)
 	    {
             std::strcpy(pb, "A scroll ");
-		pb = &prbuf[9];
+		pb = &cur_game->prbuf[9];
 	    }
 	    else
 	    {
             std::sprintf(pb, "%d scrolls ", obj->o_count);
-		pb = &prbuf[strlen(prbuf)];
+		pb = &cur_game->prbuf[strlen(cur_game->prbuf)];
 	    }
-	    op = &scr_info[which];
+	    op = &cur_game->scr_info[which];
 	    if (op->oi_know)
 		std::sprintf(pb, "of %s", op->oi_name);
 	    else if (op->oi_guess)
 		std::sprintf(pb, "called %s", op->oi_guess);
 	    else
-		std::sprintf(pb, "titled '%s'", s_names[which].c_str());
+		std::sprintf(pb, "titled '%s'", cur_game->s_names[which].c_str());
 	when FOOD:
 	    if (which == 1)
 		if (obj->o_count == 1)
-		    std::sprintf(pb, "A%s %s", vowelstr(fruit), fruit);
+		    std::sprintf(pb, "A%s %s", vowelstr(cur_game->fruit), cur_game->fruit);
 		else
-		    std::sprintf(pb, "%d %ss", obj->o_count, fruit);
+		    std::sprintf(pb, "%d %ss", obj->o_count, cur_game->fruit);
 	    else
 		if (obj->o_count == 1)
 		    std::strcpy(pb, "Some food");
 		else
 		    std::sprintf(pb, "%d rations of food", obj->o_count);
 	when WEAPON:
-	    sp = weap_info[which].oi_name;
+	    sp = cur_game->weap_info[which].oi_name;
 	    if (obj->o_count > 1)
 		sprintf(pb, "%d ", obj->o_count);
 	    else
 		sprintf(pb, "A%s ", vowelstr(sp));
-	    pb = &prbuf[strlen(prbuf)];
+	    pb = &cur_game->prbuf[strlen(cur_game->prbuf)];
 	    if (obj->o_flags & ISKNOW)
 		sprintf(pb, "%s %s", num(obj->o_hplus,obj->o_dplus,WEAPON), sp);
 	    else
@@ -121,54 +119,54 @@ inv_name(THING *obj, bool drop)
 		strcat(pb, "s");
 	    if (obj->o_label != nullptr)
 	    {
-		pb = &prbuf[strlen(prbuf)];
+		pb = &cur_game->prbuf[strlen(cur_game->prbuf)];
 		sprintf(pb, " called %s", obj->o_label);
 	    }
 	when ARMOR:
-	    sp = arm_info[which].oi_name;
+	    sp = cur_game->arm_info[which].oi_name;
 	    if (obj->o_flags & ISKNOW)
 	    {
 		sprintf(pb, "%s %s [",
 		    num(a_class[which] - obj->o_arm, 0, ARMOR), sp);
-		if (!terse)
+		if (!cur_game->terse)
 		    strcat(pb, "protection ");
-		pb = &prbuf[strlen(prbuf)];
+		pb = &cur_game->prbuf[strlen(cur_game->prbuf)];
 		sprintf(pb, "%d]", 10 - obj->o_arm);
 	    }
 	    else
 		sprintf(pb, "%s", sp);
 	    if (obj->o_label != nullptr)
 	    {
-		pb = &prbuf[strlen(prbuf)];
+		pb = &cur_game->prbuf[strlen(cur_game->prbuf)];
 		sprintf(pb, " called %s", obj->o_label);
 	    }
 	when AMULET:
 	    strcpy(pb, "The Amulet of Yendor");
 	when GOLD:
-	    sprintf(prbuf, "%d Gold pieces", obj->o_goldval);
+	    sprintf(cur_game->prbuf, "%d Gold pieces", obj->o_goldval);
 #ifdef MASTER
 	otherwise:
 	    debug("Picked up something funny %s", unctrl(obj->o_type));
 	    sprintf(pb, "Something bizarre %s", unctrl(obj->o_type));
 #endif
     }
-    if (inv_describe)
+    if (cur_game->inv_describe)
     {
-	if (obj == cur_armor)
+	if (obj == cur_game->cur_armor)
 	    strcat(pb, " (being worn)");
-	if (obj == cur_weapon)
+	if (obj == cur_game->cur_weapon)
 	    strcat(pb, " (weapon in hand)");
-	if (obj == cur_ring[LEFT])
+	if (obj == cur_game->cur_ring[LEFT])
 	    strcat(pb, " (on left hand)");
-	else if (obj == cur_ring[RIGHT])
+	else if (obj == cur_game->cur_ring[RIGHT])
 	    strcat(pb, " (on right hand)");
     }
-    if (drop && isupper(prbuf[0]))
-	prbuf[0] = (char) tolower(prbuf[0]);
-    else if (!drop && islower(*prbuf))
-	*prbuf = (char) toupper(*prbuf);
-    prbuf[MAXSTR-1] = '\0';
-    return prbuf;
+    if (drop && isupper(cur_game->prbuf[0]))
+	cur_game->prbuf[0] = (char) tolower(cur_game->prbuf[0]);
+    else if (!drop && islower(*cur_game->prbuf))
+	*cur_game->prbuf = (char) toupper(*cur_game->prbuf);
+    cur_game->prbuf[MAXSTR-1] = '\0';
+    return cur_game->prbuf;
 }
 
 /*
@@ -185,7 +183,7 @@ drop()
     ch = chat(hero.y, hero.x);
     if (ch != FLOOR && ch != PASSAGE)
     {
-	after = false;
+	cur_game->after = false;
 	msg("there is something there already");
 	return;
     }
@@ -193,16 +191,16 @@ drop()
 	return;
     if (!dropcheck(obj))
 	return;
-    obj = leave_pack(obj, true, (bool)!ISMULT(obj->o_type));
+    obj = level_item(leave_pack(obj, true, (bool)!ISMULT(obj->o_type)));
     /*
      * Link it into the level object list
      */
-    attach(lvl_obj, obj);
+    obj->o_pos = hero;
+    attach(cur_game->lvl_obj, obj);
     chat(hero.y, hero.x) = (char) obj->o_type;
     flat(hero.y, hero.x) |= F_DROPPED;
-    obj->o_pos = hero;
     if (obj->o_type == AMULET)
-	amulet = false;
+	cur_game->amulet = false;
     msg("dropped %s", inv_name(obj, true));
 }
 
@@ -215,24 +213,24 @@ dropcheck(THING *obj)
 {
     if (obj == nullptr)
 	return true;
-    if (obj != cur_armor && obj != cur_weapon
-	&& obj != cur_ring[LEFT] && obj != cur_ring[RIGHT])
+    if (obj != cur_game->cur_armor && obj != cur_game->cur_weapon
+	&& obj != cur_game->cur_ring[LEFT] && obj != cur_game->cur_ring[RIGHT])
 	    return true;
     if (obj->o_flags & ISCURSED)
     {
 	msg("you can't.  It appears to be cursed");
 	return false;
     }
-    if (obj == cur_weapon)
-	cur_weapon = nullptr;
-    else if (obj == cur_armor)
+    if (obj == cur_game->cur_weapon)
+	cur_game->cur_weapon = nullptr;
+    else if (obj == cur_game->cur_armor)
     {
 	waste_time();
-	cur_armor = nullptr;
+	cur_game->cur_armor = nullptr;
     }
     else
     {
-	cur_ring[obj == cur_ring[LEFT] ? LEFT : RIGHT] = nullptr;
+	cur_game->cur_ring[obj == cur_game->cur_ring[LEFT] ? LEFT : RIGHT] = nullptr;
 	switch (obj->o_which)
 	{
 	    case R_ADDSTR:
@@ -256,6 +254,7 @@ new_thing()
 {
     THING *cur;
     int r;
+    rng_scope stream(RNG_ITEM);
 
     cur = new_item();
     cur->o_hplus = 0;
@@ -270,23 +269,23 @@ new_thing()
      * Decide what kind of object it will be
      * If we haven't had food for a while, let it be food.
      */
-    switch (no_food > 3 ? 2 : pick_one(things, NUMTHINGS))
+    switch (cur_game->no_food > 3 ? 2 : pick_one(cur_game->things, NUMTHINGS))
     {
 	case 0:
 	    cur->o_type = POTION;
-	    cur->o_which = pick_one(pot_info, MAXPOTIONS);
+	    cur->o_which = pick_one(cur_game->pot_info, MAXPOTIONS);
 	when 1:
 	    cur->o_type = SCROLL;
-	    cur->o_which = pick_one(scr_info, MAXSCROLLS);
+	    cur->o_which = pick_one(cur_game->scr_info, MAXSCROLLS);
 	when 2:
 	    cur->o_type = FOOD;
-	    no_food = 0;
+	    cur_game->no_food = 0;
 	    if (rnd(10) != 0)
 		cur->o_which = 0;
 	    else
 		cur->o_which = 1;
 	when 3:
-	    init_weapon(cur, pick_one(weap_info, MAXWEAPONS));
+	    init_weapon(cur, pick_one(cur_game->weap_info, MAXWEAPONS));
 	    if ((r = rnd(100)) < 10)
 	    {
 		cur->o_flags |= ISCURSED;
@@ -296,7 +295,7 @@ new_thing()
 		cur->o_hplus += rnd(3) + 1;
 	when 4:
 	    cur->o_type = ARMOR;
-	    cur->o_which = pick_one(arm_info, MAXARMORS);
+	    cur->o_which = pick_one(cur_game->arm_info, MAXARMORS);
 	    cur->o_arm = a_class[cur->o_which];
 	    if ((r = rnd(100)) < 20)
 	    {
@@ -307,7 +306,7 @@ new_thing()
 		cur->o_arm -= rnd(3) + 1;
 	when 5:
 	    cur->o_type = RING;
-	    cur->o_which = pick_one(ring_info, MAXRINGS);
+	    cur->o_which = pick_one(cur_game->ring_info, MAXRINGS);
 	    switch (cur->o_which)
 	    {
 		case R_ADDSTR:
@@ -325,7 +324,7 @@ new_thing()
 	    }
 	when 6:
 	    cur->o_type = STICK;
-	    cur->o_which = pick_one(ws_info, MAXSTICKS);
+	    cur->o_which = pick_one(cur_game->ws_info, MAXSTICKS);
 	    fix_stick(*cur);
 #ifdef MASTER
 	otherwise:
@@ -354,7 +353,7 @@ pick_one(struct obj_info *info, int nitems)
     if (info == end)
     {
 #ifdef MASTER
-	if (wizard)
+	if (cur_game->wizard)
 	{
 	    msg("bad pick_one: %d from %d items", i, nitems);
 	    for (info = start; info < end; info++)
@@ -370,13 +369,6 @@ pick_one(struct obj_info *info, int nitems)
  * discovered:
  *	list what the player has discovered in this game of a certain type
  */
-static int line_cnt = 0;
-
-static bool newpage = false;
-
-static const char* lastfmt;
-static const char* lastarg;
-
 
 void
 discovered()
@@ -386,10 +378,10 @@ discovered()
 
     do {
 	disc_list = false;
-	if (!terse)
+	if (!cur_game->terse)
 	    addmsg("for ");
 	addmsg("what type");
-	if (!terse)
+	if (!cur_game->terse)
 	    addmsg(" of object do you want a list");
 	msg("? (* for all)");
 	ch = readchar();
@@ -406,7 +398,7 @@ discovered()
 		disc_list = true;
 		break;
 	    default:
-		if (terse)
+		if (cur_game->terse)
 		    msg("Not a type");
 		else
 		    msg("Please type one of %c%c%c%c (ESCAPE to quit)", POTION, SCROLL, RING, STICK);
@@ -443,26 +435,26 @@ print_disc(char type)
 {
     struct obj_info *info = nullptr;
     int i, maxnum = 0, num_found;
-    static THING obj;
-    static int order[MAX4(MAXSCROLLS, MAXPOTIONS, MAXRINGS, MAXSTICKS)];
+    THING obj = {};
+    int order[MAX4(MAXSCROLLS, MAXPOTIONS, MAXRINGS, MAXSTICKS)];
 
     switch (type)
     {
 	case SCROLL:
 	    maxnum = MAXSCROLLS;
-	    info = scr_info;
+	    info = cur_game->scr_info;
 	    break;
 	case POTION:
 	    maxnum = MAXPOTIONS;
-	    info = pot_info;
+	    info = cur_game->pot_info;
 	    break;
 	case RING:
 	    maxnum = MAXRINGS;
-	    info = ring_info;
+	    info = cur_game->ring_info;
 	    break;
 	case STICK:
 	    maxnum = MAXSTICKS;
-	    info = ws_info;
+	    info = cur_game->ws_info;
 	    break;
     }
     set_order(order, maxnum);
@@ -511,88 +503,84 @@ set_order(int* order, int numthings)
 char
 add_line(const char* fmt, const char* arg)
 {
-    WINDOW *tw, *sw;
     int x, y;
     const char* prompt = "--Press space to continue--";
-    static int maxlen = -1;
 
-    if (line_cnt == 0)
+    if (cur_game->line_cnt == 0)
     {
-	    wclear(hw);
-	    if (inv_type == INV_SLOW)
-		mpos = 0;
+	    cur_game->hw->clear();
+	    if (cur_game->inv_type == INV_SLOW)
+		cur_game->mpos = 0;
     }
-    if (inv_type == INV_SLOW)
+    if (cur_game->inv_type == INV_SLOW)
     {
 	if (*fmt != '\0')
 	    if (msg(fmt, arg) == ESCAPE)
 		return ESCAPE;
-	line_cnt++;
+	cur_game->line_cnt++;
     }
     else
     {
-	if (maxlen < 0)
-	    maxlen = (int) strlen(prompt);
-	if (line_cnt >= LINES - 1 || fmt == nullptr)
+	if (cur_game->maxlen < 0)
+	    cur_game->maxlen = (int) strlen(prompt);
+	if (cur_game->line_cnt >= cur_game->display->lines() - 1 || fmt == nullptr)
 	{
-	    if (inv_type == INV_OVER && fmt == nullptr && !newpage)
+	    if (cur_game->inv_type == INV_OVER && fmt == nullptr && !cur_game->newpage)
 	    {
 		msg("");
-		refresh();
-		tw = newwin(line_cnt + 1, maxlen + 2, 0, COLS - maxlen - 3);
-		sw = subwin(tw, line_cnt + 1, maxlen + 1, 0, COLS - maxlen - 2);
-                for (y = 0; y <= line_cnt; y++)
+		cur_game->cw->refresh();
+		auto tw = cur_game->display->new_canvas(cur_game->line_cnt + 1, cur_game->maxlen + 2, 0, cur_game->display->cols() - cur_game->maxlen - 3);
+                for (y = 0; y <= cur_game->line_cnt; y++)
                 {
-                    wmove(sw, y, 0);
-                    for (x = 0; x <= maxlen; x++)
-                        waddch(sw, mvwinch(hw, y, x));
+                    tw->move(y, 1);
+                    for (x = 0; x <= cur_game->maxlen; x++)
+                        tw->addch(cur_game->hw->mvinch(y, x));
                 }
-		wmove(tw, line_cnt, 1);
-		waddstr(tw, prompt);
+		tw->move(cur_game->line_cnt, 1);
+		tw->addstr(prompt);
 		/*
 		 * if there are lines below, use 'em
 		 */
-		if (LINES > NUMLINES)
+		if (cur_game->display->lines() > NUMLINES)
 		{
-		    if (NUMLINES + line_cnt > LINES)
-			mvwin(tw, LINES - (line_cnt + 1), COLS - maxlen - 3);
+		    if (NUMLINES + cur_game->line_cnt > cur_game->display->lines())
+			tw->place(cur_game->display->lines() - (cur_game->line_cnt + 1), cur_game->display->cols() - cur_game->maxlen - 3);
 		    else
-			mvwin(tw, NUMLINES, 0);
+			tw->place(NUMLINES, 0);
 		}
-		touchwin(tw);
-		wrefresh(tw);
+		tw->touch();
+		tw->refresh();
 		wait_for(' ');
-                if (md_hasclreol())
+                if (cur_game->display->has_clreol())
 		{
-		    werase(tw);
-		    leaveok(tw, true);
-		    wrefresh(tw);
+		    tw->erase();
+		    tw->refresh();
 		}
-		delwin(tw);
-		touchwin(stdscr);
+		tw.reset();
+		cur_game->cw->touch();
 	    }
 	    else
 	    {
-		wmove(hw, LINES - 1, 0);
-		waddstr(hw, prompt);
-		wrefresh(hw);
+		cur_game->hw->move(cur_game->display->lines() - 1, 0);
+		cur_game->hw->addstr(prompt);
+		cur_game->hw->refresh();
 		wait_for(' ');
-		clearok(curscr, true);
-		wclear(hw);
-		touchwin(stdscr);
+		cur_game->display->redraw();
+		cur_game->hw->clear();
+		cur_game->cw->touch();
 	    }
-	    newpage = true;
-	    line_cnt = 0;
-	    maxlen = (int) strlen(prompt);
+	    cur_game->newpage = true;
+	    cur_game->line_cnt = 0;
+	    cur_game->maxlen = (int) strlen(prompt);
 	}
-	if (fmt != nullptr && !(line_cnt == 0 && *fmt == '\0'))
+	if (fmt != nullptr && !(cur_game->line_cnt == 0 && *fmt == '\0'))
 	{
-	    mvwprintw(hw, line_cnt++, 0, fmt, arg);
-	    getyx(hw, y, x);
-	    if (maxlen < x)
-		maxlen = x;
-	    lastfmt = fmt;
-	    lastarg = arg;
+	    cur_game->hw->mvprintw(cur_game->line_cnt++, 0, fmt, arg);
+	    cur_game->hw->getyx(y, x);
+	    if (cur_game->maxlen < x)
+		cur_game->maxlen = x;
+	    cur_game->lastfmt = fmt;
+	    cur_game->lastarg = arg;
 	}
     }
     return ~ESCAPE;
@@ -606,18 +594,18 @@ add_line(const char* fmt, const char* arg)
 void
 end_line()
 {
-    if (inv_type != INV_SLOW)
+    if (cur_game->inv_type != INV_SLOW)
     {
-	if (line_cnt == 1 && !newpage)
+	if (cur_game->line_cnt == 1 && !cur_game->newpage)
 	{
-	    mpos = 0;
-	    msg(lastfmt, lastarg);
+	    cur_game->mpos = 0;
+	    msg(cur_game->lastfmt, cur_game->lastarg);
 	}
 	else
 	    add_line(nullptr, nullptr);
     }
-    line_cnt = 0;
-    newpage = false;
+    cur_game->line_cnt = 0;
+    cur_game->newpage = false;
 }
 
 /*
@@ -629,15 +617,15 @@ nothing(char type)
 {
     const char* tystr = nullptr;
 
-    if (terse)
+    if (cur_game->terse)
     {
-	    std::sprintf(prbuf, "Nothing");
+	    std::sprintf(cur_game->prbuf, "Nothing");
     } else {
-	    std::sprintf(prbuf, "Haven't discovered anything");
+	    std::sprintf(cur_game->prbuf, "Haven't discovered anything");
     }
     if (type != '*')
     {
-	    auto sp = &prbuf[strlen(prbuf)];
+	    auto sp = &cur_game->prbuf[strlen(cur_game->prbuf)];
 
         switch (type)
         {
@@ -649,7 +637,7 @@ nothing(char type)
         std::sprintf(sp, " about any %ss", tystr);
     }
 
-    return prbuf;
+    return cur_game->prbuf;
 }
 
 /*
@@ -672,21 +660,21 @@ nameit(
         if (obj.o_count == 1)
         {
             std::snprintf(
-                prbuf,
+                cur_game->prbuf,
                 2 * MAXSTR,
                 "A %s ",
                 type ? type->c_str() : ""
             );
         } else {
             std::snprintf(
-                prbuf,
+                cur_game->prbuf,
                 2 * MAXSTR,
                 "%d %ss ",
                 obj.o_count,
                 type ? type->c_str() : ""
             );
         }
-        pb = &prbuf[std::strlen(prbuf)];
+        pb = &cur_game->prbuf[std::strlen(cur_game->prbuf)];
         if (op.oi_know)
         {
             std::sprintf(
@@ -711,7 +699,7 @@ nameit(
     else if (obj.o_count == 1)
     {
         std::snprintf(
-            prbuf,
+            cur_game->prbuf,
             2 * MAXSTR,
             "A%s %s %s",
             which ? vowelstr(*which) : "",
@@ -720,7 +708,7 @@ nameit(
         );
     } else {
         std::snprintf(
-            prbuf,
+            cur_game->prbuf,
             2 * MAXSTR,
             "%d %s %ss",
             obj.o_count,
@@ -751,27 +739,27 @@ pr_list()
 {
     int ch;
 
-    if (!terse)
+    if (!cur_game->terse)
 	addmsg("for ");
     addmsg("what type");
-    if (!terse)
+    if (!cur_game->terse)
 	addmsg(" of object do you want a list");
     msg("? ");
     ch = readchar();
     switch (ch)
     {
 	case POTION:
-	    pr_spec(pot_info, MAXPOTIONS);
+	    pr_spec(cur_game->pot_info, MAXPOTIONS);
 	when SCROLL:
-	    pr_spec(scr_info, MAXSCROLLS);
+	    pr_spec(cur_game->scr_info, MAXSCROLLS);
 	when RING:
-	    pr_spec(ring_info, MAXRINGS);
+	    pr_spec(cur_game->ring_info, MAXRINGS);
 	when STICK:
-	    pr_spec(ws_info, MAXSTICKS);
+	    pr_spec(cur_game->ws_info, MAXSTICKS);
 	when ARMOR:
-	    pr_spec(arm_info, MAXARMORS);
+	    pr_spec(cur_game->arm_info, MAXARMORS);
 	when WEAPON:
-	    pr_spec(weap_info, MAXWEAPONS);
+	    pr_spec(cur_game->weap_info, MAXWEAPONS);
 	otherwise:
 	    return;
     }
@@ -794,9 +782,9 @@ pr_spec(struct obj_info *info, int nitems)
     {
 	if (i == '9' + 1)
 	    i = 'a';
-	sprintf(prbuf, "%c: %%s (%d%%%%)", i, info->oi_prob - lastprob);
+	sprintf(cur_game->prbuf, "%c: %%s (%d%%%%)", i, info->oi_prob - lastprob);
 	lastprob = info->oi_prob;
-	add_line(prbuf, info->oi_name);
+	add_line(cur_game->prbuf, info->oi_name);
 	info++;
     }
     end_line();
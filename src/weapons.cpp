@@ -13,14 +13,10 @@
 #include <cctype>
 #include <cstring>
 
-#include <ncurses.h>
-
 #include <roguepp/roguepp.hpp>
 
 #define NO_WEAPON -1
 
-int group = 2;
-
 static struct init_weaps
 {
     /** Damage when wielded. */
@@ -67,6 +63,8 @@ missile(int ydelta, int xdelta)
     if (moat(obj->o_pos.y, obj->o_pos.x) == nullptr ||
 	!hit_monster(unc(obj->o_pos), obj))
 	    fall(obj, true);
+    else
+	discard(obj);
 }
 
 /*
@@ -89,12 +87,12 @@ do_motion(THING *obj, int ydelta, int xdelta)
 	/*
 	 * Erase the old one
 	 */
-	if (!ce(obj->o_pos, hero) && cansee(unc(obj->o_pos)) && !terse)
+	if (!ce(obj->o_pos, hero) && cansee(unc(obj->o_pos)) && !cur_game->terse)
 	{
 	    ch = chat(obj->o_pos.y, obj->o_pos.x);
 	    if (ch == FLOOR && !show_floor())
 		ch = ' ';
-	    mvaddch(obj->o_pos.y, obj->o_pos.x, ch);
+	    cur_game->cw->mvaddch(obj->o_pos.y, obj->o_pos.x, ch);
 	}
 	/*
 	 * Get the new position
@@ -107,10 +105,10 @@ do_motion(THING *obj, int ydelta, int xdelta)
 	     * It hasn't hit anything yet, so display it
 	     * If it alright.
 	     */
-	    if (cansee(unc(obj->o_pos)) && !terse)
+	    if (cansee(unc(obj->o_pos)) && !cur_game->terse)
 	    {
-		mvaddch(obj->o_pos.y, obj->o_pos.x, obj->o_type);
-		refresh();
+		cur_game->cw->mvaddch(obj->o_pos.y, obj->o_pos.x, obj->o_type);
+		cur_game->cw->refresh();
 	    }
 	    continue;
 	}
@@ -127,10 +125,11 @@ void
 fall(THING *obj, bool pr)
 {
     PLACE *pp;
-    static coord fpos;
+    static thread_local coord fpos;
 
     if (fallpos(&obj->o_pos, &fpos))
     {
+	obj = level_item(obj);
 	pp = INDEX(fpos.y, fpos.x);
 	pp->p_ch = (char) obj->o_type;
 	obj->o_pos = fpos;
@@ -139,20 +138,20 @@ fall(THING *obj, bool pr)
 	    if (pp->p_monst != nullptr)
 		pp->p_monst->t_oldch = (char) obj->o_type;
 	    else
-		mvaddch(fpos.y, fpos.x, obj->o_type);
+		cur_game->cw->mvaddch(fpos.y, fpos.x, obj->o_type);
 	}
-	attach(lvl_obj, obj);
+	attach(cur_game->lvl_obj, obj);
 	return;
     }
     if (pr)
     {
-	if (has_hit)
+	if (cur_game->has_hit)
 	{
 	    endmsg();
-	    has_hit = false;
+	    cur_game->has_hit = false;
 	}
 	msg("the %s vanishes as it hits the ground",
-	    weap_info[obj->o_which].oi_name);
+	    cur_game->weap_info[obj->o_which].oi_name);
     }
     discard(obj);
 }
@@ -179,12 +178,12 @@ init_weapon(THING *weap, int which)
     if (which == DAGGER)
     {
 	weap->o_count = rnd(4) + 2;
-	weap->o_group = group++;
+	weap->o_group = cur_game->group++;
     }
     else if (weap->o_flags & ISMANY)
     {
 	weap->o_count = rnd(8) + 8;
-	weap->o_group = group++;
+	weap->o_group = cur_game->group++;
     }
     else
     {
@@ -200,7 +199,7 @@ init_weapon(THING *weap, int which)
 int
 hit_monster(int y, int x, THING *obj)
 {
-    static coord mp;
+    coord mp;
 
     mp.y = y;
     mp.x = x;
@@ -214,7 +213,7 @@ hit_monster(int y, int x, THING *obj)
 char *
 num(int n1, int n2, char type)
 {
-    static char numbuf[10];
+    static thread_local char numbuf[10];
 
     sprintf(numbuf, n1 < 0 ? "%d" : "+%d", n1);
     if (type == WEAPON)
@@ -233,17 +232,17 @@ wield()
     THING *obj, *oweapon;
     char *sp;
 
-    oweapon = cur_weapon;
-    if (!dropcheck(cur_weapon))
+    oweapon = cur_game->cur_weapon;
+    if (!dropcheck(cur_game->cur_weapon))
     {
-	cur_weapon = oweapon;
+	cur_game->cur_weapon = oweapon;
 	return;
     }
-    cur_weapon = oweapon;
+    cur_game->cur_weapon = oweapon;
     if ((obj = get_item("wield", WEAPON)) == nullptr)
     {
 bad:
-	after = false;
+	cur_game->after = false;
 	return;
     }
 
@@ -256,8 +255,8 @@ bad:
         goto bad;
 
     sp = inv_name(obj, true);
-    cur_weapon = obj;
-    if (!terse)
+    cur_game->cur_weapon = obj;
+    if (!cur_game->terse)
 	addmsg("you are now ");
     msg("wielding %s (%c)", sp, obj->o_packch);
 }
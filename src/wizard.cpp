@@ -16,8 +16,6 @@
 #include <cstring>
 #include <unordered_map>
 
-#include <ncurses.h>
-
 #include <roguepp/roguepp.hpp>
 
 static const char* type_name(int);
@@ -43,7 +41,7 @@ whatis(bool insist, int type)
 	obj = get_item("identify", type);
 	if (insist)
 	{
-	    if (n_objs == 0)
+	    if (cur_game->n_objs == 0)
 		return;
 	    else if (obj == nullptr)
 		msg("you must identify something");
@@ -63,16 +61,16 @@ whatis(bool insist, int type)
     switch (obj->o_type)
     {
         case SCROLL:
-	    set_know(obj, scr_info);
+	    set_know(obj, cur_game->scr_info);
         when POTION:
-	    set_know(obj, pot_info);
+	    set_know(obj, cur_game->pot_info);
 	when STICK:
-	    set_know(obj, ws_info);
+	    set_know(obj, cur_game->ws_info);
         when WEAPON:
         case ARMOR:
 	    obj->o_flags |= ISKNOW;
         when RING:
-	    set_know(obj, ring_info);
+	    set_know(obj, cur_game->ring_info);
     }
     msg(inv_name(obj, false));
 }
@@ -135,17 +133,17 @@ create_obj()
     obj = new_item();
     msg("type of item: ");
     obj->o_type = readchar();
-    mpos = 0;
+    cur_game->mpos = 0;
     msg("which %c do you want? (0-f)", obj->o_type);
     obj->o_which = (isdigit((ch = readchar())) ? ch - '0' : ch - 'a' + 10);
     obj->o_group = 0;
     obj->o_count = 1;
-    mpos = 0;
+    cur_game->mpos = 0;
     if (obj->o_type == WEAPON || obj->o_type == ARMOR)
     {
 	msg("blessing? (+,-,n)");
 	bless = readchar();
-	mpos = 0;
+	cur_game->mpos = 0;
 	if (bless == '-')
 	    obj->o_flags |= ISCURSED;
 	if (obj->o_type == WEAPON)
@@ -174,7 +172,7 @@ create_obj()
 	    case R_ADDDAM:
 		msg("blessing? (+,-,n)");
 		bless = readchar();
-		mpos = 0;
+		cur_game->mpos = 0;
 		if (bless == '-')
 		    obj->o_flags |= ISCURSED;
 		obj->o_arm = (bless == '-' ? -1 : rnd(2) + 1);
@@ -187,7 +185,7 @@ create_obj()
     else if (obj->o_type == GOLD)
     {
 	msg("how much?");
-	get_num(&obj->o_goldval, stdscr);
+	get_num(&obj->o_goldval, cur_game->cw);
     }
     add_pack(obj, false);
 }
@@ -201,9 +199,9 @@ create_obj()
 void
 teleport()
 {
-    static coord c;
+    static thread_local coord c;
 
-    mvaddch(hero.y, hero.x, floor_at());
+    cur_game->cw->mvaddch(hero.y, hero.x, floor_at());
     find_floor(nullptr, &c, false, true);
     if (roomin(&c) != proom)
     {
@@ -216,19 +214,19 @@ teleport()
 	hero = c;
 	look(true);
     }
-    mvaddch(hero.y, hero.x, PLAYER);
+    cur_game->cw->mvaddch(hero.y, hero.x, PLAYER);
     /*
      * turn off ISHELD in case teleportation was done while fighting
      * a Flytrap
      */
-    if (on(player, ISHELD)) {
-	player.t_flags &= ~ISHELD;
-	vf_hit = 0;
-	strcpy(monsters['F'-'A'].m_stats.s_dmg, "000x0");
+    if (on(cur_game->player, ISHELD)) {
+	cur_game->player.t_flags &= ~ISHELD;
+	cur_game->vf_hit = 0;
+	strcpy(cur_game->monsters['F'-'A'].m_stats.s_dmg, "000x0");
     }
-    no_move = 0;
-    count = 0;
-    running = false;
+    cur_game->no_move = 0;
+    cur_game->count = 0;
+    cur_game->running = false;
     flush_type();
 }
 
@@ -241,15 +239,15 @@ int
 passwd()
 {
     char *sp, c;
-    static char buf[MAXSTR];
+    char buf[MAXSTR];
 
     msg("wizard's Password:");
-    mpos = 0;
+    cur_game->mpos = 0;
     sp = buf;
     while ((c = readchar()) != '\n' && c != '\r' && c != ESCAPE)
-	if (c == md_killchar())
+	if (c == cur_game->display->killchar())
 	    sp = buf;
-	else if (c == md_erasechar() && sp > buf)
+	else if (c == cur_game->display->erasechar() && sp > buf)
 	    sp--;
 	else
 	    *sp++ = c;
@@ -269,17 +267,17 @@ show_map()
 {
     int y, x, real;
 
-    wclear(hw);
+    cur_game->hw->clear();
     for (y = 1; y < NUMLINES - 1; y++)
 	for (x = 0; x < NUMCOLS; x++)
 	{
 	    real = flat(y, x);
 	    if (!(real & F_REAL))
-		wstandout(hw);
-	    wmove(hw, y, x);
-	    waddch(hw, chat(y, x));
+		cur_game->hw->standout();
+	    cur_game->hw->move(y, x);
+	    cur_game->hw->addch(chat(y, x));
 	    if (!real)
-		wstandend(hw);
+		cur_game->hw->standend();
 	}
     show_win("---More (level map)---");
 }
@@ -0,0 +1,161 @@
+/*
+ * Work stealing thread pool for running many games at once
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+
+#include <roguepp/work_pool.hpp>
+
+/** Pool the calling thread works for, if any. */
+static thread_local work_pool* this_pool = nullptr;
+/** Index of the calling thread's queue in this_pool. */
+static thread_local std::size_t this_worker = 0;
+
+work_pool::work_pool(unsigned int threads)
+    : m_queued(0)
+    , m_pending(0)
+    , m_next(0)
+    , m_stopping(false)
+{
+    if (threads == 0)
+    {
+        threads = std::thread::hardware_concurrency();
+    }
+    if (threads == 0)
+    {
+        threads = 1;
+    }
+    for (unsigned int i = 0; i < threads; ++i)
+    {
+        m_queues.push_back(std::make_unique<queue>());
+    }
+    for (unsigned int i = 0; i < threads; ++i)
+    {
+        m_workers.emplace_back(&work_pool::work, this, i);
+    }
+}
+
+work_pool::~work_pool()
+{
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_stopping = true;
+    }
+    m_wakeup.notify_all();
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+void
+work_pool::submit(job j)
+{
+    std::size_t target;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        ++m_pending;
+        if (this_pool == this)
+        {
+            target = this_worker;
+        } else {
+            target = m_next++ % m_queues.size();
+        }
+    }
+    {
+        auto& q = *m_queues[target];
+        std::lock_guard<std::mutex> lock(q.mutex);
+
+        q.jobs.push_front(std::move(j));
+        ++m_queued;
+    }
+    {
+        // Taking the lock keeps the notification from slipping in between
+        // an idle worker's last look at the queues and its wait.
+        std::lock_guard<std::mutex> lock(m_mutex);
+    }
+    m_wakeup.notify_one();
+}
+
+void
+work_pool::wait()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_idle.wait(lock, [this] { return m_pending == 0; });
+}
+
+/**
+ * Get the next job for the given worker: its own newest job first,
+ * otherwise the oldest job of some other worker.
+ */
+bool
+work_pool::take(std::size_t self, job& j)
+{
+    const auto count = m_queues.size();
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        auto& q = *m_queues[(self + i) % count];
+        std::lock_guard<std::mutex> lock(q.mutex);
+
+        if (q.jobs.empty())
+        {
+            continue;
+        }
+        if (i == 0)
+        {
+            j = std::move(q.jobs.front());
+            q.jobs.pop_front();
+        } else {
+            j = std::move(q.jobs.back());
+            q.jobs.pop_back();
+        }
+        --m_queued;
+
+        return true;
+    }
+
+    return false;
+}
+
+void
+work_pool::work(std::size_t self)
+{
+    this_pool = this;
+    this_worker = self;
+    for (;;)
+    {
+        job j;
+
+        if (take(self, j))
+        {
+            j();
+            j = nullptr;
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (--m_pending == 0)
+            {
+                m_idle.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_wakeup.wait(lock, [this] { return m_stopping || m_queued > 0; });
+        if (m_stopping && m_queued == 0)
+        {
+            return;
+        }
+    }
+}